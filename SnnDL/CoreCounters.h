@@ -0,0 +1,62 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// CoreCounters.h: 核心热路径计数器块头文件
+//
+
+#ifndef _CORECOUNTERS_H
+#define _CORECOUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 单写者计数器
+ *
+ * 只由所属核心递增，读者（父组件、剖析线程）随时可读到某个已写入的值。
+ * 递增为 relaxed load + store 而非 fetch_add，不产生带 lock 前缀的指令，
+ * 开销与普通 uint64_t 自增相同。
+ */
+class RelaxedCounter {
+public:
+    void add(uint64_t n = 1) {
+        value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    void set(uint64_t v) { value_.store(v, std::memory_order_relaxed); }
+    uint64_t get() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * @brief 每核心计数器块
+ *
+ * 核心在热路径上直接写入，父组件在 setup 时经 SnnCoreAPI::getCounters() 取得指针后
+ * 按需读取，不再逐周期通过 getStatistics 构造 std::map。独占缓存行，避免与相邻核心的
+ * 计数器伪共享。
+ */
+struct alignas(64) CoreCounters {
+    RelaxedCounter spikes_received;
+    RelaxedCounter spikes_generated;
+    RelaxedCounter neurons_fired;
+    RelaxedCounter memory_requests;
+    RelaxedCounter total_cycles;
+    RelaxedCounter active_cycles;
+    RelaxedCounter suspended_cycles;
+
+    /** 与 SnnPESubComponent::getUtilization 口径一致 */
+    double utilization() const {
+        uint64_t total = total_cycles.get();
+        return total ? static_cast<double>(active_cycles.get()) / static_cast<double>(total) : 0.0;
+    }
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _CORECOUNTERS_H */
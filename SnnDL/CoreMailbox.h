@@ -0,0 +1,114 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// CoreMailbox.h: 固定延迟的核间脉冲邮箱头文件
+//
+
+#ifndef _COREMAILBOX_H
+#define _COREMAILBOX_H
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "SpikeEvent.h"
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 核间脉冲邮箱（功能级互连）
+ *
+ * 每个目标核心一个FIFO邮箱，脉冲投递后经固定延迟可见，
+ * 每周期一次性取出全部到期脉冲。不建模逐跳转发、虚拟通道与信用，
+ * 用于不研究片内互连的设计空间扫描。
+ */
+class CoreMailbox {
+public:
+    /**
+     * @param num_cores 核心数
+     * @param latency_cycles 投递延迟（周期，最小为1）
+     */
+    CoreMailbox(int num_cores, uint64_t latency_cycles)
+        : boxes_(num_cores > 0 ? num_cores : 0), latency_(latency_cycles > 0 ? latency_cycles : 1) {}
+
+    ~CoreMailbox() {
+        for (auto& box : boxes_) {
+            for (auto& entry : box) delete entry.spike;
+        }
+    }
+
+    CoreMailbox(const CoreMailbox&) = delete;
+    CoreMailbox& operator=(const CoreMailbox&) = delete;
+
+    /**
+     * @brief 投递脉冲到目标核心邮箱，接管脉冲内存
+     * @return 目标核心无效时返回false（脉冲仍归调用者）
+     */
+    bool post(int dst_core, SpikeEvent* spike, uint64_t now) {
+        if (dst_core < 0 || dst_core >= static_cast<int>(boxes_.size()) || !spike) return false;
+        // 延迟固定，入队时间单调，FIFO顺序即到期顺序
+        auto& box = boxes_[dst_core];
+        box.push_back(Entry{now + latency_, spike});
+        pending_++;
+        posted_++;
+        if (box.size() > peak_depth_) peak_depth_ = box.size();
+        return true;
+    }
+
+    /**
+     * @brief 取出目标核心所有已到期的脉冲
+     * @param deliver 对每个脉冲调用，接管其内存
+     * @return 取出的脉冲数
+     */
+    template <typename F>
+    size_t drain(int dst_core, uint64_t now, F&& deliver) {
+        auto& box = boxes_[dst_core];
+        size_t count = 0;
+        while (!box.empty() && box.front().ready_cycle <= now) {
+            SpikeEvent* spike = box.front().spike;
+            box.pop_front();
+            pending_--;
+            count++;
+            deliver(spike);
+        }
+        return count;
+    }
+
+    /**
+     * @brief 丢弃全部尚未取出的脉冲
+     * @return 丢弃的脉冲数
+     */
+    size_t clear() {
+        size_t dropped = pending_;
+        for (auto& box : boxes_) {
+            for (auto& entry : box) delete entry.spike;
+            box.clear();
+        }
+        pending_ = 0;
+        return dropped;
+    }
+
+    size_t pending() const { return pending_; }
+    uint64_t posted() const { return posted_; }
+    size_t peakDepth() const { return peak_depth_; }
+    uint64_t latency() const { return latency_; }
+
+private:
+    struct Entry {
+        uint64_t ready_cycle;
+        SpikeEvent* spike;
+    };
+
+    std::vector<std::deque<Entry>> boxes_;
+    uint64_t latency_;
+    size_t pending_ = 0;
+    uint64_t posted_ = 0;
+    size_t peak_depth_ = 0;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _COREMAILBOX_H */
@@ -0,0 +1,240 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// CsrWeightStore.cc: 只读内存映射CSR权重存储实现文件
+//
+
+#include "CsrWeightStore.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::SnnDL;
+
+namespace {
+
+// 头部字段偏移
+constexpr size_t OFF_VERSION = 8;
+constexpr size_t OFF_HEADER_BYTES = 12;
+constexpr size_t OFF_NUM_ROWS = 16;
+constexpr size_t OFF_NUM_COLS = 24;
+constexpr size_t OFF_NNZ = 32;
+constexpr size_t OFF_ROW_BASE = 40;
+constexpr size_t OFF_ROW_PTR = 48;
+constexpr size_t OFF_COL = 56;
+constexpr size_t OFF_WEIGHT = 64;
+
+template <typename T>
+T readField(const uint8_t* base, size_t offset) {
+    T value;
+    std::memcpy(&value, base + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void writeField(uint8_t* base, size_t offset, T value) {
+    std::memcpy(base + offset, &value, sizeof(T));
+}
+
+uint64_t align8(uint64_t v) { return (v + 7) & ~static_cast<uint64_t>(7); }
+
+// 进程内共享表：规范化路径 -> 已映射的存储
+std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::map<std::string, std::weak_ptr<const CsrWeightStore>>& registry() {
+    static std::map<std::string, std::weak_ptr<const CsrWeightStore>> r;
+    return r;
+}
+
+std::string canonicalPath(const std::string& path) {
+    char* resolved = ::realpath(path.c_str(), nullptr);
+    if (!resolved) return path;
+    std::string result(resolved);
+    ::free(resolved);
+    return result;
+}
+
+} // namespace
+
+constexpr char CsrWeightStore::MAGIC[8];
+
+CsrView CsrView::slice(uint64_t first, uint64_t count) const {
+    CsrView sub;
+    if (first >= rows) return sub;
+    uint64_t available = rows - first;
+    sub.row_ptr = row_ptr + first;
+    sub.col = col;
+    sub.weight = weight;
+    sub.rows = static_cast<uint32_t>(count < available ? count : available);
+    return sub;
+}
+
+CsrWeightStore::~CsrWeightStore() {
+    if (mapping_) ::munmap(mapping_, mapped_bytes_);
+}
+
+bool CsrWeightStore::isCsrFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {0};
+    if (!file.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::shared_ptr<const CsrWeightStore> CsrWeightStore::open(const std::string& path, std::string& error) {
+    std::string key = canonicalPath(path);
+    std::lock_guard<std::mutex> lock(registryMutex());
+
+    auto& table = registry();
+    auto it = table.find(key);
+    if (it != table.end()) {
+        if (auto existing = it->second.lock()) return existing;
+    }
+
+    std::shared_ptr<CsrWeightStore> store(new CsrWeightStore());
+    if (!store->map(key, error)) return nullptr;
+    table[key] = store;
+    return store;
+}
+
+bool CsrWeightStore::map(const std::string& path, std::string& error) {
+    path_ = path;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "无法打开文件: " + std::string(std::strerror(errno));
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(HEADER_BYTES)) {
+        ::close(fd);
+        error = "文件过短，缺少CSR头部";
+        return false;
+    }
+    mapped_bytes_ = static_cast<size_t>(st.st_size);
+    void* addr = ::mmap(nullptr, mapped_bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        mapped_bytes_ = 0;
+        error = "mmap失败: " + std::string(std::strerror(errno));
+        return false;
+    }
+    mapping_ = addr;
+
+    const uint8_t* base = static_cast<const uint8_t*>(mapping_);
+    if (std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "magic不匹配，不是SNNDLCSR文件";
+        return false;
+    }
+    uint32_t version = readField<uint32_t>(base, OFF_VERSION);
+    if (version != VERSION) {
+        error = "不支持的CSR版本 " + std::to_string(version);
+        return false;
+    }
+    uint32_t header_bytes = readField<uint32_t>(base, OFF_HEADER_BYTES);
+    num_rows_ = readField<uint64_t>(base, OFF_NUM_ROWS);
+    num_cols_ = readField<uint64_t>(base, OFF_NUM_COLS);
+    nnz_ = readField<uint64_t>(base, OFF_NNZ);
+    row_base_ = readField<uint64_t>(base, OFF_ROW_BASE);
+    uint64_t row_ptr_off = readField<uint64_t>(base, OFF_ROW_PTR);
+    uint64_t col_off = readField<uint64_t>(base, OFF_COL);
+    uint64_t weight_off = readField<uint64_t>(base, OFF_WEIGHT);
+
+    // 段必须对齐、互不越界，才能直接按类型指针访问
+    auto section_ok = [this](uint64_t offset, uint64_t bytes) {
+        return offset % 8 == 0 && offset <= mapped_bytes_ && bytes <= mapped_bytes_ - offset;
+    };
+    if (header_bytes < HEADER_BYTES || num_rows_ >= UINT32_MAX ||
+        !section_ok(row_ptr_off, (num_rows_ + 1) * sizeof(uint64_t)) ||
+        !section_ok(col_off, nnz_ * sizeof(uint32_t)) ||
+        !section_ok(weight_off, nnz_ * sizeof(float))) {
+        error = "CSR头部字段与文件大小不符";
+        return false;
+    }
+
+    view_.row_ptr = reinterpret_cast<const uint64_t*>(base + row_ptr_off);
+    view_.col = reinterpret_cast<const uint32_t*>(base + col_off);
+    view_.weight = reinterpret_cast<const float*>(base + weight_off);
+    view_.rows = static_cast<uint32_t>(num_rows_);
+
+    // 一次性校验行偏移单调，之后各核心切片无需再检查
+    if (view_.row_ptr[0] != 0 || view_.row_ptr[num_rows_] != nnz_) {
+        error = "row_ptr 首尾与nnz不一致";
+        return false;
+    }
+    for (uint64_t r = 0; r < num_rows_; r++) {
+        if (view_.row_ptr[r] > view_.row_ptr[r + 1]) {
+            error = "row_ptr 非单调，行 " + std::to_string(r);
+            return false;
+        }
+    }
+    ::madvise(mapping_, mapped_bytes_, MADV_WILLNEED);
+    return true;
+}
+
+CsrView CsrWeightStore::globalRows(uint64_t global_first, uint64_t count) const {
+    if (global_first < row_base_) return CsrView();
+    return view_.slice(global_first - row_base_, count);
+}
+
+bool CsrWeightStore::write(const std::string& path, uint64_t row_base, uint64_t num_cols,
+                           const std::vector<uint64_t>& row_ptr, const std::vector<uint32_t>& col,
+                           const std::vector<float>& weight, std::string& error) {
+    if (row_ptr.empty() || row_ptr.front() != 0 || row_ptr.back() != col.size() ||
+        col.size() != weight.size()) {
+        error = "row_ptr/col/weight 长度不一致";
+        return false;
+    }
+    uint64_t num_rows = row_ptr.size() - 1;
+    uint64_t nnz = col.size();
+    uint64_t row_ptr_off = HEADER_BYTES;
+    uint64_t col_off = align8(row_ptr_off + row_ptr.size() * sizeof(uint64_t));
+    uint64_t weight_off = align8(col_off + nnz * sizeof(uint32_t));
+    uint64_t total = align8(weight_off + nnz * sizeof(float));
+
+    std::vector<uint8_t> header(HEADER_BYTES, 0);
+    std::memcpy(header.data(), MAGIC, sizeof(MAGIC));
+    writeField<uint32_t>(header.data(), OFF_VERSION, VERSION);
+    writeField<uint32_t>(header.data(), OFF_HEADER_BYTES, HEADER_BYTES);
+    writeField<uint64_t>(header.data(), OFF_NUM_ROWS, num_rows);
+    writeField<uint64_t>(header.data(), OFF_NUM_COLS, num_cols);
+    writeField<uint64_t>(header.data(), OFF_NNZ, nnz);
+    writeField<uint64_t>(header.data(), OFF_ROW_BASE, row_base);
+    writeField<uint64_t>(header.data(), OFF_ROW_PTR, row_ptr_off);
+    writeField<uint64_t>(header.data(), OFF_COL, col_off);
+    writeField<uint64_t>(header.data(), OFF_WEIGHT, weight_off);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        error = "无法创建文件 " + path;
+        return false;
+    }
+    static const char zeros[8] = {0};
+    auto pad_to = [&file](uint64_t offset) {
+        uint64_t pos = static_cast<uint64_t>(file.tellp());
+        if (offset > pos) file.write(zeros, static_cast<std::streamsize>(offset - pos));
+    };
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    file.write(reinterpret_cast<const char*>(row_ptr.data()), row_ptr.size() * sizeof(uint64_t));
+    pad_to(col_off);
+    file.write(reinterpret_cast<const char*>(col.data()), nnz * sizeof(uint32_t));
+    pad_to(weight_off);
+    file.write(reinterpret_cast<const char*>(weight.data()), nnz * sizeof(float));
+    pad_to(total);
+    if (!file) {
+        error = "写入失败 " + path;
+        return false;
+    }
+    return true;
+}
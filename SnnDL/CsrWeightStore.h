@@ -0,0 +1,125 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// CsrWeightStore.h: 只读内存映射CSR权重存储（进程内共享）头文件
+//
+
+#ifndef _CSRWEIGHTSTORE_H
+#define _CSRWEIGHTSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief CSR连接表的零拷贝视图
+ *
+ * row_ptr 为相对 col/weight 起点的绝对偏移，取行子区间只需移动 row_ptr 指针，
+ * 不复制任何数据。视图不拥有内存，生命周期由 CsrWeightStore 或调用者保证。
+ */
+struct CsrView {
+    const uint64_t* row_ptr = nullptr;   ///< rows+1 个偏移
+    const uint32_t* col = nullptr;       ///< 突触后神经元全局ID（行内升序）
+    const float* weight = nullptr;
+    uint32_t rows = 0;
+
+    bool empty() const { return rows == 0; }
+    uint64_t rowBegin(uint32_t r) const { return row_ptr[r]; }
+    uint64_t rowEnd(uint32_t r) const { return row_ptr[r + 1]; }
+    uint64_t nnz() const { return rows ? row_ptr[rows] - row_ptr[0] : 0; }
+
+    /**
+     * @brief 取 [first, first+count) 行的子视图（越界部分截断）
+     */
+    CsrView slice(uint64_t first, uint64_t count) const;
+};
+
+/**
+ * @brief 版本化二进制CSR权重文件的只读内存映射
+ *
+ * 文件布局（小端）：
+ * - 头部 HEADER_BYTES 字节：magic "SNNDLCSR"、u32 版本、u32 头部长度，
+ *   随后 u64 num_rows / num_cols / nnz / row_base 及三个段的文件偏移
+ * - row_ptr 段：u64[num_rows+1]
+ * - col 段：u32[nnz]
+ * - weight 段：f32[nnz]
+ * 各段按8字节对齐。行号为突触前神经元全局ID减 row_base，行按全局ID排序、
+ * 行内按突触后全局ID排序，因此每个节点/核心的行是连续区间，可直接切片。
+ *
+ * 同一路径在进程内只映射一次，所有组件共享同一份只读页面。
+ */
+class CsrWeightStore {
+public:
+    static constexpr char MAGIC[8] = {'S', 'N', 'N', 'D', 'L', 'C', 'S', 'R'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t HEADER_BYTES = 80;
+
+    ~CsrWeightStore();
+    CsrWeightStore(const CsrWeightStore&) = delete;
+    CsrWeightStore& operator=(const CsrWeightStore&) = delete;
+
+    /**
+     * @brief 打开（或复用已打开的）CSR文件
+     * @param path 文件路径
+     * @param error 输出：失败原因
+     * @return 共享存储，失败返回空指针
+     */
+    static std::shared_ptr<const CsrWeightStore> open(const std::string& path, std::string& error);
+
+    /**
+     * @brief 判断文件是否以CSR magic开头（用于格式自动识别）
+     */
+    static bool isCsrFile(const std::string& path);
+
+    /**
+     * @brief 写出CSR文件（row_ptr 以0起始，长度为行数+1）
+     * @return 是否成功，失败时 error 给出原因
+     */
+    static bool write(const std::string& path, uint64_t row_base, uint64_t num_cols,
+                      const std::vector<uint64_t>& row_ptr, const std::vector<uint32_t>& col,
+                      const std::vector<float>& weight, std::string& error);
+
+    uint64_t numRows() const { return num_rows_; }
+    uint64_t numCols() const { return num_cols_; }
+    uint64_t nnz() const { return nnz_; }
+    uint64_t rowBase() const { return row_base_; }
+    uint64_t mappedBytes() const { return mapped_bytes_; }
+    const std::string& path() const { return path_; }
+
+    /**
+     * @brief 整个文件的视图
+     */
+    const CsrView& view() const { return view_; }
+
+    /**
+     * @brief 突触前全局ID [global_first, global_first+count) 的零拷贝视图
+     *
+     * 返回视图的第 r 行对应全局ID global_first+r；超出文件覆盖范围的行被截断，
+     * 起点不在文件范围内时返回空视图。
+     */
+    CsrView globalRows(uint64_t global_first, uint64_t count) const;
+
+private:
+    CsrWeightStore() = default;
+    bool map(const std::string& path, std::string& error);
+
+    std::string path_;
+    void* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    uint64_t num_rows_ = 0;
+    uint64_t num_cols_ = 0;
+    uint64_t nnz_ = 0;
+    uint64_t row_base_ = 0;
+    CsrView view_;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _CSRWEIGHTSTORE_H */
@@ -0,0 +1,128 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// EventPool.h: 脉冲路径事件对象的定长空闲链表分配器头文件
+//
+
+#ifndef _EVENTPOOL_H
+#define _EVENTPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 按类型划分的定长对象池
+ *
+ * 供事件类的类级 operator new/delete 使用：释放的内存块挂入空闲链表，
+ * 下次分配直接复用，避免高发放率下每个脉冲多次进出通用堆。
+ * 空闲链表按线程划分（SST 多线程仿真中组件不跨线程），无需加锁；
+ * 跨线程释放的块进入释放线程的链表，因块大小相同仍可安全复用。
+ * 尺寸与 sizeof(T) 不同的请求（派生类）直接走全局堆。
+ *
+ * @tparam T 池化的事件类型
+ */
+template <typename T>
+class EventPool {
+public:
+    /**
+     * @brief 池统计信息（本线程）
+     */
+    struct Stats {
+        uint64_t live = 0;        ///< 当前存活对象数
+        uint64_t peak = 0;        ///< 存活对象数峰值
+        uint64_t allocations = 0; ///< 分配总次数
+        uint64_t reused = 0;      ///< 由空闲链表满足的分配次数
+        uint64_t cached = 0;      ///< 空闲链表中的块数
+    };
+
+    /** 空闲链表最多缓存的块数，超出部分归还全局堆 */
+    static constexpr uint64_t MAX_CACHED = 8192;
+
+    static void* allocate(std::size_t size) {
+        if (size != sizeof(T)) return ::operator new(size);
+        State& s = state();
+        s.stats.allocations++;
+        if (++s.stats.live > s.stats.peak) s.stats.peak = s.stats.live;
+        if (s.head) {
+            FreeNode* node = s.head;
+            s.head = node->next;
+            s.stats.cached--;
+            s.stats.reused++;
+            return node;
+        }
+        return ::operator new(sizeof(T) < sizeof(FreeNode) ? sizeof(FreeNode) : sizeof(T));
+    }
+
+    static void release(void* p, std::size_t size) {
+        if (!p) return;
+        if (size != sizeof(T)) {
+            ::operator delete(p);
+            return;
+        }
+        State& s = state();
+        if (s.stats.live > 0) s.stats.live--;
+        if (s.stats.cached >= MAX_CACHED) {
+            ::operator delete(p);
+            return;
+        }
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = s.head;
+        s.head = node;
+        s.stats.cached++;
+    }
+
+    static const Stats& stats() { return state().stats; }
+
+    /**
+     * @brief 将空闲链表中的块全部归还全局堆
+     */
+    static void trim() { state().trim(); }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct State {
+        FreeNode* head = nullptr;
+        Stats stats;
+
+        void trim() {
+            while (head) {
+                FreeNode* next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+            stats.cached = 0;
+        }
+        // 不在析构中归还：进程退出时仍可能有事件晚于线程局部状态释放
+    };
+
+    static State& state() {
+        static thread_local State s;
+        return s;
+    }
+};
+
+/**
+ * @brief 为事件类声明池化的类级 operator new/delete
+ *
+ * 在类定义内使用；虚析构保证经由基类指针删除时也回到对应的池。
+ */
+#define SNNDL_POOLED_EVENT(cls)                                                   \
+    static void* operator new(std::size_t size) {                                 \
+        return ::SST::SnnDL::EventPool<cls>::allocate(size);                       \
+    }                                                                             \
+    static void operator delete(void* p, std::size_t size) {                      \
+        ::SST::SnnDL::EventPool<cls>::release(p, size);                            \
+    }
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _EVENTPOOL_H */
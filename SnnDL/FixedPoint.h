@@ -0,0 +1,183 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// FixedPoint.h: 定点/低精度数值格式（权重与膜电位）头文件
+//
+
+#ifndef _FIXEDPOINT_H
+#define _FIXEDPOINT_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 有符号定点数值格式：值 = 码字 × lsb，码字按位宽饱和
+ *
+ * float32 为不量化的原始格式；int16/int8 下量化采用就近舍入，超出码字范围时饱和到
+ * 最大/最小码字。lsb 取2的幂时码字与 float 之间的换算是精确的，因此用 float 存放
+ * 量化后的值（snap/add）与在整型寄存器上做饱和运算逐位一致。
+ * 内存映像中码字按小端、每值 bytes() 字节存放。
+ */
+class FixedPointFormat {
+public:
+    enum class Precision : uint8_t {
+        FLOAT32,
+        INT16,
+        INT8
+    };
+
+    FixedPointFormat() = default;
+
+    FixedPointFormat(Precision precision, float lsb)
+        : precision_(precision), lsb_(lsb > 0.0f ? lsb : 1.0f), inv_lsb_(1.0f / lsb_) {
+        max_code_ = precision == Precision::INT16 ? INT16_MAX : (precision == Precision::INT8 ? INT8_MAX : 0);
+    }
+
+    /**
+     * @brief 由参数名解析格式
+     * @param name float32 | int16 | int8
+     * @param lsb 一个码字对应的数值（定点格式下须 > 0）
+     */
+    static bool parse(const std::string& name, float lsb, FixedPointFormat& out, std::string& error) {
+        Precision precision;
+        if (name == "float32" || name == "float") {
+            out = FixedPointFormat();
+            return true;
+        } else if (name == "int16") {
+            precision = Precision::INT16;
+        } else if (name == "int8") {
+            precision = Precision::INT8;
+        } else {
+            error = "未知的数值精度 '" + name + "' (可选 float32|int16|int8)";
+            return false;
+        }
+        if (!(lsb > 0.0f)) {
+            error = "定点格式 " + name + " 的scale须大于0";
+            return false;
+        }
+        out = FixedPointFormat(precision, lsb);
+        return true;
+    }
+
+    const char* name() const {
+        return precision_ == Precision::INT16 ? "int16" : (precision_ == Precision::INT8 ? "int8" : "float32");
+    }
+    Precision precision() const { return precision_; }
+    bool isFixed() const { return precision_ != Precision::FLOAT32; }
+    float lsb() const { return lsb_; }
+
+    /** 内存中每个值的字节数 */
+    uint32_t bytes() const {
+        return precision_ == Precision::INT16 ? 2 : (precision_ == Precision::INT8 ? 1 : sizeof(float));
+    }
+
+    int32_t maxCode() const { return max_code_; }
+    int32_t minCode() const { return -max_code_ - 1; }
+    float maxValue() const { return max_code_ * lsb_; }
+    float minValue() const { return minCode() * lsb_; }
+
+    /** 就近舍入并饱和到码字范围（NaN 量化为0） */
+    int32_t quantize(float x) const {
+        float q = std::nearbyint(x * inv_lsb_);
+        if (q >= static_cast<float>(max_code_)) return max_code_;
+        if (q <= static_cast<float>(minCode())) return minCode();
+        if (q != q) return 0;
+        return static_cast<int32_t>(q);
+    }
+
+    /** 量化时是否会被饱和截断 */
+    bool saturates(float x) const {
+        if (!isFixed()) return false;
+        float q = std::nearbyint(x * inv_lsb_);
+        return q > static_cast<float>(max_code_) || q < static_cast<float>(minCode());
+    }
+
+    float dequantize(int32_t code) const { return static_cast<float>(code) * lsb_; }
+
+    /** 取最近的可表示值（float32 下原样返回） */
+    float snap(float x) const { return isFixed() ? dequantize(quantize(x)) : x; }
+
+    /** 饱和加法：两个可表示值之和等价于码字相加后饱和 */
+    float add(float a, float b) const { return isFixed() ? snap(a + b) : a + b; }
+
+    void encode(float x, uint8_t* out) const {
+        if (precision_ == Precision::INT16) {
+            int16_t code = static_cast<int16_t>(quantize(x));
+            std::memcpy(out, &code, sizeof(code));
+        } else if (precision_ == Precision::INT8) {
+            int8_t code = static_cast<int8_t>(quantize(x));
+            std::memcpy(out, &code, sizeof(code));
+        } else {
+            std::memcpy(out, &x, sizeof(float));
+        }
+    }
+
+    float decode(const uint8_t* in) const {
+        if (precision_ == Precision::INT16) {
+            int16_t code;
+            std::memcpy(&code, in, sizeof(code));
+            return dequantize(code);
+        } else if (precision_ == Precision::INT8) {
+            int8_t code;
+            std::memcpy(&code, in, sizeof(code));
+            return dequantize(code);
+        }
+        float value;
+        std::memcpy(&value, in, sizeof(float));
+        return value;
+    }
+
+    /**
+     * @brief 将 count 个值编码到 out（覆盖）
+     * @return 被饱和截断的值个数
+     */
+    uint64_t encodeArray(const float* values, size_t count, std::vector<uint8_t>& out) const {
+        out.resize(count * bytes());
+        if (!isFixed()) {
+            std::memcpy(out.data(), values, count * sizeof(float));
+            return 0;
+        }
+        uint64_t saturated = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (saturates(values[i])) saturated++;
+            encode(values[i], out.data() + i * bytes());
+        }
+        return saturated;
+    }
+
+    /**
+     * @brief 解码读回的连续值（不完整的尾部字节被忽略）
+     * @return 解出的值个数
+     */
+    size_t decodeArray(const uint8_t* data, size_t size, std::vector<float>& out) const {
+        size_t count = size / bytes();
+        out.resize(count);
+        if (!isFixed()) {
+            std::memcpy(out.data(), data, count * sizeof(float));
+            return count;
+        }
+        for (size_t i = 0; i < count; i++) {
+            out[i] = decode(data + i * bytes());
+        }
+        return count;
+    }
+
+private:
+    Precision precision_ = Precision::FLOAT32;
+    float lsb_ = 1.0f;
+    float inv_lsb_ = 1.0f;
+    int32_t max_code_ = 0;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _FIXEDPOINT_H */
@@ -10,6 +10,7 @@
 #include "SnnNetworkAdapter.h"
 #include "MultiCorePERouterInterface.h"
 #include "OptimizedInternalRing.h"
+#include "SpikeBundle.h"
 
 #include <fstream>
 #include <sstream>
@@ -38,6 +39,13 @@ MultiCorePE::MultiCorePE(ComponentId_t id, Params& params) : Component(id) {
     global_neuron_base_ = params.find<uint64_t>("global_neuron_base", 0);
     verbose_ = verbose_level;
     weights_file_ = params.find<std::string>("weights_file", "");
+    connectivity_file_ = params.find<std::string>("connectivity_file", "");
+    weight_layout_ = params.find<std::string>("weight_layout", "dense");
+    weight_base_addr_ = params.find<uint64_t>("base_addr", 0);
+    core_weight_stride_ = params.find<uint64_t>("core_weight_stride", 0);
+    if (core_weight_stride_ == 0) {
+        core_weight_stride_ = static_cast<uint64_t>(neurons_per_core_) * neurons_per_core_ * sizeof(float);
+    }
     enable_numa_ = params.find<bool>("enable_numa", true);
     
     // 神经元参数
@@ -57,6 +65,65 @@ MultiCorePE::MultiCorePE(ComponentId_t id, Params& params) : Component(id) {
     
     // 环形网络实现选择
     use_optimized_ring_ = params.find<bool>("use_optimized_ring", true);
+    std::string interconnect = params.find<std::string>("internal_interconnect", "");
+    if (interconnect.empty()) {
+        interconnect_mode_ = use_optimized_ring_ ? InterconnectMode::OPTIMIZED_RING : InterconnectMode::LEGACY_RING;
+    } else if (interconnect == "optimized_ring") {
+        interconnect_mode_ = InterconnectMode::OPTIMIZED_RING;
+    } else if (interconnect == "legacy_ring") {
+        interconnect_mode_ = InterconnectMode::LEGACY_RING;
+    } else if (interconnect == "mailbox") {
+        interconnect_mode_ = InterconnectMode::MAILBOX;
+    } else {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 未知的internal_interconnect: %s\n", interconnect.c_str());
+    }
+    mailbox_latency_ = params.find<uint64_t>("mailbox_latency", 1);
+    std::string ring_routing = params.find<std::string>("ring_routing", "minimal");
+    if (ring_routing == "minimal") {
+        ring_routing_ = RingRoutingMode::MINIMAL;
+    } else if (ring_routing == "adaptive") {
+        ring_routing_ = RingRoutingMode::ADAPTIVE;
+    } else {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 未知的ring_routing: %s\n", ring_routing.c_str());
+    }
+    ring_flits_per_cycle_ = params.find<int>("ring_flits_per_cycle", 1);
+    ring_vcs_ = params.find<int>("ring_vcs", 2);
+    ring_credits_per_vc_ = params.find<uint32_t>("ring_credits_per_vc", 8);
+    
+    // 神经元放置参数
+    std::string placement = params.find<std::string>("neuron_placement", "blocked");
+    if (placement == "blocked") {
+        placement_by_connectivity_ = false;
+    } else if (placement == "connectivity") {
+        placement_by_connectivity_ = true;
+    } else {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 未知的neuron_placement: %s\n", placement.c_str());
+    }
+    placement_profile_ = params.find<std::string>("placement_profile", "");
+    placement_profile_out_ = params.find<std::string>("placement_profile_out", "");
+    placement_passes_ = params.find<int>("placement_passes", 4);
+    placement_balance_weight_ = params.find<double>("placement_balance_weight", 1.0);
+    
+    // 核间发送背压参数
+    internal_retry_depth_ = params.find<uint32_t>("internal_retry_depth", 256);
+    core_output_depth_ = params.find<uint32_t>("core_output_depth", 1024);
+    synaptic_delay_ = params.find<uint32_t>("synaptic_delay", 0);
+    max_synaptic_delay_ = params.find<uint32_t>("max_synaptic_delay", 0);
+    neuron_model_ = params.find<std::string>("neuron_model", "lif");
+    if (params.contains("core_neuron_models")) {
+        params.find_array<std::string>("core_neuron_models", core_neuron_models_);
+    }
+    for (const char* key : {"izh_a", "izh_b", "izh_c", "izh_d", "izh_dt", "izh_v_peak",
+                            "alif_tau_adapt", "alif_beta", "weight_precision", "weight_scale",
+                            "membrane_precision", "membrane_scale",
+                            "max_cache_entries", "weight_cache_ways", "weight_cache_policy",
+                            "row_fanout_delivery", "connectivity_format",
+                            "spike_queue_horizon", "deterministic_spike_order"}) {
+        if (params.contains(key)) neuron_model_params_[key] = params.find<std::string>(key);
+    }
+    delay_file_ = params.find<std::string>("delay_file", "");
+    batch_fire_check_ = params.find<bool>("batch_fire_check", true);
+    retry_per_core_.assign(std::max(num_cores_, 1), 0);
     
     // 权重验证参数
     verify_weights_ = params.find<bool>("verify_weights", false);
@@ -66,9 +133,41 @@ MultiCorePE::MultiCorePE(ComponentId_t id, Params& params) : Component(id) {
     
     // 权重回退参数
     use_event_weight_fallback_ = params.find<bool>("use_event_weight_fallback", false);
-    enable_memory_weights_ = params.find<bool>("enable_memory_weights", true);
+    enable_weight_fetch_ = params.find<bool>("enable_weight_fetch", false);
     write_weights_on_init_ = params.find<bool>("write_weights_on_init", true);
     
+    // 空闲时钟挂起参数
+    lazy_leak_ = params.find<bool>("lazy_leak", false);
+    enable_clock_suspend_ = params.find<bool>("enable_clock_suspend", false);
+    update_threads_ = params.find<int>("update_threads", 1);
+    
+    // 二进制事件环：0为不记录
+    uint32_t trace_ring_size = params.find<uint32_t>("trace_ring_size", 0);
+    trace_file_ = params.find<std::string>("trace_file", "snndl_trace_node{node}.bin");
+    trace_ring_ = trace_ring_size > 0 ? new TraceRing(trace_ring_size) : nullptr;
+    
+    // 发放栅格/流量记录：为空时不记录
+    record_file_ = params.find<std::string>("record_file", "");
+    recorder_ = nullptr;
+    if (!record_file_.empty()) {
+        recorder_ = new SpikeRecorder(node_id_, params.find<uint32_t>("record_block_spikes", 65536),
+                                      params.find<uint64_t>("record_traffic_interval", 10000));
+        std::string error;
+        if (!recorder_->open(substituteNodePath(record_file_), error)) {
+            output_->fatal(CALL_INFO, -1, "❌ 错误: 节点%d %s\n", node_id_, error.c_str());
+        }
+    }
+    
+    // 状态快照：checkpoint_out 保存，checkpoint_in 由各核心在构造时读回
+    checkpoint_out_ = params.find<std::string>("checkpoint_out", "");
+    checkpoint_in_ = params.find<std::string>("checkpoint_in", "");
+    checkpoint_cycle_ = params.find<uint64_t>("checkpoint_cycle", 0);
+    
+    // 批量推理：样本周期在init阶段注册时钟后换算为周期数
+    sample_period_ = params.find<std::string>("sample_period", "");
+    sample_counts_file_ = params.find<std::string>("sample_counts_file", "");
+    update_min_neurons_per_thread_ = params.find<uint32_t>("update_min_neurons_per_thread", 8192);
+    
     // output_->verbose(CALL_INFO, 2, 0, 
     //     "🔧 多核PE配置: cores=%d, neurons_per_core=%d, total_neurons=%d, node_id=%d\n",
     //     num_cores_, neurons_per_core_, total_neurons_, node_id_);
@@ -87,6 +186,9 @@ MultiCorePE::MultiCorePE(ComponentId_t id, Params& params) : Component(id) {
     
     // 初始化时钟计数器
     current_cycle_ = 0;
+    clock_tc_ = nullptr;
+    clock_handler_ = nullptr;
+    clock_suspended_ = false;
     test_cycle_counter_ = 0;
     test_spikes_sent_ = 0;
     
@@ -108,6 +210,7 @@ MultiCorePE::MultiCorePE(ComponentId_t id, Params& params) : Component(id) {
     external_nic_ = nullptr;
     optimized_ring_ = nullptr;
     internal_ring_ = nullptr;
+    mailbox_ = nullptr;
     controller_ = nullptr;
     
     // 初始化端口指针为空
@@ -133,7 +236,11 @@ MultiCorePE::~MultiCorePE() {
     // 清理内部组件
     delete optimized_ring_;
     delete internal_ring_;
+    delete mailbox_;
     delete controller_;
+    delete trace_ring_;
+    delete recorder_;
+    if (sample_counts_out_) std::fclose(sample_counts_out_);
     delete output_;
     
     // 清理外部脉冲队列
@@ -141,6 +248,8 @@ MultiCorePE::~MultiCorePE() {
         delete external_spike_queue_.front();
         external_spike_queue_.pop();
     }
+    for (auto& pending : internal_retry_queue_) delete pending.spike;
+    internal_retry_queue_.clear();
     
     // 清理挂起的内存请求
     for (auto& pair : pending_memory_requests_) {
@@ -157,11 +266,33 @@ void MultiCorePE::init(unsigned int phase) {
         
         // 配置时钟
         std::string clock_freq = "1GHz";  // 默认时钟频率
-        // 不需要单独的clock_handler_变量
-        registerClock(clock_freq, new Clock::Handler2<MultiCorePE,&MultiCorePE::clockTick>(this));
+        // 保留时钟处理器以便空闲挂起后重新注册
+        clock_handler_ = new Clock::Handler2<MultiCorePE,&MultiCorePE::clockTick>(this);
+        clock_tc_ = registerClock(clock_freq, clock_handler_);
         
         // output_->verbose(CALL_INFO, 2, 0, "⏰ 配置时钟频率: %s\n", clock_freq.c_str());
         
+        if (!sample_period_.empty()) {
+            sample_period_cycles_ = getTimeConverter(sample_period_)->getFactor() / clock_tc_->getFactor();
+            if (sample_period_cycles_ == 0) {
+                output_->fatal(CALL_INFO, -1, "❌ 错误: sample_period=%s 短于一个时钟周期\n", sample_period_.c_str());
+            }
+            if (!sample_counts_file_.empty()) {
+                std::string path = substituteNodePath(sample_counts_file_);
+                sample_counts_out_ = std::fopen(path.c_str(), "w");
+                if (!sample_counts_out_) {
+                    output_->fatal(CALL_INFO, -1, "❌ 错误: 无法创建样本计数文件 %s\n", path.c_str());
+                }
+                std::fprintf(sample_counts_out_, "sample,neuron,count\n");
+            }
+            if (enable_clock_suspend_) {
+                sample_wakeup_link_ = configureSelfLink("sample_wakeup", clock_tc_,
+                    new Event::Handler2<MultiCorePE,&MultiCorePE::handleSampleWakeup>(this));
+            }
+            output_->verbose(CALL_INFO, 1, 0, "🧪 节点%d批量推理: 样本周期=%s (%" PRIu64 "周期)\n",
+                             node_id_, sample_period_.c_str(), sample_period_cycles_);
+        }
+        
         // 初始化统计收集
         
         // 初始化端口连接
@@ -238,9 +369,14 @@ void MultiCorePE::setup() {
     
     // 检查内部互连（新的优化版本或旧版本）
     // 单核情况下不需要内部互连
-    if (num_cores_ > 1 && !optimized_ring_ && !internal_ring_) {
+    if (num_cores_ > 1 && !optimized_ring_ && !internal_ring_ && !mailbox_) {
         output_->fatal(CALL_INFO, -1, "❌ 错误: 多核配置但内部互连未初始化\n");
     }
+    
+    if (placement_by_connectivity_) {
+        computePlacement();
+    }
+    
     // 调用子核心的setup
     for (auto* core : cores_) {
         if (core) core->setup();
@@ -248,6 +384,7 @@ void MultiCorePE::setup() {
     
     // 调用网络接口的setup
     if (external_nic_) {
+        if (recorder_) external_nic_->setRecorder(recorder_);
         external_nic_->setup();
         // output_->verbose(CALL_INFO, 2, 0, "✅ 网络接口setup完成\n");
     }
@@ -269,7 +406,8 @@ void MultiCorePE::setup() {
 }
 
 void MultiCorePE::finish() {
-    // 更新最终统计信息
+    // 时钟可能已挂起，先刷新各核心状态再更新最终统计信息
+    pollCoreStates(true);
     updateStatistics();
     
     // 简练的结果输出
@@ -281,8 +419,88 @@ void MultiCorePE::finish() {
     }
     
     // 简练的节点结果摘要
-    printf("NODE%d: 脉冲=%lu, 激发=%lu\n", node_id_, agg_spikes, agg_fired);
-    fflush(stdout);
+    output_->output("NODE%d: 脉冲=%" PRIu64 ", 激发=%" PRIu64 "\n", node_id_, agg_spikes, agg_fired);
+    
+    const auto& spike_pool = EventPool<SpikeEvent>::stats();
+    output_->verbose(CALL_INFO, 1, 0, "SpikeEvent对象池: 存活=%" PRIu64 ", 峰值=%" PRIu64
+                     ", 分配=%" PRIu64 ", 复用=%" PRIu64 "\n",
+                     spike_pool.live, spike_pool.peak, spike_pool.allocations, spike_pool.reused);
+    
+    if (mailbox_) {
+        output_->verbose(CALL_INFO, 1, 0, "核间邮箱: 投递=%" PRIu64 ", 单邮箱峰值深度=%zu\n",
+                         mailbox_->posted(), mailbox_->peakDepth());
+    }
+    if (backpressure_cycles_ > 0 || internal_spikes_dropped_ > 0) {
+        output_->verbose(CALL_INFO, 1, 0, "核心背压: 周期=%" PRIu64 ", 核间重发队列满丢弃=%" PRIu64 ", 未发出=%zu\n",
+                         backpressure_cycles_, internal_spikes_dropped_, internal_retry_queue_.size());
+    }
+    
+    if (sample_period_cycles_ > 0) {
+        finishSample();
+        if (sample_counts_out_) {
+            std::fclose(sample_counts_out_);
+            sample_counts_out_ = nullptr;
+        }
+        output_->verbose(CALL_INFO, 1, 0, "批量推理: 样本=%" PRIu64 ", 边界丢弃在途脉冲=%" PRIu64 "\n",
+                         current_sample_ + 1, sample_spikes_flushed_);
+    }
+    
+    // checkpoint_cycle 为0、或节点时钟挂起错过了该周期时，在finish时保存
+    if (!checkpoint_out_.empty() && !checkpoint_written_) {
+        writeCheckpoint();
+    }
+    
+    if (recorder_) {
+        std::string error;
+        if (recorder_->close(current_cycle_, error)) {
+            output_->verbose(CALL_INFO, 1, 0, "记录: 发放=%" PRIu64 ", 栅格块=%" PRIu64 ", 流量快照=%" PRIu64
+                             ", %" PRIu64 "字节 -> %s\n", recorder_->fires(), recorder_->rasterBlocks(),
+                             recorder_->trafficChunks(), recorder_->bytesWritten(),
+                             substituteNodePath(record_file_).c_str());
+        } else {
+            output_->verbose(CALL_INFO, 1, 0, "⚠️ 节点%d %s\n", node_id_, error.c_str());
+        }
+    }
+    
+    if (trace_ring_) {
+        std::string path = substituteNodePath(trace_file_);
+        std::string error;
+        if (trace_ring_->dump(path, error)) {
+            output_->verbose(CALL_INFO, 1, 0, "事件环: 记录=%" PRIu64 ", 覆盖=%" PRIu64 " -> %s\n",
+                             trace_ring_->recorded(), trace_ring_->overwritten(), path.c_str());
+        } else {
+            output_->verbose(CALL_INFO, 1, 0, "⚠️ 节点%d转储事件环失败: %s\n", node_id_, error.c_str());
+        }
+    }
+    
+    // 导出发放计数，供下一次运行按活动放置
+    if (!placement_profile_out_.empty()) {
+        std::vector<uint64_t> fire_counts(total_neurons_, 0);
+        for (auto* core : cores_) {
+            if (core) core->getFiringCounts(fire_counts);
+        }
+        std::string path = substituteNodePath(placement_profile_out_);
+        std::string error;
+        if (!NeuronPlacement::writeProfile(path, global_neuron_base_, fire_counts, error)) {
+            output_->verbose(CALL_INFO, 1, 0, "⚠️ 节点%d导出发放计数失败: %s\n", node_id_, error.c_str());
+        }
+    }
+    
+    if (optimized_ring_) {
+        const LatencyHistogram& hop = optimized_ring_->getHopLatencyHistogram();
+        const LatencyHistogram& e2e = optimized_ring_->getMessageLatencyHistogram();
+        output_->verbose(CALL_INFO, 1, 0, "核间环网: 消息=%" PRIu64 ", 端到端延迟 均值=%.2f p50>=%" PRIu64
+                         " p99>=%" PRIu64 " 最大=%" PRIu64 ", 每跳停留 均值=%.2f 最大=%" PRIu64
+                         ", 非最短路径注入=%" PRIu64 "\n",
+                         e2e.samples, e2e.mean(), e2e.percentileLow(0.5), e2e.percentileLow(0.99), e2e.max,
+                         hop.mean(), hop.max, optimized_ring_->getAdaptiveDetours());
+        // 每跳停留周期直方图，桶k覆盖[2^(k-1), 2^k)
+        for (int b = 0; b < LatencyHistogram::NUM_BUCKETS; b++) {
+            if (hop.counts[b] == 0) continue;
+            output_->verbose(CALL_INFO, 2, 0, "  每跳停留>=%" PRIu64 "周期: %" PRIu64 "\n",
+                             LatencyHistogram::bucketLow(b), hop.counts[b]);
+        }
+    }
     
     // 调用网络接口的finish
     if (external_nic_) {
@@ -292,6 +510,12 @@ void MultiCorePE::finish() {
 
 bool MultiCorePE::clockTick(Cycle_t current_cycle) {
     current_cycle_ = current_cycle;
+    if (recorder_) recorder_->tick(current_cycle);
+    if (sample_period_cycles_ > 0) advanceSamples(current_cycle);
+    if (checkpoint_cycle_ > 0 && !checkpoint_written_ && current_cycle >= checkpoint_cycle_ &&
+        !checkpoint_out_.empty()) {
+        writeCheckpoint();
+    }
     
     // 详细调试信息（仅在高详细度时输出）
     if (verbose_ >= 4 && current_cycle % 1000 == 0) {
@@ -325,13 +549,11 @@ bool MultiCorePE::clockTick(Cycle_t current_cycle) {
         int target_unit = determineTargetUnit(spike->getDestinationNeuron());
         if (target_unit >= 0 && target_unit < num_cores_) {
             // 目标在本节点，直接投递给对应的处理单元
-            // Debug output removed
-            fflush(stdout);
             deliverSpikeToCore(target_unit, spike);
         } else {
             // 目标不在本节点，需要转发到其他节点
             if (external_nic_) {
-                output_->verbose(CALL_INFO, 3, 0, "🔄 中继转发脉冲: 神经元%d -> 目标节点%d\n", 
+                SNNDL_TRACE(output_, 3, 0, "🔄 中继转发脉冲: 神经元%d -> 目标节点%d\n", 
                                spike->getDestinationNeuron(), spike->getDestinationNode());
                 external_nic_->sendSpike(spike);
                 // 不要删除spike，已经转交给网络适配器
@@ -345,34 +567,14 @@ bool MultiCorePE::clockTick(Cycle_t current_cycle) {
     
     // 2. SubComponent时钟由SST自动管理，无需手动调用tick
     // 更新处理单元状态统计（从SnnPE SubComponent获取实际数据）
-    for (int i = 0; i < num_cores_; i++) {
-        if (cores_[i] != nullptr) {
-            std::map<std::string, uint64_t> core_stats;
-            cores_[i]->getStatistics(core_stats);
-            auto it_sp = core_stats.find("spikes_received");
-            auto it_nf = core_stats.find("neurons_fired");
-            uint64_t old_spikes = unit_states_[i].spikes_processed;
-            uint64_t new_spikes = (it_sp != core_stats.end()) ? it_sp->second : 0;
-            unit_states_[i].spikes_processed = new_spikes;
-            unit_states_[i].neurons_fired = (it_nf != core_stats.end()) ? it_nf->second : 0;
-            unit_states_[i].utilization = cores_[i]->getUtilization();
-            unit_states_[i].is_active = cores_[i]->hasWork();
-            
-            // 调试：跟踪统计数据变化 (已禁用避免过多输出)
-            // if (new_spikes != old_spikes) {
-            //     printf("DEBUG: 核心%d统计更新，节点%d - 旧值:%lu -> 新值:%lu (来自getStatistics)\n", 
-            //            i, node_id_, old_spikes, new_spikes);
-            //     fflush(stdout);
-            // }
-        } else {
-            unit_states_[i].spikes_processed = 0;
-            unit_states_[i].neurons_fired = 0;
-            unit_states_[i].utilization = 0.0;
-            unit_states_[i].is_active = false;
-        }
-    }
+    pollCoreStates();
     
-    // 3. 内部互连时钟滴答
+    // 3. 内部互连时钟滴答：先重发上周期被拒收的脉冲
+    retryInternalSpikes();
+    if (!canSendSpike()) {
+        backpressure_cycles_++;
+        stat_backpressure_cycles_->addData(1);
+    }
     if (optimized_ring_) {
         optimized_ring_->tick(current_cycle);
         
@@ -383,6 +585,8 @@ bool MultiCorePE::clockTick(Cycle_t current_cycle) {
         
         // 处理跨核脉冲路由（旧版本兼容）
         handleCrossCoreRouting();
+    } else if (mailbox_) {
+        handleMailboxDelivery();
     }
     
     // 4. 多核控制器时钟滴答
@@ -402,18 +606,94 @@ bool MultiCorePE::clockTick(Cycle_t current_cycle) {
     
     // 6. 更新统计信息（每1000周期一次）
     if (current_cycle % 1000 == 0) {
+        pollCoreStates(true);
         updateStatistics();
     }
     
+    // 7. 外部队列与内部互连均已排空时挂起时钟，由新到达的脉冲唤醒
+    if (enable_clock_suspend_ && canSuspendClock()) {
+        clock_suspended_ = true;
+        SNNDL_TRACE(output_, 4, 0, "💤 节点%d空闲，挂起时钟 (周期%" PRIu64 ")\n", node_id_, current_cycle_);
+        // 挂起期间样本边界不会经时钟推进：到边界时由自链接唤醒，按时复位而不是等到下一个输入
+        uint64_t next_boundary = sample_start_cycle_ + sample_period_cycles_;
+        if (sample_wakeup_link_ && sample_wakeup_cycle_ != next_boundary) {
+            sample_wakeup_cycle_ = next_boundary;
+            sample_wakeup_link_->send(next_boundary - current_cycle, nullptr);
+        }
+        return true;
+    }
+    
     // 时钟事件处理，让外部组件有机会基于周期推进
     // 继续仿真
     return false;
 }
 
+void MultiCorePE::pollCoreStates(bool refresh_activity) {
+    for (int i = 0; i < num_cores_; i++) {
+        if (core_counters_[i] != nullptr) {
+            // 按指针直接读取核心计数器块，不构造临时map
+            const CoreCounters* counters = core_counters_[i];
+            unit_states_[i].spikes_processed = counters->spikes_received.get();
+            unit_states_[i].neurons_fired = counters->neurons_fired.get();
+            unit_states_[i].utilization = counters->utilization();
+        } else if (cores_[i] != nullptr) {
+            std::map<std::string, uint64_t> core_stats;
+            cores_[i]->getStatistics(core_stats);
+            auto it_sp = core_stats.find("spikes_received");
+            auto it_nf = core_stats.find("neurons_fired");
+            unit_states_[i].spikes_processed = (it_sp != core_stats.end()) ? it_sp->second : 0;
+            unit_states_[i].neurons_fired = (it_nf != core_stats.end()) ? it_nf->second : 0;
+            unit_states_[i].utilization = cores_[i]->getUtilization();
+        } else {
+            unit_states_[i].spikes_processed = 0;
+            unit_states_[i].neurons_fired = 0;
+            unit_states_[i].utilization = 0.0;
+            unit_states_[i].is_active = false;
+            continue;
+        }
+        // hasWork() 需扫描全部神经元，仅在统计周期与finish时刷新
+        if (refresh_activity) {
+            unit_states_[i].is_active = cores_[i]->hasWork();
+        }
+    }
+}
+
+bool MultiCorePE::canSuspendClock() const {
+    if (!external_spike_queue_.empty()) return false;
+    if (optimized_ring_ && optimized_ring_->getPendingMessageCount() > 0) return false;
+    if (internal_ring_ && internal_ring_->getPendingMessageCount() > 0) return false;
+    if (mailbox_ && mailbox_->pending() > 0) return false;
+    if (!internal_retry_queue_.empty()) return false;
+    
+    // 测试流量与一次性跨核测试注入依赖时钟推进
+    if (enable_test_traffic_ && (test_max_spikes_ <= 0 || test_spikes_sent_ < test_max_spikes_)) return false;
+    if (!test_injected_ && num_cores_ > 1) return false;
+    return true;
+}
+
+void MultiCorePE::wakeClock() {
+    if (!clock_suspended_) return;
+    clock_suspended_ = false;
+    // current_cycle_ 由时钟处理器参数刷新，无需在此补齐
+    reregisterClock(clock_tc_, clock_handler_);
+}
+
+void MultiCorePE::handleSampleWakeup(SST::Event* ev) {
+    delete ev;
+    advanceSamples(getCurrentSimTime(clock_tc_));
+    wakeClock();
+}
+
 void MultiCorePE::handleExternalSpikeEvent(SST::Event* ev) {
-    // Debug output disabled to prevent excessive logging
-    // printf("DEBUG: MultiCorePE::handleExternalSpikeEvent被调用，事件指针: %p, 节点ID: %d\n", (void*)ev, node_id_);
-    fflush(stdout);
+    // 数据源按目标节点批量发送：逐个还原后走单脉冲路径
+    if (SpikeBundle* bundle = dynamic_cast<SpikeBundle*>(ev)) {
+        size_t target_offset = 0;
+        for (size_t i = 0; i < bundle->getSpikeCount(); i++) {
+            routeExternalSpikeEvent(bundle->unpackSpike(i, target_offset));
+        }
+        delete bundle;
+        return;
+    }
     
     SpikeEvent* spike = dynamic_cast<SpikeEvent*>(ev);
     if (!spike) {
@@ -421,12 +701,10 @@ void MultiCorePE::handleExternalSpikeEvent(SST::Event* ev) {
         delete ev;
         return;
     }
-    
-    // Debug output disabled to prevent excessive logging
-    // printf("DEBUG: SpikeEvent转换成功，神经元%d -> 神经元%d\n", 
-    //        spike->getSourceNeuron(), spike->getDestinationNeuron());
-    fflush(stdout);
-    
+    routeExternalSpikeEvent(spike);
+}
+
+void MultiCorePE::routeExternalSpikeEvent(SpikeEvent* spike) {
     // 检查跳数限制，防止无限循环
     if (spike->isExpired()) {
         output_->verbose(CALL_INFO, 2, 0, "⚠️ 脉冲达到最大跳数限制，丢弃: 源神经元%d -> 目标神经元%d\n",
@@ -435,9 +713,14 @@ void MultiCorePE::handleExternalSpikeEvent(SST::Event* ev) {
         return;
     }
     
+    // 时钟可能已挂起：新样本的首个输入到达时先完成样本边界复位
+    if (sample_period_cycles_ > 0) advanceSamples(getCurrentSimTime(clock_tc_));
+    
     spike->incrementHopCount();
+    SNNDL_TRACE_EVENT(trace_ring_, current_cycle_, TraceEventType::EXT_IN, TraceRing::NODE_CORE,
+                      spike->getSourceNeuron(), spike->getDestinationNeuron(), spike->getWeight());
     
-    output_->verbose(CALL_INFO, 3, 0, "📨 接收外部脉冲: 源神经元%d -> 目标神经元%d, 权重%.3f, 跳数%d\n",
+    SNNDL_TRACE(output_, 3, 0, "📨 接收外部脉冲: 源神经元%d -> 目标神经元%d, 权重%.3f, 跳数%d\n",
                     spike->getSourceNeuron(), spike->getDestinationNeuron(), spike->getWeight(), spike->getHopCount());
     
     stat_external_spikes_received_->addData(1);
@@ -447,43 +730,32 @@ void MultiCorePE::handleExternalSpikeEvent(SST::Event* ev) {
     bool is_local = (dest_node == static_cast<uint32_t>(node_id_));
 
     // 调试输出：显示节点判断结果
-    output_->verbose(CALL_INFO, 2, 0, "🔍 脉冲路由判断: 目标神经元=%d, 目标节点=%u, 本地节点=%d, 本地判断=%s\n",
-                     spike->getDestinationNeuron(), dest_node, node_id_, is_local ? "本地" : "跨节点");
-    // Debug output removed
-    fflush(stdout);
+    SNNDL_TRACE(output_, 2, 0, "🔍 脉冲路由判断: 目标神经元=%d, 目标节点=%u, 本地节点=%d, 本地判断=%s\n",
+                spike->getDestinationNeuron(), dest_node, node_id_, is_local ? "本地" : "跨节点");
     
     if (is_local) {
         // 本地脉冲，加入队列处理
-        // Debug output removed
-        fflush(stdout);
+        wakeClock();
         external_spike_queue_.push(spike);
-        output_->verbose(CALL_INFO, 4, 0, "✅ 本地脉冲已加入队列\n");
+        SNNDL_TRACE(output_, 4, 0, "✅ 本地脉冲已加入队列\n");
     } else {
         // 跨核（同一MultiCorePE内不同处理单元）或外部（非本PE）
         int target_unit = determineTargetUnit(spike->getDestinationNeuron());
         if (target_unit >= 0 && target_unit < num_cores_) {
             // 目标在本MultiCorePE内的其他处理单元，直接分发给目标处理单元
-            SpikeEvent* cross_core_spike = new SpikeEvent(
-                spike->getSourceNeuron(),
-                spike->getDestinationNeuron(),
-                spike->getDestinationNode(),
-                spike->getWeight(),
-                spike->getSpikeTime()
-            );
-            cross_core_spike->hop_count = spike->getHopCount();  // 传递跳数
+            // 复制构造：保留跳数与聚合扇出的目标列表
+            SpikeEvent* cross_core_spike = new SpikeEvent(*spike);
             deliverSpikeToCore(target_unit, cross_core_spike);
-            output_->verbose(CALL_INFO, 4, 0, "🔄 外部脉冲直接分发到核心%d\n", target_unit);
+            SNNDL_TRACE(output_, 4, 0, "🔄 外部脉冲直接分发到核心%d\n", target_unit);
         } else {
             // 目标不在本MultiCorePE，视为外部转发（若配置了外部输出端口）
-            output_->verbose(CALL_INFO, 2, 0, "🔍 准备转发跨节点脉冲: 神经元%d, 目标节点%d, external_nic_=%p, external_spike_output_link_=%p\n",
-                           spike->getDestinationNeuron(), spike->getDestinationNode(),
-                           (void*)external_nic_, (void*)external_spike_output_link_);
+            SNNDL_TRACE(output_, 2, 0, "🔍 准备转发跨节点脉冲: 神经元%d, 目标节点%d, external_nic_=%p, external_spike_output_link_=%p\n",
+                        spike->getDestinationNeuron(), spike->getDestinationNode(),
+                        (void*)external_nic_, (void*)external_spike_output_link_);
             if (external_nic_) {
-                output_->verbose(CALL_INFO, 2, 0, "🌐 尝试通过SnnNIC发送跨节点脉冲: 神经元%d -> 目标节点%d\n",
-                               spike->getDestinationNeuron(), spike->getDestinationNode());
+                SNNDL_TRACE(output_, 2, 0, "🌐 通过SnnNIC转发跨节点脉冲: 神经元%d -> 目标节点%d, 跳数%d\n",
+                            spike->getDestinationNeuron(), spike->getDestinationNode(), spike->getHopCount());
                 sendExternalSpike(spike);
-                output_->verbose(CALL_INFO, 2, 0, "📤 外部转发脉冲到其他PE: 目标神经元%d, 跳数%d, 目标节点%d\n",
-                                spike->getDestinationNeuron(), spike->getHopCount(), spike->getDestinationNode());
                 return; // sendExternalSpike会接管事件
             } else {
                 output_->verbose(CALL_INFO, 1, 0, "⚠️ 无法确定目标处理单元且无外部输出，丢弃: 神经元%d\n",
@@ -497,9 +769,10 @@ void MultiCorePE::handleExternalSpikeEvent(SST::Event* ev) {
 void MultiCorePE::handleExternalSpike(SpikeEvent* spike) {
     if (!spike) return;
     
-    output_->verbose(CALL_INFO, 3, 0, "🔄 处理外部脉冲: 目标神经元%d\n", spike->getDestinationNeuron());
+    SNNDL_TRACE(output_, 3, 0, "🔄 处理外部脉冲: 目标神经元%d\n", spike->getDestinationNeuron());
     
     // 将脉冲加入外部队列，由时钟处理器处理
+    wakeClock();
     external_spike_queue_.push(spike);
     stat_external_spikes_received_->addData(1);
 }
@@ -516,18 +789,21 @@ void MultiCorePE::sendExternalSpike(SpikeEvent* spike) {
         return;
     }
 
-    output_->verbose(CALL_INFO, 3, 0, "📤 发送外部脉冲: 源神经元%d -> 目标神经元%d, 跳数%d\n",
+    SNNDL_TRACE(output_, 3, 0, "📤 发送外部脉冲: 源神经元%d -> 目标神经元%d, 跳数%d\n",
                      spike->getSourceNeuron(), spike->getDestinationNeuron(), spike->getHopCount());
 
+    SNNDL_TRACE_EVENT(trace_ring_, current_cycle_, TraceEventType::EXT_OUT, TraceRing::NODE_CORE,
+                      spike->getSourceNeuron(), static_cast<uint32_t>(target_node), spike->getWeight());
+
     // 优先使用网络适配器，如果未配置则回退到传统链接
     if (external_nic_) {
         // 使用网络适配器发送脉冲（这将触发路由计算和统计收集）
         external_nic_->sendSpike(spike);
-        output_->verbose(CALL_INFO, 3, 0, "🌐 通过网络适配器发送脉冲\n");
+        SNNDL_TRACE(output_, 3, 0, "🌐 通过网络适配器发送脉冲\n");
     } else if (external_spike_output_link_) {
         // 回退到传统链接模式
         external_spike_output_link_->send(spike);
-        output_->verbose(CALL_INFO, 3, 0, "🔗 通过传统链接发送脉冲\n");
+        SNNDL_TRACE(output_, 3, 0, "🔗 通过传统链接发送脉冲\n");
     } else {
         output_->verbose(CALL_INFO, 2, 0, "⚠️ 没有可用的外部发送方式，丢弃脉冲\n");
         delete spike;
@@ -546,7 +822,7 @@ void MultiCorePE::routeInternalSpike(int src_core, int dst_core, SpikeEvent* spi
         return;
     }
     
-    output_->verbose(CALL_INFO, 4, 0, "🔄 路由内部脉冲: 核心%d -> 核心%d, 神经元%d\n",
+    SNNDL_TRACE(output_, 4, 0, "🔄 路由内部脉冲: 核心%d -> 核心%d, 神经元%d\n",
                     src_core, dst_core, spike->getDestinationNeuron());
     
     // 单核情况或同一核心内，直接递送
@@ -554,13 +830,64 @@ void MultiCorePE::routeInternalSpike(int src_core, int dst_core, SpikeEvent* spi
         deliverSpikeToCore(dst_core, spike);
         return;
     }
+    SNNDL_TRACE_EVENT(trace_ring_, current_cycle_, TraceEventType::INTER_CORE, static_cast<uint32_t>(src_core),
+                      spike->getDestinationNeuron(), static_cast<uint32_t>(dst_core), spike->getWeight());
+    if (recorder_) {
+        recorder_->recordTraffic(SpikeRecorder::TrafficKind::INTER_CORE, SpikeRecorder::NETWORK_PORT, 0,
+                                 static_cast<uint32_t>(src_core), static_cast<uint32_t>(dst_core),
+                                 spike->hasTargets() ? spike->getTargetCount() : 1, 0);
+    }
+    
+    // 功能级邮箱：固定延迟后由目标核心批量取出
+    // 以当前仿真周期作为投递时间：挂起唤醒后及核心先于本组件执行时 current_cycle_ 尚未刷新
+    if (mailbox_) {
+        wakeClock();
+        if (mailbox_->post(dst_core, spike, getCurrentSimTime(clock_tc_))) {
+            inter_core_messages_count_++;
+            if (stat_inter_core_messages_) stat_inter_core_messages_->addData(1);
+        } else {
+            delete spike;
+        }
+        return;
+    }
     
+    if (!optimized_ring_ && !internal_ring_) {
+        output_->verbose(CALL_INFO, 2, 0, "⚠️ 无内部环形网络，丢弃跨核脉冲: 核心%d -> 核心%d\n", src_core, dst_core);
+        delete spike;
+        return;
+    }
+    
+    // 环形网络需要时钟推进才能投递
+    wakeClock();
+    
+    // 同一源核心已有待重发脉冲时排在其后，保持核间顺序
+    if (retry_per_core_[src_core] == 0 && sendToRing(src_core, dst_core, spike)) {
+        return;
+    }
+    
+    // 环形网络缓冲已满：暂存重发，而不是丢弃
+    if (internal_retry_depth_ > 0 && internal_retry_queue_.size() >= internal_retry_depth_) {
+        output_->verbose(CALL_INFO, 2, 0, "⚠️ 核间重发队列已满，丢弃脉冲: 核心%d -> 核心%d\n", src_core, dst_core);
+        internal_spikes_dropped_++;
+        stat_internal_spikes_dropped_->addData(1);
+        delete spike;
+        return;
+    }
+    internal_retry_queue_.push_back(PendingInternalSpike{src_core, dst_core, spike});
+    retry_per_core_[src_core]++;
+    stat_internal_retry_depth_->addData(internal_retry_queue_.size());
+    SNNDL_TRACE(output_, 4, 0, "⏳ 内部环形网络暂无空间，脉冲待重发: 核心%d -> 核心%d (队列%zu)\n",
+                     src_core, dst_core, internal_retry_queue_.size());
+}
+
+bool MultiCorePE::sendToRing(int src_core, int dst_core, SpikeEvent* spike) {
     // 创建内部消息
     RingMessage msg;
     msg.type = RingMessageType::SPIKE_MESSAGE;
     msg.src_unit = src_core;
     msg.dst_unit = dst_core;
-    msg.timestamp = current_cycle_;
+    // 发出周期用于样本边界判断，挂起唤醒后 current_cycle_ 可能尚未刷新
+    msg.timestamp = getCurrentSimTime(clock_tc_);
     msg.payload.spike_data = spike;
     
     bool sent_successfully = false;
@@ -568,23 +895,31 @@ void MultiCorePE::routeInternalSpike(int src_core, int dst_core, SpikeEvent* spi
     // 优先使用优化的环形网络
     if (optimized_ring_) {
         sent_successfully = optimized_ring_->sendMessage(src_core, dst_core, msg, 1); // 优先级1
-        if (sent_successfully) {
-            inter_core_messages_count_++;
-            if (stat_inter_core_messages_) stat_inter_core_messages_->addData(1);
-        }
     } 
     // 回退到旧的环形网络
     else if (internal_ring_) {
         sent_successfully = internal_ring_->sendMessage(msg);
-        if (sent_successfully) {
-            inter_core_messages_count_++;
-            if (stat_inter_core_messages_) stat_inter_core_messages_->addData(1);
-        }
     }
     
-    if (!sent_successfully) {
-        output_->verbose(CALL_INFO, 2, 0, "⚠️ 内部环形网络发送失败: 核心%d -> 核心%d\n", src_core, dst_core);
-        delete spike;
+    if (sent_successfully) {
+        inter_core_messages_count_++;
+        if (stat_inter_core_messages_) stat_inter_core_messages_->addData(1);
+    }
+    return sent_successfully;
+}
+
+void MultiCorePE::retryInternalSpikes() {
+    if (internal_retry_queue_.empty()) return;
+    
+    std::vector<bool> blocked(num_cores_, false);
+    for (auto it = internal_retry_queue_.begin(); it != internal_retry_queue_.end();) {
+        if (!blocked[it->src_core] && sendToRing(it->src_core, it->dst_core, it->spike)) {
+            retry_per_core_[it->src_core]--;
+            it = internal_retry_queue_.erase(it);
+        } else {
+            blocked[it->src_core] = true;
+            ++it;
+        }
     }
 }
 
@@ -596,10 +931,197 @@ int MultiCorePE::determineTargetUnit(int neuron_id) const {
         return -1;  // 非本MultiCorePE的神经元
     }
     
+    if (!placement_.empty()) {
+        return placement_[local_neuron_id];
+    }
+    
     int target_unit = local_neuron_id / neurons_per_core_;
     return (target_unit >= 0 && target_unit < num_cores_) ? target_unit : -1;
 }
 
+std::string MultiCorePE::substituteNodePath(const std::string& path) const {
+    std::string result = path;
+    size_t pos;
+    while ((pos = result.find("{node}")) != std::string::npos) {
+        result.replace(pos, 6, std::to_string(node_id_));
+    }
+    return result;
+}
+
+void MultiCorePE::writeCheckpoint() {
+    checkpoint_written_ = true;
+    StateSnapshotHeader header;
+    header.node_id = static_cast<uint32_t>(node_id_);
+    header.num_cores = static_cast<uint32_t>(num_cores_);
+    header.neurons_per_core = static_cast<uint32_t>(neurons_per_core_);
+    header.cycle = current_cycle_;
+    
+    std::vector<std::vector<uint8_t>> core_states(cores_.size());
+    size_t saved = 0;
+    for (size_t i = 0; i < cores_.size(); i++) {
+        if (cores_[i] && cores_[i]->saveState(core_states[i])) {
+            saved++;
+        } else {
+            core_states[i].clear();
+            output_->verbose(CALL_INFO, 1, 0, "⚠️ 节点%d核心%zu不支持保存状态，快照中缺少该核心\n", node_id_, i);
+        }
+    }
+    
+    std::string path = substituteNodePath(checkpoint_out_);
+    std::string error;
+    if (writeStateSnapshot(path, header, core_states, error)) {
+        output_->verbose(CALL_INFO, 1, 0, "💾 节点%d保存状态快照: 周期=%" PRIu64 ", 核心=%zu/%zu -> %s\n",
+                         node_id_, current_cycle_, saved, cores_.size(), path.c_str());
+    } else {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 节点%d %s\n", node_id_, error.c_str());
+    }
+}
+
+void MultiCorePE::advanceSamples(uint64_t cycle) {
+    uint64_t sample = cycle / sample_period_cycles_;
+    if (sample <= current_sample_) return;
+    // 时钟挂起期间可能跨过多个样本，被跳过的样本没有发放，各记一个0
+    while (current_sample_ < sample) {
+        finishSample();
+        current_sample_++;
+    }
+    sample_start_cycle_ = current_sample_ * sample_period_cycles_;
+    flushSampleTraffic();
+    for (auto* core : cores_) {
+        if (core) core->resetState();
+    }
+}
+
+void MultiCorePE::flushSampleTraffic() {
+    uint64_t flushed = 0;
+    while (!external_spike_queue_.empty()) {
+        delete external_spike_queue_.front();
+        external_spike_queue_.pop();
+        flushed++;
+    }
+    for (auto& pending : internal_retry_queue_) delete pending.spike;
+    flushed += internal_retry_queue_.size();
+    internal_retry_queue_.clear();
+    std::fill(retry_per_core_.begin(), retry_per_core_.end(), 0);
+    if (mailbox_) flushed += mailbox_->clear();
+    sample_spikes_flushed_ += flushed;
+    if (flushed > 0) {
+        output_->verbose(CALL_INFO, 2, 0, "🧪 节点%d样本%" PRIu64 "开始: 丢弃上一样本排队脉冲%" PRIu64 "个\n",
+                         node_id_, current_sample_, flushed);
+    }
+}
+
+void MultiCorePE::finishSample() {
+    std::vector<uint64_t> counts(total_neurons_, 0);
+    for (auto* core : cores_) {
+        if (core) core->getFiringCounts(counts);
+    }
+    if (sample_fire_base_.size() != counts.size()) sample_fire_base_.assign(counts.size(), 0);
+    
+    uint64_t sample_spikes = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        uint64_t n = counts[i] - sample_fire_base_[i];
+        if (n == 0) continue;
+        sample_spikes += n;
+        if (sample_counts_out_) {
+            std::fprintf(sample_counts_out_, "%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+                         current_sample_, global_neuron_base_ + i, n);
+        }
+    }
+    sample_fire_base_.swap(counts);
+    stat_sample_output_spikes_->addData(sample_spikes);
+    output_->verbose(CALL_INFO, 2, 0, "🧪 节点%d样本%" PRIu64 "结束: 发放=%" PRIu64 "\n",
+                     node_id_, current_sample_, sample_spikes);
+}
+
+void MultiCorePE::computePlacement() {
+    if (num_cores_ <= 1) return;
+    if (connectivity_file_.empty()) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 节点%d未配置connectivity_file，保持按块放置\n", node_id_);
+        return;
+    }
+    
+    // 各核心共用同一张PE级连接表，{core} 取0即可
+    std::string path = substituteNodePath(connectivity_file_);
+    size_t pos;
+    while ((pos = path.find("{core}")) != std::string::npos) {
+        path.replace(pos, 6, "0");
+    }
+    if (!CsrWeightStore::isCsrFile(path)) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 节点%d连接表%s不是CSR格式（可用convert_weights_csr.py转换），保持按块放置\n",
+                         node_id_, path.c_str());
+        return;
+    }
+    std::string error;
+    std::shared_ptr<const CsrWeightStore> store = CsrWeightStore::open(path, error);
+    if (!store) {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 节点%d无法打开连接表 %s: %s\n", node_id_, path.c_str(), error.c_str());
+    }
+    
+    NeuronPlacement placement(static_cast<uint32_t>(total_neurons_), num_cores_,
+                              static_cast<uint32_t>(neurons_per_core_));
+    placement.setConnectivity(store->globalRows(global_neuron_base_, total_neurons_), global_neuron_base_);
+    
+    if (!placement_profile_.empty()) {
+        std::vector<double> activity;
+        std::string profile = substituteNodePath(placement_profile_);
+        if (!NeuronPlacement::loadProfile(profile, global_neuron_base_, total_neurons_, activity, error)) {
+            output_->fatal(CALL_INFO, -1, "❌ 错误: 节点%d %s\n", node_id_, error.c_str());
+        }
+        placement.setActivity(activity);
+    }
+    
+    NeuronPlacement::Options options;
+    options.passes = placement_passes_;
+    options.balance_weight = placement_balance_weight_;
+    uint64_t swaps = placement.optimize(options);
+    placement_ = placement.coreOf();
+    
+    const NeuronPlacement::Quality& before = placement.initialQuality();
+    const NeuronPlacement::Quality& after = placement.finalQuality();
+    output_->verbose(CALL_INFO, 1, 0, "📋 节点%d神经元放置: 交换=%" PRIu64 ", 跨核突触代价 %.1f -> %.1f, "
+                     "最重核心负载/平均 %.2f -> %.2f\n",
+                     node_id_, swaps, before.cut, after.cut,
+                     before.avg_load > 0 ? before.max_load / before.avg_load : 0.0,
+                     after.avg_load > 0 ? after.max_load / after.avg_load : 0.0);
+}
+
+void MultiCorePE::splitByPlacement(SpikeEvent* spike, std::vector<std::pair<int, SpikeEvent*>>& parts) const {
+    parts.clear();
+    int first_unit = determineTargetUnit(spike->getDestinationNeuron());
+    bool mixed = false;
+    if (!placement_.empty() && spike->hasTargets()) {
+        for (size_t i = 0; i < spike->getTargetCount() && !mixed; i++) {
+            mixed = determineTargetUnit(spike->getTargetNeuron(i)) != first_unit;
+        }
+    }
+    if (!mixed) {
+        parts.emplace_back(first_unit, spike);
+        return;
+    }
+    
+    for (size_t i = 0; i < spike->getTargetCount(); i++) {
+        uint32_t post = spike->getTargetNeuron(i);
+        float w = spike->getTargetWeight(i);
+        uint8_t delay = spike->getTargetDelay(i);
+        int unit = determineTargetUnit(post);
+        SpikeEvent* part = nullptr;
+        for (auto& entry : parts) {
+            if (entry.first == unit) {
+                part = entry.second;
+                break;
+            }
+        }
+        if (!part) {
+            part = new SpikeEvent(spike->getSourceNeuron(), post, spike->getDestinationNode(),
+                                  w, spike->getTimestamp());
+            parts.emplace_back(unit, part);
+        }
+        part->addTarget(post, w, delay);
+    }
+    delete spike;
+}
+
 bool MultiCorePE::isLocalNeuron(int neuron_id) const {
     int start_id = static_cast<int>(global_neuron_base_);
     int end_id = start_id + total_neurons_;
@@ -625,6 +1147,15 @@ void MultiCorePE::getStatistics(std::map<std::string, uint64_t>& stats) const {
     stats["external_spikes_sent"] = stat_external_spikes_sent_->getCollectionCount();
     stats["external_spikes_received"] = stat_external_spikes_received_->getCollectionCount();
     stats["current_cycle"] = current_cycle_;
+    
+    // 事件对象池（本线程）
+    const auto& spike_pool = EventPool<SpikeEvent>::stats();
+    const auto& wrapper_pool = EventPool<SpikeEventWrapper>::stats();
+    stats["spike_events_live"] = spike_pool.live;
+    stats["spike_events_peak"] = spike_pool.peak;
+    stats["spike_events_reused"] = spike_pool.reused;
+    stats["spike_wrappers_live"] = wrapper_pool.live;
+    stats["spike_wrappers_peak"] = wrapper_pool.peak;
 }
 
 void MultiCorePE::initializeStatistics() {
@@ -639,6 +1170,10 @@ void MultiCorePE::initializeStatistics() {
     stat_neurons_fired_ = registerStatistic<uint64_t>("total_neurons_fired");
     stat_external_spikes_sent_ = registerStatistic<uint64_t>("external_spikes_sent");
     stat_external_spikes_received_ = registerStatistic<uint64_t>("external_spikes_received");
+    stat_internal_retry_depth_ = registerStatistic<uint64_t>("internal_retry_depth");
+    stat_internal_spikes_dropped_ = registerStatistic<uint64_t>("internal_spikes_dropped");
+    stat_backpressure_cycles_ = registerStatistic<uint64_t>("backpressure_cycles");
+    stat_sample_output_spikes_ = registerStatistic<uint64_t>("sample_output_spikes");
     
     // output_->verbose(CALL_INFO, 2, 0, "✅ 统计收集初始化完成\n");
 }
@@ -654,6 +1189,7 @@ void MultiCorePE::initializeProcessingUnits() {
         // 创建SnnPE SubComponent参数
         Params core_params;
         core_params.insert("core_id", std::to_string(i));
+        core_params.insert("total_cores", std::to_string(num_cores_));
         // ★ 修正：每个核心需要能够接受整个PE的神经元范围，而不是只接受自己的4个神经元
         // 这样可以避免"无法映射的目标神经元"错误
         core_params.insert("num_neurons", std::to_string(num_cores_ * neurons_per_core_));
@@ -664,7 +1200,10 @@ void MultiCorePE::initializeProcessingUnits() {
         core_params.insert("tau_mem", std::to_string(tau_mem_));
         core_params.insert("t_ref", std::to_string(t_ref_));
         core_params.insert("node_id", std::to_string(node_id_));
-        core_params.insert("base_addr", std::to_string(neuron_id_start * 1000)); // 简单地址映射
+        // 内存权重块：WeightLoader 为每个核心写入 neurons_per_core² 的块，覆盖该核心按块放置的神经元
+        core_params.insert("base_addr", std::to_string(weight_base_addr_ + static_cast<uint64_t>(i) * core_weight_stride_));
+        core_params.insert("weight_rows", std::to_string(neurons_per_core_));
+        core_params.insert("weight_block_offset", std::to_string(i * neurons_per_core_));
         core_params.insert("verbose", std::to_string(verbose_));
         
         // 传递权重文件参数
@@ -673,6 +1212,12 @@ void MultiCorePE::initializeProcessingUnits() {
             // output_->verbose(CALL_INFO, 2, 0, "[core%d] 配置权重文件: %s\n", i, weights_file_.c_str());
         }
         
+        // 传递CSR扇出连接表（占位符由核心自行替换）
+        if (!connectivity_file_.empty()) {
+            core_params.insert("connectivity_file", connectivity_file_);
+        }
+        core_params.insert("weight_layout", weight_layout_);
+        
         // 传递权重验证参数
         core_params.insert("verify_weights", std::to_string(verify_weights_ ? 1 : 0));
         core_params.insert("weight_verify_samples", std::to_string(weight_verify_samples_));
@@ -681,9 +1226,30 @@ void MultiCorePE::initializeProcessingUnits() {
         
         // 传递权重回退参数 - 关键修复！
         core_params.insert("use_event_weight_fallback", std::to_string(use_event_weight_fallback_ ? 1 : 0));
-        core_params.insert("enable_memory_weights", std::to_string(enable_memory_weights_ ? 1 : 0));
+        core_params.insert("enable_weight_fetch", std::to_string(enable_weight_fetch_ ? 1 : 0));
         core_params.insert("write_weights_on_init", std::to_string(write_weights_on_init_ ? 1 : 0));
         
+        // 传递惰性泄漏与时钟挂起参数
+        core_params.insert("lazy_leak", std::to_string(lazy_leak_ ? 1 : 0));
+        core_params.insert("enable_clock_suspend", std::to_string(enable_clock_suspend_ ? 1 : 0));
+        core_params.insert("update_threads", std::to_string(update_threads_));
+        core_params.insert("update_min_neurons_per_thread", std::to_string(update_min_neurons_per_thread_));
+        core_params.insert("output_backlog_depth", std::to_string(core_output_depth_));
+        core_params.insert("synaptic_delay", std::to_string(synaptic_delay_));
+        core_params.insert("batch_fire_check", std::to_string(batch_fire_check_ ? 1 : 0));
+        core_params.insert("max_synaptic_delay", std::to_string(max_synaptic_delay_));
+        bool has_core_model = i < static_cast<int>(core_neuron_models_.size()) && !core_neuron_models_[i].empty();
+        core_params.insert("neuron_model", has_core_model ? core_neuron_models_[i] : neuron_model_);
+        for (const auto& entry : neuron_model_params_) {
+            core_params.insert(entry.first, entry.second);
+        }
+        if (!delay_file_.empty()) {
+            core_params.insert("delay_file", delay_file_);
+        }
+        if (!checkpoint_in_.empty()) {
+            core_params.insert("warm_start_file", substituteNodePath(checkpoint_in_));
+        }
+        
         // 记录槽位可用性
         bool slot_api_ok = isSubComponentLoadableUsingAPI<SnnCoreAPI>("core" + std::to_string(i));
         // output_->verbose(CALL_INFO, 1, 0, "[core%d] 槽位可按 API 加载: %s\n", i, slot_api_ok ? "yes" : "no");
@@ -695,10 +1261,16 @@ void MultiCorePE::initializeProcessingUnits() {
             // output_->verbose(CALL_INFO, 1, 0, "[core%d] 已通过用户槽位加载 SnnCoreAPI 实例\n", i);
         }
 
+        // 匿名核心取权重时，由核心在 core{i}_mem 端口上加载 StandardMem，端口须共享给核心
+        std::string port = "core" + std::to_string(i) + "_mem";
+        bool anonymous_memory = false;
         if (!core) {
             // 如果用户未配置，则回退到匿名加载默认实现
+            anonymous_memory = enable_weight_fetch_;
+            if (anonymous_memory) core_params.insert("memory_port", port);
             core = loadAnonymousSubComponent<SnnCoreAPI>(
-                "SnnDL.SnnPESubComponent", "core" + std::to_string(i), 0, ComponentInfo::SHARE_NONE, core_params);
+                "SnnDL.SnnPESubComponent", "core" + std::to_string(i), 0,
+                anonymous_memory ? ComponentInfo::SHARE_PORTS : ComponentInfo::SHARE_NONE, core_params);
             if (core) {
                 // output_->verbose(CALL_INFO, 1, 0, "[core%d] 匿名加载成功\n", i);
             } else {
@@ -711,18 +1283,19 @@ void MultiCorePE::initializeProcessingUnits() {
         
         if (core) {
             core->setParentInterface(this);
-            // 为每个核心配置内存Link（若用户在Python连接了对应端口则不为None）
-            std::string port = "core" + std::to_string(i) + "_mem";
-            Link* l = configureLink(port);
+            // 为每个核心配置内存Link（若用户在Python连接了对应端口则不为None）；由核心StandardMem使用时不在此配置
+            Link* l = anonymous_memory ? nullptr : configureLink(port);
             // output_->verbose(CALL_INFO, 1, 0, "[core%d] memory link = %s\n", i, l ? "connected" : "none");
             if (l) core->setMemoryLink(l);
             cores_.push_back(core);
+            core_counters_.push_back(core->getCounters());
         } else {
             cores_.push_back(nullptr);
+            core_counters_.push_back(nullptr);
             // output_->verbose(CALL_INFO, 1, 0, "⚠️ 无法加载SnnPE核心%d\n", i);
         }
         
-        output_->verbose(CALL_INFO, 3, 0, "   ✅ SnnPE核心%d: 神经元ID范围[%d, %d)\n",
+        SNNDL_TRACE(output_, 3, 0, "   ✅ SnnPE核心%d: 神经元ID范围[%d, %d)\n",
                         i, neuron_id_start, neuron_id_start + neurons_per_core_);
     }
     
@@ -744,19 +1317,27 @@ void MultiCorePE::initializeInternalRing() {
         return;
     }
     
-    // 检查是否使用优化版环形网络（默认使用）
-    // 注意：此时我们在init阶段，需要存储参数以便后续使用
-    bool use_optimized = use_optimized_ring_;
+    if (interconnect_mode_ == InterconnectMode::MAILBOX) {
+        mailbox_ = new CoreMailbox(num_cores_, mailbox_latency_);
+        optimized_ring_ = nullptr;
+        internal_ring_ = nullptr;
+        output_->verbose(CALL_INFO, 2, 0, "🔗 核间互连: mailbox（%d核心，延迟%" PRIu64 "周期）\n",
+                         num_cores_, mailbox_->latency());
+        return;
+    }
     
-    if (use_optimized) {
+    if (interconnect_mode_ == InterconnectMode::OPTIMIZED_RING) {
         // output_->verbose(CALL_INFO, 2, 0, "🔗 初始化优化的内部环形互连\n");
         
         // 使用新的OptimizedInternalRing
-        int num_vcs = 2;                // 每方向2个虚拟通道
-        uint32_t credits_per_vc = 8;    // 每VC 8个信用
-        
-        optimized_ring_ = new OptimizedInternalRing(num_cores_, num_vcs, credits_per_vc, output_);
+        optimized_ring_ = new OptimizedInternalRing(num_cores_, ring_vcs_, ring_credits_per_vc_, output_);
+        optimized_ring_->setRoutingMode(ring_routing_);
+        optimized_ring_->setFlitsPerCycle(ring_flits_per_cycle_);
         internal_ring_ = nullptr;       // 不使用旧实现
+        output_->verbose(CALL_INFO, 2, 0, "🔗 核间互连: optimized_ring（%d节点，%d VCs，%u信用/VC，%s路由，%d消息/周期）\n",
+                         num_cores_, ring_vcs_, ring_credits_per_vc_,
+                         ring_routing_ == RingRoutingMode::ADAPTIVE ? "adaptive" : "minimal",
+                         optimized_ring_->getFlitsPerCycle());
         
         // output_->verbose(CALL_INFO, 2, 0, "✅ 优化环形互连初始化完成（%d节点，%d VCs，%d信用/VC）\n", 
                         // num_cores_, num_vcs, credits_per_vc);
@@ -805,7 +1386,7 @@ void MultiCorePE::updateStatistics() {
     
     // 详细调试信息
     if (verbose_ >= 3 && current_cycle_ % 10000 == 0) {
-        output_->verbose(CALL_INFO, 3, 0, "📊 周期%" PRIu64 "统计: 脉冲=%" PRIu64 ", 发放=%" PRIu64 ", 利用率=%.2f\n",
+        SNNDL_TRACE(output_, 3, 0, "📊 周期%" PRIu64 "统计: 脉冲=%" PRIu64 ", 发放=%" PRIu64 ", 利用率=%.2f\n",
                         current_cycle_, total_spikes, total_fired, (total_utilization / num_cores_) * 100.0);
     }
 }
@@ -828,7 +1409,7 @@ void MultiCorePE::generateTestTraffic() {
         }
         
         if (spikes_to_send > 0) {
-            output_->verbose(CALL_INFO, 4, 0, "🔥 生成测试流量: %d个脉冲 (已发送%d/%d)\n", 
+            SNNDL_TRACE(output_, 4, 0, "🔥 生成测试流量: %d个脉冲 (已发送%d/%d)\n", 
                             spikes_to_send, test_spikes_sent_, test_max_spikes_);
             
             for (int i = 0; i < spikes_to_send; i++) {
@@ -855,13 +1436,16 @@ void MultiCorePE::handleCrossCoreRouting() {
     for (int i = 0; i < num_cores_; i++) {
         RingMessage msg;
         if (internal_ring_->receiveMessage(i, msg)) {
-            if (msg.type == RingMessageType::SPIKE_MESSAGE && msg.payload.spike_data) {
+            if (msg.type == RingMessageType::SPIKE_MESSAGE && msg.payload.spike_data && isStaleSampleMessage(msg)) {
+                delete msg.payload.spike_data;
+                sample_spikes_flushed_++;
+            } else if (msg.type == RingMessageType::SPIKE_MESSAGE && msg.payload.spike_data) {
                 // 将脉冲传递给目标处理单元
                 int target_unit = msg.dst_unit;
                 if (target_unit >= 0 && target_unit < num_cores_) {
                     deliverSpikeToCore(target_unit, msg.payload.spike_data);
                     
-                    output_->verbose(CALL_INFO, 4, 0, "🔄 跨核脉冲路由: 核心%d -> 核心%d\n", 
+                    SNNDL_TRACE(output_, 4, 0, "🔄 跨核脉冲路由: 核心%d -> 核心%d\n", 
                                    msg.src_unit, msg.dst_unit);
                 } else {
                     output_->verbose(CALL_INFO, 2, 0, "⚠️ 无效的目标单元: %d\n", target_unit);
@@ -879,7 +1463,10 @@ void MultiCorePE::handleOptimizedCrossCoreRouting() {
     for (int i = 0; i < num_cores_; i++) {
         RingMessage msg;
         while (optimized_ring_->receiveMessage(i, msg)) {
-            if (msg.type == RingMessageType::SPIKE_MESSAGE && msg.payload.spike_data) {
+            if (msg.type == RingMessageType::SPIKE_MESSAGE && msg.payload.spike_data && isStaleSampleMessage(msg)) {
+                delete msg.payload.spike_data;
+                sample_spikes_flushed_++;
+            } else if (msg.type == RingMessageType::SPIKE_MESSAGE && msg.payload.spike_data) {
                 // 将脉冲传递给目标处理单元
                 int target_unit = msg.dst_unit;
                 if (target_unit >= 0 && target_unit < num_cores_) {
@@ -889,7 +1476,7 @@ void MultiCorePE::handleOptimizedCrossCoreRouting() {
                     inter_core_messages_count_++;
                     stat_inter_core_messages_->addData(1);
                     
-                    output_->verbose(CALL_INFO, 4, 0, "🔄 优化跨核脉冲路由: 核心%d -> 核心%d\n", 
+                    SNNDL_TRACE(output_, 4, 0, "🔄 优化跨核脉冲路由: 核心%d -> 核心%d\n", 
                                    msg.src_unit, msg.dst_unit);
                 } else {
                     output_->verbose(CALL_INFO, 2, 0, "⚠️ 无效的目标单元: %d\n", target_unit);
@@ -897,7 +1484,7 @@ void MultiCorePE::handleOptimizedCrossCoreRouting() {
                 }
             } else {
                 // 处理其他类型的消息（内存请求、控制消息等）
-                output_->verbose(CALL_INFO, 3, 0, "🔄 处理非脉冲消息: 类型=%d\n", 
+                SNNDL_TRACE(output_, 3, 0, "🔄 处理非脉冲消息: 类型=%d\n", 
                                static_cast<int>(msg.type));
             }
         }
@@ -914,6 +1501,15 @@ void MultiCorePE::handleOptimizedCrossCoreRouting() {
     }
 }
 
+void MultiCorePE::handleMailboxDelivery() {
+    if (!mailbox_ || mailbox_->pending() == 0) return;
+    for (int i = 0; i < num_cores_; i++) {
+        mailbox_->drain(i, current_cycle_, [this, i](SpikeEvent* spike) {
+            deliverSpikeToCore(i, spike);
+        });
+    }
+}
+
 void MultiCorePE::checkLoadBalance() {
     if (!controller_) return;
     
@@ -1234,7 +1830,7 @@ int MultiCoreController::findMostLoadedCore() const {
 void MultiCorePE::handleMemoryResponse(SST::Interfaces::StandardMem::Request* resp) {
     if (!resp) return;
     
-    output_->verbose(CALL_INFO, 4, 0, "📨 收到内存响应: ID=%" PRIu64 "\n", 
+    SNNDL_TRACE(output_, 4, 0, "📨 收到内存响应: ID=%" PRIu64 "\n", 
                     resp->getID());
     
     // 查找对应的挂起请求
@@ -1261,7 +1857,7 @@ void MultiCorePE::handleMemoryResponse(SST::Interfaces::StandardMem::Request* re
 void MultiCorePE::sendSpike(SpikeEvent* event) {
     if (!event) return;
     
-    output_->verbose(CALL_INFO, 4, 0, "📤 从SubComponent接收脉冲: 源神经元%d -> 目标神经元%d\n",
+    SNNDL_TRACE(output_, 4, 0, "📤 从SubComponent接收脉冲: 源神经元%d -> 目标神经元%d\n",
                     event->getSourceNeuron(), event->getDestinationNeuron());
     
     int target_unit = determineTargetUnit(event->getDestinationNeuron());
@@ -1270,11 +1866,15 @@ void MultiCorePE::sendSpike(SpikeEvent* event) {
         // 目标在本PE内，通过内部互连路由
         // 确定源核心（由于这是从SubComponent调用的，我们需要找到源核心）
         int src_core = determineTargetUnit(event->getSourceNeuron());
-        if (src_core >= 0 && src_core < num_cores_) {
-            routeInternalSpike(src_core, target_unit, event);
-        } else {
-            // 源不在本PE，直接递送给目标
-            deliverSpikeToCore(target_unit, event);
+        std::vector<std::pair<int, SpikeEvent*>> parts;
+        splitByPlacement(event, parts);
+        for (auto& part : parts) {
+            if (src_core >= 0 && src_core < num_cores_) {
+                routeInternalSpike(src_core, part.first, part.second);
+            } else {
+                // 源不在本PE，直接递送给目标
+                deliverSpikeToCore(part.first, part.second);
+            }
         }
     } else {
         // 目标在其他PE，通过外部接口发送
@@ -1282,10 +1882,15 @@ void MultiCorePE::sendSpike(SpikeEvent* event) {
     }
 }
 
+bool MultiCorePE::canSendSpike() const {
+    if (internal_retry_depth_ > 0 && internal_retry_queue_.size() >= internal_retry_depth_) return false;
+    return !external_nic_ || external_nic_->canSend();
+}
+
 void MultiCorePE::requestMemoryAccess(uint64_t address, size_t size, 
                                     std::function<void(const void*)> callback) {
     // TODO: 在Phase 2中实现内存访问
-    output_->verbose(CALL_INFO, 4, 0, "📨 接收内存访问请求: 地址=0x%lx, 大小=%zu\n", address, size);
+    SNNDL_TRACE(output_, 4, 0, "📨 接收内存访问请求: 地址=0x%lx, 大小=%zu\n", address, size);
     
     // 暂时提供一个虚拟的响应
     static float dummy_data = 0.5f;
@@ -1311,18 +1916,25 @@ void MultiCorePE::deliverSpikeToCore(int core_id, SpikeEvent* spike) {
         return;
     }
     
+    // 放置后外部到达的聚合消息可能覆盖多个核心，按核心拆分后分别递送
+    if (!placement_.empty() && spike->hasTargets()) {
+        std::vector<std::pair<int, SpikeEvent*>> parts;
+        splitByPlacement(spike, parts);
+        if (parts.size() > 1) {
+            for (auto& part : parts) deliverSpikeToCore(part.first, part.second);
+            return;
+        }
+    }
+    
+    // 核心接管脉冲内存，须在递送前输出
+    SNNDL_TRACE(output_, 4, 0, "📨 向核心%d递送脉冲: 神经元%d\n", core_id, spike->getDestinationNeuron());
+    
     // 直接调用SnnPE SubComponent的接口
     cores_[core_id]->deliverSpike(spike);
     
     // 更新两种统计：SST统计对象和本地unit_states_
     stat_spikes_processed_->addData(1);
     unit_states_[core_id].spikes_processed++;
-    
-    // printf("DEBUG: deliverSpikeToCore完成 - 统计已更新：SST统计+本地unit_states_[%d]，节点%d\n", core_id, node_id_);
-    // fflush(stdout);
-    
-    output_->verbose(CALL_INFO, 4, 0, "📨 向核心%d递送脉冲: 神经元%d\n", 
-                    core_id, spike->getDestinationNeuron());
 }
 
 void MultiCorePE::initializeDirectionLinks() {
@@ -1433,27 +2045,27 @@ void MultiCorePE::initializeNetworkInterface() {
 // === 网络端口事件处理器实现 ===
 
 void MultiCorePE::handleNorthLinkEvent(SST::Event* event) {
-    output_->verbose(CALL_INFO, 3, 0, "📡 收到北向链路事件\n");
+    SNNDL_TRACE(output_, 3, 0, "📡 收到北向链路事件\n");
     forwardEventToNetworkAdapter(event, "north");
 }
 
 void MultiCorePE::handleSouthLinkEvent(SST::Event* event) {
-    output_->verbose(CALL_INFO, 3, 0, "📡 收到南向链路事件\n");
+    SNNDL_TRACE(output_, 3, 0, "📡 收到南向链路事件\n");
     forwardEventToNetworkAdapter(event, "south");
 }
 
 void MultiCorePE::handleEastLinkEvent(SST::Event* event) {
-    output_->verbose(CALL_INFO, 3, 0, "📡 收到东向链路事件\n");
+    SNNDL_TRACE(output_, 3, 0, "📡 收到东向链路事件\n");
     forwardEventToNetworkAdapter(event, "east");
 }
 
 void MultiCorePE::handleWestLinkEvent(SST::Event* event) {
-    output_->verbose(CALL_INFO, 3, 0, "📡 收到西向链路事件\n");
+    SNNDL_TRACE(output_, 3, 0, "📡 收到西向链路事件\n");
     forwardEventToNetworkAdapter(event, "west");
 }
 
 void MultiCorePE::handleNetworkLinkEvent(SST::Event* event) {
-    output_->verbose(CALL_INFO, 3, 0, "📡 收到通用网络链路事件\n");
+    SNNDL_TRACE(output_, 3, 0, "📡 收到通用网络链路事件\n");
     forwardEventToNetworkAdapter(event, "network");
 }
 
@@ -1467,7 +2079,7 @@ void MultiCorePE::forwardEventToNetworkAdapter(SST::Event* event, const std::str
     // 首先尝试将事件转换为SpikeEvent（直接脉冲事件）
     SpikeEvent* spike_event = dynamic_cast<SpikeEvent*>(event);
     if (spike_event) {
-        output_->verbose(CALL_INFO, 3, 0, "🔄 转发%s方向的直接脉冲事件: 神经元%u\n", 
+        SNNDL_TRACE(output_, 3, 0, "🔄 转发%s方向的直接脉冲事件: 神经元%u\n", 
                         direction.c_str(), spike_event->getNeuronId());
         handleExternalSpike(spike_event);
         return;
@@ -1476,12 +2088,12 @@ void MultiCorePE::forwardEventToNetworkAdapter(SST::Event* event, const std::str
     // 尝试将事件转换为SpikeEventWrapper（SST网络传输的脉冲事件）
     SpikeEventWrapper* wrapper_event = dynamic_cast<SpikeEventWrapper*>(event);
     if (wrapper_event) {
-        output_->verbose(CALL_INFO, 3, 0, "📦 收到%s方向的SpikeEventWrapper，开始解包\n", direction.c_str());
+        SNNDL_TRACE(output_, 3, 0, "📦 收到%s方向的SpikeEventWrapper，开始解包\n", direction.c_str());
         
         // 从wrapper中提取SpikeEvent数据并创建新的SpikeEvent对象
         SpikeEvent* extracted_spike = extractSpikeFromWrapper(wrapper_event);
         if (extracted_spike) {
-            output_->verbose(CALL_INFO, 3, 0, "✅ SpikeEventWrapper解包成功: 神经元%u -> 神经元%u\n", 
+            SNNDL_TRACE(output_, 3, 0, "✅ SpikeEventWrapper解包成功: 神经元%u -> 神经元%u\n", 
                             extracted_spike->getSourceNeuron(), extracted_spike->getDestinationNeuron());
             handleExternalSpike(extracted_spike);
         } else {
@@ -1505,7 +2117,7 @@ SpikeEvent* MultiCorePE::extractSpikeFromWrapper(SpikeEventWrapper* wrapper) {
     }
     
     try {
-        output_->verbose(CALL_INFO, 3, 0, "🔍 extractSpikeFromWrapper: 开始从wrapper提取SpikeEvent\n");
+        SNNDL_TRACE(output_, 3, 0, "🔍 extractSpikeFromWrapper: 开始从wrapper提取SpikeEvent\n");
         
         // 从wrapper中获取原始的SpikeEvent
         SpikeEvent* original_spike = wrapper->getSpikeEvent();
@@ -1515,18 +2127,10 @@ SpikeEvent* MultiCorePE::extractSpikeFromWrapper(SpikeEventWrapper* wrapper) {
         }
         
         // 创建一个新的SpikeEvent副本，避免内存管理冲突
-        SpikeEvent* extracted_spike = new SpikeEvent(
-            original_spike->getNeuronId(),
-            original_spike->getDestinationNeuron(),
-            original_spike->getDestinationNode(),
-            original_spike->getWeight(),
-            original_spike->getTimestamp()
-        );
-        
-        // 复制hop_count属性（直接访问public字段）
-        extracted_spike->hop_count = original_spike->hop_count;
+        // 复制构造同时保留hop_count与聚合扇出的目标列表
+        SpikeEvent* extracted_spike = new SpikeEvent(*original_spike);
         
-        output_->verbose(CALL_INFO, 3, 0, "✅ extractSpikeFromWrapper成功: 神经元%u -> 神经元%u (节点%u)\n", 
+        SNNDL_TRACE(output_, 3, 0, "✅ extractSpikeFromWrapper成功: 神经元%u -> 神经元%u (节点%u)\n", 
                         extracted_spike->getSourceNeuron(), 
                         extracted_spike->getDestinationNeuron(), 
                         extracted_spike->getDestinationNode());
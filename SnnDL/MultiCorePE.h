@@ -21,9 +21,11 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <cstdio>
 #include <map>
 #include <memory>
 #include <queue>
+#include <deque>
 #include <unordered_map>
 
 #include "SpikeEvent.h"
@@ -32,6 +34,11 @@
 #include "SnnPEParentInterface.h"
 #include "SnnCoreAPI.h"
 #include "OptimizedInternalRing.h"
+#include "CoreMailbox.h"
+#include "NeuronPlacement.h"
+#include "SnnTrace.h"
+#include "SpikeRecorder.h"
+#include "StateSnapshot.h"
 
 namespace SST {
 namespace SnnDL {
@@ -88,8 +95,14 @@ public:
         {"internal_ring_latency", "内部环形网络延迟", "1ns"},
         {"verbose",          "日志详细级别", "0"},
         {"node_id",          "网络节点ID", "0"},
-        {"base_addr",        "全局内存基地址", "0"},
         {"weights_file",     "权重文件路径", ""},
+        {"connectivity_file", "核心CSR扇出连接表文件(支持{node}/{core}占位符)，为空时使用固定分层路由", ""},
+        {"connectivity_format", "传递给各核心的连接表格式 [auto|records|dense|csr]", "auto"},
+        {"row_fanout_delivery", "传递给各核心：每个输入脉冲按突触前神经元处理，整行权重读回后一次施加全部突触后更新", "0"},
+        {"enable_weight_fetch", "传递给各核心：从内存读取权重。匿名核心经 core{i}_mem 端口上的 memHierarchy.standardInterface 访问内存；用户槽位核心需自行配置 memory 子组件", "0"},
+        {"weight_layout", "传递给各核心的内存权重布局 [dense|csr]，须与WeightLoader的weight_layout一致", "dense"},
+        {"base_addr", "本节点核心0权重块的内存地址，核心i为 base_addr + i*core_weight_stride；须与WeightLoader的 base_addr_start + 全局核心号*per_core_stride 一致", "0"},
+        {"core_weight_stride", "相邻核心权重块的地址间隔，须与WeightLoader的per_core_stride一致（0=neurons_per_core²×4字节）", "0"},
         {"enable_numa",      "启用NUMA优化", "1"},
         {"v_thresh",         "触发脉冲的膜电位阈值", "1.0"},
         {"v_reset",          "脉冲发放后膜电位重置值", "0.0"},
@@ -101,7 +114,49 @@ public:
         {"test_period",      "测试流量发送周期(周期数)", "100"},
         {"test_spikes_per_burst", "每次周期性发送的测试脉冲数量", "4"},
         {"test_weight",      "测试脉冲权重", "0.2"},
-        {"use_optimized_ring", "使用优化的环形网络实现(1)或原始实现(0)", "1"}
+        {"use_optimized_ring", "使用优化的环形网络实现(1)或原始实现(0)，internal_interconnect未设置时生效", "1"},
+        {"internal_interconnect", "核间互连模型 [optimized_ring|legacy_ring|mailbox]。mailbox为每核心固定延迟邮箱，每周期批量取出，不建模逐跳转发；为空时由use_optimized_ring决定", ""},
+        {"mailbox_latency", "mailbox模式的核间投递延迟(周期)", "1"},
+        {"ring_routing",     "optimized_ring注入方向选择 [minimal|adaptive]。adaptive按两个方向的缓冲占用选择方向并绕过阻塞VC", "minimal"},
+        {"ring_flits_per_cycle", "optimized_ring每个方向每周期可转发的消息数（链路宽度）", "1"},
+        {"ring_vcs",         "optimized_ring每个方向的虚拟通道数", "2"},
+        {"ring_credits_per_vc", "optimized_ring每个虚拟通道的信用数（缓冲深度）", "8"},
+        {"lazy_leak",        "核心采用惰性泄漏更新(仅在神经元被访问时补算，仅支持lif模型)", "0"},
+        {"enable_clock_suspend", "空闲时注销时钟，脉冲到达时重新注册（同时传递给各核心）", "0"},
+        {"update_threads", "每个核心泄漏/阈值更新使用的线程数（传递给各核心，总线程数为核心数×该值）", "1"},
+        {"update_min_neurons_per_thread", "每个更新线程至少分到的神经元数（传递给各核心）", "8192"},
+        {"neuron_placement", "神经元到核心的放置 [blocked|connectivity]。connectivity在setup时按connectivity_file（CSR）最小化跨核突触并均衡期望发放负载，以查找表代替 本地ID/neurons_per_core", "blocked"},
+        {"placement_profile", "上一次运行导出的发放计数文件（支持{node}占位符），用于按活动加权放置；为空时每个神经元活动视为相同", ""},
+        {"placement_profile_out", "finish时导出本节点各神经元发放计数的文件（支持{node}占位符），为空时不导出", ""},
+        {"placement_passes", "放置交换优化的最大轮数", "4"},
+        {"placement_balance_weight", "放置目标中负载均衡项的权重（0表示只最小化跨核突触）", "1.0"},
+        {"internal_retry_depth", "核间环形网络拒收时暂存待重发脉冲的上限；达到上限时向核心施加背压，溢出的脉冲丢弃计数（0=不限）", "256"},
+        {"core_output_depth", "传递给各核心的输出缓冲上限：背压期间核心暂存的发放输出数，溢出丢弃计数（0=不限）", "1024"},
+        {"synaptic_delay", "传递给各核心的突触延迟（周期），脉冲按投递周期进入核心输入日历队列", "0"},
+        {"spike_queue_horizon", "传递给各核心的输入日历桶数（周期），更远的脉冲进入溢出表", "16"},
+        {"deterministic_spike_order", "传递给各核心：同一桶内的脉冲按 (源, 目的, 时间戳) 顺序处理，而非到达顺序", "1"},
+        {"batch_fire_check", "传递给各核心：同一周期到达的脉冲先全部积分，再对每个被积分神经元检查一次阈值", "1"},
+        {"neuron_model", "各核心默认的神经元模型 [lif|izhikevich|alif]", "lif"},
+        {"core_neuron_models", "逐核心的神经元模型列表，如 [lif, lif, izhikevich, alif]，缺省项使用neuron_model；izh_*/alif_* 参数原样传递给各核心", ""},
+        {"weight_precision", "传递给各核心的内存权重精度 [float32|int16|int8]，须与WeightLoader的weight_precision一致", "float32"},
+        {"weight_scale", "定点权重的lsb，原样传递给各核心", "0.015625"},
+        {"membrane_precision", "传递给各核心的膜电位精度 [float32|int16|int8]（饱和运算）", "float32"},
+        {"membrane_scale", "定点膜电位的lsb，原样传递给各核心", "0.0009765625"},
+        {"max_cache_entries", "传递给各核心的权重缓存容量（条目数）", "4096"},
+        {"weight_cache_ways", "传递给各核心的权重缓存组相联度（每组条目数）", "8"},
+        {"weight_cache_policy", "传递给各核心的权重缓存替换策略 [lru|clock]", "lru"},
+        {"max_synaptic_delay", "传递给各核心的延迟线深度（周期），0为不启用逐突触延迟；逐突触延迟叠加在synaptic_delay之上", "0"},
+        {"delay_file", "逐突触延迟文件（uint8周期，与connectivity_file的突触顺序一致，支持{node}/{core}占位符）", ""},
+        {"trace_ring_size", "二进制事件环容量（记录数，向上取整到2的幂），0为不记录；finish时转储最近的事件", "0"},
+        {"trace_file", "事件环转储文件（支持{node}占位符）", "snndl_trace_node{node}.bin"},
+        {"record_file", "发放栅格与链路流量的列式二进制记录文件（支持{node}占位符），为空时不记录；用core_sys/snndl_record.py读取", ""},
+        {"record_block_spikes", "记录器每个栅格块的发放数，满块后交给后台线程写出", "65536"},
+        {"record_traffic_interval", "流量快照间隔（周期），0为仅在finish时写出一次", "10000"},
+        {"checkpoint_out", "状态快照输出文件（支持{node}占位符），为空时不保存；包含各核心神经元状态、权重缓存与已解析的连接表", ""},
+        {"checkpoint_cycle", "保存快照的周期（通常取暖机结束、输入到达之前），0为在finish时保存", "0"},
+        {"checkpoint_in", "warm start快照文件（支持{node}占位符），由各核心在构造时读回，跳过连接表解析与暖机", ""},
+        {"sample_period", "批量推理的样本周期（如\"300us\"，须与SpikeSource的sample_period一致），每个周期边界复位各核心神经元状态；为空时不分样本", ""},
+        {"sample_counts_file", "批量推理时逐样本写出的发放计数CSV（sample,neuron,count，仅非零项，支持{node}占位符），为空时不写出", ""}
     )
 
     // 子组件槽位文档
@@ -121,7 +176,7 @@ public:
 
     // 端口文档 
     SST_ELI_DOCUMENT_PORTS(
-        {"external_spike_input",  "外部脉冲输入端口", {"SnnDL.SpikeEvent"}},
+        {"external_spike_input",  "外部脉冲输入端口", {"SnnDL.SpikeEvent", "SnnDL.SpikeBundle"}},
         {"external_spike_output", "外部脉冲输出端口", {"SnnDL.SpikeEvent"}},
         {"network", "网络连接端口（用于direct_link模式）", {"SnnDL.SpikeEvent", "SimpleNetwork"}},
         {"north", "北向网络连接端口（网格拓扑）", {"SnnDL.SpikeEvent"}},
@@ -149,7 +204,11 @@ public:
         {"avg_core_utilization", "平均核心利用率", "percentage", 1},
         {"total_neurons_fired", "总神经元发放数", "neurons", 1},
         {"external_spikes_sent", "发送的外部脉冲数", "spikes", 1},
-        {"external_spikes_received", "接收的外部脉冲数", "spikes", 1}
+        {"external_spikes_received", "接收的外部脉冲数", "spikes", 1},
+        {"internal_retry_depth", "每次入队时的核间重发队列深度", "spikes", 1},
+        {"internal_spikes_dropped", "核间重发队列已满而丢弃的脉冲数", "spikes", 1},
+        {"backpressure_cycles", "向核心施加背压（canSendSpike()为false）的周期数", "cycles", 1},
+        {"sample_output_spikes", "批量推理时每个样本内本节点的神经元发放数（每样本一个数据点）", "spikes", 1}
     )
 
     /**
@@ -196,6 +255,11 @@ public:
      */
     void sendSpike(SpikeEvent* event) override;
     
+    /**
+     * @brief 核间重发队列与外部网络接口的发送队列均未满时才接收核心输出
+     */
+    bool canSendSpike() const override;
+    
     /**
      * @brief 向父级组件请求内存访问（从SnnPE SubComponent调用）
      */
@@ -216,6 +280,16 @@ public:
      * @brief 获取本PE管理的神经元总数
      */
     int getTotalNeurons() const override { return total_neurons_; }
+    
+    /**
+     * @brief 获取本PE的二进制事件环（trace_ring_size为0时为nullptr）
+     */
+    TraceRing* getTraceRing() const override { return trace_ring_; }
+    
+    /**
+     * @brief 获取本PE的发放栅格/流量记录器（record_file为空时为nullptr）
+     */
+    SpikeRecorder* getRecorder() const override { return recorder_; }
 
     // 友元类声明
     friend class InternalRing;
@@ -231,6 +305,10 @@ private:
     uint64_t global_neuron_base_;
     int verbose_;
     std::string weights_file_;
+    std::string connectivity_file_;
+    std::string weight_layout_;
+    uint64_t weight_base_addr_;      // 核心0权重块地址
+    uint64_t core_weight_stride_;    // 相邻核心权重块的地址间隔
     bool enable_numa_;
     bool enable_test_traffic_;
     
@@ -248,8 +326,45 @@ private:
     float test_weight_;
     int test_max_spikes_;  // 最大测试脉冲数限制
     
-    // 环形网络实现选择
+    // 核间互连模型选择
+    enum class InterconnectMode { OPTIMIZED_RING, LEGACY_RING, MAILBOX };
     bool use_optimized_ring_;
+    InterconnectMode interconnect_mode_;
+    uint64_t mailbox_latency_;
+    RingRoutingMode ring_routing_;
+    int ring_flits_per_cycle_;
+    int ring_vcs_;
+    uint32_t ring_credits_per_vc_;
+    
+    // 神经元放置
+    bool placement_by_connectivity_;
+    std::string placement_profile_;
+    std::string placement_profile_out_;
+    int placement_passes_;
+    double placement_balance_weight_;
+    std::vector<uint16_t> placement_;              ///< 本地神经元ID -> 核心，为空时按块划分
+    
+    // 核间发送背压
+    struct PendingInternalSpike {
+        int src_core;
+        int dst_core;
+        SpikeEvent* spike;
+    };
+    uint32_t internal_retry_depth_;
+    uint32_t core_output_depth_;
+    uint32_t synaptic_delay_;
+    uint32_t max_synaptic_delay_;
+    
+    // 神经元模型（可逐核心混合）
+    std::string neuron_model_;
+    std::vector<std::string> core_neuron_models_;
+    std::map<std::string, std::string> neuron_model_params_;   ///< 原样传递给核心的模型、数值精度、权重缓存、扇出与输入日历参数
+    std::string delay_file_;
+    bool batch_fire_check_;
+    std::deque<PendingInternalSpike> internal_retry_queue_;  ///< 环形网络拒收、等待重发的脉冲
+    std::vector<uint32_t> retry_per_core_;                   ///< 每个源核心在重发队列中的脉冲数
+    uint64_t internal_spikes_dropped_ = 0;
+    uint64_t backpressure_cycles_ = 0;
     
     // 权重验证参数
     bool verify_weights_;
@@ -259,9 +374,17 @@ private:
     
     // 权重回退参数
     bool use_event_weight_fallback_;
-    bool enable_memory_weights_;
+    bool enable_weight_fetch_;
     bool write_weights_on_init_;
     
+    // 空闲时钟挂起参数
+    bool lazy_leak_;
+    bool enable_clock_suspend_;
+    
+    // 核心内多线程更新参数
+    int update_threads_;
+    uint32_t update_min_neurons_per_thread_;
+    
     // ===== 组件对象 =====
     
     // 时钟和输出
@@ -277,6 +400,10 @@ private:
     Statistic<uint64_t>* stat_neurons_fired_;
     Statistic<uint64_t>* stat_external_spikes_sent_;
     Statistic<uint64_t>* stat_external_spikes_received_;
+    Statistic<uint64_t>* stat_internal_retry_depth_;
+    Statistic<uint64_t>* stat_internal_spikes_dropped_;
+    Statistic<uint64_t>* stat_backpressure_cycles_;
+    Statistic<uint64_t>* stat_sample_output_spikes_;
 
     // 本地统计：仅在环形跨核投递成功时累加
     uint64_t inter_core_messages_count_ = 0;
@@ -293,10 +420,32 @@ private:
     // 内部架构组件
     OptimizedInternalRing* optimized_ring_;
     InternalRing* internal_ring_;  // 保留兼容性
+    CoreMailbox* mailbox_;         // 功能级核间邮箱
     MultiCoreController* controller_;
     
     // 处理单元状态跟踪
     std::vector<ProcessingUnitState> unit_states_;
+    std::vector<const CoreCounters*> core_counters_;  ///< 各核心计数器块（不提供时为nullptr，回退到getStatistics）
+    TraceRing* trace_ring_;        // 二进制事件环（未启用时为nullptr）
+    std::string trace_file_;
+    SpikeRecorder* recorder_;      // 发放栅格/流量记录器（未启用时为nullptr）
+    std::string record_file_;
+    std::string checkpoint_out_;   // 状态快照输出（为空时不保存）
+    std::string checkpoint_in_;    // warm start快照（为空时冷启动）
+    uint64_t checkpoint_cycle_;
+    bool checkpoint_written_ = false;
+    
+    // 批量推理：按固定样本周期切分输入，周期边界复位神经元状态
+    std::string sample_period_;
+    uint64_t sample_period_cycles_ = 0;      ///< 样本周期（本组件时钟周期数），0为不分样本
+    uint64_t current_sample_ = 0;
+    uint64_t sample_start_cycle_ = 0;        ///< 当前样本的起始周期，之前发出的核间消息作废
+    uint64_t sample_spikes_flushed_ = 0;     ///< 样本边界丢弃的上一样本在途脉冲数
+    SST::Link* sample_wakeup_link_ = nullptr; ///< 时钟挂起时在下一样本边界唤醒的自链接
+    uint64_t sample_wakeup_cycle_ = 0;       ///< 已安排的边界唤醒周期，避免重复发送
+    std::vector<uint64_t> sample_fire_base_; ///< 当前样本开始时各神经元的累计发放数
+    std::string sample_counts_file_;
+    FILE* sample_counts_out_ = nullptr;
     
     // 外部端口
     SST::Link* external_spike_input_link_;
@@ -314,6 +463,11 @@ private:
     std::queue<SpikeEvent*> external_spike_queue_;
     std::unordered_map<uint64_t, SpikeEvent*> pending_memory_requests_;
     
+    // 时钟挂起/唤醒状态
+    TimeConverter* clock_tc_;
+    Clock::HandlerBase* clock_handler_;
+    bool clock_suspended_;
+    
     // 时钟计数器和测试流量
     uint64_t current_cycle_;
     uint64_t test_cycle_counter_;
@@ -331,6 +485,11 @@ private:
      */
     void handleExternalSpikeEvent(SST::Event* ev);
     
+    /**
+     * @brief 路由单个外部脉冲（本地入队、核间分发或跨节点转发），接管脉冲内存
+     */
+    void routeExternalSpikeEvent(SpikeEvent* spike);
+    
     /**
      * @brief 从SpikeEventWrapper中提取SpikeEvent数据
      */
@@ -341,6 +500,17 @@ private:
      */
     void routeInternalSpike(int src_core, int dst_core, SpikeEvent* spike);
     
+    /**
+     * @brief 把跨核脉冲交给环形网络
+     * @return 环形网络是否接收（失败时脉冲仍归调用者）
+     */
+    bool sendToRing(int src_core, int dst_core, SpikeEvent* spike);
+    
+    /**
+     * @brief 按序重发被环形网络拒收的脉冲，同一源核心遇到首个失败即停止
+     */
+    void retryInternalSpikes();
+    
     /**
      * @brief 处理内存响应
      */
@@ -418,6 +588,27 @@ private:
      */
     void updateStatistics();
     
+    /**
+     * @brief 从各核心拉取统计并刷新处理单元状态
+     * @param refresh_activity 同时刷新is_active（需扫描核心的全部神经元）
+     */
+    void pollCoreStates(bool refresh_activity = false);
+    
+    /**
+     * @brief 判断是否可以挂起时钟（外部队列与内部互连均已排空）
+     */
+    bool canSuspendClock() const;
+    
+    /**
+     * @brief 若时钟已挂起则重新注册
+     */
+    void wakeClock();
+    
+    /**
+     * @brief 样本边界唤醒：挂起期间按时完成边界复位
+     */
+    void handleSampleWakeup(SST::Event* ev);
+    
     /**
      * @brief 生成测试流量
      */
@@ -433,6 +624,11 @@ private:
      */
     void handleOptimizedCrossCoreRouting();
     
+    /**
+     * @brief 取出各核心邮箱中到期的脉冲并递送（mailbox模式）
+     */
+    void handleMailboxDelivery();
+    
     /**
      * @brief 负载均衡检查
      */
@@ -443,6 +639,51 @@ private:
      */
     int determineTargetUnit(int neuron_id) const;
     
+    /**
+     * @brief setup阶段按连接表（及可选发放计数）计算神经元放置查找表
+     */
+    void computePlacement();
+    
+    /**
+     * @brief 替换路径中的{node}占位符
+     */
+    std::string substituteNodePath(const std::string& path) const;
+    
+    /**
+     * @brief 收集各核心状态并写出checkpoint_out快照（每次运行只写一次）
+     */
+    void writeCheckpoint();
+    
+    /**
+     * @brief 推进到 cycle 所在的样本：结束之前的样本并复位各核心
+     */
+    void advanceSamples(uint64_t cycle);
+    
+    /**
+     * @brief 统计当前样本内的发放数，写出 sample_counts_file 并记入 sample_output_spikes
+     */
+    void finishSample();
+    
+    /**
+     * @brief 样本边界丢弃节点内排队的上一样本脉冲：外部输入队列、重发队列与邮箱；
+     * 环形网络中在途的消息在弹出时按发出周期丢弃
+     */
+    void flushSampleTraffic();
+    
+    /** 核间消息是否由已结束的样本发出（样本边界后弹出时丢弃） */
+    bool isStaleSampleMessage(const RingMessage& msg) const {
+        return sample_period_cycles_ > 0 && msg.timestamp < sample_start_cycle_;
+    }
+    
+    /**
+     * @brief 按放置表拆分聚合扇出脉冲
+     *
+     * 发送端按块划分聚合目标，放置后同一消息的目标可能分属多个核心；
+     * 此时为每个核心生成一条消息并释放原消息。目标都在同一核心时原消息原样返回。
+     * @param parts 输出：(目标核心, 消息)
+     */
+    void splitByPlacement(SpikeEvent* spike, std::vector<std::pair<int, SpikeEvent*>>& parts) const;
+    
     /**
      * @brief 确定神经元ID是否属于本MultiCorePE
      */
@@ -6,7 +6,9 @@
 //
 
 #include "MultiCorePERouterInterface.h"
+#include <algorithm>
 #include <cassert>
+#include <cinttypes>
 #include <cstdarg>
 
 using namespace SST;
@@ -19,15 +21,24 @@ MultiCorePERouterInterface::MultiCorePERouterInterface(ComponentId_t id, Params&
     , port_name_("network")
     , router_(nullptr)
     , spike_handler_(nullptr)
+    , send_queue_depth_(256)
+    , spikes_dropped_count_(0)
     , output_(nullptr)
+    , enable_bundling_(false)
+    , bundle_tc_(nullptr)
+    , bundle_clock_handler_(nullptr)
+    , bundle_clock_active_(false)
+    , bundle_cycle_(0)
 {
     // 解析参数
     node_id_ = params.find<uint32_t>("node_id", 0);
     verbose_ = params.find<uint32_t>("verbose", 0);
     port_name_ = params.find<std::string>("port_name", "network");
+    compact_wire_format_ = params.find<bool>("compact_wire_format", false);
     link_bw_ = params.find<std::string>("link_bw", "40GiB/s");
     input_buf_size_ = params.find<std::string>("input_buf_size", "2KiB");
     output_buf_size_ = params.find<std::string>("output_buf_size", "2KiB");
+    send_queue_depth_ = params.find<uint32_t>("send_queue_depth", 256);
     
     // 初始化输出
     output_ = new Output("MultiCorePERouterInterface[@p:@l]: ", verbose_, 0, Output::STDOUT);
@@ -47,6 +58,25 @@ MultiCorePERouterInterface::MultiCorePERouterInterface(ComponentId_t id, Params&
     stat_packets_received_ = registerStatistic<uint64_t>("packets_received");
     stat_send_buffer_occupancy_ = registerStatistic<double>("send_buffer_occupancy");
     stat_recv_buffer_occupancy_ = registerStatistic<double>("recv_buffer_occupancy");
+    stat_bundles_sent_ = registerStatistic<uint64_t>("bundles_sent");
+    stat_bundle_size_ = registerStatistic<uint64_t>("bundle_size");
+    stat_bundle_flush_count_ = registerStatistic<uint64_t>("bundle_flush_count");
+    stat_bundle_flush_size_ = registerStatistic<uint64_t>("bundle_flush_size");
+    stat_bundle_flush_window_ = registerStatistic<uint64_t>("bundle_flush_window");
+    stat_send_queue_depth_ = registerStatistic<uint64_t>("send_queue_depth");
+    stat_spikes_dropped_ = registerStatistic<uint64_t>("spikes_dropped");
+    
+    // 脉冲聚合：窗口计时时钟仅在有打开或积压的包时保持注册
+    enable_bundling_ = params.find<bool>("enable_spike_bundling", false);
+    if (enable_bundling_) {
+        bundler_.configure(params.find<uint32_t>("bundle_max_spikes", 32),
+                           params.find<uint64_t>("bundle_window_cycles", 4),
+                           params.find<uint32_t>("bundle_packet_size", 256));
+        bundle_clock_handler_ = new Clock::Handler2<MultiCorePERouterInterface,&MultiCorePERouterInterface::bundleClockTick>(this);
+        bundle_tc_ = registerClock(params.find<std::string>("bundle_clock", "1GHz"), bundle_clock_handler_);
+        bundle_clock_active_ = true;
+        debugPrint(2, "📦 脉冲聚合已启用");
+    }
     
     debugPrint(2, "📊 统计项注册完成");
 }
@@ -57,6 +87,7 @@ MultiCorePERouterInterface::~MultiCorePERouterInterface() {
         delete send_queue_.front();
         send_queue_.pop();
     }
+    for (SpikeBundle* bundle : pending_bundles_) delete bundle;
     
     if (output_) {
         delete output_;
@@ -104,6 +135,13 @@ void MultiCorePERouterInterface::initializeSimpleNetwork() {
                 )
             );
             
+            // 发送空间可用时排空积压队列
+            router_->setNotifyOnSend(
+                new SST::Interfaces::SimpleNetwork::Handler2<MultiCorePERouterInterface, &MultiCorePERouterInterface::spaceAvailable>(
+                    this
+                )
+            );
+            
             debugPrint(2, "✅ 网络事件处理器注册完成");
         } else {
             debugPrint(0, "❌ LinkControl SubComponent创建失败");
@@ -145,6 +183,10 @@ void MultiCorePERouterInterface::finish() {
     }
     
     // 输出最终统计
+    if (spikes_dropped_count_ > 0) {
+        debugPrint(0, "⚠️ 节点%u发送队列满丢弃脉冲%" PRIu64 "个（send_queue_depth=%u）",
+                   node_id_, spikes_dropped_count_, send_queue_depth_);
+    }
     debugPrint(1, "📊 最终统计: MultiCorePERouterInterface finish完成");
 }
 
@@ -168,6 +210,20 @@ void MultiCorePERouterInterface::sendSpike(SpikeEvent* spike_event) {
     debugPrint(4, "📤 发送脉冲: src=%u, dst=%u, target_node=%u", 
                spike_event->getSourceNeuron(), spike_event->getDestinationNeuron(), spike_event->getDestinationNode());
     
+    if (enable_bundling_) {
+        // 聚合模式：由聚合缓冲器接管脉冲，整包发送
+        wakeBundleClock();
+        bundler_.add(spike_event, bundle_cycle_);
+        dispatchReadyBundles();
+        return;
+    }
+    
+    // 已有积压时排在其后，避免乱序
+    if (!send_queue_.empty()) {
+        enqueueSpike(spike_event);
+        return;
+    }
+    
     // 转换为网络请求
     auto* req = convertSpikeToRequest(spike_event);
     if (!req) {
@@ -176,21 +232,49 @@ void MultiCorePERouterInterface::sendSpike(SpikeEvent* spike_event) {
         return;
     }
     
-    // 发送请求
+    // 发送请求（成功后请求与载荷归网络所有，先记下统计字段）
+    size_t bytes = req->size_in_bits / 8;
+    uint32_t dest_node = spike_event->getDestinationNode();
     bool sent = router_->send(req, 0);  // 使用VN 0
     if (sent) {
         stat_spikes_sent_->addData(1);
         stat_packets_sent_->addData(1);
-        stat_bytes_sent_->addData(req->size_in_bits / 8);
+        stat_bytes_sent_->addData(bytes);
         
-        debugPrint(4, "✅ 脉冲发送成功: 目标节点%u", spike_event->getDestinationNode());
+        debugPrint(4, "✅ 脉冲发送成功: 目标节点%u", dest_node);
     } else {
         debugPrint(2, "⏳ 发送缓冲区满，加入队列");
-        send_queue_.push(spike_event);
-        delete req;  // 发送失败，清理请求
+        req->takePayload();  // 取回载荷，避免随请求一同释放
+        delete req;
+        enqueueSpike(spike_event);
     }
-    
-    // 注意：spike_event由convertSpikeToRequest内部管理
+}
+
+void MultiCorePERouterInterface::enqueueSpike(SpikeEvent* spike_event) {
+    if (send_queue_depth_ > 0 && queuedCount() >= send_queue_depth_) {
+        debugPrint(2, "🚫 发送队列已满(%u)，丢弃脉冲: dst=%u, target_node=%u", send_queue_depth_,
+                   spike_event->getDestinationNeuron(), spike_event->getDestinationNode());
+        spikes_dropped_count_++;
+        stat_spikes_dropped_->addData(1);
+        delete spike_event;
+        return;
+    }
+    send_queue_.push(spike_event);
+    stat_send_queue_depth_->addData(queuedCount());
+    updateBufferStats();
+}
+
+bool MultiCorePERouterInterface::spaceAvailable(int vn) {
+    // 先发送积压的聚合包，保持发送顺序
+    while (!pending_bundles_.empty() && sendBundle(pending_bundles_.front())) {
+        pending_bundles_.pop_front();
+    }
+    processSendQueue();
+    return true;
+}
+
+bool MultiCorePERouterInterface::canSend() const {
+    return send_queue_depth_ == 0 || queuedCount() < send_queue_depth_;
 }
 
 bool MultiCorePERouterInterface::handleNetworkEvent(int vn) {
@@ -203,6 +287,26 @@ bool MultiCorePERouterInterface::handleNetworkEvent(int vn) {
     debugPrint(4, "📥 接收网络请求: src=%u, dst=%u, size=%u", 
                req->src, req->dest, req->size_in_bits / 8);
     
+    // 聚合包：逐个还原脉冲交给父组件
+    if (SpikeBundle* bundle = dynamic_cast<SpikeBundle*>(req->inspectPayload())) {
+        size_t count = bundle->getSpikeCount();
+        size_t target_offset = 0;
+        for (size_t i = 0; i < count; i++) {
+            SpikeEvent* spike = bundle->unpackSpike(i, target_offset);
+            stat_spikes_received_->addData(1);
+            if (spike_handler_) {
+                spike_handler_(spike);
+            } else {
+                delete spike;
+            }
+        }
+        stat_packets_received_->addData(1);
+        stat_bytes_received_->addData(req->size_in_bits / 8);
+        debugPrint(4, "📦 解包聚合包: src=%u, 脉冲数=%zu", static_cast<uint32_t>(req->src), count);
+        delete req;
+        return true;
+    }
+    
     // 转换为脉冲事件
     SpikeEvent* spike_event = convertRequestToSpike(req);
     if (!spike_event) {
@@ -247,41 +351,44 @@ void MultiCorePERouterInterface::processSendQueue() {
             continue;
         }
         
+        size_t bytes = req->size_in_bits / 8;
         bool sent = router_->send(req, 0);
         if (sent) {
             send_queue_.pop();
             stat_spikes_sent_->addData(1);
             stat_packets_sent_->addData(1);
-            stat_bytes_sent_->addData(req->size_in_bits / 8);
+            stat_bytes_sent_->addData(bytes);
             
             debugPrint(4, "✅ 队列脉冲发送成功");
         } else {
+            req->takePayload();
             delete req;
             break;  // 缓冲区仍满，等待下次
         }
     }
+    updateBufferStats();
 }
 
 SST::Interfaces::SimpleNetwork::Request* 
 MultiCorePERouterInterface::convertSpikeToRequest(SpikeEvent* spike_event) {
     if (!spike_event) return nullptr;
     
-    // 创建SpikeEventWrapper作为载荷
-    SpikeEventWrapper* wrapper = new SpikeEventWrapper(spike_event);
+    // SpikeEvent本身即可序列化，直接作为载荷，线上大小按实际格式计算
+    spike_event->setCompactWire(compact_wire_format_);
     
     // 创建网络请求
     auto* req = new SST::Interfaces::SimpleNetwork::Request();
     req->src = node_id_;
     req->dest = spike_event->getDestinationNode();
-    req->size_in_bits = sizeof(SpikeEventWrapper) * 8;
+    req->size_in_bits = spike_event->wireBytes() * 8;
     req->vn = 0;
     req->head = true;
     req->tail = true;
     req->allow_adaptive = true;
-    req->givePayload(wrapper);
+    req->givePayload(spike_event);
     
-    debugPrint(5, "🔄 脉冲转换请求: %u→%u, size=%lu", 
-               req->src, req->dest, sizeof(SpikeEventWrapper));
+    debugPrint(5, "🔄 脉冲转换请求: %u→%u, size=%zu", 
+               static_cast<uint32_t>(req->src), static_cast<uint32_t>(req->dest), spike_event->wireBytes());
     
     return req;
 }
@@ -292,37 +399,112 @@ MultiCorePERouterInterface::convertRequestToSpike(SST::Interfaces::SimpleNetwork
         return nullptr;
     }
     
-    // 从载荷中提取SpikeEventWrapper
-    SpikeEventWrapper* wrapper = static_cast<SpikeEventWrapper*>(request->inspectPayload());
-    if (!wrapper) {
-        debugPrint(1, "❌ 无效的载荷类型");
-        return nullptr;
-    }
-    
-    // 从wrapper中提取原始SpikeEvent
-    SpikeEvent* original_spike = wrapper->getSpikeEvent();
-    if (!original_spike) {
-        debugPrint(1, "❌ wrapper中没有SpikeEvent数据");
+    // 接管载荷：原生SpikeEvent，或兼容旧格式的SpikeEventWrapper
+    SST::Event* payload = request->takePayload();
+    SpikeEvent* spike_event = dynamic_cast<SpikeEvent*>(payload);
+    if (!spike_event) {
+        SpikeEventWrapper* wrapper = dynamic_cast<SpikeEventWrapper*>(payload);
+        if (!wrapper || !wrapper->getSpikeEvent()) {
+            debugPrint(1, "❌ 无效的载荷类型");
+            delete payload;
+            return nullptr;
+        }
+        spike_event = wrapper->getSpikeEvent();
+        wrapper->setSpikeEvent(nullptr);
         delete wrapper;
-        return nullptr;
     }
-    
-    // 创建新的SpikeEvent
-    SpikeEvent* spike_event = new SpikeEvent(
-        original_spike->getSourceNeuron(),
-        original_spike->getDestinationNeuron(),
-        original_spike->getDestinationNode(),
-        original_spike->getWeight(),
-        original_spike->getTimestamp()
-    );
+    // 紧凑线上格式只传时间戳低32位：按本地周期（核心时钟1GHz）补全高位
+    spike_event->resolveTimestamp(getCurrentSimTimeNano());
     
     debugPrint(5, "🔄 请求转换脉冲: src=%u, dst=%u, weight=%.3f", 
                spike_event->getSourceNeuron(), spike_event->getDestinationNeuron(), spike_event->getWeight());
     
-    delete wrapper;  // 清理载荷
     return spike_event;
 }
 
+bool MultiCorePERouterInterface::bundleClockTick(Cycle_t cycle) {
+    bundle_cycle_ = cycle;
+    bundler_.flushExpired(bundle_cycle_);
+    dispatchReadyBundles();
+    
+    // 积压包在后续周期重试
+    while (!pending_bundles_.empty() && sendBundle(pending_bundles_.front())) {
+        pending_bundles_.pop_front();
+    }
+    
+    if (!bundler_.hasOpenBundles() && pending_bundles_.empty()) {
+        bundle_clock_active_ = false;
+        return true;
+    }
+    return false;
+}
+
+void MultiCorePERouterInterface::wakeBundleClock() {
+    if (bundle_clock_active_) return;
+    bundle_clock_active_ = true;
+    bundle_cycle_ = reregisterClock(bundle_tc_, bundle_clock_handler_) - 1;
+}
+
+void MultiCorePERouterInterface::dispatchReadyBundles() {
+    auto& ready = bundler_.ready();
+    while (!ready.empty()) {
+        SpikeBundler::ReadyBundle r = ready.front();
+        ready.pop_front();
+        
+        stat_bundle_size_->addData(r.bundle->getSpikeCount());
+        switch (r.reason) {
+            case SpikeBundler::FlushReason::COUNT:  stat_bundle_flush_count_->addData(1); break;
+            case SpikeBundler::FlushReason::SIZE:   stat_bundle_flush_size_->addData(1); break;
+            case SpikeBundler::FlushReason::WINDOW: stat_bundle_flush_window_->addData(1); break;
+        }
+        
+        // 有积压时排在其后，避免乱序；积压已满时与单脉冲一样丢弃计数
+        if (pending_bundles_.empty() && sendBundle(r.bundle)) continue;
+        if (send_queue_depth_ > 0 && queuedCount() >= send_queue_depth_) {
+            debugPrint(2, "🚫 发送队列已满(%u)，丢弃聚合包: %zu个脉冲, target_node=%u", send_queue_depth_,
+                       r.bundle->getSpikeCount(), r.bundle->getDestinationNode());
+            spikes_dropped_count_ += r.bundle->getSpikeCount();
+            stat_spikes_dropped_->addData(r.bundle->getSpikeCount());
+            delete r.bundle;
+            continue;
+        }
+        pending_bundles_.push_back(r.bundle);
+        stat_send_queue_depth_->addData(queuedCount());
+    }
+}
+
+bool MultiCorePERouterInterface::sendBundle(SpikeBundle* bundle) {
+    if (!router_) return false;
+    
+    uint32_t dest_node = bundle->getDestinationNode();
+    size_t bytes = bundle->wireBytes();
+    size_t spikes = bundle->getSpikeCount();
+    
+    auto* req = new SST::Interfaces::SimpleNetwork::Request();
+    req->src = node_id_;
+    req->dest = dest_node;
+    req->size_in_bits = bytes * 8;
+    req->vn = 0;
+    req->head = true;
+    req->tail = true;
+    req->allow_adaptive = true;
+    req->givePayload(bundle);
+    
+    if (!router_->send(req, 0)) {
+        // 发送失败时取回载荷，避免随请求一同释放
+        req->takePayload();
+        delete req;
+        return false;
+    }
+    
+    stat_spikes_sent_->addDataNTimes(spikes, 1);
+    stat_packets_sent_->addData(1);
+    stat_bytes_sent_->addData(bytes);
+    stat_bundles_sent_->addData(1);
+    debugPrint(4, "📦 聚合包发送成功: 目标节点%u, 脉冲数=%zu, %zu字节", dest_node, spikes, bytes);
+    return true;
+}
+
 void MultiCorePERouterInterface::setNodeId(uint32_t node_id) {
     node_id_ = node_id;
     debugPrint(2, "🆔 节点ID设置为: %u", node_id_);
@@ -337,16 +519,26 @@ std::string MultiCorePERouterInterface::getNetworkStatus() const {
     status += " 状态: ";
     status += (router_ ? "就绪" : "未初始化");
     status += ", 发送队列: " + std::to_string(send_queue_.size());
+    if (send_queue_depth_ > 0) {
+        status += "/" + std::to_string(send_queue_depth_);
+    }
+    if (spikes_dropped_count_ > 0) {
+        status += ", 丢弃: " + std::to_string(spikes_dropped_count_);
+    }
+    if (enable_bundling_) {
+        status += ", 积压聚合包: " + std::to_string(pending_bundles_.size());
+    }
     return status;
 }
 
 void MultiCorePERouterInterface::updateBufferStats() {
     if (!router_) return;
     
-    // 简单的缓冲区占用率估算
-    double send_occupancy = static_cast<double>(send_queue_.size()) / 100.0; // 假设最大队列100
-    // Note: These stats are initialized in constructor but may not be available in this scope
-    // stat_send_buffer_occupancy_->addData(std::min(send_occupancy, 1.0));
+    // 发送缓冲区占用率：积压相对send_queue_depth的百分比（不限深度时不统计）
+    if (send_queue_depth_ > 0) {
+        double send_occupancy = static_cast<double>(queuedCount()) / send_queue_depth_;
+        stat_send_buffer_occupancy_->addData(std::min(send_occupancy, 1.0) * 100.0);
+    }
     
     // 接收缓冲区占用率由router内部管理
     // stat_recv_buffer_occupancy_->addData(0.0);
@@ -15,13 +15,16 @@
 #include <sst/core/statapi/statbase.h>
 #include <sst/core/statapi/stataccumulator.h>
 #include <sst/core/event.h>
+#include <sst/core/clock.h>
 #include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 
 #include "SnnInterface.h"
 #include "SpikeEvent.h"
 #include "SpikeEventWrapper.h"
+#include "SpikeBundle.h"
 
 namespace SST {
 namespace SnnDL {
@@ -52,11 +55,22 @@ public:
         {"output_buf_size", "输出缓冲区大小", "2KiB"},
         {"port_name", "网络端口名称", "network"},
         {"verbose", "日志详细级别", "0"},
+        {"compact_wire_format", "脉冲以紧凑线上格式序列化（24位神经元ID、16位定点权重）", "0"},
         
         // LinkControl配置参数
         {"job_id", "作业ID（LinkControl需要）", "0"},
         {"job_size", "作业大小（LinkControl需要）", "1"}, 
-        {"logical_nid", "逻辑节点ID（LinkControl需要）", "0"}
+        {"logical_nid", "逻辑节点ID（LinkControl需要）", "0"},
+        
+        // 脉冲聚合
+        {"enable_spike_bundling", "将发往同一节点的脉冲聚合为一个数据包", "0"},
+        {"bundle_max_spikes", "每个聚合包的最大脉冲数", "32"},
+        {"bundle_window_cycles", "聚合包自打开起最多等待的周期数（0=当周期末发送）", "4"},
+        {"bundle_packet_size", "聚合包最大字节数", "256"},
+        {"bundle_clock", "聚合窗口计时时钟频率", "1GHz"},
+        
+        // 发送队列
+        {"send_queue_depth", "网络无空间时可积压的脉冲与聚合包上限，满时canSend()返回false、新脉冲与新封出的聚合包被丢弃计数（0=不限）", "256"}
     )
 
     // 端口文档
@@ -73,7 +87,14 @@ public:
         {"packets_sent", "发送的数据包数", "packets", 1},
         {"packets_received", "接收的数据包数", "packets", 1},
         {"send_buffer_occupancy", "发送缓冲区占用率", "percent", 2},
-        {"recv_buffer_occupancy", "接收缓冲区占用率", "percent", 2}
+        {"recv_buffer_occupancy", "接收缓冲区占用率", "percent", 2},
+        {"bundles_sent", "发送的聚合包数量", "packets", 1},
+        {"bundle_size", "每个聚合包包含的脉冲数", "spikes", 1},
+        {"bundle_flush_count", "因达到脉冲数上限而发送的聚合包数", "packets", 1},
+        {"bundle_flush_size", "因达到包大小上限而发送的聚合包数", "packets", 1},
+        {"bundle_flush_window", "因聚合窗口到期而发送的聚合包数", "packets", 1},
+        {"send_queue_depth", "每次积压入队时的发送队列深度（脉冲+聚合包）", "entries", 1},
+        {"spikes_dropped", "发送队列已满而丢弃的脉冲数（含丢弃聚合包中的脉冲）", "spikes", 1}
     )
 
     /**
@@ -120,6 +141,12 @@ public:
      */
     std::string getNetworkStatus() const override;
 
+    /**
+     * @brief 有界发送队列是否还有空间
+     * @return false表示积压已达send_queue_depth，上游应暂缓发送
+     */
+    bool canSend() const override;
+
     // === SST组件生命周期方法 ===
     
     /**
@@ -143,6 +170,7 @@ private:
     uint32_t node_id_;              ///< 网络节点ID
     uint32_t verbose_;              ///< 日志详细级别
     std::string port_name_;         ///< 网络端口名称
+    bool compact_wire_format_;      ///< 是否使用紧凑线上格式
     
     // === 缓冲区配置 ===
     std::string link_bw_;           ///< 链路带宽
@@ -154,7 +182,11 @@ private:
     
     // === 事件处理 ===
     SpikeHandler spike_handler_;    ///< 脉冲处理回调
-    std::queue<SpikeEvent*> send_queue_;       ///< 发送队列
+    std::queue<SpikeEvent*> send_queue_;       ///< 发送队列（有界）
+    uint32_t send_queue_depth_;                ///< 积压上限（0=不限）
+    uint64_t spikes_dropped_count_;
+    Statistic<uint64_t>* stat_send_queue_depth_;
+    Statistic<uint64_t>* stat_spikes_dropped_;
     
     // === 输出和统计 ===
     SST::Output* output_;           ///< 日志输出
@@ -169,6 +201,20 @@ private:
     Statistic<double>* stat_send_buffer_occupancy_;
     Statistic<double>* stat_recv_buffer_occupancy_;
     
+    // === 脉冲聚合 ===
+    bool enable_bundling_;                      ///< 是否启用脉冲聚合
+    SpikeBundler bundler_;                      ///< 按目标节点聚合的缓冲器
+    std::deque<SpikeBundle*> pending_bundles_;  ///< 已封包但网络暂无空间的聚合包
+    TimeConverter* bundle_tc_;                  ///< 聚合窗口时钟
+    SST::Clock::HandlerBase* bundle_clock_handler_;
+    bool bundle_clock_active_;
+    SST::Cycle_t bundle_cycle_;
+    Statistic<uint64_t>* stat_bundles_sent_;
+    Statistic<uint64_t>* stat_bundle_size_;
+    Statistic<uint64_t>* stat_bundle_flush_count_;
+    Statistic<uint64_t>* stat_bundle_flush_size_;
+    Statistic<uint64_t>* stat_bundle_flush_window_;
+    
     // === 内部方法 ===
     
     /**
@@ -183,11 +229,28 @@ private:
      */
     bool handleNetworkEvent(int vn);
     
+    /**
+     * @brief 网络发送空间可用回调：按序发送积压的聚合包与脉冲
+     * @param vn 虚拟网络ID
+     * @return true表示保留回调
+     */
+    bool spaceAvailable(int vn);
+    
     /**
      * @brief 处理发送队列
      */
     void processSendQueue();
     
+    /**
+     * @brief 当前积压的脉冲与聚合包数
+     */
+    size_t queuedCount() const { return send_queue_.size() + pending_bundles_.size(); }
+    
+    /**
+     * @brief 把脉冲加入有界发送队列，队列已满则丢弃
+     */
+    void enqueueSpike(SpikeEvent* spike_event);
+    
     /**
      * @brief 将SpikeEvent转换为SimpleNetwork::Request
      * @param spike_event 脉冲事件
@@ -202,6 +265,30 @@ private:
      */
     SpikeEvent* convertRequestToSpike(SST::Interfaces::SimpleNetwork::Request* request);
     
+    /**
+     * @brief 聚合窗口时钟：封装到期的聚合包并发送积压，空闲时注销
+     * @param cycle 当前周期
+     * @return true表示注销时钟
+     */
+    bool bundleClockTick(SST::Cycle_t cycle);
+    
+    /**
+     * @brief 记录就绪聚合包的统计并按序发送
+     */
+    void dispatchReadyBundles();
+    
+    /**
+     * @brief 发送一个聚合包
+     * @param bundle 聚合包
+     * @return 是否已交给网络（失败时调用者保留所有权）
+     */
+    bool sendBundle(SpikeBundle* bundle);
+    
+    /**
+     * @brief 若聚合时钟已注销则重新注册
+     */
+    void wakeBundleClock();
+    
     /**
      * @brief 更新缓冲区占用率统计
      */
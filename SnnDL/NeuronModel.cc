@@ -0,0 +1,54 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// NeuronModel.cc: 可插拔神经元模型注册表实现文件
+//
+
+#include "NeuronModel.h"
+
+using namespace SST::SnnDL;
+
+namespace {
+template <typename Kernel>
+std::unique_ptr<NeuronModel> makeKernelModel(const NeuronModelParams& params) {
+    if (params.membrane.isFixed()) {
+        using Quantized = QuantizedKernel<Kernel>;
+        return std::unique_ptr<NeuronModel>(new KernelNeuronModel<Quantized>(Quantized(params)));
+    }
+    return std::unique_ptr<NeuronModel>(new KernelNeuronModel<Kernel>(Kernel(params)));
+}
+}
+
+std::map<std::string, NeuronModel::Factory>& NeuronModel::registry() {
+    // 首次使用时注册内置模型
+    static std::map<std::string, Factory> models = {
+        {LifKernel::NAME, &makeKernelModel<LifKernel>},
+        {IzhikevichKernel::NAME, &makeKernelModel<IzhikevichKernel>},
+        {AlifKernel::NAME, &makeKernelModel<AlifKernel>},
+    };
+    return models;
+}
+
+void NeuronModel::registerModel(const std::string& name, Factory factory) {
+    registry()[name] = std::move(factory);
+}
+
+std::unique_ptr<NeuronModel> NeuronModel::create(const std::string& name, const NeuronModelParams& params,
+                                                 std::string& error) {
+    auto it = registry().find(name);
+    if (it == registry().end()) {
+        error = "未知的神经元模型 '" + name + "' (可选 " + modelNames() + ")";
+        return nullptr;
+    }
+    return it->second(params);
+}
+
+std::string NeuronModel::modelNames() {
+    std::string names;
+    for (const auto& entry : registry()) {
+        if (!names.empty()) names += "|";
+        names += entry.first;
+    }
+    return names;
+}
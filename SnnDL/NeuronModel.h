@@ -0,0 +1,372 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// NeuronModel.h: 可插拔神经元模型与编译期特化更新内核头文件
+//
+
+#ifndef _NEURONMODEL_H
+#define _NEURONMODEL_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FixedPoint.h"
+#include "NeuronStateArray.h"
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 各神经元模型共用的参数集合（未用到的字段被忽略）
+ */
+struct NeuronModelParams {
+    // LIF / ALIF
+    float v_thresh = 1.0f;
+    float v_reset = 0.0f;
+    float v_rest = 0.0f;
+    float tau_mem = 20.0f;          ///< 膜时间常数（周期）
+    uint32_t t_ref = 2;             ///< 不应期（周期）
+    // Izhikevich：dv/dt = 0.04v² + 5v + 140 - u，du/dt = a(bv - u)
+    float izh_a = 0.02f;
+    float izh_b = 0.2f;
+    float izh_c = -65.0f;           ///< 发放后 v 复位值
+    float izh_d = 8.0f;             ///< 发放后 u 增量
+    float izh_dt = 1.0f;            ///< 每周期对应的积分步长(ms)
+    float izh_v_peak = 30.0f;       ///< 发放判据
+    // ALIF：阈值 = v_thresh + alif_beta × a，a 按 alif_tau_adapt 衰减，每次发放 +1
+    float alif_tau_adapt = 200.0f;
+    float alif_beta = 0.2f;
+    // 膜电位精度：定点格式下每次更新/复位后膜电位饱和取整到码字网格
+    FixedPointFormat membrane;
+};
+
+/**
+ * @brief 神经元模型接口
+ *
+ * 虚函数调用以“区间”为粒度（一次逐周期遍历或一个工作池分块调用一次），
+ * 区间内的逐神经元更新由 KernelNeuronModel<Kernel> 按具体内核实例化，可内联与向量化。
+ * 输入积分（v += w）与是否受不应期屏蔽由核心统一处理，模型只负责
+ * 逐周期动力学、阈值判据、发放复位与挂起/惰性补算。
+ */
+class NeuronModel {
+public:
+    virtual ~NeuronModel() = default;
+
+    virtual const char* name() const = 0;
+
+    /** 将状态数组复位为模型的静息状态（需要时分配 aux） */
+    virtual void initialize(NeuronStateArray& states) const = 0;
+
+    /**
+     * @brief 推进 [begin, end) 一个周期并检测发放（语义同 NeuronStateArray::updateRange）
+     * @return 本次达到发放条件的神经元数量
+     */
+    virtual std::size_t updateRange(NeuronStateArray& states, std::size_t begin, std::size_t end,
+                                    std::vector<uint32_t>& fired) const = 0;
+
+    /** 神经元当前是否满足发放条件（不应期内为否） */
+    virtual bool crossed(const NeuronStateArray& states, uint32_t i) const = 0;
+
+    /** 发放后复位 */
+    virtual void fire(NeuronStateArray& states, uint32_t i) const = 0;
+
+    /** 在无输入的前提下把单个神经元推进 cycles 个周期（挂起唤醒与惰性泄漏） */
+    virtual void advance(NeuronStateArray& states, uint32_t i, uint64_t cycles) const = 0;
+
+    /** 是否有神经元的状态偏离静息（用于空闲判定） */
+    virtual bool anyActive(const NeuronStateArray& states) const = 0;
+
+    /**
+     * @brief 按名称创建模型（lif / izhikevich / alif 及后续注册的模型）
+     * @return 未知名称时返回空指针并设置 error
+     */
+    static std::unique_ptr<NeuronModel> create(const std::string& name, const NeuronModelParams& params,
+                                               std::string& error);
+
+    using Factory = std::function<std::unique_ptr<NeuronModel>(const NeuronModelParams&)>;
+
+    /** 注册新模型（同名覆盖） */
+    static void registerModel(const std::string& name, Factory factory);
+
+    /** 已注册的模型名称，以 '|' 分隔 */
+    static std::string modelNames();
+
+private:
+    static std::map<std::string, Factory>& registry();
+};
+
+/**
+ * @brief 以编译期内核实例化的模型
+ *
+ * Kernel 提供：
+ * - bool step(float& v, uint32_t& ref, float& aux) const：一个周期的动力学，返回是否发放
+ * - bool crossed(float v, uint32_t ref, float aux) const
+ * - void fire(float& v, uint32_t& ref, float& aux) const
+ * - void advance(float& v, uint32_t& ref, float& aux, uint64_t cycles) const
+ * - bool active(float v, float aux) const
+ * - float restV() const / float restAux() const，static constexpr bool USES_AUX
+ */
+template <typename Kernel>
+class KernelNeuronModel : public NeuronModel {
+public:
+    explicit KernelNeuronModel(const Kernel& kernel) : kernel_(kernel) {}
+
+    const char* name() const override { return Kernel::NAME; }
+
+    void initialize(NeuronStateArray& states) const override {
+        states.resize(states.size(), kernel_.restV());
+        if (Kernel::USES_AUX) states.aux.assign(states.size(), kernel_.restAux());
+    }
+
+    std::size_t updateRange(NeuronStateArray& states, std::size_t begin, std::size_t end,
+                            std::vector<uint32_t>& fired) const override {
+        const Kernel k = kernel_;   // 局部副本，参数留在寄存器中
+        if (end > states.size()) end = states.size();
+        float* v = states.v_mem.data();
+        uint32_t* ref = states.refractory.data();
+        uint8_t* mask = states.fired_mask.data();
+        float scratch = 0.0f;
+        float* aux = Kernel::USES_AUX ? states.aux.data() : nullptr;
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; i++) {
+            bool hit = k.step(v[i], ref[i], Kernel::USES_AUX ? aux[i] : scratch);
+            mask[i] = hit ? 1 : 0;
+            if (hit) {
+                fired.push_back(static_cast<uint32_t>(i));
+                count++;
+            }
+        }
+        return count;
+    }
+
+    bool crossed(const NeuronStateArray& states, uint32_t i) const override {
+        return kernel_.crossed(states.v_mem[i], states.refractory[i], Kernel::USES_AUX ? states.aux[i] : 0.0f);
+    }
+
+    void fire(NeuronStateArray& states, uint32_t i) const override {
+        float scratch = 0.0f;
+        kernel_.fire(states.v_mem[i], states.refractory[i], Kernel::USES_AUX ? states.aux[i] : scratch);
+    }
+
+    void advance(NeuronStateArray& states, uint32_t i, uint64_t cycles) const override {
+        float scratch = 0.0f;
+        kernel_.advance(states.v_mem[i], states.refractory[i], Kernel::USES_AUX ? states.aux[i] : scratch, cycles);
+    }
+
+    bool anyActive(const NeuronStateArray& states) const override {
+        for (std::size_t i = 0; i < states.size(); i++) {
+            if (kernel_.active(states.v_mem[i], Kernel::USES_AUX ? states.aux[i] : 0.0f)) return true;
+        }
+        return false;
+    }
+
+    const Kernel& kernel() const { return kernel_; }
+
+private:
+    Kernel kernel_;
+};
+
+/**
+ * @brief LIF：不应期内递减计数，否则高于静息时按 leak 衰减
+ *
+ * 逐周期遍历直接使用 NeuronStateArray::updateRange 的 AVX-512/AVX2 实现。
+ */
+struct LifKernel {
+    static constexpr const char* NAME = "lif";
+    static constexpr bool USES_AUX = false;
+
+    float leak, v_rest, v_thresh, v_reset;
+    uint32_t t_ref;
+
+    explicit LifKernel(const NeuronModelParams& p)
+        : leak(std::exp(-1.0f / p.tau_mem)), v_rest(p.v_rest), v_thresh(p.v_thresh),
+          v_reset(p.v_reset), t_ref(p.t_ref) {}
+
+    bool step(float& v, uint32_t& ref, float&) const {
+        if (ref > 0) {
+            ref--;
+        } else if (v > v_rest) {
+            v = v_rest + (v - v_rest) * leak;
+        }
+        return ref == 0 && v >= v_thresh;
+    }
+    bool crossed(float v, uint32_t ref, float) const { return ref == 0 && v >= v_thresh; }
+    void fire(float& v, uint32_t& ref, float&) const {
+        v = v_reset;
+        ref = t_ref;
+    }
+    void advance(float& v, uint32_t& ref, float&, uint64_t cycles) const {
+        uint64_t ref_cycles = ref < cycles ? ref : cycles;
+        ref -= static_cast<uint32_t>(ref_cycles);
+        uint64_t leak_cycles = cycles - ref_cycles;
+        if (leak_cycles > 0 && v > v_rest) {
+            v = v_rest + (v - v_rest) * std::pow(leak, static_cast<float>(leak_cycles));
+        }
+    }
+    bool active(float v, float) const { return v > 0.1f; }
+    float restV() const { return v_rest; }
+    float restAux() const { return 0.0f; }
+};
+
+template <>
+inline std::size_t KernelNeuronModel<LifKernel>::updateRange(NeuronStateArray& states, std::size_t begin,
+                                                             std::size_t end, std::vector<uint32_t>& fired) const {
+    return states.updateRange(begin, end, kernel_.leak, kernel_.v_rest, kernel_.v_thresh, true, fired);
+}
+
+/**
+ * @brief Izhikevich（2003）模型，欧拉积分，aux 为恢复变量 u
+ */
+struct IzhikevichKernel {
+    static constexpr const char* NAME = "izhikevich";
+    static constexpr bool USES_AUX = true;
+    static constexpr uint64_t MAX_ADVANCE_STEPS = 1024;   ///< 补算步数上限，此后视为已收敛到静息点
+
+    float a, b, c, d, dt, v_peak;
+    uint32_t t_ref;
+    bool has_rest;        ///< 无输入时是否存在稳定静息点（否则持续自发放电）
+    float rest_v, rest_u; ///< 稳定静息点：u=b*v 且 0.04v²+(5-b)v+140=0 的较小根
+
+    explicit IzhikevichKernel(const NeuronModelParams& p)
+        : a(p.izh_a), b(p.izh_b), c(p.izh_c), d(p.izh_d), dt(p.izh_dt), v_peak(p.izh_v_peak), t_ref(p.t_ref) {
+        // 默认参数下为 (-70, -14)，而不是复位点 (c, b*c)
+        float disc = (5.0f - b) * (5.0f - b) - 4.0f * 0.04f * 140.0f;
+        has_rest = disc >= 0.0f;
+        rest_v = has_rest ? (-(5.0f - b) - std::sqrt(disc)) / (2.0f * 0.04f) : c;
+        rest_u = b * rest_v;
+    }
+
+    bool step(float& v, uint32_t& u_ref, float& u) const {
+        if (u_ref > 0) u_ref--;
+        float dv = 0.04f * v * v + 5.0f * v + 140.0f - u;
+        float du = a * (b * v - u);
+        v += dt * dv;
+        u += dt * du;
+        if (v > v_peak) v = v_peak;   // 防止发散
+        return u_ref == 0 && v >= v_peak;
+    }
+    bool crossed(float v, uint32_t ref, float) const { return ref == 0 && v >= v_peak; }
+    void fire(float& v, uint32_t& ref, float& u) const {
+        v = c;
+        u += d;
+        ref = t_ref;
+    }
+    void advance(float& v, uint32_t& ref, float& u, uint64_t cycles) const {
+        uint64_t steps = cycles < MAX_ADVANCE_STEPS ? cycles : MAX_ADVANCE_STEPS;
+        for (uint64_t s = 0; s < steps; s++) {
+            if (step(v, ref, u)) fire(v, ref, u);
+        }
+        if (cycles > steps) ref = 0;
+    }
+    bool active(float v, float u) const {
+        return !has_rest || std::fabs(v - rest_v) > 0.5f || std::fabs(u - rest_u) > 0.5f;
+    }
+    float restV() const { return rest_v; }
+    float restAux() const { return rest_u; }
+};
+
+/**
+ * @brief 自适应阈值 LIF（ALIF），aux 为适应变量 a
+ */
+struct AlifKernel {
+    static constexpr const char* NAME = "alif";
+    static constexpr bool USES_AUX = true;
+
+    float leak, rho, v_rest, v_thresh, v_reset, beta;
+    uint32_t t_ref;
+
+    explicit AlifKernel(const NeuronModelParams& p)
+        : leak(std::exp(-1.0f / p.tau_mem)), rho(std::exp(-1.0f / p.alif_tau_adapt)), v_rest(p.v_rest),
+          v_thresh(p.v_thresh), v_reset(p.v_reset), beta(p.alif_beta), t_ref(p.t_ref) {}
+
+    bool step(float& v, uint32_t& ref, float& adapt) const {
+        if (ref > 0) {
+            ref--;
+        } else if (v > v_rest) {
+            v = v_rest + (v - v_rest) * leak;
+        }
+        adapt *= rho;
+        return ref == 0 && v >= v_thresh + beta * adapt;
+    }
+    bool crossed(float v, uint32_t ref, float adapt) const { return ref == 0 && v >= v_thresh + beta * adapt; }
+    void fire(float& v, uint32_t& ref, float& adapt) const {
+        v = v_reset;
+        ref = t_ref;
+        adapt += 1.0f;
+    }
+    void advance(float& v, uint32_t& ref, float& adapt, uint64_t cycles) const {
+        uint64_t ref_cycles = ref < cycles ? ref : cycles;
+        ref -= static_cast<uint32_t>(ref_cycles);
+        uint64_t leak_cycles = cycles - ref_cycles;
+        if (leak_cycles > 0 && v > v_rest) {
+            v = v_rest + (v - v_rest) * std::pow(leak, static_cast<float>(leak_cycles));
+        }
+        adapt *= std::pow(rho, static_cast<float>(cycles));
+    }
+    bool active(float v, float adapt) const { return v > 0.1f || adapt > 1e-3f; }
+    float restV() const { return v_rest; }
+    float restAux() const { return 0.0f; }
+};
+
+/**
+ * @brief 定点膜电位包装：内核照常以 float 计算，写回前按 membrane 格式取整并饱和
+ *
+ * 发放判据取自内核在取整前的结果，与“高精度计算、低精度写回”的硬件数据通路一致。
+ * 惰性补算/挂起唤醒的多周期推进只在末尾取整一次，是逐周期取整的近似。
+ */
+template <typename Kernel>
+struct QuantizedKernel {
+    static constexpr const char* NAME = Kernel::NAME;
+    static constexpr bool USES_AUX = Kernel::USES_AUX;
+
+    Kernel inner;
+    FixedPointFormat q;
+
+    explicit QuantizedKernel(const NeuronModelParams& p) : inner(p), q(p.membrane) {}
+
+    bool step(float& v, uint32_t& ref, float& aux) const {
+        bool hit = inner.step(v, ref, aux);
+        v = q.snap(v);
+        return hit;
+    }
+    bool crossed(float v, uint32_t ref, float aux) const { return inner.crossed(v, ref, aux); }
+    void fire(float& v, uint32_t& ref, float& aux) const {
+        inner.fire(v, ref, aux);
+        v = q.snap(v);
+    }
+    void advance(float& v, uint32_t& ref, float& aux, uint64_t cycles) const {
+        inner.advance(v, ref, aux, cycles);
+        v = q.snap(v);
+    }
+    bool active(float v, float aux) const { return inner.active(v, aux); }
+    float restV() const { return q.snap(inner.restV()); }
+    float restAux() const { return inner.restAux(); }
+};
+
+/** 定点LIF：先走SIMD内核，再对同一区间做一次取整写回（区间仍在缓存中） */
+template <>
+inline std::size_t KernelNeuronModel<QuantizedKernel<LifKernel>>::updateRange(NeuronStateArray& states,
+                                                                              std::size_t begin, std::size_t end,
+                                                                              std::vector<uint32_t>& fired) const {
+    const LifKernel& k = kernel_.inner;
+    std::size_t count = states.updateRange(begin, end, k.leak, k.v_rest, k.v_thresh, true, fired);
+    if (end > states.size()) end = states.size();
+    const FixedPointFormat q = kernel_.q;
+    float* v = states.v_mem.data();
+    for (std::size_t i = begin; i < end; i++) {
+        v[i] = q.snap(v[i]);
+    }
+    return count;
+}
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _NEURONMODEL_H */
@@ -0,0 +1,222 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// NeuronPlacement.cc: 基于连接与发放活动的神经元到核心放置实现文件
+//
+
+#include "NeuronPlacement.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace SST::SnnDL;
+
+NeuronPlacement::NeuronPlacement(uint32_t num_neurons, int num_cores, uint32_t neurons_per_core)
+    : num_neurons_(num_neurons), num_cores_(std::max(1, num_cores)),
+      neurons_per_core_(std::max<uint32_t>(1, neurons_per_core)),
+      activity_(num_neurons, 1.0), fanout_(num_neurons) {}
+
+void NeuronPlacement::setConnectivity(const CsrView& rows, uint64_t global_base) {
+    for (auto& list : fanout_) list.clear();
+    uint32_t covered = std::min(rows.rows, num_neurons_);
+    for (uint32_t r = 0; r < covered; r++) {
+        for (uint64_t i = rows.rowBegin(r); i < rows.rowEnd(r); i++) {
+            uint64_t post = rows.col[i];
+            if (post < global_base || post >= global_base + num_neurons_) continue;
+            uint32_t local = static_cast<uint32_t>(post - global_base);
+            if (local != r) fanout_[r].push_back(local);
+        }
+    }
+}
+
+void NeuronPlacement::setActivity(const std::vector<double>& activity) {
+    if (activity.size() == num_neurons_) activity_ = activity;
+}
+
+double NeuronPlacement::balanceCost(double load) const {
+    double avg = final_.avg_load;
+    if (avg <= 0.0) return 0.0;
+    double dev = load - avg;
+    return balance_weight_ * dev * dev / avg;
+}
+
+void NeuronPlacement::moveNeighborsConn(uint32_t v, int from, int to) {
+    const size_t C = static_cast<size_t>(num_cores_);
+    for (uint64_t e = adj_ptr_[v]; e < adj_ptr_[v + 1]; e++) {
+        double* row = &conn_[adj_[e].neighbor * C];
+        row[from] -= adj_[e].weight;
+        row[to] += adj_[e].weight;
+    }
+}
+
+NeuronPlacement::Quality NeuronPlacement::evaluate() const {
+    const size_t C = static_cast<size_t>(num_cores_);
+    Quality q;
+    // 每条跨核边在两个端点各计一次
+    for (uint32_t v = 0; v < num_neurons_; v++) {
+        for (size_t c = 0; c < C; c++) {
+            if (c != core_of_[v]) q.cut += conn_[v * C + c];
+        }
+    }
+    q.cut *= 0.5;
+    double total = 0.0;
+    for (double load : core_load_) {
+        total += load;
+        q.max_load = std::max(q.max_load, load);
+    }
+    q.avg_load = total / num_cores_;
+    return q;
+}
+
+uint64_t NeuronPlacement::optimize(const Options& options) {
+    const size_t C = static_cast<size_t>(num_cores_);
+    balance_weight_ = options.balance_weight;
+
+    // 初始：按块划分，与原先的 local_id / neurons_per_core 一致
+    core_of_.assign(num_neurons_, 0);
+    members_.assign(C, {});
+    slot_.assign(num_neurons_, 0);
+    for (uint32_t v = 0; v < num_neurons_; v++) {
+        int c = std::min<int>(num_cores_ - 1, static_cast<int>(v / neurons_per_core_));
+        core_of_[v] = static_cast<uint16_t>(c);
+        slot_[v] = static_cast<uint32_t>(members_[c].size());
+        members_[c].push_back(v);
+    }
+
+    // 无向邻接表：u→v 的代价为 u 的发放活动；负载 = 自身发放 + 收到的PE内积分
+    load_.assign(activity_.begin(), activity_.end());
+    std::vector<uint64_t> degree(num_neurons_ + 1, 0);
+    for (uint32_t u = 0; u < num_neurons_; u++) {
+        for (uint32_t v : fanout_[u]) {
+            degree[u]++;
+            degree[v]++;
+            load_[v] += activity_[u];
+        }
+    }
+    adj_ptr_.assign(num_neurons_ + 1, 0);
+    for (uint32_t v = 0; v < num_neurons_; v++) adj_ptr_[v + 1] = adj_ptr_[v] + degree[v];
+    adj_.resize(adj_ptr_[num_neurons_]);
+    std::vector<uint64_t> fill(adj_ptr_.begin(), adj_ptr_.end() - 1);
+    for (uint32_t u = 0; u < num_neurons_; u++) {
+        for (uint32_t v : fanout_[u]) {
+            adj_[fill[u]++] = Edge{v, activity_[u]};
+            adj_[fill[v]++] = Edge{u, activity_[u]};
+        }
+    }
+
+    conn_.assign(static_cast<size_t>(num_neurons_) * C, 0.0);
+    for (uint32_t v = 0; v < num_neurons_; v++) {
+        for (uint64_t e = adj_ptr_[v]; e < adj_ptr_[v + 1]; e++) {
+            conn_[v * C + core_of_[adj_[e].neighbor]] += adj_[e].weight;
+        }
+    }
+    core_load_.assign(C, 0.0);
+    for (uint32_t v = 0; v < num_neurons_; v++) core_load_[core_of_[v]] += load_[v];
+
+    initial_ = evaluate();
+    final_ = initial_;               // balanceCost 使用 final_.avg_load（交换不改变平均值）
+    if (num_cores_ < 2) return 0;
+
+    // 成对交换：每个神经元与其他核心上的神经元尝试交换，取目标函数下降最多者
+    std::vector<double> w_to_v(num_neurons_, 0.0);
+    uint64_t swaps = 0;
+    for (int pass = 0; pass < options.passes; pass++) {
+        uint64_t pass_swaps = 0;
+        for (uint32_t v = 0; v < num_neurons_; v++) {
+            const int a = core_of_[v];
+            for (uint64_t e = adj_ptr_[v]; e < adj_ptr_[v + 1]; e++) {
+                w_to_v[adj_[e].neighbor] += adj_[e].weight;
+            }
+
+            double best = -1e-9;
+            uint32_t best_u = num_neurons_;
+            const double bal_a = balanceCost(core_load_[a]);
+            for (int c = 0; c < num_cores_; c++) {
+                if (c == a) continue;
+                const double move_v = conn_[v * C + a] - conn_[v * C + c];
+                const double bal_before = bal_a + balanceCost(core_load_[c]);
+                for (uint32_t u : members_[c]) {
+                    double d_cut = move_v + conn_[u * C + c] - conn_[u * C + a] + 2.0 * w_to_v[u];
+                    double d_load = load_[u] - load_[v];
+                    double d_bal = balanceCost(core_load_[a] + d_load) +
+                                   balanceCost(core_load_[c] - d_load) - bal_before;
+                    double delta = d_cut + d_bal;
+                    if (delta < best) {
+                        best = delta;
+                        best_u = u;
+                    }
+                }
+            }
+
+            for (uint64_t e = adj_ptr_[v]; e < adj_ptr_[v + 1]; e++) {
+                w_to_v[adj_[e].neighbor] = 0.0;
+            }
+            if (best_u == num_neurons_) continue;
+
+            // 执行交换 v(a) <-> u(c)
+            const uint32_t u = best_u;
+            const int c = core_of_[u];
+            moveNeighborsConn(v, a, c);
+            moveNeighborsConn(u, c, a);
+            core_load_[a] += load_[u] - load_[v];
+            core_load_[c] += load_[v] - load_[u];
+            std::swap(members_[a][slot_[v]], members_[c][slot_[u]]);
+            std::swap(slot_[v], slot_[u]);
+            core_of_[v] = static_cast<uint16_t>(c);
+            core_of_[u] = static_cast<uint16_t>(a);
+            pass_swaps++;
+        }
+        swaps += pass_swaps;
+        if (pass_swaps == 0) break;
+    }
+
+    final_ = evaluate();
+    return swaps;
+}
+
+bool NeuronPlacement::loadProfile(const std::string& path, uint64_t global_base, uint32_t num_neurons,
+                                  std::vector<double>& activity, std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "无法打开发放计数文件: " + path;
+        return false;
+    }
+    activity.assign(num_neurons, 0.0);
+    std::string line;
+    uint64_t line_no = 0;
+    while (std::getline(file, line)) {
+        line_no++;
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        uint64_t neuron;
+        double count;
+        if (!(iss >> neuron >> count)) {
+            error = "发放计数文件第" + std::to_string(line_no) + "行格式错误";
+            return false;
+        }
+        if (neuron >= global_base && neuron < global_base + num_neurons) {
+            activity[neuron - global_base] += count;
+        }
+    }
+    return true;
+}
+
+bool NeuronPlacement::writeProfile(const std::string& path, uint64_t global_base,
+                                   const std::vector<uint64_t>& counts, std::string& error) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        error = "无法创建发放计数文件: " + path;
+        return false;
+    }
+    file << "# global_neuron_id fire_count\n";
+    for (size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] > 0) file << (global_base + i) << ' ' << counts[i] << '\n';
+    }
+    if (!file) {
+        error = "写入失败 " + path;
+        return false;
+    }
+    return true;
+}
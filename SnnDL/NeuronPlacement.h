@@ -0,0 +1,122 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// NeuronPlacement.h: 基于连接与发放活动的神经元到核心放置头文件
+//
+
+#ifndef _NEURONPLACEMENT_H
+#define _NEURONPLACEMENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CsrWeightStore.h"
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief PE内神经元到核心的放置
+ *
+ * 初始为按块划分（本地ID / 每核神经元数），随后以成对交换迭代优化目标
+ *   J = 跨核突触代价 + balance_weight × Σ_c (L_c - L_avg)² / L_avg
+ * 其中突触 u→v 的代价为 u 的发放活动，L_c 为核心c上神经元的期望负载
+ * （自身发放 + 来自PE内突触前神经元的积分次数）。每核神经元数保持不变，
+ * 因此交换只改变映射、不改变各核心的状态容量。
+ *
+ * 活动默认为每个神经元1（纯连接驱动）；给出上一次运行导出的发放计数时按计数加权。
+ */
+class NeuronPlacement {
+public:
+    /**
+     * @brief 放置优化选项
+     */
+    struct Options {
+        int passes = 4;                 ///< 交换优化的最大轮数
+        double balance_weight = 1.0;    ///< 负载均衡项权重
+    };
+
+    /**
+     * @brief 放置质量（优化前后各一份）
+     */
+    struct Quality {
+        double cut = 0.0;               ///< 活动加权的跨核突触代价
+        double max_load = 0.0;          ///< 最重核心负载
+        double avg_load = 0.0;          ///< 平均核心负载
+    };
+
+    NeuronPlacement(uint32_t num_neurons, int num_cores, uint32_t neurons_per_core);
+
+    /**
+     * @brief 读入PE内连接：rows 第r行为本地神经元r的扇出，只保留突触后也在本PE内的突触
+     * @param rows CSR视图（行数不足时缺失行视为无突触）
+     * @param global_base 本PE第一个神经元的全局ID
+     */
+    void setConnectivity(const CsrView& rows, uint64_t global_base);
+
+    /**
+     * @brief 设置每个本地神经元的发放活动（长度须等于神经元数）
+     */
+    void setActivity(const std::vector<double>& activity);
+
+    /**
+     * @brief 从块划分出发执行交换优化
+     * @return 完成的交换次数
+     */
+    uint64_t optimize(const Options& options);
+
+    /** 本地神经元ID -> 核心 */
+    const std::vector<uint16_t>& coreOf() const { return core_of_; }
+    const Quality& initialQuality() const { return initial_; }
+    const Quality& finalQuality() const { return final_; }
+
+    /**
+     * @brief 读取发放计数文件（每行 "全局神经元ID 计数"，#开头为注释），只取本PE范围
+     */
+    static bool loadProfile(const std::string& path, uint64_t global_base, uint32_t num_neurons,
+                            std::vector<double>& activity, std::string& error);
+
+    /**
+     * @brief 写出发放计数文件，格式同 loadProfile
+     */
+    static bool writeProfile(const std::string& path, uint64_t global_base,
+                             const std::vector<uint64_t>& counts, std::string& error);
+
+private:
+    /** 无向邻接表中的一条边 */
+    struct Edge {
+        uint32_t neighbor;
+        double weight;
+    };
+
+    Quality evaluate() const;
+    double balanceCost(double load) const;
+    void moveNeighborsConn(uint32_t v, int from, int to);
+
+    uint32_t num_neurons_;
+    int num_cores_;
+    uint32_t neurons_per_core_;
+    double balance_weight_ = 1.0;
+
+    std::vector<double> activity_;
+    std::vector<std::vector<uint32_t>> fanout_;    ///< PE内有向扇出（本地ID）
+    std::vector<uint64_t> adj_ptr_;                ///< 无向邻接表 CSR 偏移
+    std::vector<Edge> adj_;
+    std::vector<double> load_;                     ///< 每个神经元的期望负载
+
+    std::vector<uint16_t> core_of_;
+    std::vector<std::vector<uint32_t>> members_;   ///< 每个核心上的神经元
+    std::vector<uint32_t> slot_;                   ///< 神经元在 members_[core] 中的位置
+    std::vector<double> conn_;                     ///< [v*C+c] v 与核心c上神经元的边权之和
+    std::vector<double> core_load_;
+
+    Quality initial_;
+    Quality final_;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _NEURONPLACEMENT_H */
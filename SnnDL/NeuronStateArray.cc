@@ -0,0 +1,143 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// NeuronStateArray.cc: 结构数组(SoA)神经元状态存储与向量化更新内核实现文件
+//
+
+#include "NeuronStateArray.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace SST::SnnDL;
+
+void NeuronStateArray::resize(std::size_t n, float v_rest) {
+    v_mem.assign(n, v_rest);
+    refractory.assign(n, 0);
+    fired_mask.assign(n, 0);
+    last_spike_time.assign(n, 0);
+    last_update_cycle.assign(n, 0);
+}
+
+const char* NeuronStateArray::kernelName() {
+#if defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+std::size_t NeuronStateArray::updateScalar(std::size_t begin, std::size_t end, float leak_factor, float v_rest,
+                                           float v_thresh, bool leak_above_rest_only, std::vector<uint32_t>& fired) {
+    std::size_t count = 0;
+    for (std::size_t i = begin; i < end; i++) {
+        if (refractory[i] > 0) {
+            refractory[i]--;
+        } else if (!leak_above_rest_only || v_mem[i] > v_rest) {
+            v_mem[i] = v_rest + (v_mem[i] - v_rest) * leak_factor;
+        }
+        uint8_t hit = (refractory[i] == 0 && v_mem[i] >= v_thresh) ? 1 : 0;
+        fired_mask[i] = hit;
+        if (hit) {
+            fired.push_back(static_cast<uint32_t>(i));
+            count++;
+        }
+    }
+    return count;
+}
+
+std::size_t NeuronStateArray::updateAndDetect(float leak_factor, float v_rest, float v_thresh,
+                                              bool leak_above_rest_only, std::vector<uint32_t>& fired) {
+    return updateRange(0, v_mem.size(), leak_factor, v_rest, v_thresh, leak_above_rest_only, fired);
+}
+
+std::size_t NeuronStateArray::updateRange(std::size_t begin, std::size_t end, float leak_factor, float v_rest,
+                                          float v_thresh, bool leak_above_rest_only, std::vector<uint32_t>& fired) {
+    if (end > v_mem.size()) end = v_mem.size();
+    std::size_t i = begin;
+    std::size_t count = 0;
+
+    // 向量部分与标量部分使用相同的 乘法+加法 顺序（不使用FMA），保证结果逐位一致
+#if defined(__AVX512F__)
+    const std::size_t n = end;
+    const __m512 vrest = _mm512_set1_ps(v_rest);
+    const __m512 vleak = _mm512_set1_ps(leak_factor);
+    const __m512 vth = _mm512_set1_ps(v_thresh);
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi32(1);
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_loadu_ps(&v_mem[i]);
+        __m512i r = _mm512_loadu_si512(reinterpret_cast<const void*>(&refractory[i]));
+
+        __mmask16 in_ref = _mm512_cmpneq_epi32_mask(r, zero);
+        r = _mm512_mask_sub_epi32(r, in_ref, r, one);
+
+        __mmask16 do_leak = static_cast<__mmask16>(~in_ref);
+        if (leak_above_rest_only) {
+            do_leak &= _mm512_cmp_ps_mask(v, vrest, _CMP_GT_OQ);
+        }
+        __m512 leaked = _mm512_add_ps(vrest, _mm512_mul_ps(_mm512_sub_ps(v, vrest), vleak));
+        v = _mm512_mask_blend_ps(do_leak, v, leaked);
+
+        _mm512_storeu_ps(&v_mem[i], v);
+        _mm512_storeu_si512(reinterpret_cast<void*>(&refractory[i]), r);
+
+        __mmask16 hit = _mm512_cmpeq_epi32_mask(r, zero) & _mm512_cmp_ps_mask(v, vth, _CMP_GE_OQ);
+        uint32_t bits = static_cast<uint32_t>(hit);
+        for (int lane = 0; lane < 16; lane++) {
+            fired_mask[i + lane] = static_cast<uint8_t>((bits >> lane) & 1u);
+        }
+        while (bits) {
+            int lane = __builtin_ctz(bits);
+            fired.push_back(static_cast<uint32_t>(i + lane));
+            count++;
+            bits &= bits - 1;
+        }
+    }
+#elif defined(__AVX2__)
+    const std::size_t n = end;
+    const __m256 vrest = _mm256_set1_ps(v_rest);
+    const __m256 vleak = _mm256_set1_ps(leak_factor);
+    const __m256 vth = _mm256_set1_ps(v_thresh);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(&v_mem[i]);
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&refractory[i]));
+
+        // r==0 的通道全1；其余通道加 -1 完成递减
+        __m256i ref_zero = _mm256_cmpeq_epi32(r, zero);
+        r = _mm256_add_epi32(r, _mm256_andnot_si256(ref_zero, _mm256_set1_epi32(-1)));
+
+        __m256 do_leak = _mm256_castsi256_ps(ref_zero);
+        if (leak_above_rest_only) {
+            do_leak = _mm256_and_ps(do_leak, _mm256_cmp_ps(v, vrest, _CMP_GT_OQ));
+        }
+        __m256 leaked = _mm256_add_ps(vrest, _mm256_mul_ps(_mm256_sub_ps(v, vrest), vleak));
+        v = _mm256_blendv_ps(v, leaked, do_leak);
+
+        _mm256_storeu_ps(&v_mem[i], v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&refractory[i]), r);
+
+        __m256 hit = _mm256_and_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(r, zero)),
+                                   _mm256_cmp_ps(v, vth, _CMP_GE_OQ));
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_ps(hit));
+        for (int lane = 0; lane < 8; lane++) {
+            fired_mask[i + lane] = static_cast<uint8_t>((bits >> lane) & 1u);
+        }
+        while (bits) {
+            int lane = __builtin_ctz(bits);
+            fired.push_back(static_cast<uint32_t>(i + lane));
+            count++;
+            bits &= bits - 1;
+        }
+    }
+#endif
+
+    // 尾部（或无SIMD时的全部）使用标量实现
+    count += updateScalar(i, end, leak_factor, v_rest, v_thresh, leak_above_rest_only, fired);
+    return count;
+}
@@ -0,0 +1,119 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// NeuronStateArray.h: 结构数组(SoA)神经元状态存储与向量化更新内核头文件
+//
+
+#ifndef _NEURONSTATEARRAY_H
+#define _NEURONSTATEARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 按指定字节对齐分配内存的分配器
+ *
+ * 保证各状态数组首地址按缓存行/向量寄存器宽度对齐。
+ */
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+    AlignedAllocator() noexcept {}
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/**
+ * @brief 结构数组(SoA)形式的神经元状态存储
+ *
+ * 膜电位、不应期计数器与发放掩码分别存放在独立的对齐数组中，
+ * 使泄漏/不应期/阈值比较可以在一次遍历中以SIMD方式完成。
+ * 根据编译目标自动选择 AVX-512、AVX2 或标量实现。
+ */
+class NeuronStateArray {
+public:
+    template <typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+    AlignedVector<float> v_mem;              ///< 膜电位
+    AlignedVector<uint32_t> refractory;      ///< 不应期剩余周期
+    AlignedVector<uint8_t> fired_mask;       ///< 最近一次更新中达到发放条件的神经元(1=是)
+    AlignedVector<float> aux;                ///< 模型的第二个状态变量（Izhikevich的u、ALIF的适应量），LIF不分配
+    std::vector<uint64_t> last_spike_time;   ///< 最后一次发放的周期
+    std::vector<uint64_t> last_update_cycle; ///< 惰性泄漏/挂起补算使用的最后更新周期
+
+    /**
+     * @brief 调整神经元数量并全部复位为静息状态
+     * @param n 神经元数量
+     * @param v_rest 静息电位
+     */
+    void resize(std::size_t n, float v_rest);
+
+    /**
+     * @brief 神经元数量
+     */
+    std::size_t size() const { return v_mem.size(); }
+    bool empty() const { return v_mem.empty(); }
+
+    /**
+     * @brief 单次遍历完成泄漏、不应期递减与阈值比较
+     *
+     * 对每个神经元：不应期>0时递减；否则按 v_rest + (v - v_rest) * leak_factor 泄漏
+     * （leak_above_rest_only 为真时仅在 v > v_rest 时泄漏）。
+     * 随后不应期为0且 v >= v_thresh 的神经元写入 fired_mask 并追加到 fired。
+     *
+     * @param leak_factor 每周期泄漏因子
+     * @param v_rest 静息电位
+     * @param v_thresh 发放阈值
+     * @param leak_above_rest_only 是否仅对高于静息电位的神经元泄漏
+     * @param fired 输出：达到发放条件的神经元索引（升序，追加写入）
+     * @return 本次达到发放条件的神经元数量
+     */
+    std::size_t updateAndDetect(float leak_factor, float v_rest, float v_thresh,
+                                bool leak_above_rest_only, std::vector<uint32_t>& fired);
+
+    /**
+     * @brief 只更新 [begin, end) 区间，语义与 updateAndDetect 相同
+     *
+     * 各神经元的计算互不依赖，任意切分区间得到的状态与整体更新逐位一致，
+     * 不同区间可由不同线程并发执行（区间按64个神经元对齐可避免 fired_mask 伪共享）。
+     */
+    std::size_t updateRange(std::size_t begin, std::size_t end, float leak_factor, float v_rest, float v_thresh,
+                            bool leak_above_rest_only, std::vector<uint32_t>& fired);
+
+    /**
+     * @brief 当前编译所用的内核实现名称（avx512/avx2/scalar）
+     */
+    static const char* kernelName();
+
+private:
+    std::size_t updateScalar(std::size_t begin, std::size_t end, float leak_factor, float v_rest, float v_thresh,
+                             bool leak_above_rest_only, std::vector<uint32_t>& fired);
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _NEURONSTATEARRAY_H */
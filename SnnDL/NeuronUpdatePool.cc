@@ -0,0 +1,116 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// NeuronUpdatePool.cc: 组件内多线程神经元更新工作池实现文件
+//
+
+#include "NeuronUpdatePool.h"
+
+#include <algorithm>
+
+using namespace SST::SnnDL;
+
+namespace {
+// 工作线程在阻塞前的自旋次数；逐周期调用时下一步通常很快到来
+constexpr int SPIN_LIMIT = 20000;
+}
+
+NeuronUpdatePool::NeuronUpdatePool(int num_threads, std::size_t min_neurons_per_thread)
+    : num_threads_(std::max(1, num_threads)),
+      min_neurons_per_thread_(std::max<std::size_t>(CHUNK_ALIGN, min_neurons_per_thread)) {
+    bounds_.assign(static_cast<std::size_t>(num_threads_) + 1, 0);
+    chunk_fired_.resize(num_threads_);
+    for (int w = 1; w < num_threads_; w++) {
+        workers_.emplace_back(&NeuronUpdatePool::workerLoop, this, w);
+    }
+}
+
+NeuronUpdatePool::~NeuronUpdatePool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true, std::memory_order_release);
+    }
+    wake_cv_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+void NeuronUpdatePool::runChunk(int chunk) {
+    std::vector<uint32_t>& out = chunk_fired_[chunk];
+    out.clear();
+    (*range_)(bounds_[chunk], bounds_[chunk + 1], out);
+}
+
+void NeuronUpdatePool::workerLoop(int worker) {
+    uint64_t seen = 0;
+    while (true) {
+        uint64_t gen;
+        int spins = 0;
+        while ((gen = generation_.load(std::memory_order_acquire)) == seen) {
+            if (stop_.load(std::memory_order_acquire)) return;
+            if (++spins < SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_cv_.wait(lock, [&] {
+                return stop_.load(std::memory_order_acquire) ||
+                       generation_.load(std::memory_order_acquire) != seen;
+            });
+            spins = 0;
+        }
+        seen = gen;
+        if (worker < active_chunks_) {
+            runChunk(worker);
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+}
+
+std::size_t NeuronUpdatePool::updateAndDetect(NeuronStateArray& states, float leak_factor, float v_rest,
+                                              float v_thresh, bool leak_above_rest_only,
+                                              std::vector<uint32_t>& fired) {
+    RangeFn range = [&](std::size_t begin, std::size_t end, std::vector<uint32_t>& out) {
+        return states.updateRange(begin, end, leak_factor, v_rest, v_thresh, leak_above_rest_only, out);
+    };
+    return run(states.size(), range, fired);
+}
+
+std::size_t NeuronUpdatePool::run(std::size_t n, const RangeFn& range, std::vector<uint32_t>& fired) {
+    int chunks = static_cast<int>(std::min<std::size_t>(num_threads_, n / min_neurons_per_thread_));
+    if (chunks <= 1) {
+        serial_steps_++;
+        return range(0, n, fired);
+    }
+
+    // 均分后按 CHUNK_ALIGN 向上取整，最后一块吸收余数
+    std::size_t per_chunk = (n + chunks - 1) / chunks;
+    per_chunk = (per_chunk + CHUNK_ALIGN - 1) / CHUNK_ALIGN * CHUNK_ALIGN;
+    for (int c = 0; c <= chunks; c++) {
+        bounds_[c] = std::min(n, static_cast<std::size_t>(c) * per_chunk);
+    }
+    bounds_[chunks] = n;
+
+    range_ = &range;
+    active_chunks_ = chunks;
+    pending_.store(chunks - 1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    wake_cv_.notify_all();
+
+    runChunk(0);
+    while (pending_.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+
+    // 按块顺序合并，等价于串行遍历得到的升序列表
+    std::size_t count = 0;
+    for (int c = 0; c < chunks; c++) {
+        fired.insert(fired.end(), chunk_fired_[c].begin(), chunk_fired_[c].end());
+        count += chunk_fired_[c].size();
+    }
+    parallel_steps_++;
+    return count;
+}
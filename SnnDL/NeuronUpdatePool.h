@@ -0,0 +1,100 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// NeuronUpdatePool.h: 组件内多线程神经元更新工作池头文件
+//
+
+#ifndef _NEURONUPDATEPOOL_H
+#define _NEURONUPDATEPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "NeuronStateArray.h"
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 组件内的神经元更新工作池
+ *
+ * SST 的线程并行以组件为粒度，单个大规模PE的逐周期泄漏/阈值遍历只能在一个线程上执行。
+ * 工作池把神经元区间按64个神经元对齐切成若干块，调用线程处理第0块，
+ * 常驻工作线程处理其余块，各块的发放列表按块顺序合并，
+ * 因此结果（状态与升序发放列表）与串行 updateAndDetect 逐位一致，与线程数无关。
+ *
+ * 只并行泄漏/不应期/阈值阶段；发放处理、脉冲发送等仍在组件线程上串行执行。
+ * 工作线程先自旋等待下一步，超过自旋上限后阻塞，避免空闲时占满宿主核心。
+ */
+class NeuronUpdatePool {
+public:
+    /**
+     * @param num_threads 参与更新的线程总数（含调用线程），<=1 时不创建工作线程
+     * @param min_neurons_per_thread 每个线程至少分到的神经元数，规模不足时少用线程或退化为串行
+     */
+    NeuronUpdatePool(int num_threads, std::size_t min_neurons_per_thread);
+    ~NeuronUpdatePool();
+
+    NeuronUpdatePool(const NeuronUpdatePool&) = delete;
+    NeuronUpdatePool& operator=(const NeuronUpdatePool&) = delete;
+
+    /**
+     * @brief 与 NeuronStateArray::updateAndDetect 语义相同的并行版本
+     * @param fired 输出：达到发放条件的神经元索引（升序，追加写入）
+     * @return 本次达到发放条件的神经元数量
+     */
+    std::size_t updateAndDetect(NeuronStateArray& states, float leak_factor, float v_rest, float v_thresh,
+                                bool leak_above_rest_only, std::vector<uint32_t>& fired);
+
+    /** 区间更新函数：推进 [begin, end) 并把发放索引追加到 fired，返回发放数 */
+    using RangeFn = std::function<std::size_t(std::size_t, std::size_t, std::vector<uint32_t>&)>;
+
+    /**
+     * @brief 将 [0, n) 按块分给各线程执行 range，发放列表按块顺序合并
+     *
+     * 用于非LIF神经元模型：range 内为模型内核的逐神经元循环。
+     */
+    std::size_t run(std::size_t n, const RangeFn& range, std::vector<uint32_t>& fired);
+
+    int threads() const { return num_threads_; }
+    uint64_t parallelSteps() const { return parallel_steps_; }
+    uint64_t serialSteps() const { return serial_steps_; }
+
+private:
+    static constexpr std::size_t CHUNK_ALIGN = 64;   ///< 块边界对齐（fired_mask 一个缓存行）
+
+    void workerLoop(int worker);
+    void runChunk(int chunk);
+
+    int num_threads_;
+    std::size_t min_neurons_per_thread_;
+    std::vector<std::thread> workers_;
+
+    // 步间同步：generation_ 递增发布新的一步，pending_ 为尚未完成的工作线程块数
+    std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<int> pending_{0};
+    std::atomic<bool> stop_{false};
+
+    // 当前一步的任务描述（发布前由调用线程写入）
+    const RangeFn* range_ = nullptr;
+    int active_chunks_ = 0;
+    std::vector<std::size_t> bounds_;                 ///< 块c为 [bounds_[c], bounds_[c+1])
+    std::vector<std::vector<uint32_t>> chunk_fired_;  ///< 每块的发放列表
+
+    uint64_t parallel_steps_ = 0;
+    uint64_t serial_steps_ = 0;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _NEURONUPDATEPOOL_H */
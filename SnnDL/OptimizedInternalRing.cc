@@ -16,90 +16,84 @@
 using namespace SST;
 using namespace SST::SnnDL;
 
+// ===== LatencyHistogram 实现 =====
+
+uint64_t LatencyHistogram::percentileLow(double q) const {
+    if (samples == 0) return 0;
+    uint64_t target = static_cast<uint64_t>(std::ceil(q * samples));
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < NUM_BUCKETS; b++) {
+        seen += counts[b];
+        if (seen >= target) return bucketLow(b);
+    }
+    return bucketLow(NUM_BUCKETS - 1);
+}
+
 // ===== RingNode 实现 =====
 
-void RingNode::initializeVCs(int num_vcs_per_direction, uint32_t credits_per_vc) {
-    // 初始化顺时针虚拟通道
+void RingNode::initializeVCs(int num_vcs_per_direction, uint32_t credits_per_vc, uint32_t ejection_capacity) {
     cw_vcs.clear();
-    cw_vcs.reserve(num_vcs_per_direction);
-    for (int i = 0; i < num_vcs_per_direction; i++) {
-        cw_vcs.emplace_back(i, i, credits_per_vc);  // VC ID = priority for simplicity
-    }
-    
-    // 初始化逆时针虚拟通道
     ccw_vcs.clear();
+    local_vcs.clear();
+    cw_vcs.reserve(num_vcs_per_direction);
     ccw_vcs.reserve(num_vcs_per_direction);
+    local_vcs.reserve(num_vcs_per_direction);
     for (int i = 0; i < num_vcs_per_direction; i++) {
+        cw_vcs.emplace_back(i, i, credits_per_vc);  // VC ID = priority for simplicity
         ccw_vcs.emplace_back(i, i, credits_per_vc);
+        local_vcs.emplace_back(i, i, credits_per_vc);
     }
     
-    // 初始化本地虚拟通道
-    local_vcs.clear();
-    local_vcs.reserve(num_vcs_per_direction);
-    for (int i = 0; i < num_vcs_per_direction; i++) {
-        local_vcs.emplace_back(i, i, credits_per_vc);
+    // 初始时全部VC为空且有空间
+    uint64_t all = (num_vcs_per_direction >= MAX_VCS) ? ~0ULL : ((1ULL << num_vcs_per_direction) - 1);
+    for (int d = 0; d < 3; d++) {
+        vc_data_mask[d] = 0;
+        vc_space_mask[d] = (credits_per_vc > 0) ? all : 0;
+        vc_occupancy[d] = 0;
     }
+    
+    ejection_queue.reset(ejection_capacity);
 }
 
-VirtualChannel* RingNode::selectOutputVC(RouteDirection direction, int priority) {
-    std::vector<VirtualChannel>* vcs = nullptr;
-    
+std::vector<VirtualChannel>* RingNode::vcsFor(RouteDirection direction) {
     switch (direction) {
-        case RouteDirection::CLOCKWISE:
-            vcs = &cw_vcs;
-            break;
-        case RouteDirection::COUNTER_CLOCKWISE:
-            vcs = &ccw_vcs;
-            break;
-        case RouteDirection::LOCAL:
-            vcs = &local_vcs;
-            break;
-        default:
-            return nullptr;
-    }
-    
-    // 首先尝试找到匹配优先级且有空间的VC
-    for (auto& vc : *vcs) {
-        if (vc.priority == priority && vc.hasSpace()) {
-            return &vc;
-        }
+        case RouteDirection::CLOCKWISE:         return &cw_vcs;
+        case RouteDirection::COUNTER_CLOCKWISE: return &ccw_vcs;
+        case RouteDirection::LOCAL:             return &local_vcs;
+        default:                                return nullptr;
     }
+}
+
+void RingNode::refreshVC(RouteDirection direction, int vc_index) {
+    std::vector<VirtualChannel>* vcs = vcsFor(direction);
+    if (!vcs) return;
+    const VirtualChannel& vc = (*vcs)[vc_index];
+    int d = static_cast<int>(direction);
+    uint64_t bit = 1ULL << vc_index;
+    vc_data_mask[d] = vc.hasData() ? (vc_data_mask[d] | bit) : (vc_data_mask[d] & ~bit);
+    vc_space_mask[d] = vc.hasSpace() ? (vc_space_mask[d] | bit) : (vc_space_mask[d] & ~bit);
+}
+
+int RingNode::selectOutputVC(RouteDirection direction, int priority) const {
+    if (direction == RouteDirection::INVALID) return -1;
+    uint64_t space = vc_space_mask[static_cast<int>(direction)];
+    if (!space) return -1;
     
-    // 如果没有匹配的，找到任何有空间的VC
-    for (auto& vc : *vcs) {
-        if (vc.hasSpace()) {
-            return &vc;
-        }
+    // VC i 的优先级为 i：优先选择匹配优先级的VC，否则取任意有空间的VC
+    if (priority >= 0 && priority < MAX_VCS && (space & (1ULL << priority))) {
+        return priority;
     }
-    
-    return nullptr;  // 没有可用的VC
+    return __builtin_ctzll(space);
 }
 
 bool RingNode::canAcceptMessage(RouteDirection direction, int priority) const {
-    const std::vector<VirtualChannel>* vcs = nullptr;
+    if (direction == RouteDirection::INVALID || priority < 0) return false;
+    uint64_t space = vc_space_mask[static_cast<int>(direction)];
     
-    switch (direction) {
-        case RouteDirection::CLOCKWISE:
-            vcs = &cw_vcs;
-            break;
-        case RouteDirection::COUNTER_CLOCKWISE:
-            vcs = &ccw_vcs;
-            break;
-        case RouteDirection::LOCAL:
-            vcs = &local_vcs;
-            break;
-        default:
-            return false;
-    }
-    
-    // 检查是否有任何VC可以接受这个优先级的消息
-    for (const auto& vc : *vcs) {
-        if (vc.priority <= priority && vc.hasSpace()) {
-            return true;
-        }
-    }
-    
-    return false;
+    // 检查是否有优先级不低于该消息（VC下标 <= priority）的VC有空间
+    uint64_t eligible = (priority >= MAX_VCS - 1) ? ~0ULL : ((1ULL << (priority + 1)) - 1);
+    return (space & eligible) != 0;
 }
 
 // ===== OptimizedInternalRing 实现 =====
@@ -107,7 +101,8 @@ bool RingNode::canAcceptMessage(RouteDirection direction, int priority) const {
 OptimizedInternalRing::OptimizedInternalRing(int num_nodes, int num_vcs, 
                                            uint32_t credits_per_vc, SST::Output* output)
     : num_nodes_(num_nodes), num_vcs_(num_vcs), credits_per_vc_(credits_per_vc), 
-      output_(output), last_stats_cycle_(0) {
+      output_(output), routing_mode_(RingRoutingMode::MINIMAL), flits_per_cycle_(1),
+      last_stats_cycle_(0), adaptive_detours_(0) {
     
     if (output_) {
         // output_->verbose(CALL_INFO, 1, 0, "🔗 初始化优化的内部环形网络: %d节点, %d VCs, %d信用/VC\n",
@@ -121,24 +116,46 @@ OptimizedInternalRing::OptimizedInternalRing(int num_nodes, int num_vcs,
         }
     }
     
-    if (num_vcs_ < 1) {
+    if (num_vcs_ < 1 || num_vcs_ > RingNode::MAX_VCS) {
         if (output_) {
-            output_->fatal(CALL_INFO, -1, "❌ 至少需要1个虚拟通道，当前: %d\n", num_vcs_);
+            output_->fatal(CALL_INFO, -1, "❌ 虚拟通道数需在1~%d之间，当前: %d\n", RingNode::MAX_VCS, num_vcs_);
         }
     }
     
-    // 初始化节点
+    // 初始化节点：弹出队列容量取单方向全部VC容量的两倍（两个方向可同时到达）
+    uint32_t ejection_capacity = 2 * static_cast<uint32_t>(num_vcs_) * credits_per_vc_;
     nodes_.reserve(num_nodes_);
     for (int i = 0; i < num_nodes_; i++) {
         nodes_.emplace_back(std::make_unique<RingNode>(i));
-        nodes_[i]->initializeVCs(num_vcs_, credits_per_vc_);
+        nodes_[i]->initializeVCs(num_vcs_, credits_per_vc_, ejection_capacity);
     }
     
     // 初始化环形拓扑
     initializeTopology();
     
-    // 初始化路由缓存
-    route_cache_.resize(num_nodes_ * num_nodes_, 0);
+    // 预计算全部源/目标对的路由方向
+    route_cache_.assign(static_cast<size_t>(num_nodes_) * num_nodes_, RouteDirection::LOCAL);
+    for (int src = 0; src < num_nodes_; src++) {
+        for (int dst = 0; dst < num_nodes_; dst++) {
+            if (src == dst) continue;
+            int cw_hops = calculateHops(src, dst, RouteDirection::CLOCKWISE);
+            int ccw_hops = calculateHops(src, dst, RouteDirection::COUNTER_CLOCKWISE);
+            // 选择跳数更少的方向，相等时优先选择顺时针
+            route_cache_[static_cast<size_t>(src) * num_nodes_ + dst] =
+                (cw_hops <= ccw_hops) ? RouteDirection::CLOCKWISE : RouteDirection::COUNTER_CLOCKWISE;
+        }
+    }
+    
+    // 预分配消息槽：总数等于全部VC与弹出队列容量之和，入队有空间时必有空闲槽
+    size_t per_node = 3 * static_cast<size_t>(num_vcs_) * credits_per_vc_ + ejection_capacity;
+    size_t total_slots = per_node * num_nodes_;
+    message_slots_.assign(total_slots, RingMessage());
+    free_slots_.resize(total_slots);
+    slot_enqueue_cycle_.assign(total_slots, 0);
+    for (size_t i = 0; i < total_slots; i++) {
+        free_slots_[i] = static_cast<RingHandle>(total_slots - 1 - i);
+    }
+    vc_resident_ = 0;
     
     if (output_) {
         // output_->verbose(CALL_INFO, 1, 0, "✅ 优化的环形网络初始化完成\n");
@@ -200,13 +217,18 @@ bool OptimizedInternalRing::sendMessage(int src_node, int dst_node, const RingMe
     
     // 如果是本地消息，直接放入弹出队列
     if (src_node == dst_node) {
-        src->ejection_queue.push(message);
+        if (src->ejection_queue.full()) return false;  // 背压：弹出队列已满
+        RingHandle h = allocateSlot(message);
+        message_slots_[h].timestamp = std::max(message.timestamp, total_cycles_.load());
+        src->ejection_queue.push(h);
         src->messages_ejected++;
         return true;
     }
     
     // 选择路由方向
-    RouteDirection route_dir = selectRoute(src_node, dst_node);
+    RouteDirection route_dir = (routing_mode_ == RingRoutingMode::ADAPTIVE)
+                                   ? selectAdaptiveRoute(src_node, dst_node)
+                                   : selectRoute(src_node, dst_node);
     if (route_dir == RouteDirection::INVALID) {
         if (output_) {
             output_->verbose(CALL_INFO, 1, 0, "⚠️ 无法路由消息: src=%d, dst=%d\n", src_node, dst_node);
@@ -215,8 +237,8 @@ bool OptimizedInternalRing::sendMessage(int src_node, int dst_node, const RingMe
     }
     
     // 选择虚拟通道
-    VirtualChannel* vc = src->selectOutputVC(route_dir, priority);
-    if (!vc) {
+    int vc_index = src->selectOutputVC(route_dir, priority);
+    if (vc_index < 0) {
         if (output_) {
             output_->verbose(CALL_INFO, 3, 0, "⚠️ 节点%d无可用VC，方向=%d，优先级=%d\n", 
                            src_node, static_cast<int>(route_dir), priority);
@@ -224,24 +246,23 @@ bool OptimizedInternalRing::sendMessage(int src_node, int dst_node, const RingMe
         return false;  // 背压：没有可用的VC
     }
     
-    // 创建带有路由信息的消息副本
-    RingMessage routed_msg = message;
+    // 消息写入消息槽（全程唯一一次复制），之后只传递句柄
+    RingHandle h = allocateSlot(message);
+    RingMessage& routed_msg = message_slots_[h];
     routed_msg.src_unit = src_node;
     routed_msg.dst_unit = dst_node;
-    routed_msg.timestamp = total_cycles_.load();
+    // 注入周期：调用方给出的周期较新时以其为准（所属组件时钟挂起期间环未推进）
+    routed_msg.timestamp = std::max(message.timestamp, total_cycles_.load());
     
-    // 将消息加入VC缓冲区
-    vc->buffer.push(routed_msg);
-    vc->consumeCredit();
-    vc->state = VCState::ACTIVE;
-    vc->last_activity_cycle = total_cycles_.load();
+    pushToVC(src, route_dir, vc_index, h);
+    if (route_dir != selectRoute(src_node, dst_node)) adaptive_detours_++;
     
     // 更新统计
     src->messages_injected++;
     
     if (output_) {
         output_->verbose(CALL_INFO, 4, 0, "📤 消息注入: 节点%d->%d, VC%d, 方向=%d\n",
-                        src_node, dst_node, vc->vc_id, static_cast<int>(route_dir));
+                        src_node, dst_node, vc_index, static_cast<int>(route_dir));
     }
     
     return true;
@@ -253,8 +274,10 @@ bool OptimizedInternalRing::receiveMessage(int node_id, RingMessage& message) {
         return false;
     }
     
-    message = node->ejection_queue.front();
+    RingHandle h = node->ejection_queue.front();
     node->ejection_queue.pop();
+    message = message_slots_[h];
+    releaseSlot(h);
     
     // 更新延迟统计
     uint64_t current_cycle = total_cycles_.load();
@@ -262,6 +285,7 @@ bool OptimizedInternalRing::receiveMessage(int node_id, RingMessage& message) {
         uint64_t latency = current_cycle - message.timestamp;
         node->total_latency_cycles += latency;
         total_latency_cycles_.fetch_add(latency);
+        message_latency_.add(latency);
     }
     
     if (output_) {
@@ -275,9 +299,11 @@ bool OptimizedInternalRing::receiveMessage(int node_id, RingMessage& message) {
 void OptimizedInternalRing::tick(uint64_t current_cycle) {
     total_cycles_.store(current_cycle);
     
-    // 处理每个节点的路由
-    for (int i = 0; i < num_nodes_; i++) {
-        processNodeRouting(i, current_cycle);
+    // 处理每个节点的路由（VC中没有消息时无需遍历）
+    if (vc_resident_ > 0) {
+        for (int i = 0; i < num_nodes_; i++) {
+            processNodeRouting(i, current_cycle);
+        }
     }
     
     // 定期更新统计信息
@@ -291,25 +317,63 @@ RouteDirection OptimizedInternalRing::selectRoute(int src, int dst) const {
     if (src == dst) {
         return RouteDirection::LOCAL;
     }
-    
-    // 检查缓存
-    uint64_t cache_key = generateRouteCacheKey(src, dst);
-    auto cache_it = route_lookup_cache_.find(cache_key);
-    if (cache_it != route_lookup_cache_.end()) {
-        return cache_it->second;
+    if (src < 0 || src >= num_nodes_ || dst < 0 || dst >= num_nodes_) {
+        return RouteDirection::INVALID;
+    }
+    return route_cache_[static_cast<size_t>(src) * num_nodes_ + dst];
+}
+
+RouteDirection OptimizedInternalRing::selectAdaptiveRoute(int src, int dst) const {
+    RouteDirection minimal = selectRoute(src, dst);
+    if (minimal == RouteDirection::LOCAL || minimal == RouteDirection::INVALID) {
+        return minimal;
     }
     
-    // 计算两个方向的跳数
-    int cw_hops = calculateHops(src, dst, RouteDirection::CLOCKWISE);
-    int ccw_hops = calculateHops(src, dst, RouteDirection::COUNTER_CLOCKWISE);
+    const RingNode* node = nodes_[src].get();
+    const int cw = static_cast<int>(RouteDirection::CLOCKWISE);
+    const int ccw = static_cast<int>(RouteDirection::COUNTER_CLOCKWISE);
     
-    // 选择跳数更少的方向，相等时优先选择顺时针
-    RouteDirection selected = (cw_hops <= ccw_hops) ? RouteDirection::CLOCKWISE : RouteDirection::COUNTER_CLOCKWISE;
+    // 以周期估计：每跳1周期，加上前两跳在该方向排队的消息按链路宽度折算的等待
+    uint64_t cw_cost = static_cast<uint64_t>(calculateHops(src, dst, RouteDirection::CLOCKWISE)) * flits_per_cycle_ +
+                       node->vc_occupancy[cw] + node->next_cw->vc_occupancy[cw];
+    uint64_t ccw_cost = static_cast<uint64_t>(calculateHops(src, dst, RouteDirection::COUNTER_CLOCKWISE)) * flits_per_cycle_ +
+                        node->vc_occupancy[ccw] + node->next_ccw->vc_occupancy[ccw];
     
-    // 缓存路由决策
-    route_lookup_cache_[cache_key] = selected;
+    RouteDirection chosen = minimal;
+    if (cw_cost < ccw_cost) {
+        chosen = RouteDirection::CLOCKWISE;
+    } else if (ccw_cost < cw_cost) {
+        chosen = RouteDirection::COUNTER_CLOCKWISE;
+    }
     
-    return selected;
+    // 选中方向在源节点已无空间时，另一方向有空间则改走另一方向，避免注入背压
+    RouteDirection other = (chosen == RouteDirection::CLOCKWISE) ? RouteDirection::COUNTER_CLOCKWISE
+                                                                 : RouteDirection::CLOCKWISE;
+    if (!node->vc_space_mask[static_cast<int>(chosen)] && node->vc_space_mask[static_cast<int>(other)]) {
+        chosen = other;
+    }
+    return chosen;
+}
+
+void OptimizedInternalRing::pushToVC(RingNode* node, RouteDirection direction, int vc_index, RingHandle handle) {
+    VirtualChannel& vc = (*node->vcsFor(direction))[vc_index];
+    vc.buffer.push(handle);
+    vc.consumeCredit();
+    node->vc_occupancy[static_cast<int>(direction)]++;
+    slot_enqueue_cycle_[handle] = total_cycles_.load();
+    vc.state = VCState::ACTIVE;
+    vc.last_activity_cycle = total_cycles_.load();
+    node->refreshVC(direction, vc_index);
+    vc_resident_++;
+}
+
+void OptimizedInternalRing::popFromVC(RingNode* node, RouteDirection direction, int vc_index) {
+    VirtualChannel& vc = (*node->vcsFor(direction))[vc_index];
+    vc.buffer.pop();
+    node->vc_occupancy[static_cast<int>(direction)]--;
+    vc.returnCredit();
+    node->refreshVC(direction, vc_index);
+    vc_resident_--;
 }
 
 int OptimizedInternalRing::calculateHops(int src, int dst, RouteDirection direction) const {
@@ -347,59 +411,83 @@ void OptimizedInternalRing::processNodeRouting(int node_id, uint64_t current_cyc
 }
 
 void OptimizedInternalRing::processDirectionVCs(RingNode* node, RouteDirection direction, uint64_t current_cycle) {
-    std::vector<VirtualChannel>& vcs = getVCs(node, direction);
-    
-    // VC仲裁：选择一个VC进行服务
-    int selected_vc = vcArbitration(vcs);
-    if (selected_vc == -1) return;  // 没有可服务的VC
-    
-    VirtualChannel& vc = vcs[selected_vc];
-    if (!vc.hasData()) return;
+    // VC仲裁：每周期最多服务flits_per_cycle_条消息，同一VC可连续服务
+    const int d = static_cast<int>(direction);
+    uint64_t candidates = node->vc_data_mask[d];
+    int served = 0;
+    while (candidates && served < flits_per_cycle_) {
+        int vc_index = vcArbitration(node, direction, candidates);
+        if (serveVC(node, direction, vc_index, current_cycle)) {
+            served++;
+            candidates &= node->vc_data_mask[d];
+            continue;
+        }
+        // 队首阻塞：MINIMAL模式下该方向本周期停止；ADAPTIVE模式绕过该VC继续服务其他VC
+        if (routing_mode_ != RingRoutingMode::ADAPTIVE) break;
+        candidates &= ~(1ULL << vc_index);
+    }
+}
+
+bool OptimizedInternalRing::serveVC(RingNode* node, RouteDirection direction, int vc_index, uint64_t current_cycle) {
+    VirtualChannel& vc = (*node->vcsFor(direction))[vc_index];
+    RingHandle h = vc.buffer.front();
+    const RingMessage& msg = message_slots_[h];
     
-    RingMessage& msg = vc.buffer.front();
+    // 每周期最多前进一跳：本周期刚到达的消息下个周期才可离开
+    // （否则按节点编号顺序处理时，顺时针消息会在一个周期内连续穿过多个节点）
+    const uint64_t entered = slot_enqueue_cycle_[h];
+    if (entered >= current_cycle) return false;
     
     // 检查是否到达目标
     if (msg.dst_unit == node->node_id) {
+        // 弹出队列已满时保留在VC中，下个周期重试
+        if (node->ejection_queue.full()) return false;
+        
         // 消息到达目标，弹出到本地
-        node->ejection_queue.push(msg);
-        vc.buffer.pop();
-        vc.returnCredit();
+        popFromVC(node, direction, vc_index);
+        hop_latency_.add(current_cycle - entered);
+        node->ejection_queue.push(h);
         node->messages_ejected++;
         
         if (output_) {
             output_->verbose(CALL_INFO, 4, 0, "🎯 消息到达目标: 节点%d\n", node->node_id);
         }
-        return;
+        return true;
     }
     
-    // 需要继续转发，确定下一跳方向
-    RouteDirection next_dir = selectRoute(node->node_id, msg.dst_unit);
+    // 需要继续转发：自适应路由在注入时已选定方向，之后沿同方向前进；
+    // 最短路径路由在途中重新查表（结果与注入方向一致）
+    RouteDirection next_dir = (routing_mode_ == RingRoutingMode::ADAPTIVE)
+                                  ? direction
+                                  : selectRoute(node->node_id, msg.dst_unit);
     if (next_dir == RouteDirection::INVALID) {
         // 路由失败，丢弃消息
-        vc.buffer.pop();
-        vc.returnCredit();
         if (output_) {
             output_->verbose(CALL_INFO, 1, 0, "⚠️ 路由失败，丢弃消息: 当前节点%d, 目标%d\n", 
                            node->node_id, msg.dst_unit);
         }
-        return;
+        popFromVC(node, direction, vc_index);
+        releaseSlot(h);
+        return true;
     }
     
     // 转发消息
-    if (forwardMessage(node, msg, next_dir)) {
-        vc.buffer.pop();
-        vc.returnCredit();
+    if (forwardMessage(node, h, next_dir)) {
+        popFromVC(node, direction, vc_index);
+        hop_latency_.add(current_cycle - entered);
         node->messages_forwarded++;
         
         if (output_) {
             output_->verbose(CALL_INFO, 4, 0, "🔄 消息转发: 节点%d, 方向=%d\n", 
                            node->node_id, static_cast<int>(next_dir));
         }
+        return true;
     }
     // 如果转发失败，消息保留在当前VC中等待下个周期
+    return false;
 }
 
-bool OptimizedInternalRing::forwardMessage(RingNode* node, const RingMessage& message, RouteDirection direction) {
+bool OptimizedInternalRing::forwardMessage(RingNode* node, RingHandle handle, RouteDirection direction) {
     RingNode* next_node = nullptr;
     
     switch (direction) {
@@ -411,7 +499,8 @@ bool OptimizedInternalRing::forwardMessage(RingNode* node, const RingMessage& me
             break;
         case RouteDirection::LOCAL:
             // 本地消息，直接加入弹出队列
-            node->ejection_queue.push(message);
+            if (node->ejection_queue.full()) return false;
+            node->ejection_queue.push(handle);
             return true;
         default:
             return false;
@@ -419,40 +508,29 @@ bool OptimizedInternalRing::forwardMessage(RingNode* node, const RingMessage& me
     
     if (!next_node) return false;
     
+    int priority = message_slots_[handle].priority;
+    
     // 检查下一个节点是否能接受消息
-    if (!next_node->canAcceptMessage(direction, message.priority)) {
+    if (!next_node->canAcceptMessage(direction, priority)) {
         return false;  // 背压：下一节点无法接受
     }
     
     // 选择下一节点的虚拟通道
-    VirtualChannel* next_vc = next_node->selectOutputVC(direction, message.priority);
-    if (!next_vc) {
+    int next_vc = next_node->selectOutputVC(direction, priority);
+    if (next_vc < 0) {
         return false;  // 没有可用的VC
     }
     
-    // 转发消息
-    next_vc->buffer.push(message);
-    next_vc->consumeCredit();
-    next_vc->state = VCState::ACTIVE;
-    next_vc->last_activity_cycle = total_cycles_.load();
-    
+    // 转发句柄
+    pushToVC(next_node, direction, next_vc, handle);
     return true;
 }
 
-int OptimizedInternalRing::vcArbitration(const std::vector<VirtualChannel>& vcs) const {
-    // 轮询仲裁：优先服务优先级高且有数据的VC
-    int best_vc = -1;
-    int highest_priority = std::numeric_limits<int>::max();
-    
-    for (size_t i = 0; i < vcs.size(); i++) {
-        const VirtualChannel& vc = vcs[i];
-        if (vc.hasData() && vc.priority < highest_priority) {
-            highest_priority = vc.priority;
-            best_vc = static_cast<int>(i);
-        }
-    }
-    
-    return best_vc;
+int OptimizedInternalRing::vcArbitration(const RingNode* node, RouteDirection direction, uint64_t candidates) const {
+    // 优先服务优先级最高（下标最小）且有数据的VC
+    if (direction == RouteDirection::INVALID) return -1;
+    uint64_t data = node->vc_data_mask[static_cast<int>(direction)] & candidates;
+    return data ? __builtin_ctzll(data) : -1;
 }
 
 std::vector<VirtualChannel>& OptimizedInternalRing::getVCs(RingNode* node, RouteDirection direction) {
@@ -491,31 +569,6 @@ bool OptimizedInternalRing::hasTrafficForNode(int node_id) const {
     return !node->ejection_queue.empty();
 }
 
-int OptimizedInternalRing::getPendingMessageCount() const {
-    int total = 0;
-    
-    for (const auto& node_ptr : nodes_) {
-        const RingNode* node = node_ptr.get();
-        
-        // 计算所有VC中的消息
-        for (const auto& vc : node->cw_vcs) {
-            total += static_cast<int>(vc.buffer.size());
-        }
-        for (const auto& vc : node->ccw_vcs) {
-            total += static_cast<int>(vc.buffer.size());
-        }
-        for (const auto& vc : node->local_vcs) {
-            total += static_cast<int>(vc.buffer.size());
-        }
-        
-        // 计算注入和弹出队列
-        total += static_cast<int>(node->injection_queue.size());
-        total += static_cast<int>(node->ejection_queue.size());
-    }
-    
-    return total;
-}
-
 double OptimizedInternalRing::getAverageLatency() const {
     uint64_t total_msgs = total_messages_routed_.load();
     uint64_t total_lat = total_latency_cycles_.load();
@@ -679,6 +732,7 @@ void OptimizedInternalRing::updateCredit(int node_id, RouteDirection direction,
     } else {
         vcs[vc_id].consumeCredit();
     }
+    node->refreshVC(direction, vc_id);
 }
 
 void OptimizedInternalRing::getNodeStatistics(int node_id, uint64_t& injected, uint64_t& ejected, 
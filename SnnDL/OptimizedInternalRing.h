@@ -13,7 +13,6 @@
 #include <queue>
 #include <atomic>
 #include <memory>
-#include <unordered_map>
 #include <cstdint>
 
 #include "SpikeEvent.h"
@@ -88,6 +87,46 @@ enum class RouteDirection {
     INVALID             // 无效路由
 };
 
+/**
+ * @brief 注入时的方向选择策略
+ */
+enum class RingRoutingMode {
+    MINIMAL,    // 最短路径，跳数相等时顺时针
+    ADAPTIVE    // 按两个方向的缓冲占用估算排队延迟选择方向，并允许绕过阻塞的VC
+};
+
+/**
+ * @brief 以2为底的对数分桶延迟直方图
+ *
+ * 桶0记录0周期，桶k记录[2^(k-1), 2^k)周期，最后一个桶收纳其余更大的值。
+ */
+struct LatencyHistogram {
+    static constexpr int NUM_BUCKETS = 16;
+
+    uint64_t counts[NUM_BUCKETS] = {0};
+    uint64_t samples = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+    static int bucketOf(uint64_t cycles) {
+        if (cycles == 0) return 0;
+        int bucket = 64 - __builtin_clzll(cycles);
+        return bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1;
+    }
+    /** 桶k的下界（周期） */
+    static uint64_t bucketLow(int bucket) { return bucket == 0 ? 0 : (1ULL << (bucket - 1)); }
+
+    void add(uint64_t cycles) {
+        counts[bucketOf(cycles)]++;
+        samples++;
+        sum += cycles;
+        if (cycles > max) max = cycles;
+    }
+    double mean() const { return samples ? static_cast<double>(sum) / samples : 0.0; }
+    /** 分位数所在桶的下界 */
+    uint64_t percentileLow(double q) const;
+};
+
 /**
  * @brief 虚拟通道状态
  */
@@ -98,6 +137,42 @@ enum class VCState {
     ACTIVE      // 活跃传输
 };
 
+/** 环内消息句柄：消息槽数组中的下标 */
+using RingHandle = uint32_t;
+static constexpr RingHandle INVALID_RING_HANDLE = ~static_cast<RingHandle>(0);
+
+/**
+ * @brief 定长句柄环形缓冲区
+ *
+ * 容量在初始化时一次性分配，入队/出队只移动下标，不分配内存。
+ */
+struct HandleRing {
+    std::vector<RingHandle> slots;
+    uint32_t head = 0;
+    uint32_t count = 0;
+
+    void reset(uint32_t capacity) {
+        slots.assign(capacity, INVALID_RING_HANDLE);
+        head = 0;
+        count = 0;
+    }
+    uint32_t capacity() const { return static_cast<uint32_t>(slots.size()); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count >= slots.size(); }
+    RingHandle front() const { return slots[head]; }
+    void push(RingHandle h) {
+        uint32_t tail = head + count;
+        if (tail >= slots.size()) tail -= static_cast<uint32_t>(slots.size());
+        slots[tail] = h;
+        count++;
+    }
+    void pop() {
+        if (++head == slots.size()) head = 0;
+        count--;
+    }
+};
+
 /**
  * @brief 虚拟通道结构
  */
@@ -105,16 +180,18 @@ struct VirtualChannel {
     int vc_id;                              ///< 虚拟通道ID
     int priority;                           ///< 优先级 (0=最高)
     VCState state;                          ///< 当前状态
-    std::queue<RingMessage> buffer;         ///< 消息缓冲区
+    HandleRing buffer;                      ///< 消息句柄缓冲区（容量=max_credits）
     uint32_t credits;                       ///< 信用计数
     uint32_t max_credits;                   ///< 最大信用数
     uint64_t last_activity_cycle;           ///< 最后活动周期
     
     VirtualChannel(int id = 0, int prio = 0, uint32_t max_cred = 8) 
         : vc_id(id), priority(prio), state(VCState::IDLE), 
-          credits(max_cred), max_credits(max_cred), last_activity_cycle(0) {}
+          credits(max_cred), max_credits(max_cred), last_activity_cycle(0) {
+        buffer.reset(max_cred);
+    }
     
-    bool hasSpace() const { return credits > 0 && buffer.size() < max_credits; }
+    bool hasSpace() const { return credits > 0 && !buffer.full(); }
     bool hasData() const { return !buffer.empty(); }
     void consumeCredit() { if (credits > 0) credits--; }
     void returnCredit() { if (credits < max_credits) credits++; }
@@ -124,6 +201,9 @@ struct VirtualChannel {
  * @brief 环形网络节点
  */
 struct RingNode {
+    /** 每个方向最多支持的虚拟通道数（占用掩码的位宽） */
+    static constexpr int MAX_VCS = 64;
+
     int node_id;                                        ///< 节点ID
     
     // 物理连接
@@ -137,9 +217,13 @@ struct RingNode {
     std::vector<VirtualChannel> ccw_vcs;                ///< 逆时针虚拟通道
     std::vector<VirtualChannel> local_vcs;              ///< 本地注入/弹出通道
     
-    // 输入输出缓冲区
-    std::queue<RingMessage> injection_queue;           ///< 注入队列
-    std::queue<RingMessage> ejection_queue;            ///< 弹出队列
+    // 按方向（CLOCKWISE/COUNTER_CLOCKWISE/LOCAL）维护的VC占用位图，第i位对应VC i
+    uint64_t vc_data_mask[3];                           ///< 非空VC
+    uint64_t vc_space_mask[3];                          ///< 可接收消息的VC
+    uint32_t vc_occupancy[3];                           ///< 各方向VC中缓冲的消息总数（自适应路由的拥塞估计）
+    
+    // 弹出缓冲区
+    HandleRing ejection_queue;                          ///< 弹出队列（定长）
     
     // 统计信息
     uint64_t messages_forwarded;                        ///< 转发消息数
@@ -149,12 +233,24 @@ struct RingNode {
     
     RingNode(int id = 0) : node_id(id), next_cw(nullptr), prev_cw(nullptr),
                           next_ccw(nullptr), prev_ccw(nullptr),
+                          vc_data_mask{0, 0, 0}, vc_space_mask{0, 0, 0}, vc_occupancy{0, 0, 0},
                           messages_forwarded(0), messages_injected(0), 
                           messages_ejected(0), total_latency_cycles(0) {}
                           
-    void initializeVCs(int num_vcs_per_direction, uint32_t credits_per_vc);
-    VirtualChannel* selectOutputVC(RouteDirection direction, int priority);
+    void initializeVCs(int num_vcs_per_direction, uint32_t credits_per_vc, uint32_t ejection_capacity);
+    
+    /**
+     * @brief 选择可接收消息的输出VC
+     * @return VC下标，-1表示没有可用VC
+     */
+    int selectOutputVC(RouteDirection direction, int priority) const;
     bool canAcceptMessage(RouteDirection direction, int priority) const;
+    
+    /**
+     * @brief 按VC当前状态刷新占用位图
+     */
+    void refreshVC(RouteDirection direction, int vc_index);
+    std::vector<VirtualChannel>* vcsFor(RouteDirection direction);
 };
 
 /**
@@ -163,10 +259,13 @@ struct RingNode {
  * 主要优化特性：
  * 1. 真正的双向环形拓扑
  * 2. 多虚拟通道支持，避免死锁
- * 3. 自适应路由算法
+ * 3. 自适应路由算法：ADAPTIVE模式下按源节点与第一跳节点的缓冲占用选择注入方向，
+ *    注入后方向固定（不会在环上来回折返），阻塞的VC不妨碍同方向其他VC前进
  * 4. 基于信用的流控制
  * 5. 优先级调度
- * 6. 零拷贝消息传递
+ * 6. 每个方向每周期可转发flits_per_cycle条消息（链路宽度）
+ * 7. 零拷贝消息传递：消息在注入时写入预分配的消息槽，VC与弹出队列
+ *    只传递槽句柄，路由过程不复制消息、不分配内存
  */
 class OptimizedInternalRing {
 public:
@@ -222,7 +321,23 @@ public:
      * @brief 获取网络中待处理消息总数
      * @return 消息总数
      */
-    int getPendingMessageCount() const;
+    int getPendingMessageCount() const {
+        return static_cast<int>(message_slots_.size() - free_slots_.size());
+    }
+    
+    // ===== 路由配置 =====
+    
+    /**
+     * @brief 设置注入方向选择策略
+     */
+    void setRoutingMode(RingRoutingMode mode) { routing_mode_ = mode; }
+    RingRoutingMode getRoutingMode() const { return routing_mode_; }
+    
+    /**
+     * @brief 设置每个方向每周期可转发的消息数（链路宽度，最小为1）
+     */
+    void setFlitsPerCycle(int flits) { flits_per_cycle_ = flits > 0 ? flits : 1; }
+    int getFlitsPerCycle() const { return flits_per_cycle_; }
     
     // ===== 路由算法 =====
     
@@ -234,6 +349,15 @@ public:
      */
     RouteDirection selectRoute(int src, int dst) const;
     
+    /**
+     * @brief 拥塞感知的注入方向选择
+     *
+     * 代价 = 跳数 + (源节点与第一跳节点在该方向的缓冲消息数) / 链路宽度，
+     * 即以周期估计的传输加排队延迟；代价相等时取最短路径方向。
+     * 选中方向在源节点无VC空间而另一方向有空间时改走另一方向。
+     */
+    RouteDirection selectAdaptiveRoute(int src, int dst) const;
+    
     /**
      * @brief 计算两节点间的跳数
      * @param src 源节点ID
@@ -287,6 +411,21 @@ public:
     void getNodeStatistics(int node_id, uint64_t& injected, uint64_t& ejected, 
                           uint64_t& forwarded, double& avg_latency) const;
     
+    /**
+     * @brief 每跳延迟直方图：消息在每个路由节点VC中停留的周期数
+     */
+    const LatencyHistogram& getHopLatencyHistogram() const { return hop_latency_; }
+    
+    /**
+     * @brief 端到端延迟直方图：注入到被接收的周期数
+     */
+    const LatencyHistogram& getMessageLatencyHistogram() const { return message_latency_; }
+    
+    /**
+     * @brief 自适应路由选择了非最短路径方向的注入次数
+     */
+    uint64_t getAdaptiveDetours() const { return adaptive_detours_; }
+    
     /**
      * @brief 获取虚拟通道利用率
      * @param node_id 节点ID
@@ -318,6 +457,8 @@ private:
     int num_vcs_;                                       ///< 每方向虚拟通道数
     uint32_t credits_per_vc_;                           ///< 每VC信用数
     SST::Output* output_;                               ///< 日志输出
+    RingRoutingMode routing_mode_;                      ///< 注入方向选择策略
+    int flits_per_cycle_;                               ///< 每方向每周期转发消息数
     
     // ===== 网络拓扑 =====
     std::vector<std::unique_ptr<RingNode>> nodes_;      ///< 网络节点数组
@@ -327,10 +468,16 @@ private:
     std::atomic<uint64_t> total_latency_cycles_{0};     ///< 总延迟周期
     std::atomic<uint64_t> total_cycles_{0};             ///< 总仿真周期
     uint64_t last_stats_cycle_;                         ///< 上次统计周期
+    LatencyHistogram hop_latency_;                      ///< 每跳停留周期
+    LatencyHistogram message_latency_;                  ///< 端到端延迟
+    uint64_t adaptive_detours_;                         ///< 非最短路径注入次数
     
     // ===== 性能优化 =====
-    std::vector<uint32_t> route_cache_;                 ///< 路由缓存
-    mutable std::unordered_map<uint64_t, RouteDirection> route_lookup_cache_; ///< 路由查找缓存
+    std::vector<RouteDirection> route_cache_;           ///< 预计算的路由表 [src*N+dst]
+    std::vector<RingMessage> message_slots_;            ///< 预分配的消息槽
+    std::vector<RingHandle> free_slots_;                ///< 空闲消息槽句柄栈
+    std::vector<uint64_t> slot_enqueue_cycle_;          ///< 消息进入当前VC的周期 [handle]，用于每跳计时
+    uint64_t vc_resident_;                              ///< 驻留在VC中的消息数（为0时跳过路由）
     
     // ===== 内部方法 =====
     
@@ -354,6 +501,12 @@ private:
      */
     void processDirectionVCs(RingNode* node, RouteDirection direction, uint64_t current_cycle);
     
+    /**
+     * @brief 尝试让指定VC的队首消息离开（弹出到本地或转发到下一跳）
+     * @return 队首消息是否已离开该VC
+     */
+    bool serveVC(RingNode* node, RouteDirection direction, int vc_index, uint64_t current_cycle);
+    
     /**
      * @brief 处理注入队列
      * @param node 节点指针
@@ -364,18 +517,38 @@ private:
     /**
      * @brief 在指定方向转发消息
      * @param node RingNode指针
-     * @param message 消息
+     * @param handle 消息句柄
      * @param direction 转发方向
      * @return 是否成功转发
      */
-    bool forwardMessage(RingNode* node, const RingMessage& message, RouteDirection direction);
+    bool forwardMessage(RingNode* node, RingHandle handle, RouteDirection direction);
+    
+    /**
+     * @brief 将消息句柄放入节点指定方向的VC
+     */
+    void pushToVC(RingNode* node, RouteDirection direction, int vc_index, RingHandle handle);
+    
+    /**
+     * @brief 弹出节点指定方向VC的队首句柄
+     */
+    void popFromVC(RingNode* node, RouteDirection direction, int vc_index);
+    
+    RingHandle allocateSlot(const RingMessage& message) {
+        RingHandle h = free_slots_.back();
+        free_slots_.pop_back();
+        message_slots_[h] = message;
+        return h;
+    }
+    void releaseSlot(RingHandle h) { free_slots_.push_back(h); }
     
     /**
      * @brief VC仲裁器 - 选择下一个服务的VC
-     * @param vcs 虚拟通道数组
+     * @param node 节点指针
+     * @param direction 方向
+     * @param candidates 本轮仍可参与仲裁的VC位图（已绕过的阻塞VC被清除）
      * @return 选中的VC索引，-1表示无可用VC
      */
-    int vcArbitration(const std::vector<VirtualChannel>& vcs) const;
+    int vcArbitration(const RingNode* node, RouteDirection direction, uint64_t candidates) const;
     
     /**
      * @brief 交换机仲裁器 - 处理多个VC竞争同一输出端口
@@ -391,16 +564,6 @@ private:
      */
     void updateStatistics(uint64_t current_cycle);
     
-    /**
-     * @brief 生成路由缓存键
-     * @param src 源节点
-     * @param dst 目标节点
-     * @return 缓存键
-     */
-    uint64_t generateRouteCacheKey(int src, int dst) const {
-        return (static_cast<uint64_t>(src) << 32) | static_cast<uint64_t>(dst);
-    }
-    
     /**
      * @brief 获取节点指针（带边界检查）
      * @param node_id 节点ID
@@ -10,7 +10,9 @@
 #include <sst/core/params.h>
 #include <sst/core/link.h>
 #include <map>
+#include <vector>
 
+#include "CoreCounters.h"
 #include "SpikeEvent.h"
 #include "SnnPEParentInterface.h"
 
@@ -39,6 +41,15 @@ public:
     virtual double getUtilization() const = 0;
     // 可选：设置内存连接，默认空实现，具体实现可覆盖
     virtual void setMemoryLink(SST::Link* /*link*/) {}
+    // 可选：将各神经元（PE内本地ID）的发放次数累加到counts，默认不提供
+    virtual void getFiringCounts(std::vector<uint64_t>& /*counts*/) const {}
+    // 可选：热路径计数器块，父组件缓存该指针后直接读取；返回nullptr时回退到getStatistics
+    virtual const CoreCounters* getCounters() const { return nullptr; }
+    // 可选：导出warm start所需的核心状态（写入StateSnapshot的核心段），不支持时返回false；
+    // 读回由实现在构造时按 warm_start_file 参数自行完成
+    virtual bool saveState(std::vector<uint8_t>& /*state*/) { return false; }
+    // 可选：批量推理的样本边界，神经元状态复位到静息；权重缓存与连接表保留
+    virtual void resetState() {}
 
 protected:
     // 提供构造函数以便派生类在初始化列表中正确调用
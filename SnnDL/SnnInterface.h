@@ -13,6 +13,7 @@
 #include <functional>
 #include <string>
 #include "SpikeEvent.h"
+#include "SpikeRecorder.h"
 
 namespace SST {
 namespace SnnDL {
@@ -82,6 +83,18 @@ public:
      * @return 状态字符串
      */
     virtual std::string getNetworkStatus() const = 0;
+
+    /**
+     * @brief 发送队列是否还能接收脉冲（背压）
+     * @return false表示有界发送队列已满，调用者应暂缓发送；默认不限
+     */
+    virtual bool canSend() const { return true; }
+
+    /**
+     * @brief 设置流量记录器（父组件启用record_file时调用）
+     * @param recorder 收发时按 (对端节点, 链路, VC) 累计流量；nullptr表示不记录
+     */
+    virtual void setRecorder(SpikeRecorder* /*recorder*/) {}
 };
 
 } // namespace SnnDL
@@ -6,6 +6,7 @@
 //
 
 #include "SnnNIC.h"
+#include "SnnTrace.h"
 #include <sst/core/serialization/serialize.h>
 
 using namespace SST;
@@ -22,7 +23,13 @@ SnnNIC::SnnNIC(ComponentId_t id, Params& params)
       spikes_received_count(0),
       packets_sent_count(0),
       packets_received_count(0),
-      use_direct_link(false)
+      use_direct_link(false),
+      enable_bundling(false),
+      bundle_tc(nullptr),
+      bundle_clock_handler(nullptr),
+      bundle_clock_active(false),
+      bundle_cycle(0),
+      bundles_sent_count(0)
 {
     // 获取参数
     node_id = params.find<uint32_t>("node_id", 0);
@@ -101,12 +108,34 @@ SnnNIC::SnnNIC(ComponentId_t id, Params& params)
     stat_spikes_received = registerStatistic<uint64_t>("spikes_received");
     stat_packets_sent = registerStatistic<uint64_t>("packets_sent");
     stat_packets_received = registerStatistic<uint64_t>("packets_received");
+    stat_bundles_sent = registerStatistic<uint64_t>("bundles_sent");
+    stat_bundle_size = registerStatistic<uint64_t>("bundle_size");
+    stat_bundle_flush_count = registerStatistic<uint64_t>("bundle_flush_count");
+    stat_bundle_flush_size = registerStatistic<uint64_t>("bundle_flush_size");
+    stat_bundle_flush_window = registerStatistic<uint64_t>("bundle_flush_window");
+    stat_send_queue_depth = registerStatistic<uint64_t>("send_queue_depth");
+    stat_spikes_dropped = registerStatistic<uint64_t>("spikes_dropped");
+    send_queue_depth = params.find<uint32_t>("send_queue_depth", 256);
+    
+    // 脉冲聚合仅用于SimpleNetwork模式；窗口计时时钟在有打开的包时才注册
+    compact_wire_format = params.find<bool>("compact_wire_format", false);
+    enable_bundling = !use_direct_link && params.find<bool>("enable_spike_bundling", false);
+    if (enable_bundling) {
+        bundler.configure(params.find<uint32_t>("bundle_max_spikes", 32),
+                          params.find<uint64_t>("bundle_window_cycles", 4),
+                          params.find<uint32_t>("bundle_packet_size", 256));
+        bundle_clock_handler = new Clock::Handler2<SnnNIC,&SnnNIC::bundleClockTick>(this);
+        bundle_tc = registerClock(params.find<std::string>("bundle_clock", "1GHz"), bundle_clock_handler);
+        bundle_clock_active = true;
+    }
     
     // output->verbose(CALL_INFO, 1, 0, "SnnNIC初始化完成\n");
 }
 
 SnnNIC::~SnnNIC()
 {
+    for (SpikeBundle* bundle : pending_bundles) delete bundle;
+
     if (output) {
         delete output;
         output = nullptr;
@@ -132,7 +161,7 @@ void SnnNIC::sendSpike(SpikeEvent* spike_event)
     uint32_t source_neuron = spike_event->getNeuronId();
     uint32_t dest_neuron = spike_event->getDestinationNeuron();
     if (dest_node == node_id && source_neuron == dest_neuron) {
-        output->verbose(CALL_INFO, 3, 0, "本地脉冲直接传递：神经元%u -> 神经元%u (同节点同神经元)\n",
+        SNNDL_TRACE(output, 3, 0, "本地脉冲直接传递：神经元%u -> 神经元%u (同节点同神经元)\n",
                        source_neuron, dest_neuron);
 
         // 直接调用本地处理器
@@ -149,8 +178,10 @@ void SnnNIC::sendSpike(SpikeEvent* spike_event)
         
         // 创建包装的SpikeEvent用于网络传输
         SpikeEvent* network_spike = new SpikeEvent(*spike_event);  // 复制构造
+        network_spike->setCompactWire(compact_wire_format);
         
         // 直接通过Link发送
+        recordTraffic(SpikeRecorder::TrafficKind::NET_TX, node_id, dest_node, 0, 1, network_spike->wireBytes() * 8);
         direct_link->send(network_spike);
         
         spikes_sent_count++;
@@ -160,6 +191,12 @@ void SnnNIC::sendSpike(SpikeEvent* spike_event)
         
         // output->verbose(CALL_INFO, 3, 0, "直接Link发送成功\n");
         
+    } else if (enable_bundling && network) {
+        // 聚合模式：按目标节点缓存，达到数量/大小上限或窗口到期时整包发送
+        wakeBundleClock();
+        bundler.add(spike_event, bundle_cycle);
+        dispatchReadyBundles();
+        
     } else if (!use_direct_link && network) {
         // 使用SimpleNetwork模式发送脉冲
         
@@ -177,21 +214,26 @@ void SnnNIC::sendSpike(SpikeEvent* spike_event)
             return;
         }
         
-        // 按照MemNIC模式：先检查空间，再发送
-        if (network->spaceToSend(0, req->size_in_bits) && network->send(req, 0)) {
+        // 按照MemNIC模式：先检查空间，再发送（成功后载荷归网络所有，先记下日志字段）
+        // 已有积压时排在其后，避免乱序
+        uint32_t neuron_id = spike_event->getNeuronId();
+        size_t bits = req->size_in_bits;
+        if (pending_spikes.empty() && network->spaceToSend(0, req->size_in_bits) && network->send(req, 0)) {
             // 发送成功
+            recordTraffic(SpikeRecorder::TrafficKind::NET_TX, node_id, dest_node, 0, 1, bits);
             spikes_sent_count++;
             packets_sent_count++;
             stat_spikes_sent->addData(1);
             stat_packets_sent->addData(1);
             
             output->verbose(CALL_INFO, 1, 0, "发送脉冲成功：节点%u -> 节点%u，神经元%u (vn=0)\n",
-                           node_id, dest_node, spike_event->getNeuronId());
+                           node_id, dest_node, neuron_id);
         } else {
             // 发送失败 - 添加到待发送队列，稍后重试
             output->verbose(CALL_INFO, 1, 0, "网络发送失败（空间不足），添加到待发送队列 (vn=0)\n");
-            pending_spikes.push(spike_event);
-            delete req; // 清理请求对象，因为没有发送成功
+            req->takePayload(); // 取回载荷，避免随请求一同释放
+            delete req;
+            enqueuePending(spike_event);
         }
     } else {
         output->verbose(CALL_INFO, 1, 0, "发送脉冲失败：无可用网络接口\n");
@@ -218,9 +260,30 @@ std::string SnnNIC::getNetworkStatus() const
     ss << ", 发送包=" << packets_sent_count;
     ss << ", 接收包=" << packets_received_count;
     ss << ", 待发送=" << pending_spikes.size();
+    if (spikes_dropped_count > 0) ss << ", 丢弃=" << spikes_dropped_count;
     return ss.str();
 }
 
+bool SnnNIC::canSend() const
+{
+    if (use_direct_link || send_queue_depth == 0) return true;
+    return queuedCount() < send_queue_depth;
+}
+
+void SnnNIC::enqueuePending(SpikeEvent* spike_event)
+{
+    if (send_queue_depth > 0 && queuedCount() >= send_queue_depth) {
+        output->verbose(CALL_INFO, 2, 0, "待发送队列已满(%u)，丢弃脉冲：神经元%u -> 节点%u\n",
+                        send_queue_depth, spike_event->getNeuronId(), spike_event->getDestinationNode());
+        spikes_dropped_count++;
+        stat_spikes_dropped->addData(1);
+        delete spike_event;
+        return;
+    }
+    pending_spikes.push(spike_event);
+    stat_send_queue_depth->addData(queuedCount());
+}
+
 bool SnnNIC::handleIncoming(int vn)
 {
     SimpleNetwork::Request* req = network->recv(vn);
@@ -230,14 +293,35 @@ bool SnnNIC::handleIncoming(int vn)
     
     packets_received_count++;  // 更新内部计数器
     stat_packets_received->addData(1);
+    SpikeBundle* bundle = dynamic_cast<SpikeBundle*>(req->inspectPayload());
+    recordTraffic(SpikeRecorder::TrafficKind::NET_RX, static_cast<uint32_t>(req->src), node_id, vn,
+                  bundle ? bundle->getSpikeCount() : 1, req->size_in_bits);
     
-    output->verbose(CALL_INFO, 3, 0, "接收网络数据包：VN=%d，来源=%ld，目标=%ld\n",
+    SNNDL_TRACE(output, 3, 0, "接收网络数据包：VN=%d，来源=%ld，目标=%ld\n",
                    vn, req->src, req->dest);
     
+    // 聚合包：逐个还原脉冲并交给处理器
+    if (bundle) {
+        size_t target_offset = 0;
+        for (size_t i = 0; i < bundle->getSpikeCount(); i++) {
+            SpikeEvent* spike = bundle->unpackSpike(i, target_offset);
+            spikes_received_count++;
+            stat_spikes_received->addData(1);
+            if (spike_handler) {
+                spike_handler(spike);
+            } else {
+                delete spike;
+            }
+        }
+        SNNDL_TRACE(output, 4, 0, "解包聚合包：来源=%ld，脉冲数=%zu\n", req->src, bundle->getSpikeCount());
+        delete req;
+        return true;
+    }
+    
     // 提取并处理脉冲事件
     SpikeEvent* spike_event = extractSpikeEvent(req);
     if (spike_event && spike_handler) {
-        output->verbose(CALL_INFO, 4, 0, "提取到脉冲事件：源神经元=%u，目标神经元=%u\n",
+        SNNDL_TRACE(output, 4, 0, "提取到脉冲事件：源神经元=%u，目标神经元=%u\n",
                        spike_event->neuron_id, spike_event->getDestinationNeuron());
         
         stat_spikes_received->addData(1);
@@ -250,7 +334,7 @@ bool SnnNIC::handleIncoming(int vn)
 
 bool SnnNIC::spaceAvailable(int vn)
 {
-    output->verbose(CALL_INFO, 5, 0, "网络发送空间可用：VN=%d\n", vn);
+    SNNDL_TRACE(output, 5, 0, "网络发送空间可用：VN=%d\n", vn);
     
     // 检查网络接口是否有效
     if (!network) {
@@ -258,24 +342,37 @@ bool SnnNIC::spaceAvailable(int vn)
         return true;
     }
     
-    // 处理待发送队列中的脉冲（如果有的话）
+    // 先发送积压的聚合包，保持发送顺序
+    while (!pending_bundles.empty()) {
+        if (!sendBundle(pending_bundles.front())) break;
+        pending_bundles.pop_front();
+    }
+    
+    // 处理待发送队列中的脉冲（如果有的话），发送成功才出队以保持顺序
     while (!pending_spikes.empty() && network->spaceToSend(vn, 1)) {
         SpikeEvent* spike = pending_spikes.front();
-        pending_spikes.pop();
         
         // 获取目标节点ID
         uint32_t dest_node = spike->getDestinationNode();
         SimpleNetwork::Request* req = createNetworkRequest(spike, dest_node);
         
         // 使用相同的双重检查模式
+        size_t bits = req ? req->size_in_bits : 0;
         if (req && network->spaceToSend(vn, req->size_in_bits) && network->send(req, vn)) {
-            output->verbose(CALL_INFO, 4, 0, "发送延迟的脉冲事件成功：节点%u -> 节点%u\n", node_id, dest_node);
+            recordTraffic(SpikeRecorder::TrafficKind::NET_TX, node_id, dest_node, vn, 1, bits);
+            SNNDL_TRACE(output, 4, 0, "发送延迟的脉冲事件成功：节点%u -> 节点%u\n", node_id, dest_node);
+            pending_spikes.pop();
+            spikes_sent_count++;
+            packets_sent_count++;
             stat_spikes_sent->addData(1);
             stat_packets_sent->addData(1);
+        } else if (!req) {
+            pending_spikes.pop();
+            delete spike;
         } else {
-            // 如果仍然无法发送，重新加入队列
-            pending_spikes.push(spike);
-            if (req) delete req; // 清理请求对象
+            // 仍然无法发送，留在队首等待下次通知
+            req->takePayload(); // 取回载荷，避免随请求一同释放
+            delete req;
             break;
         }
     }
@@ -337,6 +434,12 @@ void SnnNIC::finish()
     output->output("  发送包: %lu\n", packets_sent_count);
     output->output("  接收包: %lu\n", packets_received_count);
     output->output("  待发送队列: %zu\n", pending_spikes.size());
+    if (spikes_dropped_count > 0) {
+        output->output("  队列满丢弃: %lu\n", spikes_dropped_count);
+    }
+    if (enable_bundling) {
+        output->output("  聚合包: 发送=%lu, 积压=%zu\n", bundles_sent_count, pending_bundles.size());
+    }
     output->output("  网络模式: %s\n", use_direct_link ? "直接Link" : "SimpleNetwork");
     
     // 清理待发送队列
@@ -350,56 +453,114 @@ void SnnNIC::finish()
     }
 }
 
-SimpleNetwork::Request* SnnNIC::createNetworkRequest(SpikeEvent* spike_event, uint32_t dest_node)
+bool SnnNIC::bundleClockTick(Cycle_t cycle)
 {
-    if (!spike_event) {
-        return nullptr;
-    }
+    bundle_cycle = cycle;
+    bundler.flushExpired(bundle_cycle);
+    dispatchReadyBundles();
     
-    // 创建可序列化的载荷事件
-    class SpikePayload : public SST::Event {
-    public:
-        uint32_t src_neuron_id;
-        uint32_t dest_neuron_id;
-        uint64_t timestamp;
-        float weight;
-        
-        SpikePayload() : SST::Event(), src_neuron_id(0), dest_neuron_id(0), timestamp(0), weight(0.0f) {}
+    if (!bundler.hasOpenBundles()) {
+        // 无打开的包时注销时钟，积压包由 spaceAvailable 回调继续发送
+        bundle_clock_active = false;
+        return true;
+    }
+    return false;
+}
+
+void SnnNIC::wakeBundleClock()
+{
+    if (bundle_clock_active) return;
+    bundle_clock_active = true;
+    bundle_cycle = reregisterClock(bundle_tc, bundle_clock_handler) - 1;
+}
+
+void SnnNIC::dispatchReadyBundles()
+{
+    auto& ready = bundler.ready();
+    while (!ready.empty()) {
+        SpikeBundler::ReadyBundle r = ready.front();
+        ready.pop_front();
         
-        SpikePayload(const SpikeEvent* spike) : SST::Event()
-        {
-            src_neuron_id = spike->neuron_id;
-            dest_neuron_id = spike->getDestinationNeuron();
-            timestamp = spike->timestamp;
-            weight = spike->getWeight();
+        stat_bundle_size->addData(r.bundle->getSpikeCount());
+        switch (r.reason) {
+            case SpikeBundler::FlushReason::COUNT:  stat_bundle_flush_count->addData(1); break;
+            case SpikeBundler::FlushReason::SIZE:   stat_bundle_flush_size->addData(1); break;
+            case SpikeBundler::FlushReason::WINDOW: stat_bundle_flush_window->addData(1); break;
         }
         
-        void serialize_order(SST::Core::Serialization::serializer& ser) override {
-            Event::serialize_order(ser);
-            SST_SER(src_neuron_id);
-            SST_SER(dest_neuron_id);
-            SST_SER(timestamp);
-            SST_SER(weight);
+        // 有积压时排在其后，避免乱序；积压已满时与单脉冲一样丢弃计数
+        if (pending_bundles.empty() && sendBundle(r.bundle)) continue;
+        if (send_queue_depth > 0 && queuedCount() >= send_queue_depth) {
+            output->verbose(CALL_INFO, 2, 0, "待发送队列已满(%u)，丢弃聚合包：%zu个脉冲 -> 节点%u\n",
+                            send_queue_depth, r.bundle->getSpikeCount(), r.bundle->getDestinationNode());
+            spikes_dropped_count += r.bundle->getSpikeCount();
+            stat_spikes_dropped->addData(r.bundle->getSpikeCount());
+            delete r.bundle;
+            continue;
         }
-        
-        ImplementSerializable(SpikePayload)
-    };
+        pending_bundles.push_back(r.bundle);
+        stat_send_queue_depth->addData(queuedCount());
+    }
+}
+
+bool SnnNIC::sendBundle(SpikeBundle* bundle)
+{
+    if (!network) return false;
+    
+    size_t bits = bundle->wireBytes() * 8;
+    if (!network->spaceToSend(0, bits)) return false;
     
-    // 创建网络请求
+    uint32_t dest_node = bundle->getDestinationNode();
     SimpleNetwork::Request* req = new SimpleNetwork::Request();
     req->dest = dest_node;
     req->src = node_id;
-    req->vn = 0; // 使用虚拟网络0
-    req->size_in_bits = sizeof(SpikePayload) * 8;
+    req->vn = 0;
+    req->size_in_bits = bits;
     req->head = true;
     req->tail = true;
     req->allow_adaptive = true;
+    size_t spikes = bundle->getSpikeCount();
+    req->givePayload(bundle);
+    
+    if (!network->send(req, 0)) {
+        // 发送失败时取回载荷，避免随请求一同释放
+        req->takePayload();
+        delete req;
+        return false;
+    }
+    
+    spikes_sent_count += spikes;
+    packets_sent_count++;
+    bundles_sent_count++;
+    recordTraffic(SpikeRecorder::TrafficKind::NET_TX, node_id, dest_node, 0, spikes, bits);
+    stat_spikes_sent->addDataNTimes(spikes, 1);
+    stat_packets_sent->addData(1);
+    stat_bundles_sent->addData(1);
+    SNNDL_TRACE(output, 3, 0, "发送聚合包：节点%u -> 节点%u，脉冲数=%zu，%zu bits\n",
+                   node_id, dest_node, spikes, bits);
+    return true;
+}
+
+SimpleNetwork::Request* SnnNIC::createNetworkRequest(SpikeEvent* spike_event, uint32_t dest_node)
+{
+    if (!spike_event) {
+        return nullptr;
+    }
     
-    // 创建载荷并赋给请求
-    SpikePayload* payload = new SpikePayload(spike_event);
-    req->givePayload(payload);
+    // SpikeEvent本身即可序列化，直接作为载荷，线上大小按实际格式计算
+    spike_event->setCompactWire(compact_wire_format);
     
-    output->verbose(CALL_INFO, 4, 0, "创建网络请求：源=%ld，目标=%ld，大小=%zu bits\n",
+    SimpleNetwork::Request* req = new SimpleNetwork::Request();
+    req->dest = dest_node;
+    req->src = node_id;
+    req->vn = 0; // 使用虚拟网络0
+    req->size_in_bits = spike_event->wireBytes() * 8;
+    req->head = true;
+    req->tail = true;
+    req->allow_adaptive = true;
+    req->givePayload(spike_event);
+    
+    SNNDL_TRACE(output, 4, 0, "创建网络请求：源=%ld，目标=%ld，大小=%zu bits\n",
                    req->src, req->dest, req->size_in_bits);
     
     return req;
@@ -407,44 +568,19 @@ SimpleNetwork::Request* SnnNIC::createNetworkRequest(SpikeEvent* spike_event, ui
 
 SpikeEvent* SnnNIC::extractSpikeEvent(SimpleNetwork::Request* req)
 {
-    if (!req || !req->inspectPayload()) {
+    if (!req || !dynamic_cast<SpikeEvent*>(req->inspectPayload())) {
         return nullptr;
     }
     
-    // 从payload中提取SpikeEvent信息
-    class SpikePayload : public SST::Event {
-    public:
-        uint32_t src_neuron_id;
-        uint32_t dest_neuron_id;
-        uint64_t timestamp;
-        float weight;
-        
-        SpikePayload() : SST::Event(), src_neuron_id(0), dest_neuron_id(0), timestamp(0), weight(0.0f) {}
-        
-        void serialize_order(SST::Core::Serialization::serializer& ser) override {
-            Event::serialize_order(ser);
-            SST_SER(src_neuron_id);
-            SST_SER(dest_neuron_id);
-            SST_SER(timestamp);
-            SST_SER(weight);
-        }
-        
-        ImplementSerializable(SpikePayload)
-    };
-    
-    SpikePayload* payload = static_cast<SpikePayload*>(req->inspectPayload());
-    
-    // 重建SpikeEvent对象
-    SpikeEvent* spike_event = new SpikeEvent();
-    spike_event->neuron_id = payload->src_neuron_id;
-    spike_event->setDestinationNeuron(payload->dest_neuron_id);
-    spike_event->timestamp = payload->timestamp;
-    spike_event->setWeight(payload->weight);
+    // 接管载荷中的SpikeEvent，不再逐字段复制
+    SpikeEvent* spike_event = static_cast<SpikeEvent*>(req->takePayload());
     // 设置目标节点，确保接收端能够正确识别本地投递
     spike_event->setDestinationNode(static_cast<uint32_t>(req->dest));
+    // 紧凑线上格式只传时间戳低32位：按本地周期（核心时钟1GHz）补全高位
+    spike_event->resolveTimestamp(getCurrentSimTimeNano());
     
-    output->verbose(CALL_INFO, 4, 0, "解包SpikeEvent：神经元%u -> 神经元%u\n",
-                   payload->src_neuron_id, payload->dest_neuron_id);
+    SNNDL_TRACE(output, 4, 0, "解包SpikeEvent：神经元%u -> 神经元%u\n",
+                   spike_event->neuron_id, spike_event->getDestinationNeuron());
     
     return spike_event;
 }
@@ -457,8 +593,9 @@ void SnnNIC::handleDirectSpikeEvent(SST::Event* event)
     
     // 直接转换为SpikeEvent
     SpikeEvent* spike_event = static_cast<SpikeEvent*>(event);
+    spike_event->resolveTimestamp(getCurrentSimTimeNano());
     
-    output->verbose(CALL_INFO, 3, 0, "接收直接Link脉冲：源神经元=%u，目标神经元=%u\n",
+    SNNDL_TRACE(output, 3, 0, "接收直接Link脉冲：源神经元=%u，目标神经元=%u\n",
                    spike_event->neuron_id, spike_event->getDestinationNeuron());
     
     if (spike_handler) {
@@ -466,6 +603,9 @@ void SnnNIC::handleDirectSpikeEvent(SST::Event* event)
         packets_received_count++;
         stat_spikes_received->addData(1);
         stat_packets_received->addData(1);
+        // 直接Link不携带源节点
+        recordTraffic(SpikeRecorder::TrafficKind::NET_RX, SpikeRecorder::UNKNOWN_NODE, node_id, 0, 1,
+                      spike_event->wireBytes() * 8);
         
         // 调用脉冲处理器
         spike_handler(spike_event);
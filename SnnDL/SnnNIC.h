@@ -12,9 +12,12 @@
 #include <sst/core/link.h>
 #include <sst/core/output.h>
 #include <sst/core/statapi/statbase.h>
+#include <sst/core/clock.h>
 #include <queue>
+#include <deque>
 #include "SnnInterface.h"
 #include "SpikeEvent.h"
+#include "SpikeBundle.h"
 
 namespace SST {
 namespace SnnDL {
@@ -45,7 +48,14 @@ public:
         {"output_buf_size", "输出缓冲区大小", "1KiB"},
         {"port_name", "网络端口名称", "network"},
         {"use_direct_link", "是否使用直接Link模式", "true"},
-        {"verbose", "日志详细级别", "0"}
+        {"compact_wire_format", "脉冲以紧凑线上格式序列化（24位神经元ID、16位定点权重）", "false"},
+        {"verbose", "日志详细级别", "0"},
+        {"enable_spike_bundling", "SimpleNetwork模式下将发往同一节点的脉冲聚合为一个数据包", "0"},
+        {"bundle_max_spikes", "每个聚合包的最大脉冲数", "32"},
+        {"bundle_window_cycles", "聚合包自打开起最多等待的周期数（0=当周期末发送）", "4"},
+        {"bundle_packet_size", "聚合包最大字节数", "256"},
+        {"bundle_clock", "聚合窗口计时时钟频率", "1GHz"},
+        {"send_queue_depth", "SimpleNetwork模式下网络无空间时可积压的脉冲与聚合包上限，满时canSend()返回false、新脉冲与新封出的聚合包被丢弃计数（0=不限）", "256"}
     )
 
     // 端口文档
@@ -63,7 +73,14 @@ public:
         {"spikes_sent", "发送的脉冲数量", "spikes", 1},
         {"spikes_received", "接收的脉冲数量", "spikes", 1},
         {"packets_sent", "发送的网络数据包数量", "packets", 1},
-        {"packets_received", "接收的网络数据包数量", "packets", 1}
+        {"packets_received", "接收的网络数据包数量", "packets", 1},
+        {"bundles_sent", "发送的聚合包数量", "packets", 1},
+        {"bundle_size", "每个聚合包包含的脉冲数", "spikes", 1},
+        {"bundle_flush_count", "因达到脉冲数上限而发送的聚合包数", "packets", 1},
+        {"bundle_flush_size", "因达到包大小上限而发送的聚合包数", "packets", 1},
+        {"bundle_flush_window", "因聚合窗口到期而发送的聚合包数", "packets", 1},
+        {"send_queue_depth", "每次积压入队时的发送队列深度（脉冲+聚合包）", "entries", 1},
+        {"spikes_dropped", "发送队列已满而丢弃的脉冲数（含丢弃聚合包中的脉冲）", "spikes", 1}
     )
 
     /**
@@ -84,6 +101,8 @@ public:
     void setNodeId(uint32_t node_id) override;
     uint32_t getNodeId() const override;
     std::string getNetworkStatus() const override;
+    bool canSend() const override;
+    void setRecorder(SpikeRecorder* rec) override { recorder = rec; }
 
     // === SimpleNetwork 回调方法 ===
     bool handleIncoming(int vn);
@@ -115,6 +134,37 @@ private:
      * @return 解包的脉冲事件（如果成功）
      */
     SpikeEvent* extractSpikeEvent(SST::Interfaces::SimpleNetwork::Request* req);
+    
+    /**
+     * @brief 聚合窗口时钟：封装到期的聚合包并发送，无打开包时注销
+     */
+    bool bundleClockTick(SST::Cycle_t cycle);
+    
+    /**
+     * @brief 记录就绪聚合包的统计并尝试按序发送
+     */
+    void dispatchReadyBundles();
+    
+    /**
+     * @brief 发送一个聚合包
+     * @return 是否成功交给网络（失败时调用者保留所有权）
+     */
+    bool sendBundle(SpikeBundle* bundle);
+    
+    /**
+     * @brief 若聚合时钟已注销则重新注册
+     */
+    void wakeBundleClock();
+    
+    /**
+     * @brief 当前积压的脉冲与聚合包数
+     */
+    size_t queuedCount() const { return pending_spikes.size() + pending_bundles.size(); }
+    
+    /**
+     * @brief 网络暂无空间时把脉冲加入有界待发送队列，队列已满则丢弃
+     */
+    void enqueuePending(SpikeEvent* spike_event);
 
     // === 成员变量 ===
     
@@ -129,9 +179,18 @@ private:
     std::string input_buf_size;                ///< 输入缓冲区大小
     std::string output_buf_size;               ///< 输出缓冲区大小
     bool use_direct_link;                      ///< 是否使用直接链接模式
+    bool compact_wire_format;                  ///< 是否使用紧凑线上格式
     
     // 回调处理器
     SpikeHandler spike_handler;                ///< 脉冲接收处理器
+    SpikeRecorder* recorder = nullptr;         ///< 流量记录器（由父组件设置，可为空）
+    
+    void recordTraffic(SpikeRecorder::TrafficKind kind, uint32_t src, uint32_t dst, int vn,
+                       uint64_t spikes, uint64_t bits) {
+        if (recorder) {
+            recorder->recordTraffic(kind, SpikeRecorder::NETWORK_PORT, static_cast<uint16_t>(vn), src, dst, spikes, bits);
+        }
+    }
     
     // 统计计数器
     uint64_t spikes_sent_count;
@@ -145,8 +204,27 @@ private:
     Statistic<uint64_t>* stat_packets_sent;
     Statistic<uint64_t>* stat_packets_received;
     
-    // 待发送队列（可选，用于流量控制）
+    // 待发送队列（有界，满时通过canSend()向上游施加背压）
     std::queue<SpikeEvent*> pending_spikes;
+    uint32_t send_queue_depth = 256;           ///< 积压上限（0=不限）
+    uint64_t spikes_dropped_count = 0;
+    Statistic<uint64_t>* stat_send_queue_depth;
+    Statistic<uint64_t>* stat_spikes_dropped;
+    
+    // 脉冲聚合
+    bool enable_bundling;                      ///< 是否启用脉冲聚合
+    SpikeBundler bundler;                      ///< 按目标节点聚合的缓冲器
+    std::deque<SpikeBundle*> pending_bundles;  ///< 已封包但网络暂无空间的聚合包
+    TimeConverter* bundle_tc;                  ///< 聚合窗口时钟
+    Clock::HandlerBase* bundle_clock_handler;  ///< 聚合窗口时钟处理器
+    bool bundle_clock_active;                  ///< 聚合窗口时钟是否已注册
+    SST::Cycle_t bundle_cycle;                 ///< 聚合窗口时钟的当前周期
+    uint64_t bundles_sent_count;
+    Statistic<uint64_t>* stat_bundles_sent;
+    Statistic<uint64_t>* stat_bundle_size;
+    Statistic<uint64_t>* stat_bundle_flush_count;
+    Statistic<uint64_t>* stat_bundle_flush_size;
+    Statistic<uint64_t>* stat_bundle_flush_window;
 };
 
 } // namespace SnnDL
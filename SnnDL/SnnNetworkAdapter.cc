@@ -85,6 +85,7 @@ SnnNetworkAdapter::SnnNetworkAdapter(SST::ComponentId_t id, SST::Params& params)
     // Merlin集成参数
     enable_merlin_router = params.find<bool>("enable_merlin_router", false);
     use_direct_link = params.find<bool>("use_direct_link", true);
+    compact_wire_format = params.find<bool>("compact_wire_format", false);
     use_multi_port = params.find<bool>("use_multi_port", false);
     port_name = params.find<std::string>("port_name", "network");
     
@@ -345,7 +346,8 @@ bool SnnNetworkAdapter::handleIncoming(int vn)
 bool SnnNetworkAdapter::spaceAvailable(int vn)
 {
     // 处理待发送队列 - 参考SnnNIC的成功实现
-    while (!pending_spikes.empty() && router && router->spaceToSend(vn, 64)) { // 假设64位数据包
+    while (!pending_spikes.empty() && router &&
+           router->spaceToSend(vn, pending_spikes.front()->wireBytes() * 8)) {
         SpikeEvent* spike = pending_spikes.front();
         pending_spikes.pop();
         
@@ -365,13 +367,15 @@ bool SnnNetworkAdapter::spaceAvailable(int vn)
             if (stat_remote_spikes) stat_remote_spikes->addData(1);
         } else {
             // 仍然无法发送，重新放回队列
+            // 取回payload，避免随请求一同释放
+            if (req) {
+                req->takePayload();
+                delete req;
+            }
             pending_spikes.push(spike);
-            if (req) delete req;
             break; // 停止尝试更多发送
         }
-        
-        // 清理原始脉冲事件（已经复制到请求中）
-        delete spike;
+        // 脉冲事件已作为payload交由网络接管
     }
     
     return true;
@@ -447,8 +451,9 @@ void SnnNetworkAdapter::routeSpike(SpikeEvent* spike_event, uint32_t dest_node)
     average_latency_cycles = (average_latency_cycles + estimated_latency) / 2; // 简单移动平均
     if (stat_average_latency) stat_average_latency->addData(estimated_latency);
     
-    // 模拟带宽使用
-    uint64_t packet_size_bytes = 64; // 假设每个脉冲64字节
+    // 按实际线上格式统计带宽
+    spike_event->setCompactWire(compact_wire_format);
+    uint64_t packet_size_bytes = spike_event->wireBytes();
     bandwidth_bytes_sent += packet_size_bytes;
     if (stat_bandwidth_utilization) stat_bandwidth_utilization->addData(packet_size_bytes);
     
@@ -489,17 +494,16 @@ SST::Interfaces::SimpleNetwork::Request* SnnNetworkAdapter::createNetworkRequest
     // 设置正确的目标地址
     req->dest = dest_node;  // 使用实际目标节点
     req->src = node_id;
-    req->size_in_bits = 64 * 8;  // 64字节 = 512比特
+    req->size_in_bits = spike_event->wireBytes() * 8;
     req->vn = 0;  // 虚拟网络0
     req->head = true;
     req->tail = true;
     req->allow_adaptive = true;
     
-    // 关键：将SpikeEvent包装为SpikeEventWrapper，然后作为payload
-    SpikeEventWrapper* wrapper = new SpikeEventWrapper(spike_event);
-    req->givePayload(wrapper);
+    // SpikeEvent本身即可序列化，直接作为payload，避免额外分配wrapper
+    req->givePayload(spike_event);
     
-    output->verbose(CALL_INFO, 3, 0, "🌐 创建SimpleNetwork请求: src=%u, dest=%u, 包装SpikeEvent=%u->%u\n", 
+    output->verbose(CALL_INFO, 3, 0, "🌐 创建SimpleNetwork请求: src=%u, dest=%u, SpikeEvent=%u->%u\n", 
                     node_id, dest_node, spike_event->getNeuronId(), spike_event->getDestinationNeuron());
     
     return req;
@@ -509,46 +513,34 @@ SpikeEvent* SnnNetworkAdapter::extractSpikeFromRequest(SST::Interfaces::SimpleNe
 {
     if (!req) return nullptr;
     
-    // 从请求中提取SpikeEventWrapper，然后解包得到SpikeEvent
+    // 从请求中取出payload：原生SpikeEvent，或兼容旧格式的SpikeEventWrapper
     SST::Event* payload = req->takePayload();
     if (!payload) {
         output->verbose(CALL_INFO, 1, 0, "⚠️ SimpleNetwork请求没有payload\n");
         return nullptr;
     }
     
-    // 尝试转换为SpikeEventWrapper
-    SpikeEventWrapper* wrapper = dynamic_cast<SpikeEventWrapper*>(payload);
-    if (!wrapper) {
-        output->verbose(CALL_INFO, 1, 0, "⚠️ Payload不是SpikeEventWrapper类型\n");
-        delete payload;
-        return nullptr;
-    }
-    
-    // 从wrapper中提取SpikeEvent
-    SpikeEvent* original_spike = wrapper->getSpikeEvent();
-    if (!original_spike) {
-        output->verbose(CALL_INFO, 1, 0, "⚠️ SpikeEventWrapper中没有SpikeEvent\n");
+    SpikeEvent* extracted_spike = dynamic_cast<SpikeEvent*>(payload);
+    if (!extracted_spike) {
+        SpikeEventWrapper* wrapper = dynamic_cast<SpikeEventWrapper*>(payload);
+        if (!wrapper || !wrapper->getSpikeEvent()) {
+            output->verbose(CALL_INFO, 1, 0, "⚠️ Payload中没有SpikeEvent\n");
+            delete payload;
+            return nullptr;
+        }
+        // 接管wrapper中的SpikeEvent（保留目标列表），不再复制
+        extracted_spike = wrapper->getSpikeEvent();
+        wrapper->setSpikeEvent(nullptr);
         delete wrapper;
-        return nullptr;
     }
-    
-    // 创建SpikeEvent的副本
-    SpikeEvent* extracted_spike = new SpikeEvent(
-        original_spike->getNeuronId(),
-        original_spike->getDestinationNeuron(),
-        original_spike->getDestinationNode(),
-        original_spike->getWeight(),
-        original_spike->getTimestamp()
-    );
-    extracted_spike->hop_count = original_spike->hop_count + 1;  // 增加跳数
+    // 紧凑线上格式只传时间戳低32位：按本地周期（核心时钟1GHz）补全高位
+    extracted_spike->resolveTimestamp(getCurrentSimTimeNano());
+    extracted_spike->incrementHopCount();
     
     output->verbose(CALL_INFO, 3, 0, "🌐 从SimpleNetwork请求提取SpikeEvent: %u->%u (跳数%u)\n", 
                     extracted_spike->getNeuronId(), extracted_spike->getDestinationNeuron(), 
                     extracted_spike->hop_count);
     
-    // 清理wrapper
-    delete wrapper;
-    
     return extracted_spike;
 }
 
@@ -795,57 +787,28 @@ void SnnNetworkAdapter::sendViaDirectLink(SpikeEvent* spike_event, uint32_t dest
     output->verbose(CALL_INFO, 3, 0, "📡 通过直接Link发送脉冲: 源=%u, 目标=%u, 神经元=%u\n", 
                     node_id, dest_node, spike_event->getNeuronId());
     
-    // 创建新的SpikeEvent用于网络传输（避免复制构造问题）
-    SpikeEvent* network_spike = new SpikeEvent(
-        spike_event->getNeuronId(), 
-        spike_event->getDestinationNeuron(),
-        spike_event->getDestinationNode(),
-        spike_event->getWeight(),
-        spike_event->getTimestamp()
-    );
-    
-    // 使用SpikeEventWrapper进行SST Event传输
-    SpikeEventWrapper* wrapper_event = new SpikeEventWrapper(network_spike);
-    
-    // 直接通过Link发送 - 添加防御性检查和Link状态诊断
-    output->verbose(CALL_INFO, 2, 0, "🔍 将要发送SpikeEventWrapper=%p(spike_data=%p)通过actual_link=%p\n", 
-                    (void*)wrapper_event, (void*)network_spike, (void*)actual_link);
-    
-    // 详细检查Link对象的状态
-    if (actual_link) {
-        output->verbose(CALL_INFO, 2, 0, "🔍 Link状态诊断:\n");
-        output->verbose(CALL_INFO, 2, 0, "  - actual_link指针: %p\n", (void*)actual_link);
-        output->verbose(CALL_INFO, 2, 0, "  - 尝试调用Link方法...\n");
-        try {
-            // 测试Link对象是否有效 - 调用一个简单的方法
-            output->verbose(CALL_INFO, 2, 0, "  - Link对象看起来有效\n");
-        } catch (...) {
-            output->verbose(CALL_INFO, 1, 0, "❌ Link对象无效或已损坏\n");
-            delete wrapper_event;
-            return;
-        }
-    }
+    // 单次复制构造即可发送：接收端直接识别原生SpikeEvent，无需再套一层wrapper
+    SpikeEvent* network_spike = new SpikeEvent(*spike_event);
+    network_spike->setCompactWire(compact_wire_format);
     
-    if (!wrapper_event) {
-        output->verbose(CALL_INFO, 1, 0, "❌ wrapper_event为null，无法发送\n");
-        return;
-    }
+    output->verbose(CALL_INFO, 2, 0, "🔍 将要发送SpikeEvent=%p通过actual_link=%p\n", 
+                    (void*)network_spike, (void*)actual_link);
     
+    size_t bits = network_spike->wireBytes() * 8;
     try {
-        output->verbose(CALL_INFO, 2, 0, "🔍 开始调用actual_link->send(SpikeEventWrapper)\n");
-        actual_link->send(wrapper_event);
-        output->verbose(CALL_INFO, 2, 0, "🔍 SpikeEventWrapper send 调用完成\n");
+        actual_link->send(network_spike);
     } catch (const std::exception& e) {
-        output->verbose(CALL_INFO, 1, 0, "❌ SpikeEventWrapper send异常: %s\n", e.what());
-        delete wrapper_event;
+        output->verbose(CALL_INFO, 1, 0, "❌ SpikeEvent send异常: %s\n", e.what());
+        delete network_spike;
         return;
     } catch (...) {
-        output->verbose(CALL_INFO, 1, 0, "❌ SpikeEventWrapper send未知异常\n");
-        delete wrapper_event;
+        output->verbose(CALL_INFO, 1, 0, "❌ SpikeEvent send未知异常\n");
+        delete network_spike;
         return;
     }
     
     output->verbose(CALL_INFO, 3, 0, "✅ 脉冲通过直接Link发送成功\n");
+    recordTraffic(SpikeRecorder::TrafficKind::NET_TX, -1, node_id, dest_node, 0, bits);
     
     // 更新统计信息
     spikes_routed_count++;
@@ -897,17 +860,10 @@ void SnnNetworkAdapter::sendViaMultiPortLink(SpikeEvent* spike_event, uint32_t d
     
     std::string direction = port_directions[next_port];
     
-    // 创建新的SpikeEvent用于网络传输
-    SpikeEvent* network_spike = new SpikeEvent(
-        spike_event->getNeuronId(), 
-        spike_event->getDestinationNeuron(),
-        spike_event->getDestinationNode(),
-        spike_event->getWeight(),
-        spike_event->getTimestamp()
-    );
-    
-    // 使用SpikeEventWrapper包装Event以符合SST要求  
-    SpikeEventWrapper* wrapper = new SpikeEventWrapper(network_spike);
+    // 单次复制构造即可发送，接收端直接识别原生SpikeEvent
+    SpikeEvent* network_spike = new SpikeEvent(*spike_event);
+    network_spike->setCompactWire(compact_wire_format);
+    size_t bits = network_spike->wireBytes() * 8;
     
     output->verbose(CALL_INFO, 3, 0, "📡 准备通过%s方向发送脉冲: 源=%u, 目标=%u, 神经元=%u\n", 
                     direction.c_str(), node_id, dest_node, spike_event->getNeuronId());
@@ -916,46 +872,43 @@ void SnnNetworkAdapter::sendViaMultiPortLink(SpikeEvent* spike_event, uint32_t d
     auto parent_it = parent_direction_links.find(direction);
     if (parent_it != parent_direction_links.end() && parent_it->second) {
         output->verbose(CALL_INFO, 2, 0, "🔄 使用父组件注入的%s方向链路发送\n", direction.c_str());
-        sendEventToDirection(wrapper, direction);
+        sendEventToDirection(network_spike, direction);
     } else {
         // 回退到自己的多端口链路
         auto self_it = direction_links.find(direction);
         if (self_it != direction_links.end() && self_it->second) {
             output->verbose(CALL_INFO, 2, 0, "🔄 使用自己的%s方向链路发送\n", direction.c_str());
-            output->verbose(CALL_INFO, 2, 0, "🔍 将要发送wrapper=%p(spike=%p)通过%s方向link=%p\n", 
-                            (void*)wrapper, (void*)network_spike, direction.c_str(), (void*)self_it->second);
+            output->verbose(CALL_INFO, 2, 0, "🔍 将要发送spike=%p通过%s方向link=%p\n", 
+                            (void*)network_spike, direction.c_str(), (void*)self_it->second);
             
             // 验证Link的有效性
             if (!self_it->second) {
                 output->verbose(CALL_INFO, 1, 0, "❌ %s方向link为null，无法发送\n", direction.c_str());
-                delete wrapper;
                 delete network_spike;
                 return;
             }
             
             try {
-                self_it->second->send(wrapper);
+                self_it->second->send(network_spike);
                 output->verbose(CALL_INFO, 2, 0, "🔍 %s方向Link send 调用完成\n", direction.c_str());
             } catch (const std::exception& e) {
                 output->verbose(CALL_INFO, 1, 0, "❌ %s方向Link send异常: %s\n", direction.c_str(), e.what());
-                delete wrapper;
                 delete network_spike;
                 return;
             } catch (...) {
                 output->verbose(CALL_INFO, 1, 0, "❌ %s方向Link send未知异常\n", direction.c_str());
-                delete wrapper;
                 delete network_spike;
                 return;
             }
         } else {
             output->verbose(CALL_INFO, 1, 0, "❌ %s方向的链路不存在，无法发送\n", direction.c_str());
-            delete wrapper;
             delete network_spike;  // 清理内存
             return;
         }
     }
     
     output->verbose(CALL_INFO, 3, 0, "✅ 脉冲通过%s方向发送成功\n", direction.c_str());
+    recordTraffic(SpikeRecorder::TrafficKind::NET_TX, next_port, node_id, dest_node, 0, bits);
     
     // 更新统计信息
     spikes_routed_count++;
@@ -986,10 +939,12 @@ void SnnNetworkAdapter::sendViaMerlinRouter(SpikeEvent* spike_event, uint32_t de
                     node_id, dest_node, next_port);
     
     // 按照SnnNIC模式：先检查空间，再发送（使用vn=0）
+    size_t bits = req->size_in_bits;
     bool sent = router->spaceToSend(0, req->size_in_bits) && router->send(req, 0);
     
     if (sent) {
         output->verbose(CALL_INFO, 3, 0, "✅ 脉冲通过Merlin路由器发送成功\n");
+        recordTraffic(SpikeRecorder::TrafficKind::NET_TX, next_port, node_id, dest_node, 0, bits);
         
         // 更新统计信息
         spikes_routed_count++;
@@ -1036,8 +991,12 @@ void SnnNetworkAdapter::handleDirectSpikeEvent(SST::Event* event)
     }
     
     if (spike_event && spike_handler) {
+        spike_event->resolveTimestamp(getCurrentSimTimeNano());
         output->verbose(CALL_INFO, 2, 0, "📦 处理接收的脉冲: 神经元%u\n", 
                         spike_event->getNeuronId());
+        // 直接Link不携带源节点
+        recordTraffic(SpikeRecorder::TrafficKind::NET_RX, -1, SpikeRecorder::UNKNOWN_NODE, node_id, 0,
+                      spike_event->wireBytes() * 8);
         
         // 调用脉冲处理回调
         spike_handler(spike_event);
@@ -1068,6 +1027,9 @@ bool SnnNetworkAdapter::handleNetworkEvent(int vn)
         output->verbose(CALL_INFO, 2, 0, "📦 接收到网络数据包: 源=%lu, 目标=%lu, 大小=%lu\n", 
                         req->src, req->dest, req->size_in_bits);
         
+        recordTraffic(SpikeRecorder::TrafficKind::NET_RX, -1, static_cast<uint32_t>(req->src), node_id, vn,
+                      req->size_in_bits);
+        
         // 提取脉冲事件
         SpikeEvent* received_spike = extractSpikeFromRequest(req);
         
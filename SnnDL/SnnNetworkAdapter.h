@@ -139,6 +139,7 @@ public:
         {"congestion_threshold", "拥塞阈值", "0.8"},
         {"enable_merlin_router", "启用Merlin路由器集成", "false"},
         {"use_direct_link", "是否使用直接Link模式", "true"},
+        {"compact_wire_format", "脉冲以紧凑线上格式序列化（24位神经元ID、16位定点权重）", "false"},
         {"port_name", "网络端口名称", "network"},
         {"verbose", "日志详细级别", "0"}
     )
@@ -190,6 +191,7 @@ public:
     void setNodeId(uint32_t node_id) override;
     uint32_t getNodeId() const override;
     std::string getNetworkStatus() const override;
+    void setRecorder(SpikeRecorder* rec) override { recorder = rec; }
 
     // === 网络接口回调方法 ===
     bool handleIncoming(int vn);
@@ -349,10 +351,22 @@ private:
     double congestion_threshold;               ///< 拥塞阈值
     bool enable_merlin_router;                 ///< 是否启用Merlin路由器集成
     bool use_direct_link;                      ///< 是否使用直接Link模式
+    bool compact_wire_format;                  ///< 是否使用紧凑线上格式
     std::string port_name;                     ///< 网络端口名称
     
     // 回调处理器
     SpikeHandler spike_handler;                ///< 脉冲接收处理器
+    SpikeRecorder* recorder = nullptr;         ///< 流量记录器（由父组件设置，可为空）
+    
+    /** 按方向端口累计流量，port 超出方向范围时记为 NETWORK_PORT */
+    void recordTraffic(SpikeRecorder::TrafficKind kind, int port, uint32_t src, uint32_t dst, int vn,
+                       uint64_t bits) {
+        if (recorder) {
+            uint8_t link = (port >= 0 && port < SpikeRecorder::NETWORK_PORT) ? static_cast<uint8_t>(port)
+                                                                               : SpikeRecorder::NETWORK_PORT;
+            recorder->recordTraffic(kind, link, static_cast<uint16_t>(vn), src, dst, 1, bits);
+        }
+    }
     
     // SimpleNetwork包装器
     SimpleNetworkWrapper* simple_network_wrapper; ///< SimpleNetwork包装器
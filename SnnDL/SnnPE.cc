@@ -7,11 +7,14 @@
 
 #include <sst/core/sst_config.h>
 #include "SnnPE.h"
+#include "SnnTrace.h"
+#include "SpikeBundle.h"
 
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 using namespace SST;
 using namespace SST::SnnDL;
@@ -55,9 +58,27 @@ SnnPE::SnnPE(ComponentId_t id, Params& params) : Component(id) {
     leak_factor = exp(-1.0f / tau_mem);  // 临时值，setup()中会重新计算
     
     // 初始化神经元状态
-    neurons.resize(num_neurons, NeuronState(v_rest));
+    neurons.resize(num_neurons, v_rest);
+    fired_indices.reserve(num_neurons);
     output->verbose(CALL_INFO, 2, 0, "初始化了%u个神经元状态\n", num_neurons);
     
+    // 本地CSR权重的存储精度
+    std::string precision_error;
+    if (!FixedPointFormat::parse(params.find<std::string>("weight_precision", "float32"),
+                                 params.find<float>("weight_scale", 1.0f / 64.0f), weight_precision, precision_error)) {
+        output->fatal(CALL_INFO, -1, "weight_precision配置错误: %s\n", precision_error.c_str());
+    }
+    
+    // 组件内多线程更新：拆分泄漏/阈值遍历，发放列表按块顺序合并，结果与串行一致
+    int update_threads = params.find<int>("update_threads", 1);
+    uint32_t update_min_neurons = params.find<uint32_t>("update_min_neurons_per_thread", 8192);
+    update_pool = nullptr;
+    if (update_threads > 1) {
+        update_pool = new NeuronUpdatePool(update_threads, update_min_neurons);
+        output->verbose(CALL_INFO, 1, 0, "神经元更新工作池: %d个线程, 每线程至少%u个神经元\n",
+                        update_threads, update_min_neurons);
+    }
+    
     // 尝试加载SubComponent接口
     snn_interface = loadUserSubComponent<SnnInterface>("network_interface", ComponentInfo::SHARE_NONE);
     
@@ -144,7 +165,12 @@ SnnPE::SnnPE(ComponentId_t id, Params& params) : Component(id) {
     
     // 注册时钟处理器
     std::string clock_freq = params.find<std::string>("clock", "1GHz");
-    registerClock(clock_freq, new Clock::Handler2<SnnPE,&SnnPE::clockTick>(this));
+    clock_handler = new Clock::Handler2<SnnPE,&SnnPE::clockTick>(this);
+    clock_tc = registerClock(clock_freq, clock_handler);
+    enable_clock_suspend = params.find<bool>("enable_clock_suspend", false);
+    clock_suspended = false;
+    last_tick_cycle = 0;
+    suspended_cycles = 0;
     output->verbose(CALL_INFO, 2, 0, "注册了时钟处理器，频率: %s\n", clock_freq.c_str());
     
     // 初始化统计计数器
@@ -190,6 +216,7 @@ SnnPE::SnnPE(ComponentId_t id, Params& params) : Component(id) {
 
 // ===== 析构函数 =====
 SnnPE::~SnnPE() {
+    delete update_pool;
     if (output) {
         delete output;
     }
@@ -266,6 +293,7 @@ void SnnPE::setup() {
             
             if (loadWeights(weights_file_path)) {
                 output->verbose(CALL_INFO, 1, 0, "成功加载权重文件: %s\n", weights_file_path.c_str());
+                quantizeWeights();
             } else {
                 output->verbose(CALL_INFO, 1, 0, "权重文件加载失败，使用空权重矩阵\n");
                 // 初始化空的CSR矩阵
@@ -308,6 +336,13 @@ void SnnPE::finish() {
     output->output("生成脉冲数: %" PRIu64 "\n", spikes_generated_count);
     output->output("发放神经元数: %" PRIu64 "\n", neurons_fired_count);
     output->output("突触操作数: %" PRIu64 "\n", synaptic_ops_count);
+    if (enable_clock_suspend) {
+        output->output("时钟挂起跳过周期: %" PRIu64 "\n", suspended_cycles);
+    }
+    if (update_pool) {
+        output->output("更新线程: %d, 并行步数: %" PRIu64 ", 串行步数: %" PRIu64 "\n",
+                       update_pool->threads(), update_pool->parallelSteps(), update_pool->serialSteps());
+    }
     output->output("接口模式: %s\n", use_interface_mode ? "SubComponent" : "传统Link");
     output->output("路由模式: %s\n", use_embedded_router ? "嵌入式路由器" : "无路由器");
     
@@ -320,15 +355,17 @@ void SnnPE::finish() {
 
 // ===== 时钟处理器 =====
 bool SnnPE::clockTick(Cycle_t current_cycle) {
-    // 对所有神经元应用泄漏和不应期更新
-    for (uint32_t i = 0; i < num_neurons; i++) {
-        // 处理不应期
-        if (neurons[i].refractory_timer > 0) {
-            neurons[i].refractory_timer--;
-        } else {
-            // 应用泄漏动态
-            applyLeak(i);
-        }
+    last_tick_cycle = current_cycle;
+    
+    // 对所有神经元应用泄漏和不应期更新，并在同一遍历中找出达到阈值的神经元
+    fired_indices.clear();
+    if (update_pool) {
+        update_pool->updateAndDetect(neurons, leak_factor, v_rest, v_thresh, false, fired_indices);
+    } else {
+        neurons.updateAndDetect(leak_factor, v_rest, v_thresh, false, fired_indices);
+    }
+    for (uint32_t idx : fired_indices) {
+        checkAndFireSpike(idx);
     }
     
     // Phase 3: 移除测试内存请求，改为完全由脉冲事件驱动
@@ -352,14 +389,56 @@ bool SnnPE::clockTick(Cycle_t current_cycle) {
     
     // 每1000个周期输出一次调试信息
     if (current_cycle % 1000 == 0) {
-        output->verbose(CALL_INFO, 3, 0, "时钟滴答: 周期%" PRIu64 "\n", current_cycle);
+        SNNDL_TRACE(output, 3, 0, "时钟滴答: 周期%" PRIu64 "\n", current_cycle);
+    }
+    
+    // 空闲挂起：脉冲直接在事件处理器中积分，逐周期工作只剩泄漏，可在唤醒时一次补算
+    bool test_traffic_active = use_interface_mode && snn_interface && enable_test_traffic;
+    if (enable_clock_suspend && !test_traffic_active && pending_requests.empty()) {
+        clock_suspended = true;
+        SNNDL_TRACE(output, 4, 0, "空闲挂起时钟: 周期%" PRIu64 "\n", current_cycle);
+        return true;   // 注销时钟
     }
     
     return false;  // 返回false表示继续仿真
 }
 
+void SnnPE::wakeClock() {
+    if (!clock_suspended) return;
+    clock_suspended = false;
+    
+    SST::Cycle_t next_cycle = reregisterClock(clock_tc, clock_handler);
+    SST::Cycle_t skipped = (next_cycle > last_tick_cycle + 1) ? (next_cycle - last_tick_cycle - 1) : 0;
+    suspended_cycles += skipped;
+    if (skipped == 0) return;
+    
+    // 等价于逐周期执行clockTick中的更新：先消耗不应期，剩余周期按 leak^k 衰减
+    for (uint32_t i = 0; i < num_neurons; i++) {
+        uint32_t ref_cycles = static_cast<uint32_t>(std::min<SST::Cycle_t>(neurons.refractory[i], skipped));
+        neurons.refractory[i] -= ref_cycles;
+        SST::Cycle_t leak_cycles = skipped - ref_cycles;
+        if (leak_cycles > 0) {
+            neurons.v_mem[i] = v_rest + (neurons.v_mem[i] - v_rest) *
+                               std::pow(leak_factor, static_cast<float>(leak_cycles));
+        }
+    }
+    SNNDL_TRACE(output, 4, 0, "唤醒时钟: 补算%" PRIu64 "个周期的泄漏\n", skipped);
+}
+
 // ===== 事件处理器 =====
 void SnnPE::handleSpikeEvent(Event* ev) {
+    wakeClock();
+    
+    // 数据源按目标节点批量发送：逐个还原后走单脉冲路径
+    if (SpikeBundle* bundle = dynamic_cast<SpikeBundle*>(ev)) {
+        size_t target_offset = 0;
+        for (size_t i = 0; i < bundle->getSpikeCount(); i++) {
+            handleSpikeEvent(bundle->unpackSpike(i, target_offset));
+        }
+        delete bundle;
+        return;
+    }
+    
     SpikeEvent* spike_ev = dynamic_cast<SpikeEvent*>(ev);
     if (!spike_ev) {
         output->verbose(CALL_INFO, 1, 0, "警告: 接收到非SpikeEvent事件\n");
@@ -370,7 +449,7 @@ void SnnPE::handleSpikeEvent(Event* ev) {
     uint32_t pre_syn_id = spike_ev->neuron_id;
     spikes_received_count++;
     
-    output->verbose(CALL_INFO, 3, 0, "接收到脉冲事件: 神经元%u\n", pre_syn_id);
+    SNNDL_TRACE(output, 3, 0, "接收到脉冲事件: 神经元%u\n", pre_syn_id);
     
     // 检查是否为跨核脉冲（有目标神经元信息）
     if (spike_ev->getDestinationNeuron() != 0 || spike_ev->getDestinationNode() != 0) {
@@ -378,38 +457,38 @@ void SnnPE::handleSpikeEvent(Event* ev) {
         uint32_t target_local_id = spike_ev->getDestinationNeuron();
         double weight = spike_ev->getWeight();
         
-        printf("RECV_LINK: 核心%u通过Link接收跨核脉冲 - 源神经元%u -> 本地神经元%u, 权重=%.3f\n", 
+        SNNDL_TRACE(output, 3, 0, "RECV_LINK: 核心%u通过Link接收跨核脉冲 - 源神经元%u -> 本地神经元%u, 权重=%.3f\n", 
                node_id, pre_syn_id, target_local_id, weight);
         
         // 检查目标神经元ID有效性
         if (target_local_id >= num_neurons) {
-            printf("RECV_LINK: 错误 - 目标神经元ID %u 超出范围 (最大: %u)\n", 
+            output->verbose(CALL_INFO, 1, 0, "RECV_LINK: 错误 - 目标神经元ID %u 超出范围 (最大: %u)\n", 
                    target_local_id, num_neurons - 1);
             delete ev;
             return;
         }
         
         // 记录处理前的膜电位
-        float old_v_mem = neurons[target_local_id].v_mem;
+        float old_v_mem = neurons.v_mem[target_local_id];
         
         // 检查目标神经元是否处于不应期
-        if (neurons[target_local_id].refractory_timer == 0) {
+        if (neurons.refractory[target_local_id] == 0) {
             // 整合突触输入
-            neurons[target_local_id].v_mem += weight;
+            neurons.v_mem[target_local_id] += weight;
             synaptic_ops_count++;
             
-            printf("RECV_LINK: 核心%u处理成功 - 神经元%u: %.3f + %.3f = %.3f\n",
-                   node_id, target_local_id, old_v_mem, (float)weight, neurons[target_local_id].v_mem);
+            SNNDL_TRACE(output, 3, 0, "RECV_LINK: 核心%u处理成功 - 神经元%u: %.3f + %.3f = %.3f\n",
+                   node_id, target_local_id, old_v_mem, (float)weight, neurons.v_mem[target_local_id]);
             
             // 检查是否发放脉冲
-            if (neurons[target_local_id].v_mem >= v_thresh) {
-                printf("RECV_LINK: 核心%u神经元%u达到阈值，将发放脉冲！(%.3f >= %.3f)\n",
-                       node_id, target_local_id, neurons[target_local_id].v_mem, v_thresh);
+            if (neurons.v_mem[target_local_id] >= v_thresh) {
+                SNNDL_TRACE(output, 3, 0, "RECV_LINK: 核心%u神经元%u达到阈值，将发放脉冲！(%.3f >= %.3f)\n",
+                       node_id, target_local_id, neurons.v_mem[target_local_id], v_thresh);
             }
             
             checkAndFireSpike(target_local_id);
         } else {
-            printf("RECV_LINK: 核心%u神经元%u在不应期，忽略脉冲\n", node_id, target_local_id);
+            SNNDL_TRACE(output, 3, 0, "RECV_LINK: 核心%u神经元%u在不应期，忽略脉冲\n", node_id, target_local_id);
         }
         
         delete ev;
@@ -434,7 +513,7 @@ void SnnPE::handleSpikeEvent(Event* ev) {
         uint64_t target_address = base_addr + (local_pre_syn_id * weights_per_neuron * sizeof(float));
         size_t request_size = weights_per_neuron * sizeof(float);
         
-        output->verbose(CALL_INFO, 3, 0, "发送内存请求: 神经元%u, 地址=0x%lx, 大小=%zu\n", 
+        SNNDL_TRACE(output, 3, 0, "发送内存请求: 神经元%u, 地址=0x%lx, 大小=%zu\n", 
                        local_pre_syn_id, target_address, request_size);
         
         // 创建StandardMem Read请求
@@ -448,7 +527,7 @@ void SnnPE::handleSpikeEvent(Event* ev) {
         // 发送内存请求
         memory_->send(req);
         
-        output->verbose(CALL_INFO, 3, 0, "内存请求已发送\n");
+        SNNDL_TRACE(output, 3, 0, "内存请求已发送\n");
         // 不删除spike_ev，它被保存在pending_requests中
     } else {
         // 降级到传统模式（如果没有配置内存链接）
@@ -468,7 +547,7 @@ void SnnPE::handleSpikeEvent(Event* ev) {
         // 遍历所有连接
         for (uint64_t i = row_start; i < row_end; i++) {
             uint32_t global_post_syn_id = csr_col_indices[i];
-            float weight = csr_weights[i];
+            float weight = csrWeight(i);
             
             // 检查是否为本地连接
             if (global_post_syn_id >= neuron_id_start && global_post_syn_id < neuron_id_start + num_neurons) {
@@ -476,13 +555,13 @@ void SnnPE::handleSpikeEvent(Event* ev) {
                 uint32_t local_post_syn_id = global_post_syn_id - neuron_id_start;
                 
                 // 检查突触后神经元是否处于不应期
-                if (neurons[local_post_syn_id].refractory_timer == 0) {
+                if (neurons.refractory[local_post_syn_id] == 0) {
                     // 整合突触输入
-                    neurons[local_post_syn_id].v_mem += weight;
+                    neurons.v_mem[local_post_syn_id] += weight;
                     synaptic_ops_count++;
                     
-                    output->verbose(CALL_INFO, 4, 0, "本地突触输入: %u -> %u (本地%u), 权重=%.3f, 新v_mem=%.3f\n",
-                                   pre_syn_id, global_post_syn_id, local_post_syn_id, weight, neurons[local_post_syn_id].v_mem);
+                    SNNDL_TRACE(output, 4, 0, "本地突触输入: %u -> %u (本地%u), 权重=%.3f, 新v_mem=%.3f\n",
+                                   pre_syn_id, global_post_syn_id, local_post_syn_id, weight, neurons.v_mem[local_post_syn_id]);
                     
                     // 检查是否发放脉冲
                     checkAndFireSpike(local_post_syn_id);
@@ -493,7 +572,7 @@ void SnnPE::handleSpikeEvent(Event* ev) {
                 uint32_t dest_node_id = global_post_syn_id / 64;  // 假设每个核心64个神经元
                 uint32_t dest_local_neuron = global_post_syn_id % 64;
                 
-                printf("CROSSCORE: 跨核连接处理 - 本地神经元%u -> 全局神经元%u (核心%u:神经元%u), 权重=%.3f\n",
+                SNNDL_TRACE(output, 3, 0, "CROSSCORE: 跨核连接处理 - 本地神经元%u -> 全局神经元%u (核心%u:神经元%u), 权重=%.3f\n",
                        local_pre_syn_id, global_post_syn_id, dest_node_id, dest_local_neuron, weight);
                 
                 // 创建跨核脉冲事件
@@ -505,10 +584,10 @@ void SnnPE::handleSpikeEvent(Event* ev) {
                 if (spike_output_link) {
                     // 使用传统Link发送
                     spike_output_link->send(new_spike);
-                    printf("CROSSCORE: 跨核脉冲已发送: 源神经元%u -> 目标核心%u:神经元%u, 权重=%.3f\n",
+                    SNNDL_TRACE(output, 3, 0, "CROSSCORE: 跨核脉冲已发送: 源神经元%u -> 目标核心%u:神经元%u, 权重=%.3f\n",
                            pre_syn_id, dest_node_id, dest_local_neuron, weight);
                 } else {
-                    printf("CROSSCORE: 警告 - 无spike_output_link，跨核脉冲丢失\n");
+                    output->verbose(CALL_INFO, 1, 0, "CROSSCORE: 警告 - 无spike_output_link，跨核脉冲丢失\n");
                     delete new_spike;
                 }
             }
@@ -520,8 +599,10 @@ void SnnPE::handleSpikeEvent(Event* ev) {
 }
 
 void SnnPE::handleInterfaceSpike(SpikeEvent* spike_event) {
+    wakeClock();
+    
     if (!spike_event) {
-        printf("RECV_SPIKE: 核心%u接收到空的脉冲事件\n", node_id);
+        SNNDL_TRACE(output, 3, 0, "RECV_SPIKE: 核心%u接收到空的脉冲事件\n", node_id);
         return;
     }
     
@@ -538,14 +619,14 @@ void SnnPE::handleInterfaceSpike(SpikeEvent* spike_event) {
     
     // 检查是否为本节点的脉冲
     if (dest_node != node_id) {
-        printf("RECV_SPIKE: 错误 - 核心%u接收到发给核心%u的脉冲\n", node_id, dest_node);
+        output->verbose(CALL_INFO, 1, 0, "RECV_SPIKE: 错误 - 核心%u接收到发给核心%u的脉冲\n", node_id, dest_node);
         delete spike_event;
         return;
     }
     
     // 检查目标神经元索引
     if (dest_neuron >= num_neurons) {
-        printf("RECV_SPIKE: 错误 - 目标神经元索引%u超出范围[0, %u)\n", dest_neuron, num_neurons);
+        output->verbose(CALL_INFO, 1, 0, "RECV_SPIKE: 错误 - 目标神经元索引%u超出范围[0, %u)\n", dest_neuron, num_neurons);
         delete spike_event;
         return;
     }
@@ -553,25 +634,25 @@ void SnnPE::handleInterfaceSpike(SpikeEvent* spike_event) {
     // 处理突触连接（简化版本：直接使用权重）
     if (weight != 0.0f) {
         // 记录接收前的膜电位
-        float old_v_mem = neurons[dest_neuron].v_mem;
+        float old_v_mem = neurons.v_mem[dest_neuron];
         
         // 检查目标神经元是否在不应期
-        if (neurons[dest_neuron].refractory_timer == 0) {
-            neurons[dest_neuron].v_mem += weight;
+        if (neurons.refractory[dest_neuron] == 0) {
+            neurons.v_mem[dest_neuron] += weight;
             synaptic_ops_count++;
             
             // printf("RECV_SPIKE: 核心%u处理脉冲成功 - 神经元%u: %.3f + %.3f = %.3f\n",
-            //        node_id, dest_neuron, old_v_mem, weight, neurons[dest_neuron].v_mem);
+            //        node_id, dest_neuron, old_v_mem, weight, neurons.v_mem[dest_neuron]);
             
             // 检查是否发放脉冲
-            if (neurons[dest_neuron].v_mem >= v_thresh) {
+            if (neurons.v_mem[dest_neuron] >= v_thresh) {
                 // printf("RECV_SPIKE: 核心%u神经元%u达到阈值，将发放脉冲！(%.3f >= %.3f)\n",
-                //        node_id, dest_neuron, neurons[dest_neuron].v_mem, v_thresh);
+                //        node_id, dest_neuron, neurons.v_mem[dest_neuron], v_thresh);
             }
             
             checkAndFireSpike(dest_neuron);
         } else {
-            printf("RECV_SPIKE: 核心%u神经元%u在不应期，忽略脉冲\n", node_id, dest_neuron);
+            SNNDL_TRACE(output, 3, 0, "RECV_SPIKE: 核心%u神经元%u在不应期，忽略脉冲\n", node_id, dest_neuron);
         }
     }
     
@@ -583,6 +664,33 @@ void SnnPE::handleInterfaceSpike(SpikeEvent* spike_event) {
 bool SnnPE::loadWeights(const std::string& file_path) {
     output->verbose(CALL_INFO, 1, 0, "🚨🚨🚨 LOADWEIGHTS_ENTRY: 新版本loadWeights函数被调用！文件: %s\n", file_path.c_str());
     output->verbose(CALL_INFO, 1, 0, "尝试打开权重文件: %s\n", file_path.c_str());
+    
+    // CSR格式：共享只读映射，只复制本核心的行区间
+    if (CsrWeightStore::isCsrFile(file_path)) {
+        std::string error;
+        std::shared_ptr<const CsrWeightStore> store = CsrWeightStore::open(file_path, error);
+        if (!store) {
+            output->verbose(CALL_INFO, 1, 0, "无法映射CSR权重文件 %s: %s\n", file_path.c_str(), error.c_str());
+            return false;
+        }
+        CsrView rows = store->globalRows(neuron_id_start, num_neurons);
+        csr_row_ptr.assign(num_neurons + 1, 0);
+        csr_col_indices.clear();
+        csr_weights.clear();
+        if (!rows.empty()) {
+            uint64_t first = rows.rowBegin(0);
+            uint64_t last = rows.rowEnd(rows.rows - 1);
+            csr_col_indices.assign(rows.col + first, rows.col + last);
+            csr_weights.assign(rows.weight + first, rows.weight + last);
+            for (uint32_t i = 0; i <= num_neurons; i++) {
+                csr_row_ptr[i] = (i <= rows.rows ? rows.row_ptr[i] : last) - first;
+            }
+        }
+        output->verbose(CALL_INFO, 1, 0, "CSR权重文件映射完成: 本核心%u行, %zu个突触连接\n",
+                       rows.rows, csr_weights.size());
+        return true;
+    }
+    
     std::ifstream file(file_path, std::ios::binary); // 以二进制模式打开
     if (!file.is_open()) {
         output->verbose(CALL_INFO, 1, 0, "无法打开权重文件: %s\n", file_path.c_str());
@@ -614,13 +722,24 @@ bool SnnPE::loadWeights(const std::string& file_path) {
     uint32_t connections_loaded = 0;
     uint32_t cross_core_connections = 0;
     
-    for (uint32_t i = 0; i < total_connections; ++i) {
-        uint32_t global_pre_id, global_post_id;
+    // 一次读入全部记录，避免逐字段的小读
+    struct WeightRecord {
+        uint32_t pre;
+        uint32_t post;
         float weight;
-        
-        file.read(reinterpret_cast<char*>(&global_pre_id), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&global_post_id), sizeof(uint32_t));
-        file.read(reinterpret_cast<char*>(&weight), sizeof(float));
+    };
+    static_assert(sizeof(WeightRecord) == 12, "权重记录应为12字节");
+    std::vector<WeightRecord> records(total_connections);
+    file.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(WeightRecord));
+    if (static_cast<size_t>(file.gcount()) != records.size() * sizeof(WeightRecord)) {
+        output->verbose(CALL_INFO, 1, 0, "错误: 权重记录不完整，期望%u条\n", total_connections);
+        return false;
+    }
+    
+    for (uint32_t i = 0; i < total_connections; ++i) {
+        uint32_t global_pre_id = records[i].pre;
+        uint32_t global_post_id = records[i].post;
+        float weight = records[i].weight;
         
         // 检查此连接的突触前神经元是否属于本核心
         if (global_pre_id >= neuron_id_start && global_pre_id < neuron_id_start + num_neurons) {
@@ -678,10 +797,18 @@ bool SnnPE::loadWeights(const std::string& file_path) {
     return true;
 }
 
-void SnnPE::applyLeak(uint32_t neuron_idx) {
-    float& v_mem = neurons[neuron_idx].v_mem;
-    // 指数泄漏: v(t+dt) = v_rest + (v(t) - v_rest) * exp(-dt/tau)
-    v_mem = v_rest + (v_mem - v_rest) * leak_factor;
+void SnnPE::quantizeWeights() {
+    if (!weight_precision.isFixed()) return;
+    csr_weight_codes.resize(csr_weights.size());
+    uint64_t saturated = 0;
+    for (size_t i = 0; i < csr_weights.size(); i++) {
+        if (weight_precision.saturates(csr_weights[i])) saturated++;
+        csr_weight_codes[i] = static_cast<int16_t>(weight_precision.quantize(csr_weights[i]));
+    }
+    output->verbose(CALL_INFO, 1, 0, "权重量化为%s: %zu个突触, lsb=%g, 饱和%" PRIu64 "个, 存储%zu -> %zu字节\n",
+                   weight_precision.name(), csr_weight_codes.size(), weight_precision.lsb(), saturated,
+                   csr_weights.size() * sizeof(float), csr_weight_codes.size() * sizeof(int16_t));
+    std::vector<float>().swap(csr_weights);
 }
 
 void SnnPE::checkAndFireSpike(uint32_t neuron_idx) {
@@ -696,18 +823,18 @@ void SnnPE::checkAndFireSpike(uint32_t neuron_idx) {
     }
     
     output->verbose(CALL_INFO, 2, 0, "检查神经元%u发放: v_mem=%.6f, 阈值=%.6f\n",
-                   neuron_idx, neurons[neuron_idx].v_mem, v_thresh);
+                   neuron_idx, neurons.v_mem[neuron_idx], v_thresh);
     
-    if (neurons[neuron_idx].v_mem >= v_thresh) {
+    if (neurons.v_mem[neuron_idx] >= v_thresh) {
         recursion_depth++;  // 增加递归计数
         
         // 发放脉冲
         output->verbose(CALL_INFO, 2, 0, "🔥 神经元%u发放脉冲! (v_mem=%.6f >= v_thresh=%.6f)\n",
-                       neuron_idx, neurons[neuron_idx].v_mem, v_thresh);
+                       neuron_idx, neurons.v_mem[neuron_idx], v_thresh);
         
         // 立即重置神经元状态，防止在递归中重复触发
-        neurons[neuron_idx].v_mem = v_reset;
-        neurons[neuron_idx].refractory_timer = t_ref;
+        neurons.v_mem[neuron_idx] = v_reset;
+        neurons.refractory[neuron_idx] = t_ref;
         
         // 更新统计
         spikes_generated_count++;
@@ -727,29 +854,29 @@ void SnnPE::checkAndFireSpike(uint32_t neuron_idx) {
         
         // DEBUG: 验证行边界的合法性
         output->verbose(CALL_INFO, 2, 0, "DEBUG: 神经元%u CSR访问 - 行边界[%lu, %lu), csr_col_indices.size()=%zu, csr_weights.size()=%zu\n", 
-                       neuron_idx, row_start, row_end, csr_col_indices.size(), csr_weights.size());
+                       neuron_idx, row_start, row_end, csr_col_indices.size(), csrWeightCount());
         
-        if (row_end > csr_col_indices.size() || row_end > csr_weights.size()) {
+        if (row_end > csr_col_indices.size() || row_end > csrWeightCount()) {
             output->verbose(CALL_INFO, 1, 0, "错误: 神经元%u的行边界[%lu, %lu)超出CSR数据范围\n", 
                            neuron_idx, row_start, row_end);
             recursion_depth--;
             return;
         }
         
-        output->verbose(CALL_INFO, 4, 0, "处理神经元%u的%lu个输出连接\n", 
+        SNNDL_TRACE(output, 4, 0, "处理神经元%u的%lu个输出连接\n", 
                        neuron_idx, row_end - row_start);
         
         // 遍历所有连接，发送脉冲到目标神经元
         for (uint64_t i = row_start; i < row_end; i++) {
             // 额外安全检查：确保索引在有效范围内
-            if (i >= csr_col_indices.size() || i >= csr_weights.size()) {
+            if (i >= csr_col_indices.size() || i >= csrWeightCount()) {
                 output->verbose(CALL_INFO, 1, 0, "CRITICAL: 索引%lu超出CSR数据范围（col_size=%zu, weights_size=%zu）\n", 
-                               i, csr_col_indices.size(), csr_weights.size());
+                               i, csr_col_indices.size(), csrWeightCount());
                 break;  // 立即停止处理这个神经元
             }
             
             uint32_t global_target_neuron = csr_col_indices[i];
-            float weight = csr_weights[i];
+            float weight = csrWeight(i);
             
             // 验证目标神经元ID的合理性
             if (global_target_neuron > 1000) {  // 设置一个合理的上限
@@ -764,23 +891,23 @@ void SnnPE::checkAndFireSpike(uint32_t neuron_idx) {
             uint32_t dest_node_id = global_target_neuron / num_neurons;
             uint32_t local_target_neuron = global_target_neuron % num_neurons;
             
-            output->verbose(CALL_INFO, 4, 0, "脉冲连接: 本地神经元%u (全局%u) -> 全局神经元%u (核心%u:神经元%u), 权重=%.3f\n",
+            SNNDL_TRACE(output, 4, 0, "脉冲连接: 本地神经元%u (全局%u) -> 全局神经元%u (核心%u:神经元%u), 权重=%.3f\n",
                            neuron_idx, neuron_id_start + neuron_idx, global_target_neuron, dest_node_id, local_target_neuron, weight);
             
             // 检查是否为本地连接
             if (global_target_neuron >= neuron_id_start && global_target_neuron < neuron_id_start + num_neurons) {
                 // 本地连接：直接处理
                 uint32_t true_local_target = global_target_neuron - neuron_id_start;
-                output->verbose(CALL_INFO, 4, 0, "本地连接: 神经元%u -> 神经元%u\n",
+                SNNDL_TRACE(output, 4, 0, "本地连接: 神经元%u -> 神经元%u\n",
                                neuron_idx, true_local_target);
                 
                 // 检查目标神经元是否在不应期
-                if (neurons[true_local_target].refractory_timer == 0) {
-                    neurons[true_local_target].v_mem += weight;
+                if (neurons.refractory[true_local_target] == 0) {
+                    neurons.v_mem[true_local_target] += weight;
                     synaptic_ops_count++;
                     
-                    output->verbose(CALL_INFO, 5, 0, "本地突触更新: 神经元%u, 新v_mem=%.3f\n",
-                                   true_local_target, neurons[true_local_target].v_mem);
+                    SNNDL_TRACE(output, 5, 0, "本地突触更新: 神经元%u, 新v_mem=%.3f\n",
+                                   true_local_target, neurons.v_mem[true_local_target]);
                     
                     // 递归检查是否触发新的脉冲（现在有深度限制）
                     checkAndFireSpike(true_local_target);
@@ -788,7 +915,7 @@ void SnnPE::checkAndFireSpike(uint32_t neuron_idx) {
                 
             } else {
                 // 跨核连接：需要发送脉冲事件
-                output->verbose(CALL_INFO, 3, 0, "跨核连接: 本地神经元%u -> 全局神经元%u (核心%u:神经元%u)\n",
+                SNNDL_TRACE(output, 3, 0, "跨核连接: 本地神经元%u -> 全局神经元%u (核心%u:神经元%u)\n",
                                neuron_idx, global_target_neuron, dest_node_id, local_target_neuron);
                 
                 // 创建脉冲事件
@@ -823,6 +950,8 @@ void SnnPE::checkAndFireSpike(uint32_t neuron_idx) {
 bool SnnPE::handleRouterRequest(int vn) {
     if (!router) return false;
     
+    wakeClock();
+    
     SST::Interfaces::SimpleNetwork::Request* req = router->recv(vn);
     while (req) {
         // 解析脉冲数据包
@@ -878,7 +1007,7 @@ void SnnPE::routeSpike(SpikeEvent* spike_event, uint32_t target_node) {
         // 发送
         router->send(req, 0);
         
-        output->verbose(CALL_INFO, 3, 0, "路由脉冲：节点%u -> 节点%u\n", node_id, target_node);
+        SNNDL_TRACE(output, 3, 0, "路由脉冲：节点%u -> 节点%u\n", node_id, target_node);
     } else {
         output->verbose(CALL_INFO, 1, 0, "警告：路由器缓冲区满，丢弃脉冲到节点%u\n", target_node);
     }
@@ -891,13 +1020,13 @@ void SnnPE::processLocalSpike(SpikeEvent* spike_event) {
     if (target_neuron < num_neurons) {
         // 应用突触权重
         float weight = spike_event->getWeight();
-        neurons[target_neuron].v_mem += weight;
+        neurons.v_mem[target_neuron] += weight;
         
         synaptic_ops_count++;
         spikes_received_count++;
         
-        output->verbose(CALL_INFO, 3, 0, "处理本地脉冲：神经元%u，权重=%.3f，新膜电位=%.3f\n",
-                       target_neuron, weight, neurons[target_neuron].v_mem);
+        SNNDL_TRACE(output, 3, 0, "处理本地脉冲：神经元%u，权重=%.3f，新膜电位=%.3f\n",
+                       target_neuron, weight, neurons.v_mem[target_neuron]);
         
         // 检查是否发放脉冲
         checkAndFireSpike(target_neuron);
@@ -906,7 +1035,9 @@ void SnnPE::processLocalSpike(SpikeEvent* spike_event) {
 
 // ===== 内存响应处理器 (使用StandardMem接口) =====
 void SnnPE::handleMemResponse(SST::Interfaces::StandardMem::Request *req) {
-    output->verbose(CALL_INFO, 3, 0, "接收到内存响应\n");
+    wakeClock();
+    
+    SNNDL_TRACE(output, 3, 0, "接收到内存响应\n");
     
     // 确保这是一个ReadResp
     SST::Interfaces::StandardMem::ReadResp* readResp = 
@@ -929,7 +1060,7 @@ void SnnPE::handleMemResponse(SST::Interfaces::StandardMem::Request *req) {
     SpikeEvent* original_spike = pending_req.original_spike;
     uint32_t pre_syn_id = original_spike->neuron_id;
     
-    output->verbose(CALL_INFO, 3, 0, "恢复处理神经元%u的脉冲\n", pre_syn_id);
+    SNNDL_TRACE(output, 3, 0, "恢复处理神经元%u的脉冲\n", pre_syn_id);
     
     // 从响应中提取权重数据
     std::vector<uint8_t>& data = readResp->data;
@@ -957,22 +1088,22 @@ void SnnPE::handleMemResponse(SST::Interfaces::StandardMem::Request *req) {
     for (uint32_t i = 0; i < weights_per_neuron; ++i) {
         uint32_t post_syn_id = i;  // 简化映射：权重i连接到本地神经元i
         
-        if (post_syn_id < num_neurons && neurons[post_syn_id].refractory_timer == 0) {
+        if (post_syn_id < num_neurons && neurons.refractory[post_syn_id] == 0) {
             float weight = weights[i];
-            float old_v_mem = neurons[post_syn_id].v_mem;
+            float old_v_mem = neurons.v_mem[post_syn_id];
             
-            neurons[post_syn_id].v_mem += weight;
+            neurons.v_mem[post_syn_id] += weight;
             synaptic_ops_count++;
             
             output->verbose(CALL_INFO, 2, 0, "内存突触输入: %u -> %u, 权重=%.6f, v_mem: %.6f -> %.6f, 阈值=%.6f\n",
-                           pre_syn_id, post_syn_id, weight, old_v_mem, neurons[post_syn_id].v_mem, v_thresh);
+                           pre_syn_id, post_syn_id, weight, old_v_mem, neurons.v_mem[post_syn_id], v_thresh);
             
             // 检查是否发放脉冲
             checkAndFireSpike(post_syn_id);
         }
     }
     
-    output->verbose(CALL_INFO, 3, 0, "完成处理神经元%u的脉冲（内存模式）\n", pre_syn_id);
+    SNNDL_TRACE(output, 3, 0, "完成处理神经元%u的脉冲（内存模式）\n", pre_syn_id);
     
     // 清理
     delete original_spike;
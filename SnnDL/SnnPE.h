@@ -24,6 +24,10 @@
 
 #include "SpikeEvent.h"
 #include "SnnInterface.h"
+#include "NeuronStateArray.h"
+#include "NeuronUpdatePool.h"
+#include "CsrWeightStore.h"
+#include "FixedPoint.h"
 
 namespace SST {
 namespace SnnDL {
@@ -41,19 +45,6 @@ struct PendingRequest {
     PendingRequest(SpikeEvent* spike) : original_spike(spike), request_time(0) {}
 };
 
-/**
- * @brief 神经元状态结构体
- * 
- * 存储每个神经元的动态状态信息
- */
-struct NeuronState {
-    float v_mem;                    ///< 当前膜电位
-    uint32_t refractory_timer;      ///< 不应期计数器
-    
-    /** 构造函数，初始化为静息状态 */
-    NeuronState(float v_rest = 0.0f) : v_mem(v_rest), refractory_timer(0) {}
-};
-
 /**
  * @brief 单核脉冲神经网络处理单元
  * 
@@ -93,7 +84,12 @@ public:
         {"test_target_node", "测试流量的目标节点ID", "0"},
         {"test_period", "测试流量发送周期(周期数)", "100"},
         {"test_spikes_per_burst", "每次周期性发送的测试脉冲数量", "4"},
-        {"test_weight", "测试脉冲权重", "0.2"}
+        {"test_weight", "测试脉冲权重", "0.2"},
+        {"enable_clock_suspend", "空闲时注销时钟，脉冲或内存响应到达时重新注册并补算泄漏", "0"},
+        {"update_threads", "逐周期泄漏/阈值更新使用的线程数（含组件线程），1为串行", "1"},
+        {"update_min_neurons_per_thread", "每个更新线程至少分到的神经元数，规模不足时少用线程", "8192"},
+        {"weight_precision", "本地CSR权重的存储精度 [float32|int16|int8]，定点时按码字存放（就近舍入、饱和）", "float32"},
+        {"weight_scale", "定点权重一个码字对应的数值(lsb)", "0.015625"}
     )
 
     // SubComponent槽位文档 - 参考standardCPU的设计
@@ -173,10 +169,24 @@ private:
     bool loadWeights(const std::string& file_path);
     
     /**
-     * @brief 应用泄漏动态到指定神经元
-     * @param neuron_idx 神经元索引
+     * @brief 定点精度下把 csr_weights 转为码字存储并释放浮点数组
      */
-    void applyLeak(uint32_t neuron_idx);
+    void quantizeWeights();
+    
+    /** 第 i 个突触的权重（按当前存储精度解码） */
+    float csrWeight(uint64_t i) const {
+        return weight_precision.isFixed() ? weight_precision.dequantize(csr_weight_codes[i]) : csr_weights[i];
+    }
+    
+    /** 已存储的突触权重数 */
+    size_t csrWeightCount() const {
+        return weight_precision.isFixed() ? csr_weight_codes.size() : csr_weights.size();
+    }
+    
+    /**
+     * @brief 若时钟已挂起则重新注册，并按闭式补算挂起期间的泄漏与不应期
+     */
+    void wakeClock();
     
     /**
      * @brief 检查神经元是否发放脉冲并处理
@@ -249,11 +259,15 @@ private:
     uint32_t t_ref;                         ///< 不应期时长
     float leak_factor;                      ///< 预计算的泄漏因子
     
-    // 神经元状态单元（NSU）
-    std::vector<NeuronState> neurons;       ///< 神经元状态数组
+    // 神经元状态单元（NSU），SoA布局以支持向量化更新
+    NeuronStateArray neurons;               ///< 神经元状态数组
+    std::vector<uint32_t> fired_indices;    ///< 每周期更新内核输出的达到阈值的神经元
+    NeuronUpdatePool* update_pool;          ///< 多线程更新工作池（update_threads<=1时为nullptr）
     
     // 突触权重存储器（SWM）- CSR格式
-    std::vector<float> csr_weights;         ///< 突触权重值
+    std::vector<float> csr_weights;         ///< 突触权重值（float32精度）
+    std::vector<int16_t> csr_weight_codes;  ///< 突触权重码字（int16/int8精度）
+    FixedPointFormat weight_precision;      ///< 权重存储精度
     std::vector<uint32_t> csr_col_indices;  ///< 列（突触后神经元）索引
     std::vector<uint64_t> csr_row_ptr;      ///< 行指针数组
     
@@ -275,6 +289,14 @@ private:
     uint32_t test_period;                   ///< 周期
     uint32_t test_spikes_per_burst;         ///< 每次发送脉冲数量
     float test_weight;                      ///< 脉冲权重
+    
+    // 空闲时钟挂起
+    bool enable_clock_suspend;              ///< 是否启用空闲时钟挂起
+    bool clock_suspended;                   ///< 时钟当前是否已挂起
+    TimeConverter* clock_tc;                ///< 时钟时间转换器
+    Clock::HandlerBase* clock_handler;      ///< 时钟处理器（重新注册时复用）
+    SST::Cycle_t last_tick_cycle;           ///< 最后一次执行时钟处理器的周期号
+    uint64_t suspended_cycles;              ///< 挂起期间跳过的周期数
 };
 
 } // namespace SnnDL
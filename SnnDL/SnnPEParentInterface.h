@@ -16,6 +16,8 @@ namespace SnnDL {
 
 // 前置声明
 class SpikeEvent;
+class TraceRing;
+class SpikeRecorder;
 
 /**
  * @brief SnnPE与父级组件的通信接口
@@ -40,6 +42,16 @@ public:
      */
     virtual void sendSpike(SpikeEvent* event) = 0;
     
+    /**
+     * @brief 父级组件当前能否接收核心发出的脉冲
+     * 
+     * 核间互连或外部网络接口的有界队列已满时返回false，核心应把
+     * 发放输出暂存在自己的输出缓冲中，待返回true后再逐个发送。
+     * 
+     * @return true表示可以调用sendSpike
+     */
+    virtual bool canSendSpike() const { return true; }
+    
     /**
      * @brief 向父级组件请求内存访问
      * 
@@ -73,6 +85,22 @@ public:
      * @return 神经元总数
      */
     virtual int getTotalNeurons() const = 0;
+    
+    /**
+     * @brief 获取父级组件的二进制事件环
+     * 
+     * 核心在热路径上经 SNNDL_TRACE_EVENT 记录事件，finish() 时由父级统一转储。
+     * 
+     * @return 未启用跟踪时返回nullptr
+     */
+    virtual TraceRing* getTraceRing() const { return nullptr; }
+    
+    /**
+     * @brief 获取父级组件的发放栅格/流量记录器
+     * 
+     * @return 未配置record_file时返回nullptr
+     */
+    virtual SpikeRecorder* getRecorder() const { return nullptr; }
 };
 
 } // namespace SnnDL
@@ -18,6 +18,9 @@
 using namespace SST;
 using namespace SST::SnnDL;
 
+// warm start 快照中核心状态段的格式版本（见 saveState）
+static const uint32_t CORE_STATE_VERSION = 1;
+
 SnnPESubComponent::SnnPESubComponent(ComponentId_t id, Params& params)
     : SnnCoreAPI(id, params), parent_(nullptr) {
     
@@ -31,19 +34,34 @@ SnnPESubComponent::SnnPESubComponent(ComponentId_t id, Params& params)
     v_rest_ = params.find<float>("v_rest", 0.0f);
     tau_mem_ = params.find<float>("tau_mem", 20.0f);
     t_ref_ = params.find<uint32_t>("t_ref", 2);
+    lazy_leak_ = params.find<int>("lazy_leak", 0) != 0;
+    enable_clock_suspend_ = params.find<int>("enable_clock_suspend", 0) != 0;
     base_addr_ = params.find<uint64_t>("base_addr", 0);
+    // 内存权重块：WeightLoader 为每个核心写入 rows×rows 的块，行列均为块内索引
+    weight_rows_ = params.find<uint32_t>("weight_rows", 0);
+    if (weight_rows_ == 0) weight_rows_ = num_neurons_;
+    weight_block_offset_ = params.find<uint32_t>("weight_block_offset", 0);
     node_id_ = params.find<uint32_t>("node_id", 0);
     verbose_ = params.find<int>("verbose", 0);
     enable_weight_fetch_ = params.find<int>("enable_weight_fetch", 0) != 0;
+    memory_port_ = params.find<std::string>("memory_port", "");
     write_weights_on_init_ = params.find<int>("write_weights_on_init", 1) != 0;
     memory_warmup_cycles_ = params.find<uint64_t>("memory_warmup_cycles", 1000);
     init_default_weight_ = params.find<float>("init_default_weight", 0.5f);
     max_outstanding_requests_ = params.find<uint32_t>("max_outstanding_requests", 16);
+    output_backlog_depth_ = params.find<uint32_t>("output_backlog_depth", 1024);
+    synaptic_delay_ = params.find<uint32_t>("synaptic_delay", 0);
+    incoming_spikes_.configure(std::max<uint32_t>(params.find<uint32_t>("spike_queue_horizon", 16), synaptic_delay_ + 1));
+    deterministic_spike_order_ = params.find<int>("deterministic_spike_order", 1) != 0;
+    batch_fire_check_ = params.find<int>("batch_fire_check", 1) != 0;
     max_cache_entries_ = params.find<uint32_t>("max_cache_entries", 4096);
+    uint32_t cache_ways = params.find<uint32_t>("weight_cache_ways", 8);
+    std::string cache_policy_name = params.find<std::string>("weight_cache_policy", "lru");
     use_event_weight_fallback_ = params.find<int>("use_event_weight_fallback", 0) != 0;
     event_weight_fallback_warned_ = false;
     merge_read_cacheline_ = params.find<int>("merge_read_cacheline", 1) != 0;
     merge_read_row_ = params.find<int>("merge_read_row", 0) != 0;
+    row_fanout_delivery_ = params.find<int>("row_fanout_delivery", 0) != 0;
     line_size_bytes_ = params.find<uint32_t>("line_size_bytes", 64);
     enable_detailed_map_log_ = params.find<int>("enable_detailed_map_log", 0) != 0;
     // 权重验证参数
@@ -55,12 +73,43 @@ SnnPESubComponent::SnnPESubComponent(ComponentId_t id, Params& params)
     
     // 获取权重文件路径
     weights_file_path_ = params.find<std::string>("weights_file", "");
+    std::string connectivity_file = params.find<std::string>("connectivity_file", "");
+    std::string connectivity_format = params.find<std::string>("connectivity_format", "auto");
 
     // 参数日志改至 setup 以避免构造早期潜在问题
     
     // 初始化输出对象
     output_ = new Output("SnnPESubComponent[@p:@l]: ", verbose_, 0, Output::STDOUT);
     
+    // 配置组相联权重缓存
+    WeightCache::Policy cache_policy = WeightCache::Policy::LRU;
+    if (!WeightCache::parsePolicy(cache_policy_name, cache_policy)) {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 未知的weight_cache_policy '%s' (可选 lru|clock)\n",
+                       cache_policy_name.c_str());
+    }
+    weight_cache_.configure(max_cache_entries_, cache_ways, cache_policy);
+    
+    // 内存权重布局（须与WeightLoader一致）
+    std::string weight_layout = params.find<std::string>("weight_layout", "dense");
+    if (weight_layout == "csr") {
+        sparse_layout_ = true;
+    } else if (weight_layout != "dense") {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 未知的weight_layout '%s' (可选 dense|csr)\n",
+                       weight_layout.c_str());
+    }
+    if (static_cast<uint64_t>(weight_block_offset_) + weight_rows_ > num_neurons_) {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d权重块[%u, %u)超出神经元范围%u\n", core_id_,
+                       weight_block_offset_, weight_block_offset_ + weight_rows_, num_neurons_);
+    }
+    std::string precision_error;
+    if (!FixedPointFormat::parse(params.find<std::string>("weight_precision", "float32"),
+                                 params.find<float>("weight_scale", 1.0f / 64.0f), weight_precision_, precision_error) ||
+        !FixedPointFormat::parse(params.find<std::string>("membrane_precision", "float32"),
+                                 params.find<float>("membrane_scale", 1.0f / 1024.0f), membrane_precision_,
+                                 precision_error)) {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d %s\n", core_id_, precision_error.c_str());
+    }
+    
     // output_->verbose(CALL_INFO, 1, 0, "🔧 初始化SnnPE SubComponent (核心%d, %u个神经元)\n", 
     //                 core_id_, num_neurons_);
     
@@ -68,10 +117,97 @@ SnnPESubComponent::SnnPESubComponent(ComponentId_t id, Params& params)
     // output_->verbose(CALL_INFO, 1, 0, "🔍 权重验证配置: verify_weights=%d, samples=%u, expected=%.3f, log_each=%d\n",
     //                 verify_weights_ ? 1 : 0, weight_verify_samples_, expected_weight_value_, verify_log_each_sample_ ? 1 : 0);
     
+    // 向量化内核（--enable-snndl-simd 单独以 -mavx2/-mavx512f 编译 NeuronStateArray.cc）须在首次调用前确认CPU支持
+    const char* kernel = NeuronStateArray::kernelName();
+#if defined(__x86_64__) || defined(__i386__)
+    if ((std::strcmp(kernel, "avx512") == 0 && !__builtin_cpu_supports("avx512f")) ||
+        (std::strcmp(kernel, "avx2") == 0 && !__builtin_cpu_supports("avx2"))) {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d神经元更新内核以%s编译，当前CPU不支持；请以 --enable-snndl-simd=no 重新配置\n",
+                       core_id_, kernel);
+    }
+#endif
+    output_->verbose(CALL_INFO, 2, 0, "🧠 核心%d神经元更新内核: %s\n", core_id_, kernel);
+    
     // 初始化神经元状态（复用SnnPE逻辑）
-    neuron_states_.resize(num_neurons_);
-    for (uint32_t i = 0; i < num_neurons_; i++) {
-        neuron_states_[i] = NeuronState(v_rest_);
+    neuron_states_.resize(num_neurons_, v_rest_);
+    
+    // 神经元模型：每次遍历一次虚调用，区间内为按内核实例化的逐神经元循环
+    NeuronModelParams model_params;
+    model_params.v_thresh = v_thresh_;
+    model_params.v_reset = v_reset_;
+    model_params.v_rest = v_rest_;
+    model_params.tau_mem = tau_mem_;
+    model_params.t_ref = t_ref_;
+    model_params.izh_a = params.find<float>("izh_a", model_params.izh_a);
+    model_params.izh_b = params.find<float>("izh_b", model_params.izh_b);
+    model_params.izh_c = params.find<float>("izh_c", model_params.izh_c);
+    model_params.izh_d = params.find<float>("izh_d", model_params.izh_d);
+    model_params.izh_dt = params.find<float>("izh_dt", model_params.izh_dt);
+    model_params.izh_v_peak = params.find<float>("izh_v_peak", model_params.izh_v_peak);
+    model_params.alif_tau_adapt = params.find<float>("alif_tau_adapt", model_params.alif_tau_adapt);
+    model_params.alif_beta = params.find<float>("alif_beta", model_params.alif_beta);
+    model_params.membrane = membrane_precision_;
+    std::string model_name = params.find<std::string>("neuron_model", "lif");
+    std::string model_error;
+    neuron_model_ = NeuronModel::create(model_name, model_params, model_error);
+    if (!neuron_model_) {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d %s\n", core_id_, model_error.c_str());
+    }
+    // 惰性补算只推进收到输入的神经元：izhikevich/alif 的自发放电与适应驱动的发放需要逐周期扫描
+    if (lazy_leak_ && std::strcmp(neuron_model_->name(), "lif") != 0) {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d lazy_leak=1 仅支持lif模型，当前为%s\n",
+                       core_id_, neuron_model_->name());
+    }
+    neuron_model_->initialize(neuron_states_);
+    output_->verbose(CALL_INFO, 2, 0, "🧠 核心%d神经元模型: %s, 权重精度=%s, 膜电位精度=%s\n", core_id_,
+                     neuron_model_->name(), weight_precision_.name(), membrane_precision_.name());
+    fired_indices_.reserve(num_neurons_);
+    int update_threads = params.find<int>("update_threads", 1);
+    uint32_t update_min_neurons = params.find<uint32_t>("update_min_neurons_per_thread", 8192);
+    if (update_threads > 1 && !lazy_leak_) {
+        update_pool_ = new NeuronUpdatePool(update_threads, update_min_neurons);
+    }
+    fire_counts_.assign(num_neurons_, 0);
+    touched_mask_.assign(num_neurons_, 0);
+    delay_line_.configure(params.find<uint32_t>("max_synaptic_delay", 0), num_neurons_);
+    
+    // warm start：从快照恢复神经元状态、权重缓存以及已解析的连接表/延迟表
+    std::string warm_start_file = params.find<std::string>("warm_start_file", "");
+    if (!warm_start_file.empty()) {
+        StateSnapshotHeader header;
+        std::vector<uint8_t> state;
+        std::string error;
+        if (!readCoreStateSnapshot(warm_start_file, static_cast<uint32_t>(core_id_), header, state, error)) {
+            output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d %s\n", core_id_, error.c_str());
+        }
+        if (header.node_id != node_id_ || header.num_cores != static_cast<uint32_t>(total_cores_)) {
+            output_->fatal(CALL_INFO, -1, "❌ 错误: 快照 %s 属于节点%u(%u核)，与核心%d所在节点%u(%d核)不符\n",
+                           warm_start_file.c_str(), header.node_id, header.num_cores, core_id_, node_id_, total_cores_);
+        }
+        if (!restoreState(state, error)) {
+            output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d无法从快照 %s 恢复: %s\n",
+                           core_id_, warm_start_file.c_str(), error.c_str());
+        }
+        warm_started_ = true;
+        memory_warmup_cycles_ = 0;
+        output_->verbose(CALL_INFO, 1, 0, "♻️ 核心%d从快照 %s 恢复 (保存于周期%" PRIu64 ", %zu字节, 缓存条目=%u, 连接表=%s)\n",
+                         core_id_, warm_start_file.c_str(), header.cycle, state.size(), weight_cache_.size(),
+                         fanout_loaded_ ? "已恢复" : "未包含");
+    }
+    
+    // 加载CSR扇出连接表（未配置时沿用固定分层路由；已由快照恢复时跳过解析）
+    neurons_per_core_ = std::max<uint32_t>(1, num_neurons_ / static_cast<uint32_t>(std::max(1, total_cores_)));
+    if (!fanout_loaded_ && !connectivity_file.empty() && !loadConnectivity(connectivity_file, connectivity_format)) {
+        output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d无法加载连接表 %s\n", core_id_, connectivity_file.c_str());
+    }
+    std::string delay_file = params.find<std::string>("delay_file", "");
+    if (!delay_file.empty() && fanout_delays_.empty()) {
+        if (!fanout_loaded_) {
+            output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d配置了delay_file但没有connectivity_file\n", core_id_);
+        }
+        if (!loadDelays(delay_file)) {
+            output_->fatal(CALL_INFO, -1, "❌ 错误: 核心%d无法加载突触延迟 %s\n", core_id_, delay_file.c_str());
+        }
     }
     
     // 初始化内存访问
@@ -84,10 +220,13 @@ SnnPESubComponent::SnnPESubComponent(ComponentId_t id, Params& params)
     // 初始化统计变量
     total_cycles_ = 0;
     active_cycles_ = 0;
+    suspended_cycles_ = 0;
+    clock_suspended_ = false;
+    last_tick_cycle_ = 0;
     boot_read_sent_ = false;
     boot_write_sent_ = false;
     delayed_read_counter_ = 0;
-    delayed_read_triggered_ = false;
+    delayed_read_triggered_ = warm_started_;  // warm start时读通路已在保存前的运行中验证过
     weights_initialized_ = false;
     memory_ready_ = false;
     stat_spikes_received_ = nullptr;
@@ -96,21 +235,22 @@ SnnPESubComponent::SnnPESubComponent(ComponentId_t id, Params& params)
     stat_memory_requests_ = nullptr;
     stat_weight_cache_hits_ = nullptr;
     stat_weight_cache_misses_ = nullptr;
+    stat_weight_cache_evictions_ = nullptr;
     stat_merged_reads_rows_ = nullptr;
     stat_merged_reads_cls_ = nullptr;
+    stat_row_spikes_deferred_ = nullptr;
+    stat_fanout_messages_ = nullptr;
+    stat_fanout_synapses_ = nullptr;
     stat_weights_verify_count_ = nullptr;
     stat_weights_mismatch_count_ = nullptr;
     stat_weights_verify_sum_ = nullptr;
     
     // 初始化内部计数器
-    count_spikes_received_ = 0;
-    count_spikes_generated_ = 0;
-    count_neurons_fired_ = 0;
-    count_memory_requests_ = 0;
     
     // 配置时钟
     std::string clock_freq = "1GHz";
-    registerClock(clock_freq, new Clock::Handler2<SnnPESubComponent,&SnnPESubComponent::clockTick>(this));
+    clock_handler_ = new Clock::Handler2<SnnPESubComponent,&SnnPESubComponent::clockTick>(this);
+    clock_tc_ = registerClock(clock_freq, clock_handler_);
     
     // 立即注册统计，避免在调用 getStatistics 前指针为空
     initializeStatistics();
@@ -122,16 +262,18 @@ SnnPESubComponent::~SnnPESubComponent() {
     // output_->verbose(CALL_INFO, 1, 0, "🗑️ 销毁SnnPE SubComponent核心%d\n", core_id_);
     
     // 清理脉冲队列
-    while (!incoming_spikes_.empty()) {
-        delete incoming_spikes_.front();
-        incoming_spikes_.pop();
-    }
+    incoming_spikes_.clear();
+    for (SpikeEvent* spike : output_backlog_) delete spike;
+    output_backlog_.clear();
     
+    delete update_pool_;
     delete output_;
 }
 
 void SnnPESubComponent::setParentInterface(SnnPEParentInterface* parent) {
     parent_ = parent;
+    trace_ring_ = parent ? parent->getTraceRing() : nullptr;
+    recorder_ = parent ? parent->getRecorder() : nullptr;
     // output_->verbose(CALL_INFO, 2, 0, "🔗 核心%d设置父级接口\n", core_id_);
 }
 
@@ -142,8 +284,8 @@ void SnnPESubComponent::init(unsigned int phase) {
         // 初始化统计收集
         initializeStatistics();
         
-        // 配置内存端口（可选，但不覆盖已设置的链接）
-        if (!memory_link_) {
+        // 配置内存端口（可选，但不覆盖已设置的链接）；共享父组件端口时 mem_link 属于父组件
+        if (!memory_link_ && memory_port_.empty()) {
             memory_link_ = configureLink("mem_link");
             if (memory_link_) output_->verbose(CALL_INFO, 2, 0, "🔗 核心%d配置mem_link\n", core_id_);
         }
@@ -153,6 +295,16 @@ void SnnPESubComponent::init(unsigned int phase) {
             "memory", ComponentInfo::SHARE_NONE,
             registerTimeBase("1ns"),
             new SST::Interfaces::StandardMem::Handler2<SnnPESubComponent, &SnnPESubComponent::handleMemoryResponse>(this));
+        if (!memory_ && !memory_port_.empty()) {
+            // 匿名核心无 memory 槽位：在父组件共享的端口上加载标准接口
+            Params mem_params;
+            mem_params.insert("port", memory_port_);
+            memory_ = loadAnonymousSubComponent<SST::Interfaces::StandardMem>(
+                "memHierarchy.standardInterface", "memory", 0,
+                ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS, mem_params,
+                registerTimeBase("1ns"),
+                new SST::Interfaces::StandardMem::Handler2<SnnPESubComponent, &SnnPESubComponent::handleMemoryResponse>(this));
+        }
         if (memory_) {
             output_->verbose(CALL_INFO, 1, 0, "✅ 核心%d加载StandardMem成功\n", core_id_);
         } else {
@@ -209,10 +361,41 @@ void SnnPESubComponent::finish() {
     // 输出统计信息（使用内部计数器获得正确值）
     output_->verbose(CALL_INFO, 1, 0, "📊 核心%d统计: 接收脉冲=%" PRIu64 ", 生成脉冲=%" PRIu64 ", 神经元发放=%" PRIu64 "\n",
                     core_id_, 
-                    count_spikes_received_,
-                    count_spikes_generated_,
-                    count_neurons_fired_);
+                    counters_.spikes_received.get(),
+                    counters_.spikes_generated.get(),
+                    counters_.neurons_fired.get());
+    if (enable_clock_suspend_) {
+        // 仿真结束时仍挂起的周期没有经过 wakeClock 补记
+        if (clock_suspended_) {
+            Cycle_t now = getCurrentSimTime(clock_tc_);
+            if (now > last_tick_cycle_) suspended_cycles_ += now - last_tick_cycle_;
+        }
+        output_->verbose(CALL_INFO, 1, 0, "💤 核心%d时钟挂起跳过周期=%" PRIu64 "\n", core_id_, suspended_cycles_);
+    }
+    if (count_fire_checks_batched_ > 0 || synaptic_delay_ > 0) {
+        output_->verbose(CALL_INFO, 1, 0, "📅 核心%d输入日历: 延迟=%u, 峰值排队=%zu, 合并阈值检查=%" PRIu64 "\n",
+                         core_id_, synaptic_delay_, incoming_spikes_.peakSize(), count_fire_checks_batched_);
+    }
+    if (delay_line_.enabled()) {
+        output_->verbose(CALL_INFO, 1, 0, "⏳ 核心%d延迟线: 深度=%u, 已取出=%" PRIu64 ", 截断=%" PRIu64 ", 未到期=%zu\n",
+                         core_id_, delay_line_.maxDelay(), count_delayed_inputs_, count_delays_clamped_,
+                         delay_line_.pending());
+    }
+    if (update_pool_) {
+        output_->verbose(CALL_INFO, 1, 0, "🧵 核心%d更新线程=%d, 并行步数=%" PRIu64 ", 串行步数=%" PRIu64 "\n",
+                         core_id_, update_pool_->threads(), update_pool_->parallelSteps(), update_pool_->serialSteps());
+    }
+    if (output_stall_cycles_ > 0 || output_spikes_dropped_ > 0) {
+        output_->verbose(CALL_INFO, 1, 0, "🚦 核心%d输出背压: 停顿周期=%" PRIu64 ", 丢弃=%" PRIu64 ", 未发出=%zu\n",
+                         core_id_, output_stall_cycles_, output_spikes_dropped_, output_backlog_.size());
+    }
 
+    if (enable_weight_fetch_) {
+        output_->verbose(CALL_INFO, 1, 0, "🗃️ 核心%d权重缓存: 命中=%" PRIu64 ", 未命中=%" PRIu64 ", 淘汰=%" PRIu64 ", 占用=%u/%u\n",
+                         core_id_, weight_cache_.hits(), weight_cache_.misses(), weight_cache_.evictions(),
+                         weight_cache_.size(), weight_cache_.capacity());
+    }
+    
     if (verify_weights_) {
         output_->verbose(CALL_INFO, 1, 0, "🔍 权重验证: 完成=%u, 不匹配=%" PRIu64 ", 平均值=%.6f (期望=%.6f)\n",
                          verify_completed_, verify_mismatch_count_,
@@ -222,6 +405,7 @@ void SnnPESubComponent::finish() {
 
 bool SnnPESubComponent::clockTick(Cycle_t current_cycle) {
     total_cycles_++;
+    last_tick_cycle_ = current_cycle;
     bool has_activity = false;
     
     // 调试权重验证状态 (仅在前几个周期输出)
@@ -233,16 +417,36 @@ bool SnnPESubComponent::clockTick(Cycle_t current_cycle) {
     }
     */
     
-    // 处理输入脉冲队列
-    while (!incoming_spikes_.empty()) {
-        SpikeEvent* spike = incoming_spikes_.front();
-        incoming_spikes_.pop();
-        
-        processLocalSpike(spike);
-        has_activity = true;
-        
-        delete spike;
+    // 父级解除背压后先发出积压的输出，保持发放顺序
+    if (!output_backlog_.empty()) {
+        drainOutputBacklog();
+        if (!output_backlog_.empty()) {
+            output_stall_cycles_++;
+            stat_output_stall_cycles_->addData(1);
+        }
+    }
+    
+    // 取出本周期到期的输入桶与延迟线槽位：先全部积分，再对被积分的神经元各做一次阈值检查
+    batching_ = batch_fire_check_;
+    size_t delivered = incoming_spikes_.drain(total_cycles_, deterministic_spike_order_,
+        [this](uint64_t, size_t count) {
+            stat_input_bucket_spikes_->addData(count);
+        },
+        [this](SpikeEvent* spike) {
+            processLocalSpike(spike);
+            delete spike;
+        },
+        [](uint64_t) {});
+    size_t delayed = delay_line_.consume(total_cycles_, [this](uint32_t neuron, float current) {
+        integrateInput(neuron, current);
+    });
+    batching_ = false;
+    flushTouched();
+    if (delayed > 0) {
+        count_delayed_inputs_ += delayed;
+        stat_delayed_inputs_->addData(delayed);
     }
+    if (delivered > 0 || delayed > 0) has_activity = true;
     
     // 启动后按需读取权重（受暖机周期与开关控制）
     if (enable_weight_fetch_ && memory_ && memory_ready_ && total_cycles_ >= memory_warmup_cycles_) {
@@ -253,7 +457,7 @@ bool SnnPESubComponent::clockTick(Cycle_t current_cycle) {
             uint32_t post = 0;
             requestWeight(pre, post, [this, pre, post](float w){
                 if (!neuron_states_.empty()) {
-                    neuron_states_[post % num_neurons_].v_mem += 0.0f; // 仅拉通读路径，不直接修改
+                    neuron_states_.v_mem[post % num_neurons_] += 0.0f; // 仅拉通读路径，不直接修改
                 }
             });
             delayed_read_triggered_ = true;
@@ -271,8 +475,8 @@ bool SnnPESubComponent::clockTick(Cycle_t current_cycle) {
         if (verify_completed_ < weight_verify_samples_ && verify_requested_ - verify_completed_ < max_outstanding_requests_) {
             uint32_t sample_idx = verify_requested_;
             // 均匀选择若干 (pre, post)
-            uint32_t pre = (sample_idx * 7) % num_neurons_;
-            uint32_t post = (sample_idx * 13) % num_neurons_;
+            uint32_t pre = (sample_idx * 7) % weight_rows_;
+            uint32_t post = (sample_idx * 13) % weight_rows_;
             requestWeight(pre, post, [this, pre, post](float w){
                 verify_completed_++;
                 verify_sum_ += static_cast<double>(w);
@@ -297,37 +501,92 @@ bool SnnPESubComponent::clockTick(Cycle_t current_cycle) {
         }
     }
 
-    // 更新神经元状态（复用SnnPE逻辑）
-    updateNeuronStates();
-    
-    // 检查并触发脉冲（复用SnnPE逻辑）
-    for (uint32_t i = 0; i < num_neurons_; i++) {
-        checkAndFireSpike(i);
+    // 惰性泄漏模式下泄漏与不应期在神经元被访问时补算；
+    // 无输入时膜电位只会衰减，不会越过阈值，因此无需逐周期扫描
+    if (!lazy_leak_) {
+        // 更新神经元状态并收集达到阈值的神经元（单次向量化遍历）
+        updateNeuronStates();
+        
+        // 仅对内核报告的神经元执行发放（复用SnnPE逻辑）
+        for (uint32_t idx : fired_indices_) {
+            checkAndFireSpike(idx);
+        }
     }
     
     if (has_activity) {
         active_cycles_++;
     }
+    publishCycleCounters();
+    
+    // 空闲时挂起时钟，由 deliverSpike/handleMemoryResponse 唤醒
+    if (enable_clock_suspend_ && canSuspendClock()) {
+        if (!lazy_leak_) {
+            // 记录挂起时刻，唤醒时据此一次性补算泄漏
+            std::fill(neuron_states_.last_update_cycle.begin(),
+                      neuron_states_.last_update_cycle.end(), total_cycles_);
+        }
+        clock_suspended_ = true;
+        SNNDL_TRACE(output_, 4, 0, "💤 核心%d空闲，挂起时钟 (周期%" PRIu64 ")\n", core_id_, total_cycles_);
+        return true;   // 注销时钟
+    }
     
     return false;  // 继续时钟
 }
 
+bool SnnPESubComponent::canSuspendClock() const {
+    if (hasWork() || !pending_memory_requests_.empty() || !deferred_row_reads_.empty()) return false;
+    if (!delay_line_.empty()) return false;
+    if (!output_backlog_.empty()) return false;
+    
+    // 暖机读取与权重验证依赖时钟推进
+    if ((enable_weight_fetch_ || verify_weights_) && memory_ && memory_ready_) {
+        if (total_cycles_ < memory_warmup_cycles_) return false;
+        if (enable_weight_fetch_ && !delayed_read_triggered_) return false;
+        if (verify_weights_ && verify_completed_ < weight_verify_samples_) return false;
+    }
+    return true;
+}
+
+void SnnPESubComponent::wakeClock() {
+    if (!clock_suspended_) return;
+    clock_suspended_ = false;
+    
+    // 重新注册后处理器将在 next_cycle 执行，期间跳过的周期需补齐
+    Cycle_t next_cycle = reregisterClock(clock_tc_, clock_handler_);
+    Cycle_t skipped = (next_cycle > last_tick_cycle_ + 1) ? (next_cycle - last_tick_cycle_ - 1) : 0;
+    total_cycles_ += skipped;
+    suspended_cycles_ += skipped;
+    publishCycleCounters();
+    
+    // 非惰性模式下逐周期泄漏在挂起期间未执行，此处按闭式补算以保持周期精确
+    if (!lazy_leak_) {
+        for (uint32_t i = 0; i < num_neurons_; i++) {
+            catchUpNeuron(i, total_cycles_);
+        }
+    }
+    SNNDL_TRACE(output_, 4, 0, "⏰ 核心%d唤醒时钟，跳过%" PRIu64 "个周期\n", core_id_, skipped);
+}
+
 void SnnPESubComponent::deliverSpike(SpikeEvent* spike) {
     if (!spike) return;
     
-    output_->verbose(CALL_INFO, 4, 0, "📨 核心%d接收脉冲: 源全局ID=%u, 目标全局ID=%u, 目标神经元=%u, 权重%.3f\n",
+    SNNDL_TRACE(output_, 4, 0, "📨 核心%d接收脉冲: 源全局ID=%u, 目标全局ID=%u, 目标神经元=%u, 权重%.3f\n",
                     core_id_, spike->getSourceNeuron(), spike->getDestinationNeuron(), spike->getDestinationNeuron(), spike->getWeight());
     
-    // 将脉冲加入队列，在时钟周期中处理
-    incoming_spikes_.push(spike);
+    // 按投递周期入桶（下一个时钟周期 + 突触延迟），在时钟周期中处理
+    wakeClock();
+    incoming_spikes_.push(total_cycles_ + 1 + synaptic_delay_, spike);
     
     // 更新两种统计：SST统计对象和内部计数器
     stat_spikes_received_->addData(1);
-    count_spikes_received_++;
-    
-    // Debug output disabled to prevent excessive logging
-    // printf("DEBUG: SnnPESubComponent核心%d接收脉冲，内部计数器更新: count_spikes_received_=%lu\n", 
-    //        core_id_, count_spikes_received_);
+    counters_.spikes_received.add();
+    SNNDL_TRACE_EVENT(trace_ring_, total_cycles_, TraceEventType::SPIKE_IN, core_id_,
+                      spike->getSourceNeuron(), spike->getDestinationNeuron(), spike->getWeight());
+}
+
+void SnnPESubComponent::getFiringCounts(std::vector<uint64_t>& counts) const {
+    size_t n = std::min(counts.size(), fire_counts_.size());
+    for (size_t i = 0; i < n; i++) counts[i] += fire_counts_[i];
 }
 
 void SnnPESubComponent::setMemoryLink(SST::Link* link) {
@@ -344,9 +603,8 @@ void SnnPESubComponent::setMemoryLink(SST::Link* link) {
 }
 
 bool SnnPESubComponent::hasWork() const {
-    return !incoming_spikes_.empty() || 
-           std::any_of(neuron_states_.begin(), neuron_states_.end(),
-                      [](const NeuronState& state) { return state.v_mem > 0.1f; });
+    // 惰性模式下膜电位不逐周期扫描，存储值停在最近一次访问时；无输入的LIF神经元只会衰减、不会发放，不计为待处理工作
+    return !incoming_spikes_.empty() || (!lazy_leak_ && neuron_model_->anyActive(neuron_states_));
 }
 
 double SnnPESubComponent::getUtilization() const {
@@ -356,64 +614,78 @@ double SnnPESubComponent::getUtilization() const {
 
 void SnnPESubComponent::getStatistics(std::map<std::string, uint64_t>& stats) const {
     // 使用内部计数器而不是getCollectionCount()来获取正确的累计值
-    stats["spikes_received"] = count_spikes_received_;
-    stats["spikes_generated"] = count_spikes_generated_;
-    stats["neurons_fired"] = count_neurons_fired_;
-    stats["memory_requests"] = count_memory_requests_;
+    stats["spikes_received"] = counters_.spikes_received.get();
+    stats["spikes_generated"] = counters_.spikes_generated.get();
+    stats["neurons_fired"] = counters_.neurons_fired.get();
+    stats["memory_requests"] = counters_.memory_requests.get();
     stats["total_cycles"] = total_cycles_;
     stats["active_cycles"] = active_cycles_;
+    stats["suspended_cycles"] = suspended_cycles_;
+    stats["weight_cache_hits"] = weight_cache_.hits();
+    stats["weight_cache_misses"] = weight_cache_.misses();
+    stats["weight_cache_evictions"] = weight_cache_.evictions();
+    stats["row_spikes_deferred"] = count_row_spikes_deferred_;
+    stats["fanout_messages"] = count_fanout_messages_;
+    stats["fanout_synapses"] = count_fanout_synapses_;
 }
 
 // ===== 核心计算方法（复用SnnPE实现）=====
 
 void SnnPESubComponent::updateNeuronStates() {
-    // 复用SnnPE的神经元状态更新逻辑
-    for (uint32_t i = 0; i < num_neurons_; i++) {
-        auto& neuron = neuron_states_[i];
-        
-        // 处理不应期
-        if (neuron.refractory_timer > 0) {
-            neuron.refractory_timer--;
-            continue;
-        }
-        
-        // 应用泄漏动态
-        applyLeak(i);
+    // 泄漏、不应期递减与阈值比较在SoA数组上一次完成（AVX-512/AVX2/标量）
+    fired_indices_.clear();
+    // LIF 内核直接使用 AVX-512/AVX2 实现，其他模型为内联的逐神经元循环
+    if (update_pool_) {
+        // 块内并行、按块顺序合并，发放列表与串行结果一致
+        update_pool_->run(neuron_states_.size(),
+            [this](std::size_t begin, std::size_t end, std::vector<uint32_t>& out) {
+                return neuron_model_->updateRange(neuron_states_, begin, end, out);
+            },
+            fired_indices_);
+    } else {
+        neuron_model_->updateRange(neuron_states_, 0, neuron_states_.size(), fired_indices_);
     }
 }
 
-void SnnPESubComponent::applyLeak(uint32_t neuron_idx) {
-    // 复用SnnPE的泄漏实现
+void SnnPESubComponent::catchUpNeuron(uint32_t neuron_idx, Cycle_t target_cycle) {
+    // 将神经元状态从 last_update_cycle 推进到 target_cycle，
+    // 等价于逐周期执行 updateNeuronStates（无输入），由模型给出闭式或逐步补算
     if (neuron_idx >= num_neurons_) return;
     
-    auto& neuron = neuron_states_[neuron_idx];
+    Cycle_t& last_update = neuron_states_.last_update_cycle[neuron_idx];
+    if (target_cycle <= last_update) return;
     
-    if (neuron.v_mem > v_rest_) {
-        // 指数泄漏
-        neuron.v_mem = v_rest_ + (neuron.v_mem - v_rest_) * exp(-1.0f / tau_mem_);
-    }
+    neuron_model_->advance(neuron_states_, neuron_idx, target_cycle - last_update);
+    last_update = target_cycle;
 }
 
 void SnnPESubComponent::checkAndFireSpike(uint32_t neuron_idx) {
     // 复用SnnPE的脉冲触发逻辑
     if (neuron_idx >= num_neurons_) return;
     
-    auto& neuron = neuron_states_[neuron_idx];
-    
-    if (neuron.v_mem >= v_thresh_ && neuron.refractory_timer == 0) {
-        // 神经元发放脉冲
-        neuron.v_mem = v_reset_;
-        neuron.refractory_timer = t_ref_;
-        neuron.last_spike_time = total_cycles_;
+    if (neuron_model_->crossed(neuron_states_, neuron_idx)) {
+        // 神经元发放脉冲，按模型复位
+        neuron_model_->fire(neuron_states_, neuron_idx);
+        neuron_states_.last_spike_time[neuron_idx] = total_cycles_;
         
         stat_neurons_fired_->addData(1);
         stat_spikes_generated_->addData(1);
-        count_neurons_fired_++;
-        count_spikes_generated_++;
+        counters_.neurons_fired.add();
+        fire_counts_[neuron_idx]++;
+        counters_.spikes_generated.add();
+        SNNDL_TRACE_EVENT(trace_ring_, total_cycles_, TraceEventType::NEURON_FIRE, core_id_, neuron_idx,
+                          static_cast<uint32_t>(global_neuron_base_ + neuron_idx));
+        if (recorder_) recorder_->recordFire(total_cycles_, static_cast<uint32_t>(global_neuron_base_ + neuron_idx));
         
-        output_->verbose(CALL_INFO, 3, 0, "🔥 核心%d神经元%d发放脉冲! v_mem=%.3f -> %.3f\n",
+        SNNDL_TRACE(output_, 3, 0, "🔥 核心%d神经元%d发放脉冲! v_mem=%.3f -> %.3f\n",
                         core_id_, neuron_idx, v_thresh_, v_reset_);
         
+        // 配置了连接表时按CSR行扇出，每个目标核心聚合为一条消息
+        if (fanout_loaded_) {
+            emitFanout(neuron_idx);
+            return;
+        }
+        
         // 创建输出脉冲 - 基于频率分类网络连接模式
         uint32_t source_global = static_cast<uint32_t>(global_neuron_base_ + neuron_idx);
         
@@ -462,36 +734,475 @@ void SnnPESubComponent::checkAndFireSpike(uint32_t neuron_idx) {
         );
         
         // 通过父级接口发送脉冲
-        if (parent_) {
-            parent_->sendSpike(output_spike);
-        } else {
-            delete output_spike;
+        emitToParent(output_spike);
+    }
+}
+
+void SnnPESubComponent::emitFanout(uint32_t neuron_idx) {
+    uint32_t source_global = static_cast<uint32_t>(global_neuron_base_ + neuron_idx);
+    // 连接表未覆盖的行视为无突触
+    if (neuron_idx >= fanout_.rows) return;
+    uint64_t begin = fanout_.rowBegin(neuron_idx);
+    uint64_t end = fanout_.rowEnd(neuron_idx);
+    const uint32_t* post = fanout_.col;
+    const float* weight = fanout_.weight;
+    
+    // 行内按突触后全局ID升序，同一目标核心的突触连续排列
+    uint64_t i = begin;
+    while (i < end) {
+        uint32_t dest_core_global = post[i] / neurons_per_core_;
+        uint32_t target_node = post[i] / num_neurons_;
+        SpikeEvent* message = new SpikeEvent(source_global, post[i], target_node,
+                                             weight[i], total_cycles_);
+        uint64_t run_begin = i;
+        while (i < end && post[i] / neurons_per_core_ == dest_core_global) {
+            uint8_t delay = fanout_delays_.empty() ? 0 : fanout_delays_[i - fanout_delay_base_];
+            message->addTarget(post[i], weight[i], delay);
+            i++;
+        }
+        
+        count_fanout_messages_++;
+        count_fanout_synapses_ += (i - run_begin);
+        if (stat_fanout_messages_) stat_fanout_messages_->addData(1);
+        if (stat_fanout_synapses_) stat_fanout_synapses_->addData(i - run_begin);
+        SNNDL_TRACE(output_, 3, 0, "🔥 核心%d神经元%u扇出 -> 节点%u, %" PRIu64 "个突触\n",
+                         core_id_, neuron_idx, target_node, i - run_begin);
+        
+        emitToParent(message);
+    }
+}
+
+void SnnPESubComponent::emitToParent(SpikeEvent* spike) {
+    if (!parent_) {
+        delete spike;
+        return;
+    }
+    // 无积压且父级可接收时直接发送，否则排在积压之后
+    if (output_backlog_.empty() && parent_->canSendSpike()) {
+        parent_->sendSpike(spike);
+        return;
+    }
+    if (output_backlog_depth_ > 0 && output_backlog_.size() >= output_backlog_depth_) {
+        output_->verbose(CALL_INFO, 2, 0, "⚠️ 核心%d输出缓冲已满(%u)，丢弃脉冲: 源%u -> 目标%u\n",
+                         core_id_, output_backlog_depth_, spike->getSourceNeuron(), spike->getDestinationNeuron());
+        output_spikes_dropped_++;
+        stat_output_spikes_dropped_->addData(1);
+        delete spike;
+        return;
+    }
+    output_backlog_.push_back(spike);
+    stat_output_backlog_depth_->addData(output_backlog_.size());
+}
+
+void SnnPESubComponent::drainOutputBacklog() {
+    while (!output_backlog_.empty() && parent_->canSendSpike()) {
+        SpikeEvent* spike = output_backlog_.front();
+        output_backlog_.pop_front();
+        parent_->sendSpike(spike);
+    }
+}
+
+void SnnPESubComponent::integrateInput(uint32_t post_local, float weight) {
+    if (post_local >= num_neurons_) return;
+    if (lazy_leak_ && total_cycles_ > 0) {
+        catchUpNeuron(post_local, total_cycles_ - 1);
+    }
+    if (neuron_states_.refractory[post_local] > 0) return;
+    float& v_mem = neuron_states_.v_mem[post_local];
+    v_mem = membrane_precision_.add(v_mem, weight);
+    noteTouched(post_local);
+}
+
+void SnnPESubComponent::integrateDelayed(uint32_t post_local, float weight, uint32_t delay) {
+    if (delay == 0 || post_local >= num_neurons_) {
+        integrateInput(post_local, weight);
+        return;
+    }
+    if (!delay_line_.enabled()) {
+        if (!delay_ignored_warned_) {
+            output_->verbose(CALL_INFO, 1, 0, "⚠️ 核心%d收到带延迟的突触输入但max_synaptic_delay=0，立即施加\n", core_id_);
+            delay_ignored_warned_ = true;
+        }
+        integrateInput(post_local, weight);
+        return;
+    }
+    if (delay > delay_line_.maxDelay()) {
+        delay = delay_line_.maxDelay();
+        count_delays_clamped_++;
+        stat_delays_clamped_->addData(1);
+    }
+    // 到期周期的槽位中累加；不应期与阈值在取出时按当时状态判断。
+    // 本函数在投递桶内调用（桶周期 = 到达周期+1+synaptic_delay），延迟从 total_cycles_-1 即
+    // 到达周期+synaptic_delay 起算：逐突触延迟叠加在统一延迟之上，延迟d在到达后第 synaptic_delay+d 个周期积分。
+    // 本周期的槽位在桶之后才取出，d=1即本周期
+    delay_line_.add(total_cycles_ - 1, delay, post_local, weight);
+}
+
+void SnnPESubComponent::noteTouched(uint32_t neuron_idx) {
+    if (!batching_) {
+        checkAndFireSpike(neuron_idx);
+        return;
+    }
+    if (neuron_idx >= num_neurons_) return;
+    if (touched_mask_[neuron_idx]) {
+        count_fire_checks_batched_++;
+        return;
+    }
+    touched_mask_[neuron_idx] = 1;
+    touched_.push_back(neuron_idx);
+}
+
+void SnnPESubComponent::flushTouched() {
+    // 升序检查，发放顺序与到达顺序无关
+    std::sort(touched_.begin(), touched_.end());
+    for (uint32_t idx : touched_) {
+        touched_mask_[idx] = 0;
+        checkAndFireSpike(idx);
+    }
+    touched_.clear();
+}
+
+bool SnnPESubComponent::loadDelays(const std::string& path_template) {
+    std::string path = path_template;
+    auto substitute = [&path](const std::string& token, int value) {
+        size_t pos;
+        while ((pos = path.find(token)) != std::string::npos) {
+            path.replace(pos, token.size(), std::to_string(value));
+        }
+    };
+    substitute("{node}", static_cast<int>(node_id_));
+    substitute("{core}", core_id_);
+    
+    // 延迟与连接表突触一一对应：CSR文件为整个文件的nnz，其他格式为本核心构建的表
+    uint64_t table_nnz = fanout_store_ ? fanout_store_->nnz() : fanout_post_.size();
+    uint64_t first = fanout_.rows ? fanout_.rowBegin(0) : 0;
+    uint64_t last = fanout_.rows ? fanout_.rowEnd(fanout_.rows - 1) : 0;
+    
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        output_->verbose(CALL_INFO, 1, 0, "❌ 核心%d无法打开延迟文件: %s\n", core_id_, path.c_str());
+        return false;
+    }
+    uint64_t file_bytes = static_cast<uint64_t>(file.tellg());
+    if (file_bytes != table_nnz) {
+        output_->verbose(CALL_INFO, 1, 0, "❌ 核心%d延迟文件%s长度%" PRIu64 "与连接表突触数%" PRIu64 "不符\n",
+                         core_id_, path.c_str(), file_bytes, table_nnz);
+        return false;
+    }
+    fanout_delay_base_ = first;
+    fanout_delays_.assign(last - first, 0);
+    file.seekg(static_cast<std::streamoff>(first));
+    file.read(reinterpret_cast<char*>(fanout_delays_.data()), static_cast<std::streamsize>(fanout_delays_.size()));
+    if (!file) return false;
+    
+    uint32_t max_delay = 0;
+    for (uint8_t d : fanout_delays_) max_delay = std::max<uint32_t>(max_delay, d);
+    output_->verbose(CALL_INFO, 1, 0, "⏳ 核心%d加载突触延迟 %s: 突触=%zu, 最大延迟=%u (延迟线深度=%u)\n",
+                     core_id_, path.c_str(), fanout_delays_.size(), max_delay, delay_line_.maxDelay());
+    return true;
+}
+
+void SnnPESubComponent::resetState() {
+    // 样本边界：神经元回到静息状态，丢弃上一样本尚未积分的输入与尚未发出的输出；
+    // 权重缓存、连接表与累计统计保留
+    incoming_spikes_.clear();
+    delay_line_.clear();
+    for (uint32_t idx : touched_) touched_mask_[idx] = 0;
+    touched_.clear();
+    fired_indices_.clear();
+    // 行扇出：等待整行权重的脉冲作废；在途读取仍正常返回并填充缓存，但不再施加到膜电位
+    row_pending_spikes_.clear();
+    deferred_row_reads_.clear();
+    for (auto& entry : pending_memory_requests_) entry.second.deliver_row = false;
+    for (SpikeEvent* spike : output_backlog_) delete spike;
+    output_backlog_.clear();
+    neuron_states_.resize(num_neurons_, v_rest_);
+    neuron_model_->initialize(neuron_states_);
+    std::fill(neuron_states_.last_update_cycle.begin(), neuron_states_.last_update_cycle.end(), total_cycles_);
+    SNNDL_TRACE(output_, 3, 0, "🔁 核心%d样本边界复位 (周期%" PRIu64 ")\n", core_id_, total_cycles_);
+}
+
+bool SnnPESubComponent::saveState(std::vector<uint8_t>& state) {
+    // 核心状态段：u32 版本 | u32 神经元数 | u64 保存周期 | v_mem[] | refractory[] | aux[]
+    //   | 缓存键[] | 缓存值[] | u8 含连接表 | [row_ptr[] | post[] | weight[]] | u64 延迟基址 | 延迟[]
+    // 惰性泄漏模式下先把全部神经元补算到当前周期，快照即为该周期的状态
+    if (lazy_leak_) {
+        for (uint32_t i = 0; i < num_neurons_; i++) catchUpNeuron(i, total_cycles_);
+    }
+    if (hasWork() || !pending_memory_requests_.empty() || !delay_line_.empty() || !output_backlog_.empty()) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 核心%d保存状态时仍有在途脉冲或内存请求，这部分不计入快照\n", core_id_);
+    }
+    
+    std::vector<std::pair<uint64_t, float>> entries;
+    weight_cache_.exportEntries(entries);
+    std::vector<uint64_t> cache_keys(entries.size());
+    std::vector<float> cache_values(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        cache_keys[i] = entries[i].first;
+        cache_values[i] = entries[i].second;
+    }
+    
+    state.clear();
+    StateWriter writer(state);
+    writer.put<uint32_t>(CORE_STATE_VERSION);
+    writer.put<uint32_t>(num_neurons_);
+    writer.put<uint64_t>(total_cycles_);
+    writer.putArray(neuron_states_.v_mem);
+    writer.putArray(neuron_states_.refractory);
+    writer.putArray(neuron_states_.aux);
+    writer.putArray(cache_keys);
+    writer.putArray(cache_values);
+    // csr格式的连接表每次重新映射即可，只保存records/dense格式解析得到的表
+    bool owned_fanout = fanout_loaded_ && !fanout_store_;
+    writer.put<uint8_t>(owned_fanout ? 1 : 0);
+    if (owned_fanout) {
+        writer.putArray(fanout_row_ptr_);
+        writer.putArray(fanout_post_);
+        writer.putArray(fanout_weight_);
+    }
+    writer.put<uint64_t>(fanout_delay_base_);
+    writer.putArray(fanout_delays_);
+    return true;
+}
+
+bool SnnPESubComponent::restoreState(const std::vector<uint8_t>& state, std::string& error) {
+    StateReader reader(state.data(), state.size());
+    uint32_t version = 0;
+    uint32_t neurons = 0;
+    uint64_t saved_cycle = 0;
+    if (!reader.get(version) || version != CORE_STATE_VERSION || !reader.get(neurons) || !reader.get(saved_cycle)) {
+        error = "核心状态段版本不符或已损坏";
+        return false;
+    }
+    if (neurons != num_neurons_) {
+        error = "快照神经元数" + std::to_string(neurons) + "与num_neurons=" + std::to_string(num_neurons_) + "不符";
+        return false;
+    }
+    
+    NeuronStateArray::AlignedVector<float> v_mem;
+    NeuronStateArray::AlignedVector<uint32_t> refractory;
+    NeuronStateArray::AlignedVector<float> aux;
+    std::vector<uint64_t> cache_keys;
+    std::vector<float> cache_values;
+    uint8_t has_fanout = 0;
+    reader.getArray(v_mem);
+    reader.getArray(refractory);
+    reader.getArray(aux);
+    reader.getArray(cache_keys);
+    reader.getArray(cache_values);
+    reader.get(has_fanout);
+    if (has_fanout) {
+        reader.getArray(fanout_row_ptr_);
+        reader.getArray(fanout_post_);
+        reader.getArray(fanout_weight_);
+    }
+    reader.get(fanout_delay_base_);
+    reader.getArray(fanout_delays_);
+    if (!reader.ok() || !reader.atEnd() || v_mem.size() != num_neurons_ || refractory.size() != num_neurons_ ||
+        cache_keys.size() != cache_values.size()) {
+        error = "核心状态段已损坏";
+        return false;
+    }
+    if (aux.size() != neuron_states_.aux.size()) {
+        error = std::string("快照的神经元模型与当前neuron_model (") + neuron_model_->name() + ") 不一致";
+        return false;
+    }
+    if (has_fanout && (fanout_row_ptr_.size() != static_cast<size_t>(num_neurons_) + 1 ||
+                       fanout_row_ptr_.back() != fanout_post_.size() || fanout_post_.size() != fanout_weight_.size())) {
+        error = "快照中的连接表已损坏";
+        return false;
+    }
+    
+    // 快照状态对应保存时刻，本次运行从周期0继续（last_update_cycle等已由resize归零）
+    neuron_states_.v_mem.swap(v_mem);
+    neuron_states_.refractory.swap(refractory);
+    neuron_states_.aux.swap(aux);
+    for (size_t i = 0; i < cache_keys.size(); i++) {
+        weight_cache_.insert(cache_keys[i], cache_values[i]);
+    }
+    if (has_fanout) {
+        fanout_.row_ptr = fanout_row_ptr_.data();
+        fanout_.col = fanout_post_.data();
+        fanout_.weight = fanout_weight_.data();
+        fanout_.rows = num_neurons_;
+        fanout_loaded_ = true;
+    }
+    return true;
+}
+
+bool SnnPESubComponent::loadConnectivity(const std::string& path_template, const std::string& format) {
+    // 替换 {node}/{core} 占位符
+    std::string path = path_template;
+    auto substitute = [&path](const std::string& token, int value) {
+        size_t pos;
+        while ((pos = path.find(token)) != std::string::npos) {
+            path.replace(pos, token.size(), std::to_string(value));
         }
+    };
+    substitute("{node}", static_cast<int>(node_id_));
+    substitute("{core}", core_id_);
+    
+    // CSR格式：整个文件在进程内只映射一次，本核心直接引用自己的行区间
+    if (format == "csr" || (format == "auto" && CsrWeightStore::isCsrFile(path))) {
+        std::string error;
+        fanout_store_ = CsrWeightStore::open(path, error);
+        if (!fanout_store_) {
+            output_->verbose(CALL_INFO, 1, 0, "❌ 核心%d无法映射CSR连接表 %s: %s\n",
+                             core_id_, path.c_str(), error.c_str());
+            return false;
+        }
+        fanout_ = fanout_store_->globalRows(global_neuron_base_, num_neurons_);
+        fanout_loaded_ = true;
+        output_->verbose(CALL_INFO, 1, 0, "📋 核心%d映射CSR连接表 %s: 行=%u/%u, 突触=%" PRIu64 ", 共享映射=%zuB\n",
+                         core_id_, path.c_str(), fanout_.rows, num_neurons_, fanout_.nnz(),
+                         fanout_store_->mappedBytes());
+        return true;
+    }
+    
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        output_->verbose(CALL_INFO, 1, 0, "❌ 核心%d无法打开连接表: %s\n", core_id_, path.c_str());
+        return false;
     }
+    uint64_t file_bytes = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    
+    // 记录格式：uint32 总连接数 + uint32 本地连接数 + N × {uint32 pre, uint32 post, float w}（与SnnPE::loadWeights一致）
+    // 稠密格式：float32[本核心神经元][突触后全局ID] 行优先（test_corrected_4x4.py 生成），零权重视为无连接
+    bool records = false;
+    uint32_t total_connections = 0;
+    if (format == "records" || format == "auto") {
+        uint32_t header[2] = {0, 0};
+        if (file_bytes >= sizeof(header)) {
+            file.read(reinterpret_cast<char*>(header), sizeof(header));
+            total_connections = header[0];
+            records = (file_bytes == sizeof(header) + static_cast<uint64_t>(total_connections) * 12);
+        }
+        if (!records) {
+            if (format == "records") {
+                output_->verbose(CALL_INFO, 1, 0, "❌ 核心%d连接表长度与记录格式不符: %s\n", core_id_, path.c_str());
+                return false;
+            }
+            file.clear();
+            file.seekg(0);
+        }
+    } else if (format != "dense") {
+        output_->verbose(CALL_INFO, 1, 0, "❌ 未知的connectivity_format: %s\n", format.c_str());
+        return false;
+    }
+    
+    std::vector<std::vector<std::pair<uint32_t, float>>> rows(num_neurons_);
+    uint64_t loaded = 0;
+    if (records) {
+        for (uint32_t i = 0; i < total_connections; i++) {
+            uint32_t pre = 0, post = 0;
+            float w = 0.0f;
+            file.read(reinterpret_cast<char*>(&pre), sizeof(pre));
+            file.read(reinterpret_cast<char*>(&post), sizeof(post));
+            file.read(reinterpret_cast<char*>(&w), sizeof(w));
+            if (!file) return false;
+            if (pre >= global_neuron_base_ && pre < global_neuron_base_ + num_neurons_) {
+                rows[pre - global_neuron_base_].emplace_back(post, w);
+                loaded++;
+            }
+        }
+    } else {
+        uint64_t total_floats = file_bytes / sizeof(float);
+        if (file_bytes % sizeof(float) != 0 || total_floats % num_neurons_ != 0) {
+            output_->verbose(CALL_INFO, 1, 0, "❌ 核心%d稠密连接表大小(%" PRIu64 "B)不是%u行的整数倍\n",
+                             core_id_, file_bytes, num_neurons_);
+            return false;
+        }
+        uint64_t row_width = total_floats / num_neurons_;
+        std::vector<float> row(row_width);
+        for (uint32_t pre = 0; pre < num_neurons_; pre++) {
+            file.read(reinterpret_cast<char*>(row.data()), row_width * sizeof(float));
+            if (!file) return false;
+            for (uint64_t post = 0; post < row_width; post++) {
+                if (row[post] != 0.0f) {
+                    rows[pre].emplace_back(static_cast<uint32_t>(post), row[post]);
+                    loaded++;
+                }
+            }
+        }
+    }
+    
+    // 构建CSR，行内按突触后ID排序以便按目标核心聚合
+    fanout_row_ptr_.assign(num_neurons_ + 1, 0);
+    fanout_post_.clear();
+    fanout_weight_.clear();
+    fanout_post_.reserve(loaded);
+    fanout_weight_.reserve(loaded);
+    for (uint32_t pre = 0; pre < num_neurons_; pre++) {
+        auto& r = rows[pre];
+        std::sort(r.begin(), r.end());
+        for (const auto& syn : r) {
+            fanout_post_.push_back(syn.first);
+            fanout_weight_.push_back(weight_precision_.snap(syn.second));
+        }
+        fanout_row_ptr_[pre + 1] = fanout_post_.size();
+    }
+    fanout_.row_ptr = fanout_row_ptr_.data();
+    fanout_.col = fanout_post_.data();
+    fanout_.weight = fanout_weight_.data();
+    fanout_.rows = num_neurons_;
+    fanout_loaded_ = true;
+    
+    output_->verbose(CALL_INFO, 1, 0, "📋 核心%d加载连接表 %s: 格式=%s, 突触=%" PRIu64 "\n",
+                     core_id_, path.c_str(), records ? "records" : "dense", loaded);
+    return true;
 }
 
 void SnnPESubComponent::processLocalSpike(SpikeEvent* spike_event) {
     // 复用SnnPE的本地脉冲处理逻辑
     if (!spike_event) return;
     
+    // 聚合扇出消息：权重由发送端连接表给出，逐一施加到本核心的突触后神经元
+    if (spike_event->hasTargets()) {
+        for (size_t i = 0; i < spike_event->getTargetCount(); i++) {
+            uint32_t post = spike_event->getTargetNeuron(i);
+            if (post < global_neuron_base_ || post >= global_neuron_base_ + num_neurons_) {
+                output_->verbose(CALL_INFO, 2, 0, "⚠️ 核心%d收到无法映射的聚合目标神经元%u\n", core_id_, post);
+                continue;
+            }
+            integrateDelayed(static_cast<uint32_t>(post - global_neuron_base_), spike_event->getTargetWeight(i),
+                             spike_event->getTargetDelay(i));
+        }
+        return;
+    }
+    
     uint32_t dest = spike_event->getDestinationNeuron();
     uint32_t target_neuron = dest;
     // 全局ID → 本地ID 映射
     if (dest >= num_neurons_) {
         if (dest >= global_neuron_base_ && dest < global_neuron_base_ + num_neurons_) {
             target_neuron = static_cast<uint32_t>(dest - global_neuron_base_);
-            output_->verbose(CALL_INFO, 4, 0, "🔁 核心%d将全局ID%d映射为本地ID%d\n", core_id_, dest, target_neuron);
+            SNNDL_TRACE(output_, 4, 0, "🔁 核心%d将全局ID%d映射为本地ID%d\n", core_id_, dest, target_neuron);
         } else {
             output_->verbose(CALL_INFO, 2, 0, "⚠️ 核心%d收到无法映射的目标神经元%d的脉冲\n", core_id_, dest);
             return;
         }
     }
     
-    auto& neuron = neuron_states_[target_neuron];
+    // 行扇出：目标神经元仅用于确定本核心，权重与突触后神经元由整行决定
+    // 源不在本核心权重块内时内存中没有该行，按单突触路径处理
+    uint32_t row_pre = 0;
+    if (row_fanout_delivery_ && enable_weight_fetch_ && memory_ && memory_ready_ &&
+        toWeightIndex(mapPreToLocal(spike_event->getSourceNeuron()), row_pre)) {
+        deliverRowSpike(row_pre);
+        return;
+    }
+    
+    // 惰性泄漏：先补算到上一周期末的状态，本周期的更新仍保持挂起
+    if (lazy_leak_ && total_cycles_ > 0) {
+        catchUpNeuron(target_neuron, total_cycles_ - 1);
+    }
+    
+    float& v_mem = neuron_states_.v_mem[target_neuron];
     
     // 检查是否在不应期
-    if (neuron.refractory_timer > 0) {
-        output_->verbose(CALL_INFO, 4, 0, "⚠️ 核心%d神经元%d在不应期，忽略脉冲\n", 
+    if (neuron_states_.refractory[target_neuron] > 0) {
+        SNNDL_TRACE(output_, 4, 0, "⚠️ 核心%d神经元%d在不应期，忽略脉冲\n", 
                         core_id_, target_neuron);
         return;
     }
@@ -499,32 +1210,14 @@ void SnnPESubComponent::processLocalSpike(SpikeEvent* spike_event) {
     // 使用权重缓存/按需读取
     float weight = 0.0f;
     bool have_mem_weight = false;
-    if (enable_weight_fetch_ && memory_ && memory_ready_) {
-        // 计算 pre_local 与 post_local
-        uint32_t pre_global = spike_event->getSourceNeuron();
-        uint32_t post_global = spike_event->getDestinationNeuron();
-        uint32_t pre_local = 0;
-        uint32_t post_local = 0;
-        // 全局→本地：使用本核的 global_neuron_base_ 做基准
-        if (pre_global >= global_neuron_base_ && pre_global < global_neuron_base_ + num_neurons_) {
-            pre_local = static_cast<uint32_t>(pre_global - global_neuron_base_);
-        } else {
-            // 若源不在本核，本核的权重矩阵仍以本核 pre 为行索引，
-            // 此处若需要跨核权重，应使用源所在核的 base_addr 发起读取。
-            // 当前多核PE设计为每核自有权重块，因此以源核读取为准。
-            // 为了通用性，先按环内常见映射：取源所在核在本PE内的相对索引区间折算。
-            uint64_t pe_base = static_cast<uint64_t>(global_neuron_base_) - static_cast<uint64_t>(core_id_) * static_cast<uint64_t>(num_neurons_);
-            pre_local = static_cast<uint32_t>((static_cast<uint64_t>(pre_global) - pe_base) % static_cast<uint64_t>(num_neurons_));
-        }
-        if (post_global >= global_neuron_base_ && post_global < global_neuron_base_ + num_neurons_) {
-            post_local = static_cast<uint32_t>(post_global - global_neuron_base_);
-        } else {
-            post_local = target_neuron; // 已在上方完成映射
-        }
-        uint64_t key = static_cast<uint64_t>(pre_local) * static_cast<uint64_t>(num_neurons_) + post_local;
-        auto it = weight_cache_.find(key);
-        if (it != weight_cache_.end()) {
-            weight = it->second;
+    // 计算 pre_local 与 post_local，再折算为权重块内索引；块外的突触内存中没有权重
+    uint32_t pre_local = 0;
+    uint32_t post_local = 0;
+    if (enable_weight_fetch_ && memory_ && memory_ready_ &&
+        toWeightIndex(mapPreToLocal(spike_event->getSourceNeuron()), pre_local) &&
+        toWeightIndex(target_neuron, post_local)) {
+        uint64_t key = static_cast<uint64_t>(pre_local) * static_cast<uint64_t>(weight_rows_) + post_local;
+        if (weight_cache_.lookup(key, weight)) {
             have_mem_weight = true;
             if (stat_weight_cache_hits_) stat_weight_cache_hits_->addData(1);
             if (!first_cache_hit_logged_) {
@@ -535,13 +1228,9 @@ void SnnPESubComponent::processLocalSpike(SpikeEvent* spike_event) {
         } else if (outstanding_requests_ < max_outstanding_requests_) {
             outstanding_requests_++;
             if (outstanding_requests_ > pending_reqs_peak_) pending_reqs_peak_ = outstanding_requests_;
+            // 并发计数统一在 handleMemoryResponse 中递减
             requestWeight(pre_local, post_local, [this, key](float w){
-                // 简单容量限制
-                if (weight_cache_.size() >= max_cache_entries_) {
-                    weight_cache_.clear();
-                }
-                weight_cache_[key] = w;
-                if (outstanding_requests_ > 0) outstanding_requests_--;
+                cacheWeight(key, w);
             });
             if (stat_weight_cache_misses_) stat_weight_cache_misses_->addData(1);
             if (!first_cache_miss_logged_) {
@@ -554,7 +1243,7 @@ void SnnPESubComponent::processLocalSpike(SpikeEvent* spike_event) {
     if (!have_mem_weight) {
         // 回退策略：可选择使用事件权重，或直接使用默认初始权重（与内存一致）
         if (use_event_weight_fallback_) {
-            weight = spike_event->getWeight();
+            weight = weight_precision_.snap(static_cast<float>(spike_event->getWeight()));
             if (!event_weight_fallback_warned_) {
                 output_->verbose(CALL_INFO, 1, 0, "⚠️ 核心%d启用事件权重回退，事件权重=%.3f\n", core_id_, weight);
                 event_weight_fallback_warned_ = true;
@@ -563,7 +1252,7 @@ void SnnPESubComponent::processLocalSpike(SpikeEvent* spike_event) {
             weight = 0.0f;
         }
     }
-    neuron.v_mem += weight;
+    v_mem = membrane_precision_.add(v_mem, weight);
     
     // 一次性详细日志：打印全局/本地映射与地址
     if (enable_detailed_map_log_ || !detailed_log_emitted_) {
@@ -574,7 +1263,7 @@ void SnnPESubComponent::processLocalSpike(SpikeEvent* spike_event) {
                                  : 0u;
         uint32_t post_local_dbg = target_neuron;
         uint64_t offset_dbg = static_cast<uint64_t>(pre_local_dbg) * static_cast<uint64_t>(num_neurons_) + post_local_dbg;
-        uint64_t addr_dbg = base_addr_ + offset_dbg * sizeof(float);
+        uint64_t addr_dbg = base_addr_ + offset_dbg * weight_precision_.bytes();
         output_->verbose(CALL_INFO, 1, 0,
             "🧪 详细权重调试: 事件权重=%.3f, 内存权重=%s, 最终权重=%.3f, 回退=%s\n",
             spike_event->getWeight(), have_mem_weight ? "有" : "无", weight, use_event_weight_fallback_ ? "启用" : "禁用");
@@ -583,32 +1272,160 @@ void SnnPESubComponent::processLocalSpike(SpikeEvent* spike_event) {
             pre_global, pre_local_dbg, post_global, post_local_dbg, base_addr_, offset_dbg, addr_dbg, weight);
         detailed_log_emitted_ = true;
     }
-    output_->verbose(CALL_INFO, 5, 0, "⚡ 核心%d神经元%d: v_mem=%.3f (添加权重%.3f)\n",
-                    core_id_, target_neuron, neuron.v_mem, weight);
+    SNNDL_TRACE(output_, 5, 0, "⚡ 核心%d神经元%d: v_mem=%.3f (添加权重%.3f)\n",
+                    core_id_, target_neuron, v_mem, weight);
     
-    // 检查是否达到阈值并发放脉冲
-    checkAndFireSpike(target_neuron);
+    // 检查是否达到阈值并发放脉冲（桶投递期间推迟到桶末）
+    noteTouched(target_neuron);
+}
+
+uint32_t SnnPESubComponent::mapPreToLocal(uint32_t pre_global) const {
+    // 全局→本地：使用本核的 global_neuron_base_ 做基准
+    if (pre_global >= global_neuron_base_ && pre_global < global_neuron_base_ + num_neurons_) {
+        return static_cast<uint32_t>(pre_global - global_neuron_base_);
+    }
+    // 若源不在本核，本核的权重矩阵仍以本核 pre 为行索引，
+    // 此处若需要跨核权重，应使用源所在核的 base_addr 发起读取。
+    // 当前多核PE设计为每核自有权重块，因此以源核读取为准。
+    // 为了通用性，先按环内常见映射：取源所在核在本PE内的相对索引区间折算。
+    uint64_t pe_base = static_cast<uint64_t>(global_neuron_base_) - static_cast<uint64_t>(core_id_) * static_cast<uint64_t>(num_neurons_);
+    return static_cast<uint32_t>((static_cast<uint64_t>(pre_global) - pe_base) % static_cast<uint64_t>(num_neurons_));
+}
+
+void SnnPESubComponent::deliverRowSpike(uint32_t pre_local) {
+    // 同一行已有在途或排队的读取：合并到该读取，响应到达时一并施加
+    auto waiting = row_pending_spikes_.find(pre_local);
+    if (waiting != row_pending_spikes_.end()) {
+        waiting->second++;
+        count_row_spikes_deferred_++;
+        if (stat_row_spikes_deferred_) stat_row_spikes_deferred_->addData(1);
+        return;
+    }
+    
+    // 整行均在缓存中时立即施加；稀疏布局下行内有哪些突触须读row_ptr才知道，总是读取
+    if (!sparse_layout_) {
+        row_buffer_.resize(weight_rows_);
+        uint64_t row_key = static_cast<uint64_t>(pre_local) * static_cast<uint64_t>(weight_rows_);
+        uint32_t cached = 0;
+        while (cached < weight_rows_ && weight_cache_.lookup(row_key + cached, row_buffer_[cached])) {
+            if (stat_weight_cache_hits_) stat_weight_cache_hits_->addData(1);
+            cached++;
+        }
+        if (cached == weight_rows_) {
+            applyRowWeights(pre_local, row_buffer_.data(), weight_rows_, 1);
+            return;
+        }
+    }
+    if (stat_weight_cache_misses_) stat_weight_cache_misses_->addData(1);
+    
+    // 未命中：登记等待的脉冲，膜电位更新推迟到整行响应到达
+    row_pending_spikes_[pre_local] = 1;
+    count_row_spikes_deferred_++;
+    if (stat_row_spikes_deferred_) stat_row_spikes_deferred_->addData(1);
+    if (outstanding_requests_ < max_outstanding_requests_) {
+        requestWeightRow(pre_local);
+    } else {
+        deferred_row_reads_.push_back(pre_local);
+        SNNDL_TRACE(output_, 4, 0, "⏳ 核心%d并发读取已满(%u)，行pre=%u排队等待\n",
+                         core_id_, outstanding_requests_, pre_local);
+    }
+}
+
+void SnnPESubComponent::requestWeightRow(uint32_t pre_local) {
+    outstanding_requests_++;
+    if (outstanding_requests_ > pending_reqs_peak_) pending_reqs_peak_ = outstanding_requests_;
+    
+    if (sparse_layout_) {
+        PendingMemoryRequest pmr;
+        pmr.is_row = true;
+        pmr.pre = pre_local;
+        pmr.post_start = 0;
+        pmr.count_floats = 0;
+        pmr.has_single_cb = false;
+        pmr.cb_post = 0;
+        pmr.deliver_row = true;
+        requestSparseRow(pmr);
+        return;
+    }
+    
+    uint64_t request_addr = base_addr_ + static_cast<uint64_t>(pre_local) * weight_rows_ * weight_precision_.bytes();
+    size_t request_size = static_cast<size_t>(weight_rows_) * weight_precision_.bytes();
+    auto* read = new SST::Interfaces::StandardMem::Read(request_addr, request_size);
+    
+    PendingMemoryRequest pmr;
+    pmr.request_id = read->getID();
+    pmr.address = request_addr;
+    pmr.size = request_size;
+    pmr.is_row = true;
+    pmr.pre = pre_local;
+    pmr.post_start = 0;
+    pmr.count_floats = weight_rows_;
+    pmr.has_single_cb = false;
+    pmr.cb_post = 0;
+    pmr.deliver_row = true;
+    pending_memory_requests_[pmr.request_id] = pmr;
+    
+    SNNDL_TRACE(output_, 4, 0, "📤 行扇出读请求: pre=%u, addr=%" PRIu64 ", size=%zu\n",
+                     pre_local, request_addr, request_size);
+    memory_->send(read);
+    stat_memory_requests_->addData(1);
+    if (stat_merged_reads_rows_) stat_merged_reads_rows_->addData(1);
+    noteMemoryRequest(pre_local, request_size);
+}
+
+void SnnPESubComponent::drainDeferredRowSpikes() {
+    while (!deferred_row_reads_.empty() && outstanding_requests_ < max_outstanding_requests_) {
+        uint32_t pre_local = deferred_row_reads_.front();
+        deferred_row_reads_.pop_front();
+        requestWeightRow(pre_local);
+    }
+}
+
+void SnnPESubComponent::applyRowWeights(uint32_t pre_local, const float* weights, uint32_t count, uint32_t spikes) {
+    if (count > weight_rows_) count = weight_rows_;
+    // 逐个脉冲依次施加，使同一周期内先到的脉冲引起的发放/不应期对后续脉冲生效
+    for (uint32_t s = 0; s < spikes; s++) {
+        for (uint32_t post = 0; post < count; post++) {
+            integrateInput(weight_block_offset_ + post, weights[post]);
+        }
+    }
+    SNNDL_TRACE(output_, 5, 0, "⚡ 核心%d行扇出: pre=%u, 突触后=%u, 脉冲数=%u\n",
+                     core_id_, pre_local, count, spikes);
 }
 
 void SnnPESubComponent::requestWeight(uint32_t pre_neuron, uint32_t post_neuron, 
                                     std::function<void(float)> callback) {
-    // 简化地址映射：base_addr + (pre*num_neurons + post)*sizeof(float)
-    uint64_t offset = static_cast<uint64_t>(pre_neuron) * static_cast<uint64_t>(num_neurons_) + post_neuron;
-    uint64_t addr = base_addr_ + offset * sizeof(float);
+    // 简化地址映射：base_addr + (pre*weight_rows + post)*每权重字节数，pre/post 为权重块内索引
+    uint64_t offset = static_cast<uint64_t>(pre_neuron) * static_cast<uint64_t>(weight_rows_) + post_neuron;
+    uint64_t addr = base_addr_ + offset * weight_precision_.bytes();
 
     if (!memory_) {
         // 无StandardMem，直接返回默认权重
         if (callback) callback(0.5f);
         return;
     }
+    
+    // 稀疏布局：读取整行条目，行内没有的突触按零权重
+    if (sparse_layout_) {
+        PendingMemoryRequest pmr;
+        pmr.is_row = true;
+        pmr.pre = pre_neuron;
+        pmr.post_start = 0;
+        pmr.count_floats = 0;
+        pmr.has_single_cb = (callback != nullptr);
+        pmr.cb_post = post_neuron;
+        pmr.single_cb = callback;
+        requestSparseRow(pmr);
+        return;
+    }
 
     // 生成读取请求
     // 合并策略
     uint32_t target_pre = pre_neuron;
     uint32_t target_post = post_neuron;
-    uint32_t bytes_per_float = sizeof(float);
+    uint32_t bytes_per_weight = weight_precision_.bytes();
     uint64_t request_addr = addr;
-    size_t request_size = sizeof(float);
+    size_t request_size = bytes_per_weight;
     bool is_row = false;
     uint32_t post_start = target_post;
     uint32_t count_floats = 1;
@@ -616,20 +1433,20 @@ void SnnPESubComponent::requestWeight(uint32_t pre_neuron, uint32_t post_neuron,
     if (merge_read_row_) {
         is_row = true;
         post_start = 0;
-        count_floats = num_neurons_;
-        request_addr = base_addr_ + static_cast<uint64_t>(target_pre) * num_neurons_ * bytes_per_float;
-        request_size = static_cast<size_t>(count_floats) * bytes_per_float;
+        count_floats = weight_rows_;
+        request_addr = base_addr_ + static_cast<uint64_t>(target_pre) * weight_rows_ * bytes_per_weight;
+        request_size = static_cast<size_t>(count_floats) * bytes_per_weight;
         if (stat_merged_reads_rows_) stat_merged_reads_rows_->addData(1);
     } else if (merge_read_cacheline_) {
-        uint32_t floats_per_line = std::max<uint32_t>(1, line_size_bytes_ / bytes_per_float);
-        post_start = (target_post / floats_per_line) * floats_per_line;
-        count_floats = std::min<uint32_t>(floats_per_line, num_neurons_ - post_start);
-        request_addr = base_addr_ + (static_cast<uint64_t>(target_pre) * num_neurons_ + post_start) * bytes_per_float;
-        request_size = static_cast<size_t>(count_floats) * bytes_per_float;
+        uint32_t weights_per_line = std::max<uint32_t>(1, line_size_bytes_ / bytes_per_weight);
+        post_start = (target_post / weights_per_line) * weights_per_line;
+        count_floats = std::min<uint32_t>(weights_per_line, weight_rows_ - post_start);
+        request_addr = base_addr_ + (static_cast<uint64_t>(target_pre) * weight_rows_ + post_start) * bytes_per_weight;
+        request_size = static_cast<size_t>(count_floats) * bytes_per_weight;
         if (stat_merged_reads_cls_) stat_merged_reads_cls_->addData(1);
     }
 
-    output_->verbose(CALL_INFO, 4, 0, "📤 读请求: pre=%u, post=%u, is_row=%d, post_start=%u, count=%u, addr=%" PRIu64 ", size=%zu\n",
+    SNNDL_TRACE(output_, 4, 0, "📤 读请求: pre=%u, post=%u, is_row=%d, post_start=%u, count=%u, addr=%" PRIu64 ", size=%zu\n",
                      target_pre, target_post, is_row, post_start, count_floats, request_addr, request_size);
     auto* read = new SST::Interfaces::StandardMem::Read(request_addr, request_size);
     uint64_t reqId = read->getID();
@@ -647,13 +1464,15 @@ void SnnPESubComponent::requestWeight(uint32_t pre_neuron, uint32_t post_neuron,
     pending_memory_requests_[reqId] = pmr;
     memory_->send(read);
     stat_memory_requests_->addData(1);
-    count_memory_requests_++;
+    noteMemoryRequest(target_pre, request_size);
 }
 
 void SnnPESubComponent::handleMemoryResponse(SST::Interfaces::StandardMem::Request* req) {
     if (!req) return;
     
-    output_->verbose(CALL_INFO, 4, 0, "📨 核心%d收到内存响应: ID=%" PRIu64 "\n", 
+    wakeClock();
+    
+    SNNDL_TRACE(output_, 4, 0, "📨 核心%d收到内存响应: ID=%" PRIu64 "\n", 
                     core_id_, req->getID());
     
     // 查找对应的挂起请求
@@ -661,50 +1480,63 @@ void SnnPESubComponent::handleMemoryResponse(SST::Interfaces::StandardMem::Reque
     if (it != pending_memory_requests_.end()) {
         PendingMemoryRequest pending_req = it->second; // 拷贝一份，便于先erase
         pending_memory_requests_.erase(it);
+        SNNDL_TRACE_EVENT(trace_ring_, total_cycles_, TraceEventType::MEM_RESPONSE, core_id_, pending_req.pre,
+                          static_cast<uint32_t>(pending_req.size));
+        
+        if (pending_req.sparse_stage != 0) {
+            handleSparseResponse(pending_req, dynamic_cast<SST::Interfaces::StandardMem::ReadResp*>(req));
+            delete req;
+            return;
+        }
 
         auto* readResp = dynamic_cast<SST::Interfaces::StandardMem::ReadResp*>(req);
         if (readResp && !readResp->data.empty()) {
             const std::vector<uint8_t>& bytes = readResp->data;
-            // 将返回数据拆成float并填入缓存
-            size_t float_count = bytes.size() / sizeof(float);
-            const float* fptr = reinterpret_cast<const float*>(bytes.data());
+            if (stat_weight_bytes_read_) stat_weight_bytes_read_->addData(bytes.size());
+            // 按权重精度解码并填入缓存
+            size_t float_count = weight_precision_.decodeArray(bytes.data(), bytes.size(), decoded_weights_);
+            const float* fptr = decoded_weights_.data();
             
             // 详细调试读取的字节数据
-            output_->verbose(CALL_INFO, 3, 0, "📥 内存响应: addr=0x%lx, bytes=%zu, floats=%zu\n",
-                              pending_req.address, bytes.size(), float_count);
-            if (float_count > 0 && float_count <= 4) {
-                output_->verbose(CALL_INFO, 3, 0, "   原始字节: ");
+            SNNDL_TRACE(output_, 3, 0, "📥 内存响应: addr=0x%lx, bytes=%zu, floats=%zu\n",
+                        pending_req.address, bytes.size(), float_count);
+            if (SNNDL_TRACE_ON(3) && float_count > 0 && float_count <= 4) {
+                char hex[16 * 3 + 1] = {0};
                 for (size_t b = 0; b < std::min(bytes.size(), (size_t)16); b++) {
-                    printf("%02x ", bytes[b]);
+                    snprintf(hex + b * 3, 4, "%02x ", bytes[b]);
                 }
-                printf("\n");
-                output_->verbose(CALL_INFO, 3, 0, "   解析浮点: ");
-                for (size_t f = 0; f < float_count; f++) {
-                    printf("%.6f ", fptr[f]);
-                }
-                printf("\n");
+                SNNDL_TRACE(output_, 3, 0, "   原始字节: %s\n", hex);
+                SNNDL_TRACE(output_, 3, 0, "   解析浮点: %.6f %.6f %.6f %.6f\n",
+                            fptr[0], float_count > 1 ? fptr[1] : 0.0f,
+                            float_count > 2 ? fptr[2] : 0.0f, float_count > 3 ? fptr[3] : 0.0f);
             }
             
             for (size_t i = 0; i < float_count; ++i) {
                 uint32_t post_idx = pending_req.post_start + static_cast<uint32_t>(i);
-                if (post_idx >= num_neurons_) break;
-                uint64_t key = static_cast<uint64_t>(pending_req.pre) * static_cast<uint64_t>(num_neurons_) + post_idx;
-                // 容量控制
-                if (weight_cache_.size() >= max_cache_entries_) {
-                    weight_cache_.clear();
-                }
-                weight_cache_[key] = fptr[i];
-                output_->verbose(CALL_INFO, 4, 0, "   缓存权重: pre=%u post=%u key=%lu value=%.6f\n",
+                if (post_idx >= weight_rows_) break;
+                uint64_t key = static_cast<uint64_t>(pending_req.pre) * static_cast<uint64_t>(weight_rows_) + post_idx;
+                // 组满时由替换策略逐条淘汰
+                cacheWeight(key, fptr[i]);
+                SNNDL_TRACE(output_, 4, 0, "   缓存权重: pre=%u post=%u key=%lu value=%.6f\n",
                                   pending_req.pre, post_idx, key, fptr[i]);
             }
-            output_->verbose(CALL_INFO, 4, 0, "📥 合并读填充: pre=%u, post_start=%u, count=%zu\n",
+            SNNDL_TRACE(output_, 4, 0, "📥 合并读填充: pre=%u, post_start=%u, count=%zu\n",
                               pending_req.pre, pending_req.post_start, float_count);
+            // 行扇出：施加等待该行的全部脉冲
+            if (pending_req.deliver_row) {
+                uint32_t spikes = 0;
+                auto waiting = row_pending_spikes_.find(pending_req.pre);
+                if (waiting != row_pending_spikes_.end()) {
+                    spikes = waiting->second;
+                    row_pending_spikes_.erase(waiting);
+                }
+                applyRowWeights(pending_req.pre, fptr, static_cast<uint32_t>(float_count), spikes);
+            }
             // 单目标回调（如果需要）
             if (pending_req.has_single_cb && pending_req.single_cb) {
-                uint64_t key = static_cast<uint64_t>(pending_req.pre) * static_cast<uint64_t>(num_neurons_) + pending_req.cb_post;
+                uint64_t key = static_cast<uint64_t>(pending_req.pre) * static_cast<uint64_t>(weight_rows_) + pending_req.cb_post;
                 float value = 0.0f;
-                auto itc = weight_cache_.find(key);
-                if (itc != weight_cache_.end()) value = itc->second;
+                weight_cache_.peek(key, value);
                 pending_req.single_cb(value);
             }
         } else {
@@ -712,14 +1544,126 @@ void SnnPESubComponent::handleMemoryResponse(SST::Interfaces::StandardMem::Reque
             if (pending_req.has_single_cb && pending_req.single_cb) {
                 pending_req.single_cb(0.0f);
             }
+            if (pending_req.deliver_row) {
+                output_->verbose(CALL_INFO, 2, 0, "⚠️ 核心%d行扇出读取无数据: pre=%u，等待的脉冲按零权重处理\n",
+                                 core_id_, pending_req.pre);
+                row_pending_spikes_.erase(pending_req.pre);
+            }
         }
         // 合并读：统一在响应时递减并发计数
         if (outstanding_requests_ > 0) outstanding_requests_--;
+        drainDeferredRowSpikes();
     }
     
     delete req;
 }
 
+void SnnPESubComponent::requestSparseRow(PendingMemoryRequest pmr) {
+    // 第一次访问：row_ptr[pre] 与 row_ptr[pre+1]
+    uint64_t addr = SparseWeightLayout::rowPointerAddr(base_addr_, pmr.pre);
+    size_t size = 2 * sizeof(uint32_t);
+    auto* read = new SST::Interfaces::StandardMem::Read(addr, size);
+    pmr.request_id = read->getID();
+    pmr.address = addr;
+    pmr.size = size;
+    pmr.sparse_stage = 1;
+    pending_memory_requests_[pmr.request_id] = pmr;
+    
+    SNNDL_TRACE(output_, 4, 0, "📤 稀疏行指针读请求: pre=%u, addr=%" PRIu64 "\n", pmr.pre, addr);
+    memory_->send(read);
+    stat_memory_requests_->addData(1);
+    if (stat_merged_reads_rows_) stat_merged_reads_rows_->addData(1);
+    noteMemoryRequest(pmr.pre, size);
+}
+
+void SnnPESubComponent::handleSparseResponse(PendingMemoryRequest& pending_req,
+                                             SST::Interfaces::StandardMem::ReadResp* resp) {
+    const bool has_data = resp && !resp->data.empty();
+    if (has_data && stat_weight_bytes_read_) stat_weight_bytes_read_->addData(resp->data.size());
+    
+    if (pending_req.sparse_stage == 1) {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        if (has_data && SparseWeightLayout::decodeRowPointers(resp->data.data(), resp->data.size(), begin, end) &&
+            end > begin) {
+            // 第二次访问：该行连续的紧凑条目；并发计数保留到条目读回
+            uint64_t addr = SparseWeightLayout::entryAddr(base_addr_, weight_rows_, begin, weight_precision_);
+            size_t size = static_cast<size_t>(end - begin) * SparseWeightLayout::entryBytes(weight_precision_);
+            auto* read = new SST::Interfaces::StandardMem::Read(addr, size);
+            pending_req.request_id = read->getID();
+            pending_req.address = addr;
+            pending_req.size = size;
+            pending_req.count_floats = end - begin;
+            pending_req.sparse_stage = 2;
+            pending_memory_requests_[pending_req.request_id] = pending_req;
+            
+            SNNDL_TRACE(output_, 4, 0, "📤 稀疏行条目读请求: pre=%u, 条目=%u, addr=%" PRIu64 ", size=%zu\n",
+                             pending_req.pre, end - begin, addr, size);
+            memory_->send(read);
+            stat_memory_requests_->addData(1);
+            noteMemoryRequest(pending_req.pre, size);
+            return;
+        }
+        // 空行或无数据
+        sparse_row_.clear();
+    } else if (has_data) {
+        SparseWeightLayout::decodeEntries(resp->data.data(), resp->data.size(), sparse_row_, weight_precision_);
+    } else {
+        output_->verbose(CALL_INFO, 2, 0, "⚠️ 核心%d稀疏行条目读取无数据: pre=%u，按零权重处理\n",
+                         core_id_, pending_req.pre);
+        sparse_row_.clear();
+    }
+    finishSparseRow(pending_req);
+}
+
+void SnnPESubComponent::finishSparseRow(const PendingMemoryRequest& pending_req) {
+    const uint64_t row_key = static_cast<uint64_t>(pending_req.pre) * static_cast<uint64_t>(weight_rows_);
+    for (const auto& entry : sparse_row_) {
+        if (entry.post < weight_rows_) cacheWeight(row_key + entry.post, entry.weight);
+    }
+    
+    // 行扇出：只对行内存在的突触施加，逐个脉冲依次施加
+    if (pending_req.deliver_row) {
+        uint32_t spikes = 0;
+        auto waiting = row_pending_spikes_.find(pending_req.pre);
+        if (waiting != row_pending_spikes_.end()) {
+            spikes = waiting->second;
+            row_pending_spikes_.erase(waiting);
+        }
+        for (uint32_t s = 0; s < spikes; s++) {
+            for (const auto& entry : sparse_row_) {
+                if (entry.post < weight_rows_) integrateInput(weight_block_offset_ + entry.post, entry.weight);
+            }
+        }
+        SNNDL_TRACE(output_, 5, 0, "⚡ 核心%d稀疏行扇出: pre=%u, 突触=%zu, 脉冲数=%u\n",
+                         core_id_, pending_req.pre, sparse_row_.size(), spikes);
+    }
+    
+    // 单目标回调：行内没有该突触时为零权重，并缓存以免重复读取
+    if (pending_req.has_single_cb && pending_req.single_cb) {
+        float value = 0.0f;
+        auto found = std::lower_bound(sparse_row_.begin(), sparse_row_.end(), pending_req.cb_post,
+                                      [](const SparseWeightLayout::Entry& e, uint32_t post) { return e.post < post; });
+        if (found != sparse_row_.end() && found->post == pending_req.cb_post) {
+            value = found->weight;
+        } else {
+            cacheWeight(row_key + pending_req.cb_post, 0.0f);
+        }
+        pending_req.single_cb(value);
+    }
+    
+    if (outstanding_requests_ > 0) outstanding_requests_--;
+    drainDeferredRowSpikes();
+}
+
+void SnnPESubComponent::cacheWeight(uint64_t key, float value) {
+    uint64_t evictions_before = weight_cache_.evictions();
+    weight_cache_.insert(key, value);
+    if (weight_cache_.evictions() != evictions_before && stat_weight_cache_evictions_) {
+        stat_weight_cache_evictions_->addData(1);
+    }
+}
+
 void SnnPESubComponent::initializeStatistics() {
     // output_->verbose(CALL_INFO, 2, 0, "📊 核心%d初始化统计收集\n", core_id_);
     
@@ -729,8 +1673,19 @@ void SnnPESubComponent::initializeStatistics() {
     stat_memory_requests_ = registerStatistic<uint64_t>("memory_requests");
     stat_weight_cache_hits_ = registerStatistic<uint64_t>("weight_cache_hits");
     stat_weight_cache_misses_ = registerStatistic<uint64_t>("weight_cache_misses");
+    stat_weight_cache_evictions_ = registerStatistic<uint64_t>("weight_cache_evictions");
     stat_merged_reads_rows_ = registerStatistic<uint64_t>("merged_reads_rows");
     stat_merged_reads_cls_ = registerStatistic<uint64_t>("merged_reads_cls");
+    stat_row_spikes_deferred_ = registerStatistic<uint64_t>("row_spikes_deferred");
+    stat_fanout_messages_ = registerStatistic<uint64_t>("fanout_messages");
+    stat_fanout_synapses_ = registerStatistic<uint64_t>("fanout_synapses");
+    stat_weight_bytes_read_ = registerStatistic<uint64_t>("weight_bytes_read");
+    stat_output_backlog_depth_ = registerStatistic<uint64_t>("output_backlog_depth");
+    stat_input_bucket_spikes_ = registerStatistic<uint64_t>("input_bucket_spikes");
+    stat_delayed_inputs_ = registerStatistic<uint64_t>("delayed_inputs");
+    stat_delays_clamped_ = registerStatistic<uint64_t>("delays_clamped");
+    stat_output_stall_cycles_ = registerStatistic<uint64_t>("output_stall_cycles");
+    stat_output_spikes_dropped_ = registerStatistic<uint64_t>("output_spikes_dropped");
     stat_weights_verify_count_ = registerStatistic<uint64_t>("weights_verify_count");
     stat_weights_mismatch_count_ = registerStatistic<uint64_t>("weights_mismatch_count");
     stat_weights_verify_sum_ = registerStatistic<double>("weights_verify_sum");
@@ -6,11 +6,25 @@
 #include <sst/core/link.h>
 #include <sst/core/output.h>
 #include <queue>
+#include <deque>
 #include <map>
 #include <functional>
+#include <memory>
 #include "SpikeEvent.h"
 #include "SnnPEParentInterface.h"
 #include "SnnCoreAPI.h"
+#include "NeuronStateArray.h"
+#include "NeuronUpdatePool.h"
+#include "NeuronModel.h"
+#include "WeightCache.h"
+#include "CsrWeightStore.h"
+#include "SparseWeightLayout.h"
+#include "SpikeCalendar.h"
+#include "SynapticDelayLine.h"
+#include "CoreCounters.h"
+#include "SnnTrace.h"
+#include "SpikeRecorder.h"
+#include "StateSnapshot.h"
 
 namespace SST {
 namespace SnnDL {
@@ -37,24 +51,58 @@ public:
         {"tau_mem", "Membrane time constant", "20.0"},
         {"t_ref", "Refractory period in clock cycles", "2"},
         {"base_addr", "Base address for weight fetching", "0"},
+        {"weight_rows", "Rows (= columns) of this core's weight block in memory; must equal WeightLoader neurons_per_core. 0 = num_neurons", "0"},
+        {"weight_block_offset", "Local index of the first neuron covered by the memory weight block; synapses with pre or post outside the block are not fetched", "0"},
         {"node_id", "Node ID of the parent PE", "0"},
         {"verbose", "Verbosity level", "0"},
         {"enable_weight_fetch", "Enable fetching weights from memory", "0"},
+        {"memory_port", "Parent port for an anonymous memHierarchy.standardInterface, used when no memory slot is configured (set by MultiCorePE for its own cores)", ""},
         {"write_weights_on_init", "Write default weights to memory on init", "1"},
         {"memory_warmup_cycles", "Cycles to wait before starting memory operations", "1000"},
         {"init_default_weight", "Default weight value to initialize memory with", "0.5"},
         {"max_outstanding_requests", "Maximum number of outstanding memory requests", "16"},
         {"max_cache_entries", "Maximum number of entries in the weight cache", "4096"},
+        {"weight_cache_ways", "Associativity of the weight cache (entries per set)", "8"},
+        {"weight_cache_policy", "Weight cache replacement policy [lru|clock]", "lru"},
         {"use_event_weight_fallback", "Use weight from spike event if memory fetch fails", "0"},
         {"merge_read_cacheline", "Merge memory reads to cache line size", "1"},
         {"merge_read_row", "Merge memory reads to a full row", "0"},
+        {"row_fanout_delivery", "Treat each incoming spike as a pre-neuron spike: read its whole weight row once and apply all post-synaptic updates when the row arrives", "0"},
         {"line_size_bytes", "Cache line size in bytes", "64"},
         {"enable_detailed_map_log", "Enable detailed logging of neuron mapping", "0"},
         {"verify_weights", "Enable weight verification", "0"},
         {"weight_verify_samples", "Number of weight samples to verify", "16"},
         {"expected_weight_value", "Expected weight value for verification", "0.0"},
         {"verify_epsilon", "Epsilon for floating point comparison", "1e-4"},
-        {"verify_log_each_sample", "Log each weight sample for verification", "0"}
+        {"verify_log_each_sample", "Log each weight sample for verification", "0"},
+        {"lazy_leak", "Apply leak lazily (closed-form leak^dt) when a neuron is touched instead of sweeping all neurons every cycle (lif only; other models are rejected)", "0"},
+        {"enable_clock_suspend", "Unregister the clock while the core is idle and re-register it when a spike or memory response arrives", "0"},
+        {"neuron_model", "Neuron model kernel [lif|izhikevich|alif]; each model is a compile-time specialised per-neuron update", "lif"},
+        {"izh_a", "Izhikevich recovery time scale a", "0.02"},
+        {"izh_b", "Izhikevich recovery sensitivity b", "0.2"},
+        {"izh_c", "Izhikevich after-spike reset of v (neurons start at the stable fixed point, about -70 with the defaults)", "-65.0"},
+        {"izh_d", "Izhikevich after-spike increment of u", "8.0"},
+        {"izh_dt", "Izhikevich Euler step per cycle (ms)", "1.0"},
+        {"izh_v_peak", "Izhikevich spike cutoff", "30.0"},
+        {"alif_tau_adapt", "ALIF adaptation time constant (cycles)", "200.0"},
+        {"alif_beta", "ALIF threshold increase per unit of adaptation (threshold = v_thresh + beta*a, a += 1 per spike)", "0.2"},
+        {"weight_precision", "Weight encoding in memory [float32|int16|int8]; must match the WeightLoader. Fixed-point weights are round-to-nearest and saturating", "float32"},
+        {"weight_scale", "Value of one fixed-point weight code (lsb); a power of two keeps the conversion exact", "0.015625"},
+        {"membrane_precision", "Membrane potential precision [float32|int16|int8]; fixed-point membranes saturate on input integration and are rounded on every update", "float32"},
+        {"membrane_scale", "Value of one fixed-point membrane code (lsb); thresholds and resets should lie inside the representable range", "0.0009765625"},
+        {"update_threads", "Threads (including the component thread) used for the per-cycle leak/threshold sweep; 1 = serial", "1"},
+        {"update_min_neurons_per_thread", "Minimum neurons per update thread; fewer threads are used for smaller populations", "8192"},
+        {"connectivity_file", "Per-core CSR fan-out table (4x4_weights_node_*.bin style, {node}/{core} placeholders allowed). Empty keeps the fixed layer routing", ""},
+        {"connectivity_format", "Connectivity file format [auto|records|dense|csr]. csr files are memory-mapped once per process and each core reads its own slice in place", "auto"},
+        {"weight_layout", "Memory weight layout written by WeightLoader [dense|csr]. csr reads row_ptr[pre..pre+1] and then the packed {post,weight} entries of that row; reads are always whole rows (merge_read_* are ignored)", "dense"},
+        {"output_backlog_depth", "Maximum number of fired spike messages held while the parent applies backpressure (canSendSpike() false); further messages are dropped and counted. 0 = unbounded", "1024"},
+        {"synaptic_delay", "Cycles between the tick after a spike arrives and the tick that integrates it (input calendar bucket offset)", "0"},
+        {"spike_queue_horizon", "Number of per-cycle buckets in the input calendar; spikes due further ahead wait in an overflow map", "16"},
+        {"deterministic_spike_order", "Process spikes of one bucket in (source, destination, timestamp) order instead of arrival order", "1"},
+        {"batch_fire_check", "Integrate all spikes of a bucket first, then run the threshold check once per touched neuron", "1"},
+        {"max_synaptic_delay", "Per-synapse delay line depth in cycles (ring of max+1 per-neuron input slots). 0 disables delay lines; longer delays are clamped. Added on top of synaptic_delay", "0"},
+        {"delay_file", "Per-synapse delays for the connectivity table: raw uint8 cycles, one per synapse in table order (whole-file nnz for csr tables). {node}/{core} placeholders allowed", ""},
+        {"warm_start_file", "State snapshot written by MultiCorePE checkpoint_out. The core restores neuron state, weight cache contents and its parsed connectivity/delay tables from it, and skips memory_warmup_cycles", ""}
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -64,11 +112,22 @@ public:
         {"memory_requests", "Number of memory requests sent", "requests", 1},
         {"weight_cache_hits", "Number of weight cache hits", "hits", 1},
         {"weight_cache_misses", "Number of weight cache misses", "misses", 1},
+        {"weight_cache_evictions", "Number of weight cache entries evicted by the replacement policy", "evictions", 1},
         {"merged_reads_rows", "Number of memory reads merged to a full row", "requests", 1},
         {"merged_reads_cls", "Number of memory reads merged to a cache line", "requests", 1},
+        {"row_spikes_deferred", "Number of row fan-out spikes whose membrane updates waited for a row read", "spikes", 1},
+        {"fanout_messages", "Number of aggregated spike messages emitted from the CSR fan-out table", "messages", 1},
+        {"fanout_synapses", "Number of synapses carried by CSR fan-out messages", "synapses", 1},
         {"weights_verify_count", "Number of weights verified", "count", 1},
         {"weights_mismatch_count", "Number of weights that failed verification", "count", 1},
-        {"weights_verify_sum", "Sum of verified weights for averaging", "value", 1}
+        {"weights_verify_sum", "Sum of verified weights for averaging", "value", 1},
+        {"weight_bytes_read", "Bytes of weight data returned by memory (row pointers included in csr layout)", "bytes", 1},
+        {"output_backlog_depth", "Output backlog depth each time a spike message is held back by parent backpressure", "messages", 1},
+        {"output_stall_cycles", "Cycles in which the output backlog could not be fully drained to the parent", "cycles", 1},
+        {"output_spikes_dropped", "Spike messages dropped because the output backlog was full", "messages", 1},
+        {"input_bucket_spikes", "Spikes integrated per non-empty input calendar bucket", "spikes", 1},
+        {"delayed_inputs", "Per-neuron delay slots consumed (delayed inputs merged per neuron and due cycle)", "inputs", 1},
+        {"delays_clamped", "Delayed synaptic inputs whose delay exceeded max_synaptic_delay", "inputs", 1}
     )
 
     SnnPESubComponent(SST::ComponentId_t id, SST::Params& params);
@@ -83,17 +142,13 @@ public:
     virtual bool hasWork() const override;
     virtual double getUtilization() const override;
     virtual void getStatistics(std::map<std::string, uint64_t>& stats) const override;
+    virtual void getFiringCounts(std::vector<uint64_t>& counts) const override;
+    virtual const CoreCounters* getCounters() const override { return &counters_; }
+    virtual bool saveState(std::vector<uint8_t>& state) override;
+    virtual void resetState() override;
     void setMemoryLink(SST::Link* link);
 
 private:
-    struct NeuronState {
-        float v_mem;
-        uint32_t refractory_timer;
-        Cycle_t last_spike_time;
-        NeuronState() : v_mem(0.0f), refractory_timer(0), last_spike_time(0) {}
-        NeuronState(float v_r) : v_mem(v_r), refractory_timer(0), last_spike_time(0) {}
-    };
-
     struct PendingMemoryRequest {
         SST::Interfaces::StandardMem::Request::id_t request_id;
         uint64_t address;
@@ -105,22 +160,52 @@ private:
         bool has_single_cb;
         uint32_t cb_post;
         std::function<void(float)> single_cb;
+        bool deliver_row = false;   // 行扇出：响应到达时对整行突触后神经元施加权重
+        uint8_t sparse_stage = 0;   // 稀疏布局：0=稠密读取，1=读row_ptr，2=读行条目
     };
 
     bool clockTick(Cycle_t current_cycle);
     void handleMemoryResponse(SST::Interfaces::StandardMem::Request* req);
     void initializeStatistics();
     void updateNeuronStates();
-    void applyLeak(uint32_t neuron_idx);
+    void catchUpNeuron(uint32_t neuron_idx, Cycle_t target_cycle);
+    bool canSuspendClock() const;
+    void wakeClock();
     void checkAndFireSpike(uint32_t neuron_idx);
+    void emitFanout(uint32_t neuron_idx);
+    void emitToParent(SpikeEvent* spike);
+    void drainOutputBacklog();
+    void integrateInput(uint32_t post_local, float weight);
+    void noteTouched(uint32_t neuron_idx);
+    void flushTouched();
+    bool loadConnectivity(const std::string& path, const std::string& format);
+    bool loadDelays(const std::string& path_template);
+    bool restoreState(const std::vector<uint8_t>& state, std::string& error);
+    void integrateDelayed(uint32_t post_local, float weight, uint32_t delay);
     void processLocalSpike(SpikeEvent* spike_event);
     void requestWeight(uint32_t pre_neuron, uint32_t post_neuron, std::function<void(float)> callback);
+    uint32_t mapPreToLocal(uint32_t pre_global) const;
+    /** 本地索引 → 内存权重块内的索引；不在块内时返回 false */
+    bool toWeightIndex(uint32_t local, uint32_t& index) const {
+        if (local < weight_block_offset_ || local - weight_block_offset_ >= weight_rows_) return false;
+        index = local - weight_block_offset_;
+        return true;
+    }
+    void deliverRowSpike(uint32_t pre_local);
+    void requestWeightRow(uint32_t pre_local);
+    void drainDeferredRowSpikes();
+    void applyRowWeights(uint32_t pre_local, const float* weights, uint32_t count, uint32_t spikes);
+    void requestSparseRow(PendingMemoryRequest pmr);
+    void handleSparseResponse(PendingMemoryRequest& pending_req, SST::Interfaces::StandardMem::ReadResp* resp);
+    void finishSparseRow(const PendingMemoryRequest& pending_req);
     bool loadTextWeights(const std::string& weights_file_path);
+    void cacheWeight(uint64_t key, float value);
 
     SnnPEParentInterface* parent_;
     Output* output_;
     SST::Interfaces::StandardMem* memory_;
     SST::Link* memory_link_;
+    std::string memory_port_;
 
     int core_id_;
     int total_cores_;
@@ -131,7 +216,11 @@ private:
     float v_rest_;
     float tau_mem_;
     uint32_t t_ref_;
+    bool lazy_leak_;             // 惰性泄漏：仅在神经元被访问时补算泄漏与不应期
+    bool enable_clock_suspend_;  // 空闲时注销时钟，有事件到达时重新注册
     uint64_t base_addr_;
+    uint32_t weight_rows_;          // 内存权重块的行数=列数（与WeightLoader的neurons_per_core一致）
+    uint32_t weight_block_offset_;  // 权重块首个神经元的本地索引
     uint32_t node_id_;
     int verbose_;
     bool enable_weight_fetch_;
@@ -144,6 +233,7 @@ private:
     bool event_weight_fallback_warned_;
     bool merge_read_cacheline_;
     bool merge_read_row_;
+    bool row_fanout_delivery_;   // 行扇出投递：每个脉冲一次整行读取，响应到达后统一更新膜电位
     uint32_t line_size_bytes_;
     bool enable_detailed_map_log_;
     bool detailed_log_emitted_ = false;
@@ -161,21 +251,77 @@ private:
     
     // 权重文件路径
     std::string weights_file_path_;
+    
+    // CSR扇出连接表：行 = 本核心神经元(本地ID)，列 = 突触后神经元全局ID（行内升序）
+    // csr格式直接指向共享映射中的本核心切片；records/dense格式解析到下列自有数组
+    CsrView fanout_;
+    bool fanout_loaded_ = false;
+    std::shared_ptr<const CsrWeightStore> fanout_store_;
+    std::vector<uint64_t> fanout_row_ptr_;
+    std::vector<uint32_t> fanout_post_;
+    std::vector<float> fanout_weight_;
+    std::vector<uint8_t> fanout_delays_;  // 本核心行区间的突触延迟，下标为 连接表序号 - fanout_delay_base_
+    uint64_t fanout_delay_base_ = 0;
+    uint32_t neurons_per_core_;   // 目标核心划分粒度（num_neurons / total_cores）
 
-    std::vector<NeuronState> neuron_states_;
-    std::queue<SpikeEvent*> incoming_spikes_;
-    std::map<uint64_t, float> weight_cache_;
+    // 神经元状态（SoA布局，v_mem/refractory/fired_mask 分别对齐存放）
+    NeuronStateArray neuron_states_;
+    std::unique_ptr<NeuronModel> neuron_model_;  // 逐周期动力学/阈值/复位，按模型编译期特化
+    std::vector<uint32_t> fired_indices_;   // 每周期更新内核输出的待发放神经元
+    NeuronUpdatePool* update_pool_ = nullptr; // 多线程更新工作池（update_threads<=1时不创建）
+    SpikeCalendar incoming_spikes_;         // 按投递周期分桶的输入脉冲
+    uint32_t synaptic_delay_ = 0;
+    bool deterministic_spike_order_ = true;
+    bool batch_fire_check_ = true;
+    bool batching_ = false;                 // 正在投递一个桶，阈值检查推迟到桶末
+    std::vector<uint32_t> touched_;         // 本桶积分过的神经元
+    std::vector<uint8_t> touched_mask_;
+    uint64_t count_fire_checks_batched_ = 0; // 合并掉的逐脉冲阈值检查次数
+    
+    // 突触延迟线：延迟输入按到期周期累加到每神经元槽位
+    SynapticDelayLine delay_line_;
+    uint64_t count_delayed_inputs_ = 0;
+    uint64_t count_delays_clamped_ = 0;
+    bool delay_ignored_warned_ = false;
+    WeightCache weight_cache_;
     std::map<SST::Interfaces::StandardMem::Request::id_t, PendingMemoryRequest> pending_memory_requests_;
     SST::Interfaces::StandardMem::Request::id_t next_request_id_;
     uint32_t outstanding_requests_ = 0;
     uint32_t pending_reqs_peak_ = 0;
+    
+    // 行扇出投递状态
+    std::map<uint32_t, uint32_t> row_pending_spikes_;  // pre_local -> 等待该行权重的脉冲数（在途或排队）
+    std::deque<uint32_t> deferred_row_reads_;          // 因并发上限尚未发出行读取的 pre_local
+    std::vector<float> row_buffer_;                    // 缓存命中时拼装整行权重的暂存区
+    bool sparse_layout_ = false;                       // 内存权重为SparseWeightLayout（CSR）布局
+    std::vector<SparseWeightLayout::Entry> sparse_row_; // 最近读回的一行稀疏条目
+    FixedPointFormat weight_precision_;                // 内存权重编码（须与WeightLoader一致）
+    FixedPointFormat membrane_precision_;              // 膜电位精度，定点时输入积分为饱和加法
+    std::vector<float> decoded_weights_;               // 稠密读回数据解码后的权重
+    uint64_t count_row_spikes_deferred_ = 0;
+    uint64_t count_fanout_messages_ = 0;
+    uint64_t count_fanout_synapses_ = 0;
+    
+    // 父级背压期间暂存的发放输出
+    std::deque<SpikeEvent*> output_backlog_;
+    uint32_t output_backlog_depth_;
+    uint64_t output_stall_cycles_ = 0;
+    uint64_t output_spikes_dropped_ = 0;
 
     Cycle_t total_cycles_;
     Cycle_t active_cycles_;
+    Cycle_t suspended_cycles_;   // 时钟挂起期间跳过的周期数
+    
+    // 时钟挂起/唤醒状态
+    TimeConverter* clock_tc_;
+    Clock::HandlerBase* clock_handler_;
+    bool clock_suspended_;
+    Cycle_t last_tick_cycle_;    // 最后一次执行时钟处理器时的SST周期号
     bool boot_read_sent_;
     bool boot_write_sent_;
     uint32_t delayed_read_counter_;
     bool delayed_read_triggered_ = false;
+    bool warm_started_ = false;  // 由warm_start_file恢复，跳过暖机与启动读取
     bool weights_initialized_;
     bool memory_ready_;
     bool first_cache_hit_logged_ = false;
@@ -187,17 +333,41 @@ private:
     Statistic<uint64_t>* stat_memory_requests_;
     Statistic<uint64_t>* stat_weight_cache_hits_;
     Statistic<uint64_t>* stat_weight_cache_misses_;
+    Statistic<uint64_t>* stat_weight_cache_evictions_;
     Statistic<uint64_t>* stat_merged_reads_rows_;
     Statistic<uint64_t>* stat_merged_reads_cls_;
+    Statistic<uint64_t>* stat_row_spikes_deferred_;
+    Statistic<uint64_t>* stat_fanout_messages_;
+    Statistic<uint64_t>* stat_fanout_synapses_;
+    Statistic<uint64_t>* stat_weight_bytes_read_;
+    Statistic<uint64_t>* stat_output_backlog_depth_;
+    Statistic<uint64_t>* stat_output_stall_cycles_;
+    Statistic<uint64_t>* stat_output_spikes_dropped_;
+    Statistic<uint64_t>* stat_input_bucket_spikes_;
+    Statistic<uint64_t>* stat_delayed_inputs_;
+    Statistic<uint64_t>* stat_delays_clamped_;
     Statistic<uint64_t>* stat_weights_verify_count_;
     Statistic<uint64_t>* stat_weights_mismatch_count_;
     Statistic<double>* stat_weights_verify_sum_;
     
-    // 内部计数器用于getStatistics()方法
-    uint64_t count_spikes_received_;
-    uint64_t count_spikes_generated_;
-    uint64_t count_neurons_fired_;
-    uint64_t count_memory_requests_;
+    // 内部计数器：父组件经getCounters()按指针读取，getStatistics()也由此导出
+    CoreCounters counters_;
+    std::vector<uint32_t> fire_counts_;       // 每个神经元的发放次数（用于导出放置活动）
+    TraceRing* trace_ring_ = nullptr;         // 父组件的事件环（未启用时为nullptr）
+    SpikeRecorder* recorder_ = nullptr;       // 父组件的发放栅格记录器（未启用时为nullptr）
+    
+    /** 周期计数在热路径上以普通变量维护，在时钟处理末尾统一发布到计数器块 */
+    void publishCycleCounters() {
+        counters_.total_cycles.set(total_cycles_);
+        counters_.active_cycles.set(active_cycles_);
+        counters_.suspended_cycles.set(suspended_cycles_);
+    }
+    
+    void noteMemoryRequest(uint32_t pre, size_t bytes) {
+        counters_.memory_requests.add();
+        SNNDL_TRACE_EVENT(trace_ring_, total_cycles_, TraceEventType::MEM_REQUEST, core_id_, pre,
+                          static_cast<uint32_t>(bytes));
+    }
 };
 
 } // namespace SnnDL
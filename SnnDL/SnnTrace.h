@@ -0,0 +1,146 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SnnTrace.h: 热路径跟踪宏与二进制事件环形缓冲头文件
+//
+
+#ifndef _SNNTRACE_H
+#define _SNNTRACE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * 编译期跟踪级别：热路径上的 SNNDL_TRACE(out, level, ...) 仅在 level <= SNNDL_TRACE_LEVEL
+ * 时编译进来，否则条件为常量假，整条语句（含格式化参数的求值）被编译器消除。
+ * 编进来的语句仍受运行时 verbose 参数约束。默认 0，即热路径日志全部关闭；
+ * 调试时以 CPPFLAGS=-DSNNDL_TRACE_LEVEL=5 重新构建。
+ */
+#ifndef SNNDL_TRACE_LEVEL
+#define SNNDL_TRACE_LEVEL 0
+#endif
+
+/** 二进制事件环（TraceRing）的记录点，置0时全部编译消除 */
+#ifndef SNNDL_TRACE_RING
+#define SNNDL_TRACE_RING 1
+#endif
+
+#define SNNDL_TRACE_ON(level) (SNNDL_TRACE_LEVEL >= (level))
+
+#define SNNDL_TRACE(out, level, ...)                                   \
+    do {                                                               \
+        if (SNNDL_TRACE_ON(level)) {                                   \
+            (out)->verbose(CALL_INFO, level, __VA_ARGS__);             \
+        }                                                              \
+    } while (0)
+
+#define SNNDL_TRACE_EVENT(ring, ...)                                   \
+    do {                                                               \
+        if (SNNDL_TRACE_RING && (ring)) {                              \
+            (ring)->record(__VA_ARGS__);                               \
+        }                                                              \
+    } while (0)
+
+namespace SST {
+namespace SnnDL {
+
+/** 事件环中的记录类型（a/b/value 的含义见各项注释） */
+enum class TraceEventType : uint16_t {
+    SPIKE_IN = 1,     ///< 核心接收脉冲: a=源全局ID, b=目标全局ID, value=权重
+    NEURON_FIRE = 2,  ///< 神经元发放: a=本地神经元, b=全局ID
+    MEM_REQUEST = 3,  ///< 核心发起权重读取: a=突触前神经元, b=字节数
+    MEM_RESPONSE = 4, ///< 权重读取返回: a=突触前神经元, b=字节数
+    EXT_IN = 5,       ///< 节点接收外部脉冲: a=源全局ID, b=目标全局ID, value=权重
+    EXT_OUT = 6,      ///< 节点向网络发出脉冲: a=源全局ID, b=目标节点
+    INTER_CORE = 7    ///< 节点内跨核转发: a=目标全局ID, b=目标核心
+};
+
+/** 定长24字节记录，按小端原样写入转储文件 */
+struct TraceRecord {
+    uint64_t cycle;
+    uint16_t type;
+    uint16_t core;    ///< 核心ID；节点级事件为 0xFFFF
+    uint32_t a;
+    uint32_t b;
+    float value;
+};
+static_assert(sizeof(TraceRecord) == 24, "TraceRecord 须为24字节");
+
+/**
+ * @brief 固定容量的二进制事件环
+ *
+ * 记录一次只是一次下标取模与一条24字节写入，不分配内存、不格式化；写满后覆盖最旧的记录，
+ * 因此可在正式运行中常开，finish() 时转储最近 capacity 条事件。
+ *
+ * 转储文件格式：
+ *   "SNNTRACE"(8B) | u32 版本=1 | u32 记录字节数=24 | u64 记录数 | u64 被覆盖数 | 记录[记录数]（从旧到新）
+ */
+class TraceRing {
+public:
+    static constexpr uint16_t NODE_CORE = 0xFFFF;
+
+    /** capacity 向上取整到2的幂 */
+    explicit TraceRing(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        records_.resize(cap);
+        mask_ = cap - 1;
+    }
+
+    void record(uint64_t cycle, TraceEventType type, uint32_t core, uint32_t a, uint32_t b, float value = 0.0f) {
+        TraceRecord& r = records_[head_ & mask_];
+        r.cycle = cycle;
+        r.type = static_cast<uint16_t>(type);
+        r.core = static_cast<uint16_t>(core);
+        r.a = a;
+        r.b = b;
+        r.value = value;
+        head_++;
+    }
+
+    size_t capacity() const { return records_.size(); }
+    uint64_t recorded() const { return head_; }
+    size_t size() const { return head_ < records_.size() ? static_cast<size_t>(head_) : records_.size(); }
+    uint64_t overwritten() const { return head_ - size(); }
+
+    /** 写出转储文件，失败时返回false并给出原因 */
+    bool dump(const std::string& path, std::string& error) const {
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) {
+            error = "无法打开跟踪文件 " + path;
+            return false;
+        }
+        const uint32_t version = 1;
+        const uint32_t record_bytes = sizeof(TraceRecord);
+        const uint64_t count = size();
+        const uint64_t lost = overwritten();
+        bool ok = std::fwrite("SNNTRACE", 1, 8, f) == 8 &&
+                  std::fwrite(&version, sizeof(version), 1, f) == 1 &&
+                  std::fwrite(&record_bytes, sizeof(record_bytes), 1, f) == 1 &&
+                  std::fwrite(&count, sizeof(count), 1, f) == 1 &&
+                  std::fwrite(&lost, sizeof(lost), 1, f) == 1;
+        // 从最旧的记录开始，分两段连续写出
+        size_t start = static_cast<size_t>(lost ? (head_ & mask_) : 0);
+        size_t first = std::min(count, static_cast<uint64_t>(records_.size() - start));
+        if (ok && first > 0) ok = std::fwrite(&records_[start], sizeof(TraceRecord), first, f) == first;
+        if (ok && count > first) ok = std::fwrite(&records_[0], sizeof(TraceRecord), count - first, f) == count - first;
+        if (std::fclose(f) != 0) ok = false;
+        if (!ok) error = "写入跟踪文件失败 " + path;
+        return ok;
+    }
+
+private:
+    std::vector<TraceRecord> records_;
+    uint64_t head_ = 0;
+    size_t mask_ = 0;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _SNNTRACE_H */
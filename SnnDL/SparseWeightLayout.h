@@ -0,0 +1,170 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SparseWeightLayout.h: 仿真内存中的稀疏（CSR）权重布局头文件
+//
+
+#ifndef _SPARSEWEIGHTLAYOUT_H
+#define _SPARSEWEIGHTLAYOUT_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "FixedPoint.h"
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 每核权重块在仿真内存中的稀疏布局
+ *
+ * 稠密布局为 float[rows][cols]，地址 base + (pre*cols + post)*4。
+ * 稀疏布局（小端）：
+ * - base 起：u32 row_ptr[rows+1]，row_ptr[r] 为第r行首个条目的序号
+ * - entriesBase 起（按 ALIGN 对齐）：条目 {u32 post; weight}，行内按 post 升序，
+ *   weight 按 FixedPointFormat 编码（f32 / i16 / i8，条目8 / 6 / 5字节，紧密排列）
+ *
+ * 核心读取一行需两次访问：先读 row_ptr[pre..pre+1] 的8字节，再读连续的
+ * (end-begin)*entryBytes 字节条目。内存占用与访问量随实际突触数而非 rows*cols 增长。
+ * WeightLoader 写入与核心读取共用本类计算地址，保证两侧一致。
+ */
+class SparseWeightLayout {
+public:
+    static constexpr uint64_t ALIGN = 64;          ///< 条目段起点对齐（一个缓存行）
+    static constexpr uint64_t ENTRY_BYTES = 8;     ///< float32 权重时每个条目 {u32 post, f32 weight}
+
+    /** 解码后的一个突触 */
+    struct Entry {
+        uint32_t post;
+        float weight;
+    };
+
+    /** 第 row 行 row_ptr 的地址；读8字节即得 [begin, end) */
+    static uint64_t rowPointerAddr(uint64_t base, uint32_t row) {
+        return base + static_cast<uint64_t>(row) * sizeof(uint32_t);
+    }
+
+    /** 条目段起始地址 */
+    static uint64_t entriesBase(uint64_t base, uint32_t rows) {
+        uint64_t ptr_bytes = (static_cast<uint64_t>(rows) + 1) * sizeof(uint32_t);
+        return base + (ptr_bytes + ALIGN - 1) / ALIGN * ALIGN;
+    }
+
+    /** 给定权重格式下每个条目的字节数 */
+    static uint64_t entryBytes(const FixedPointFormat& format = FixedPointFormat()) {
+        return sizeof(uint32_t) + format.bytes();
+    }
+
+    /** 第 index 个条目的地址 */
+    static uint64_t entryAddr(uint64_t base, uint32_t rows, uint64_t index,
+                              const FixedPointFormat& format = FixedPointFormat()) {
+        return entriesBase(base, rows) + index * entryBytes(format);
+    }
+
+    /** 稀疏映像总字节数 */
+    static uint64_t imageBytes(uint32_t rows, uint64_t nnz, const FixedPointFormat& format = FixedPointFormat()) {
+        return entriesBase(0, rows) + nnz * entryBytes(format);
+    }
+
+    /**
+     * @brief 从读回的8字节 row_ptr 对解出行区间
+     */
+    static bool decodeRowPointers(const uint8_t* data, size_t bytes, uint32_t& begin, uint32_t& end) {
+        if (bytes < 2 * sizeof(uint32_t)) return false;
+        std::memcpy(&begin, data, sizeof(uint32_t));
+        std::memcpy(&end, data + sizeof(uint32_t), sizeof(uint32_t));
+        return end >= begin;
+    }
+
+    /**
+     * @brief 解码读回的连续条目
+     * @return 解出的条目数（不完整的尾部字节被忽略）
+     */
+    static size_t decodeEntries(const uint8_t* data, size_t bytes, std::vector<Entry>& out,
+                                const FixedPointFormat& format = FixedPointFormat()) {
+        const uint64_t entry_bytes = entryBytes(format);
+        size_t count = bytes / entry_bytes;
+        out.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            std::memcpy(&out[i].post, data + i * entry_bytes, sizeof(uint32_t));
+            out[i].weight = format.decode(data + i * entry_bytes + sizeof(uint32_t));
+        }
+        return count;
+    }
+
+    /**
+     * @brief 按行追加突触并序列化为内存映像
+     *
+     * 行必须按 0..rows-1 顺序开始，行内 post 须升序。权重在序列化时按 format 量化。
+     */
+    class Builder {
+    public:
+        explicit Builder(uint32_t rows, const FixedPointFormat& format = FixedPointFormat())
+            : rows_(rows), format_(format) {
+            row_ptr_.reserve(static_cast<size_t>(rows) + 1);
+            row_ptr_.push_back(0);
+        }
+
+        void add(uint32_t post, float weight) {
+            if (format_.saturates(weight)) saturated_++;
+            entries_.push_back(Entry{post, weight});
+        }
+
+        /** 结束当前行（空行也须调用） */
+        void endRow() { row_ptr_.push_back(static_cast<uint32_t>(entries_.size())); }
+
+        uint64_t nnz() const { return entries_.size(); }
+
+        /** 量化时被饱和截断的权重个数 */
+        uint64_t saturated() const { return saturated_; }
+
+        /**
+         * @brief 生成映像；未结束的行视为空行
+         */
+        void serialize(std::vector<uint8_t>& image) {
+            while (row_ptr_.size() < static_cast<size_t>(rows_) + 1) endRow();
+            const uint64_t entry_bytes = entryBytes(format_);
+            image.assign(imageBytes(rows_, entries_.size(), format_), 0);
+            std::memcpy(image.data(), row_ptr_.data(), row_ptr_.size() * sizeof(uint32_t));
+            uint8_t* out = image.data() + entriesBase(0, rows_);
+            for (size_t i = 0; i < entries_.size(); i++) {
+                std::memcpy(out + i * entry_bytes, &entries_[i].post, sizeof(uint32_t));
+                format_.encode(entries_[i].weight, out + i * entry_bytes + sizeof(uint32_t));
+            }
+        }
+
+    private:
+        uint32_t rows_;
+        FixedPointFormat format_;
+        uint64_t saturated_ = 0;
+        std::vector<uint32_t> row_ptr_;
+        std::vector<Entry> entries_;
+    };
+
+    /**
+     * @brief 由行优先稠密矩阵生成稀疏映像，零权重视为无突触
+     * @param saturated 可选输出：量化时被饱和截断的权重个数
+     * @return 非零突触数
+     */
+    static uint64_t fromDense(const float* rows_data, uint32_t rows, uint32_t cols, std::vector<uint8_t>& image,
+                              const FixedPointFormat& format = FixedPointFormat(), uint64_t* saturated = nullptr) {
+        Builder builder(rows, format);
+        for (uint32_t r = 0; r < rows; r++) {
+            const float* row = rows_data + static_cast<size_t>(r) * cols;
+            for (uint32_t c = 0; c < cols; c++) {
+                if (format.snap(row[c]) != 0.0f) builder.add(c, row[c]);
+            }
+            builder.endRow();
+        }
+        builder.serialize(image);
+        if (saturated) *saturated = builder.saturated();
+        return builder.nnz();
+    }
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _SPARSEWEIGHTLAYOUT_H */
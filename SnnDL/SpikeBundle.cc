@@ -0,0 +1,103 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SpikeBundle.cc: 多脉冲聚合事件实现文件
+//
+
+#include "SpikeBundle.h"
+
+#include <algorithm>
+
+using namespace SST::SnnDL;
+
+size_t SpikeBundle::spikeWireBytes(const SpikeEvent& spike) {
+    // 源/目标神经元各4字节，时间戳8字节，权重4字节，目标数4字节，每个目标8字节
+    return 24 + spike.getTargetCount() * (sizeof(uint32_t) + sizeof(float));
+}
+
+void SpikeBundle::addSpike(const SpikeEvent& spike) {
+    src_neurons_.push_back(spike.getSourceNeuron());
+    dest_neurons_.push_back(spike.getDestinationNeuron());
+    timestamps_.push_back(spike.getTimestamp());
+    weights_.push_back(static_cast<float>(spike.getWeight()));
+    target_counts_.push_back(static_cast<uint32_t>(spike.getTargetCount()));
+    target_neurons_.insert(target_neurons_.end(), spike.getTargetNeurons().begin(), spike.getTargetNeurons().end());
+    target_weights_.insert(target_weights_.end(), spike.getTargetWeights().begin(), spike.getTargetWeights().end());
+    // 延迟列表与目标列表等长平铺；首个带延迟的脉冲到来前的目标补0
+    if (spike.hasTargetDelays() && target_delays_.empty()) {
+        target_delays_.assign(target_neurons_.size() - spike.getTargetCount(), 0);
+    }
+    if (!target_delays_.empty()) {
+        for (size_t t = 0; t < spike.getTargetCount(); t++) target_delays_.push_back(spike.getTargetDelay(t));
+        wire_bytes_ += spike.getTargetCount();
+    }
+    wire_bytes_ += spikeWireBytes(spike);
+}
+
+SpikeEvent* SpikeBundle::unpackSpike(size_t i) const {
+    // 目标列表按脉冲顺序平铺，需累加前序脉冲的目标数得到偏移
+    size_t offset = 0;
+    for (size_t k = 0; k < i && k < target_counts_.size(); k++) offset += target_counts_[k];
+    return unpackSpike(i, offset);
+}
+
+SpikeEvent* SpikeBundle::unpackSpike(size_t i, size_t& target_offset) const {
+    if (i >= src_neurons_.size()) return nullptr;
+
+    SpikeEvent* spike = new SpikeEvent(src_neurons_[i], dest_neurons_[i], dest_node_,
+                                       weights_[i], timestamps_[i]);
+    for (uint32_t t = 0; t < target_counts_[i]; t++) {
+        uint8_t delay = target_delays_.empty() ? 0 : target_delays_[target_offset + t];
+        spike->addTarget(target_neurons_[target_offset + t], target_weights_[target_offset + t], delay);
+    }
+    target_offset += target_counts_[i];
+    return spike;
+}
+
+SpikeBundler::~SpikeBundler() {
+    for (auto& entry : open_) delete entry.second.bundle;
+    for (auto& r : ready_) delete r.bundle;
+}
+
+void SpikeBundler::configure(uint32_t max_spikes, uint64_t window_cycles, uint32_t max_bytes) {
+    max_spikes_ = std::max<uint32_t>(1, max_spikes);
+    window_cycles_ = window_cycles;
+    max_bytes_ = std::max<uint32_t>(static_cast<uint32_t>(SpikeBundle::HEADER_BYTES + 24), max_bytes);
+}
+
+void SpikeBundler::seal(std::map<uint32_t, OpenBundle>::iterator it, FlushReason reason) {
+    ready_.push_back(ReadyBundle{it->second.bundle, reason});
+    open_.erase(it);
+}
+
+void SpikeBundler::add(SpikeEvent* spike, uint64_t now) {
+    if (!spike) return;
+    uint32_t dest = spike->getDestinationNode();
+
+    auto it = open_.find(dest);
+    if (it != open_.end() &&
+        it->second.bundle->wireBytes() + SpikeBundle::spikeWireBytes(*spike) > max_bytes_) {
+        seal(it, FlushReason::SIZE);
+        it = open_.end();
+    }
+    if (it == open_.end()) {
+        it = open_.emplace(dest, OpenBundle{new SpikeBundle(dest), now}).first;
+    }
+
+    it->second.bundle->addSpike(*spike);
+    delete spike;
+
+    if (it->second.bundle->getSpikeCount() >= max_spikes_) {
+        seal(it, FlushReason::COUNT);
+    }
+}
+
+void SpikeBundler::flushExpired(uint64_t now) {
+    for (auto it = open_.begin(); it != open_.end();) {
+        auto current = it++;
+        if (now - current->second.opened_at >= window_cycles_) {
+            seal(current, FlushReason::WINDOW);
+        }
+    }
+}
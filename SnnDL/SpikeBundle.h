@@ -0,0 +1,153 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SpikeBundle.h: 多脉冲聚合事件（同一目标节点的脉冲打包为一个网络数据包）头文件
+//
+
+#ifndef _SPIKEBUNDLE_H
+#define _SPIKEBUNDLE_H
+
+#include <sst/core/event.h>
+#include <sst/core/serialization/serialize.h>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "SpikeEvent.h"
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 多脉冲聚合事件
+ *
+ * 将发往同一目标节点的多个 SpikeEvent 以结构数组形式打包，
+ * 作为一个 SimpleNetwork 数据包传输，接收端再逐个还原为 SpikeEvent。
+ * 聚合扇出事件的目标列表按脉冲顺序平铺存放。
+ */
+class SpikeBundle : public SST::Event {
+public:
+    /** 包头字节数（目标节点 + 脉冲数） */
+    static constexpr size_t HEADER_BYTES = 8;
+
+    SpikeBundle() : SST::Event(), dest_node_(0) {}
+    explicit SpikeBundle(uint32_t dest_node) : SST::Event(), dest_node_(dest_node) {}
+
+    /**
+     * @brief 追加一个脉冲（复制其内容）
+     */
+    void addSpike(const SpikeEvent& spike);
+
+    /**
+     * @brief 还原第 i 个脉冲，调用者接管返回对象
+     */
+    SpikeEvent* unpackSpike(size_t i) const;
+
+    /**
+     * @brief 顺序还原时使用：target_offset 为第 i 个脉冲的目标列表偏移，返回后前进到下一个脉冲
+     */
+    SpikeEvent* unpackSpike(size_t i, size_t& target_offset) const;
+
+    size_t getSpikeCount() const { return src_neurons_.size(); }
+    bool empty() const { return src_neurons_.empty(); }
+    uint32_t getDestinationNode() const { return dest_node_; }
+
+    /**
+     * @brief 按线上格式估算的数据包字节数（用于 size_in_bits）
+     */
+    size_t wireBytes() const { return wire_bytes_; }
+
+    /**
+     * @brief 单个脉冲在聚合包中占用的字节数
+     */
+    static size_t spikeWireBytes(const SpikeEvent& spike);
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        Event::serialize_order(ser);
+        SST_SER(dest_node_);
+        SST_SER(wire_bytes_);
+        SST_SER(src_neurons_);
+        SST_SER(dest_neurons_);
+        SST_SER(timestamps_);
+        SST_SER(weights_);
+        SST_SER(target_counts_);
+        SST_SER(target_neurons_);
+        SST_SER(target_weights_);
+        SST_SER(target_delays_);
+    }
+
+private:
+    uint32_t dest_node_;
+    size_t wire_bytes_ = HEADER_BYTES;
+    std::vector<uint32_t> src_neurons_;
+    std::vector<uint32_t> dest_neurons_;
+    std::vector<uint64_t> timestamps_;
+    std::vector<float> weights_;
+    std::vector<uint32_t> target_counts_;   ///< 每个脉冲携带的目标数（0 表示单目标事件）
+    std::vector<uint32_t> target_neurons_;
+    std::vector<float> target_weights_;
+    std::vector<uint8_t> target_delays_;    ///< 与 target_neurons_ 等长的突触延迟（为空表示全为0）
+
+    ImplementSerializable(SST::SnnDL::SpikeBundle)
+};
+
+/**
+ * @brief 按目标节点聚合脉冲的缓冲器
+ *
+ * 每个目标节点维护一个打开的 SpikeBundle，满足以下任一条件时封包：
+ * - 脉冲数达到 max_spikes（COUNT）
+ * - 再追加将超过 max_bytes（SIZE）
+ * - 自打开起经过 window_cycles 个周期（WINDOW）
+ * 封好的包进入就绪队列，由所属网络接口负责发送。
+ */
+class SpikeBundler {
+public:
+    enum class FlushReason { COUNT, SIZE, WINDOW };
+
+    struct ReadyBundle {
+        SpikeBundle* bundle;
+        FlushReason reason;
+    };
+
+    SpikeBundler() : max_spikes_(32), window_cycles_(4), max_bytes_(256) {}
+    ~SpikeBundler();
+
+    void configure(uint32_t max_spikes, uint64_t window_cycles, uint32_t max_bytes);
+
+    /**
+     * @brief 加入一个脉冲并接管其内存（内容复制进包后即释放）
+     * @param spike 脉冲事件
+     * @param now 当前周期
+     */
+    void add(SpikeEvent* spike, uint64_t now);
+
+    /**
+     * @brief 封装所有已到期的打开包
+     */
+    void flushExpired(uint64_t now);
+
+    bool hasOpenBundles() const { return !open_.empty(); }
+    std::deque<ReadyBundle>& ready() { return ready_; }
+
+private:
+    struct OpenBundle {
+        SpikeBundle* bundle;
+        uint64_t opened_at;
+    };
+
+    void seal(std::map<uint32_t, OpenBundle>::iterator it, FlushReason reason);
+
+    uint32_t max_spikes_;
+    uint64_t window_cycles_;
+    uint32_t max_bytes_;
+    std::map<uint32_t, OpenBundle> open_;   ///< 目标节点 -> 打开的包
+    std::deque<ReadyBundle> ready_;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _SPIKEBUNDLE_H */
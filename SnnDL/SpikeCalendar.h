@@ -0,0 +1,156 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SpikeCalendar.h: 按投递周期分桶的输入脉冲日历队列头文件
+//
+
+#ifndef _SPIKECALENDAR_H
+#define _SPIKECALENDAR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "SpikeEvent.h"
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 输入脉冲日历队列
+ *
+ * 以投递周期为键的环形桶数组，桶数为 horizon，覆盖 [base, base+horizon) 的周期；
+ * 更远的脉冲暂存在溢出表中，到期时直接取出。突触延迟因此只是更晚的桶，不需额外事件。
+ *
+ * 取出一个桶时可按 (源神经元, 目标神经元, 时间戳) 稳定排序，
+ * 同一周期到达的脉冲处理顺序不再取决于 SST 线程/rank 间的事件交错，
+ * 浮点累加顺序固定，结果可跨并行配置复现。
+ */
+class SpikeCalendar {
+public:
+    explicit SpikeCalendar(uint32_t horizon = 1) { configure(horizon); }
+
+    ~SpikeCalendar() { clear(); }
+
+    SpikeCalendar(const SpikeCalendar&) = delete;
+    SpikeCalendar& operator=(const SpikeCalendar&) = delete;
+
+    /**
+     * @brief 设置桶数（仅在队列为空时调用）
+     */
+    void configure(uint32_t horizon) {
+        buckets_.assign(horizon > 0 ? horizon : 1, {});
+    }
+
+    /**
+     * @brief 按投递周期入队，接管脉冲内存；早于已取出周期的脉冲并入下一个待取桶
+     */
+    void push(uint64_t due_cycle, SpikeEvent* spike) {
+        if (!spike) return;
+        if (due_cycle < base_) due_cycle = base_;
+        if (due_cycle - base_ < buckets_.size()) {
+            buckets_[due_cycle % buckets_.size()].push_back(spike);
+            ring_count_++;
+        } else {
+            overflow_[due_cycle].push_back(spike);
+        }
+        size_++;
+        if (size_ > peak_size_) peak_size_ = size_;
+    }
+
+    /**
+     * @brief 依周期顺序取出所有投递周期 <= now 的桶
+     * @param sorted 是否在桶内按 (源, 目标, 时间戳) 稳定排序
+     * @param begin_bucket 每个非空桶开始前调用 begin_bucket(cycle, count)
+     * @param deliver 对每个脉冲调用，接管其内存
+     * @param end_bucket 每个非空桶结束后调用 end_bucket(cycle)
+     * @return 取出的脉冲数
+     */
+    template <typename B, typename F, typename E>
+    size_t drain(uint64_t now, bool sorted, B&& begin_bucket, F&& deliver, E&& end_bucket) {
+        size_t count = 0;
+        while (base_ <= now && size_ > 0) {
+            if (ring_count_ == 0) {
+                // 环内无脉冲：直接跳到下一个溢出周期（或 now 之后）
+                uint64_t next = overflow_.empty() ? now + 1 : std::min(overflow_.begin()->first, now + 1);
+                if (next > base_) base_ = next;
+                if (base_ > now) break;
+            }
+            std::vector<SpikeEvent*>& bucket = buckets_[base_ % buckets_.size()];
+            ring_count_ -= bucket.size();
+            current_.swap(bucket);
+            auto over = overflow_.find(base_);
+            if (over != overflow_.end()) {
+                current_.insert(current_.end(), over->second.begin(), over->second.end());
+                overflow_.erase(over);
+            }
+            // 溢出表中进入新窗口末端的脉冲移入环
+            base_++;
+            promoteOverflow();
+
+            if (!current_.empty()) {
+                if (sorted && current_.size() > 1) {
+                    std::stable_sort(current_.begin(), current_.end(), [](const SpikeEvent* a, const SpikeEvent* b) {
+                        if (a->getSourceNeuron() != b->getSourceNeuron()) return a->getSourceNeuron() < b->getSourceNeuron();
+                        if (a->getDestinationNeuron() != b->getDestinationNeuron())
+                            return a->getDestinationNeuron() < b->getDestinationNeuron();
+                        return a->getTimestamp() < b->getTimestamp();
+                    });
+                }
+                size_ -= current_.size();
+                count += current_.size();
+                begin_bucket(base_ - 1, current_.size());
+                for (SpikeEvent* spike : current_) deliver(spike);
+                end_bucket(base_ - 1);
+                current_.clear();
+            }
+        }
+        if (size_ == 0 && base_ <= now) base_ = now + 1;
+        return count;
+    }
+
+    /** 释放所有未投递的脉冲 */
+    void clear() {
+        for (auto& bucket : buckets_) {
+            for (SpikeEvent* spike : bucket) delete spike;
+            bucket.clear();
+        }
+        for (auto& entry : overflow_) {
+            for (SpikeEvent* spike : entry.second) delete spike;
+        }
+        overflow_.clear();
+        size_ = 0;
+        ring_count_ = 0;
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t peakSize() const { return peak_size_; }
+    uint32_t horizon() const { return static_cast<uint32_t>(buckets_.size()); }
+
+private:
+    void promoteOverflow() {
+        while (!overflow_.empty() && overflow_.begin()->first - base_ < buckets_.size()) {
+            auto entry = overflow_.begin();
+            auto& bucket = buckets_[entry->first % buckets_.size()];
+            bucket.insert(bucket.end(), entry->second.begin(), entry->second.end());
+            ring_count_ += entry->second.size();
+            overflow_.erase(entry);
+        }
+    }
+
+    std::vector<std::vector<SpikeEvent*>> buckets_;          ///< 环形桶，下标为 周期 % horizon
+    std::map<uint64_t, std::vector<SpikeEvent*>> overflow_;  ///< 超出窗口的脉冲
+    std::vector<SpikeEvent*> current_;                       ///< 正在投递的桶（与环交换以复用容量）
+    uint64_t base_ = 0;                                       ///< 下一个待取出的周期
+    size_t size_ = 0;
+    size_t ring_count_ = 0;
+    size_t peak_size_ = 0;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _SPIKECALENDAR_H */
@@ -11,6 +11,13 @@
 #include <sst/core/event.h>
 #include <sst/core/serialization/serialize.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "EventPool.h"
+
 namespace SST {
 namespace SnnDL {
 
@@ -59,6 +66,9 @@ public:
         SST::Event(), neuron_id(id), timestamp(ts),
         dest_neuron(dest_n), dest_node(dest_node_id), weight(w) {}
 
+    /** 脉冲路径高频分配，使用定长对象池 */
+    SNNDL_POOLED_EVENT(SpikeEvent)
+
     // === 访问器方法 ===
     
     uint32_t getNeuronId() const { return neuron_id; }
@@ -87,23 +97,195 @@ public:
     void incrementHopCount() { hop_count++; }
     bool isExpired() const { return hop_count >= MAX_HOPS; }
 
+    // === 多目标（聚合扇出）支持 ===
+
+    /**
+     * @brief 追加一个突触后目标
+     *
+     * 携带目标列表的事件由发送端按CSR连接表聚合生成：同一目标核心的
+     * 全部突触合并为一个事件，接收端按列表逐一施加，此时 dest_neuron
+     * 仅用于路由（等于第一个目标），weight 字段不再使用。
+     *
+     * @param post 突触后神经元全局ID
+     * @param w 突触权重
+     * @param delay 突触延迟（周期）；全部为0时不携带延迟列表
+     */
+    void addTarget(uint32_t post, float w, uint8_t delay = 0) {
+        if (delay != 0 && target_delays.empty()) target_delays.assign(target_neurons.size(), 0);
+        target_neurons.push_back(post);
+        target_weights.push_back(w);
+        if (!target_delays.empty()) target_delays.push_back(delay);
+    }
+
+    bool hasTargets() const { return !target_neurons.empty(); }
+    size_t getTargetCount() const { return target_neurons.size(); }
+    uint32_t getTargetNeuron(size_t i) const { return target_neurons[i]; }
+    float getTargetWeight(size_t i) const { return target_weights[i]; }
+    uint8_t getTargetDelay(size_t i) const { return target_delays.empty() ? 0 : target_delays[i]; }
+    bool hasTargetDelays() const { return !target_delays.empty(); }
+    const std::vector<uint32_t>& getTargetNeurons() const { return target_neurons; }
+    const std::vector<float>& getTargetWeights() const { return target_weights; }
+
+    // === 紧凑线上格式 ===
+
+    /** 紧凑格式中神经元ID的位宽 */
+    static constexpr uint32_t COMPACT_NEURON_BITS = 24;
+    static constexpr uint32_t COMPACT_NEURON_MAX = (1u << COMPACT_NEURON_BITS) - 1;
+    /** 紧凑格式中目标节点ID与目标数的上限（16位） */
+    static constexpr uint32_t COMPACT_U16_MAX = 0xFFFF;
+    /** 权重定点格式 Q3.12：16位有符号，表示范围 [-8, 8) */
+    static constexpr int COMPACT_WEIGHT_FRAC_BITS = 12;
+    /** 紧凑格式头部字节数：源(3)+目标(3)+节点(2)+时间戳增量(4)+权重(2)+目标数(2) */
+    static constexpr size_t COMPACT_HEADER_BYTES = 16;
+    /** 紧凑格式每个目标的字节数：神经元(3)+权重(2) */
+    static constexpr size_t COMPACT_TARGET_BYTES = 5;
+
+    /**
+     * @brief 请求以紧凑格式序列化
+     *
+     * 仅当全部字段可无损装入紧凑格式（神经元ID<2^24、节点ID与目标数<2^16、
+     * 权重落在定点表示范围内）时生效，否则保持完整格式。
+     * 权重按 Q3.12 定点量化，时间戳仅传输相对 2^32 周期纪元的增量，
+     * 接收端（SnnNIC、MultiCorePERouterInterface、SnnNetworkAdapter）解包时
+     * 以 resolveTimestamp() 按本地周期还原高位。
+     *
+     * @param enable 是否启用
+     * @return 实际是否采用紧凑格式
+     */
+    bool setCompactWire(bool enable) {
+        compact_wire = enable && fitsCompact();
+        return compact_wire;
+    }
+    bool isCompactWire() const { return compact_wire; }
+
+    /**
+     * @brief 当前格式下的线上字节数（用于 size_in_bits）
+     */
+    size_t wireBytes() const {
+        size_t n = target_neurons.size();
+        if (compact_wire) return 1 + COMPACT_HEADER_BYTES + n * COMPACT_TARGET_BYTES;
+        // 格式标志(1)+源(4)+时间戳(8)+目标(4)+节点(4)+权重(8)+三个向量长度(24)+每目标(8，带延迟时9)
+        return 1 + 28 + 3 * sizeof(uint64_t) + n * (sizeof(uint32_t) + sizeof(float)) + target_delays.size();
+    }
+
+    /**
+     * @brief 以参考周期补全紧凑格式截断的时间戳高位
+     *
+     * 取不晚于 reference 且低32位与增量相同的最近周期；完整格式或
+     * 未截断的事件不受影响。
+     *
+     * @param reference 接收端当前周期
+     */
+    void resolveTimestamp(uint64_t reference) {
+        if (!timestamp_truncated) return;
+        uint32_t back = static_cast<uint32_t>(reference) - static_cast<uint32_t>(timestamp);
+        timestamp = (reference >= back) ? reference - back : static_cast<uint32_t>(timestamp);
+        timestamp_truncated = false;
+    }
+
+    static int16_t encodeWeight(double w) {
+        double scaled = std::nearbyint(w * (1 << COMPACT_WEIGHT_FRAC_BITS));
+        if (scaled > INT16_MAX) scaled = INT16_MAX;
+        if (scaled < INT16_MIN) scaled = INT16_MIN;
+        return static_cast<int16_t>(scaled);
+    }
+    static float decodeWeight(int16_t q) {
+        return static_cast<float>(q) / static_cast<float>(1 << COMPACT_WEIGHT_FRAC_BITS);
+    }
+
     /**
      * @brief 序列化函数，支持并行仿真中的事件传递
      * @param ser 序列化器对象
      */
     void serialize_order(SST::Core::Serialization::serializer &ser) override {
         Event::serialize_order(ser);  // 先序列化基类
+        SST_SER(compact_wire);
+        if (compact_wire) {
+            std::vector<uint8_t> packed;
+            if (ser.mode() != SST::Core::Serialization::serializer::UNPACK) packCompact(packed);
+            SST_SER(packed);
+            if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) unpackCompact(packed);
+            return;
+        }
         SST_SER(neuron_id);
         SST_SER(timestamp);
         SST_SER(dest_neuron); 
         SST_SER(dest_node);
         SST_SER(weight);
+        SST_SER(target_neurons);
+        SST_SER(target_weights);
+        SST_SER(target_delays);
     }
 
 private:
     uint32_t dest_neuron;      ///< 目标神经元ID
     uint32_t dest_node;        ///< 目标节点ID
     double weight;             ///< 突触权重
+    std::vector<uint32_t> target_neurons;  ///< 聚合扇出的突触后神经元全局ID（为空表示单目标事件）
+    std::vector<float> target_weights;     ///< 与 target_neurons 一一对应的突触权重
+    std::vector<uint8_t> target_delays;    ///< 与 target_neurons 一一对应的突触延迟（为空表示全为0）
+    bool compact_wire = false;             ///< 是否以紧凑格式序列化
+    bool timestamp_truncated = false;      ///< 时间戳是否仅含紧凑格式传输的低32位
+
+    static bool weightFits(double w) {
+        double limit = static_cast<double>(1 << (15 - COMPACT_WEIGHT_FRAC_BITS));
+        return std::isfinite(w) && w >= -limit && w < limit;
+    }
+
+    bool fitsCompact() const {
+        if (neuron_id > COMPACT_NEURON_MAX || dest_neuron > COMPACT_NEURON_MAX) return false;
+        if (dest_node > COMPACT_U16_MAX || target_neurons.size() > COMPACT_U16_MAX) return false;
+        if (!target_delays.empty()) return false;   // 紧凑格式不携带延迟
+        if (!weightFits(weight)) return false;
+        for (size_t i = 0; i < target_neurons.size(); i++) {
+            if (target_neurons[i] > COMPACT_NEURON_MAX || !weightFits(target_weights[i])) return false;
+        }
+        return true;
+    }
+
+    static void putBytes(std::vector<uint8_t>& out, uint64_t v, int bytes) {
+        for (int b = 0; b < bytes; b++) out.push_back(static_cast<uint8_t>(v >> (8 * b)));
+    }
+    static uint64_t getBytes(const uint8_t* in, int bytes) {
+        uint64_t v = 0;
+        for (int b = 0; b < bytes; b++) v |= static_cast<uint64_t>(in[b]) << (8 * b);
+        return v;
+    }
+
+    /** 按小端序打包紧凑格式 */
+    void packCompact(std::vector<uint8_t>& out) const {
+        out.reserve(COMPACT_HEADER_BYTES + target_neurons.size() * COMPACT_TARGET_BYTES);
+        putBytes(out, neuron_id, 3);
+        putBytes(out, dest_neuron, 3);
+        putBytes(out, dest_node, 2);
+        putBytes(out, static_cast<uint32_t>(timestamp), 4);
+        putBytes(out, static_cast<uint16_t>(encodeWeight(weight)), 2);
+        putBytes(out, target_neurons.size(), 2);
+        for (size_t i = 0; i < target_neurons.size(); i++) {
+            putBytes(out, target_neurons[i], 3);
+            putBytes(out, static_cast<uint16_t>(encodeWeight(target_weights[i])), 2);
+        }
+    }
+
+    void unpackCompact(const std::vector<uint8_t>& in) {
+        if (in.size() < COMPACT_HEADER_BYTES) return;
+        const uint8_t* p = in.data();
+        neuron_id = static_cast<uint32_t>(getBytes(p, 3));
+        dest_neuron = static_cast<uint32_t>(getBytes(p + 3, 3));
+        dest_node = static_cast<uint32_t>(getBytes(p + 6, 2));
+        timestamp = getBytes(p + 8, 4);
+        timestamp_truncated = true;
+        weight = decodeWeight(static_cast<int16_t>(getBytes(p + 12, 2)));
+        size_t n = static_cast<size_t>(getBytes(p + 14, 2));
+        n = std::min(n, (in.size() - COMPACT_HEADER_BYTES) / COMPACT_TARGET_BYTES);
+        target_neurons.resize(n);
+        target_weights.resize(n);
+        p += COMPACT_HEADER_BYTES;
+        for (size_t i = 0; i < n; i++, p += COMPACT_TARGET_BYTES) {
+            target_neurons[i] = static_cast<uint32_t>(getBytes(p, 3));
+            target_weights[i] = decodeWeight(static_cast<int16_t>(getBytes(p + 3, 2)));
+        }
+    }
     
     // 注册序列化支持
     ImplementSerializable(SST::SnnDL::SpikeEvent)
@@ -23,14 +23,8 @@ SpikeEventWrapper::~SpikeEventWrapper()
 SST::Event* SpikeEventWrapper::clone() 
 {
     if (spike_data) {
-        // 创建SpikeEvent的副本
-        SpikeEvent* cloned_spike = new SpikeEvent(
-            spike_data->getNeuronId(),
-            spike_data->getDestinationNeuron(),
-            spike_data->getDestinationNode(),
-            spike_data->getWeight(),
-            spike_data->getTimestamp()
-        );
+        // 创建SpikeEvent的副本（包括聚合扇出的目标列表）
+        SpikeEvent* cloned_spike = new SpikeEvent(*spike_data);
         return new SpikeEventWrapper(cloned_spike);
     }
     return new SpikeEventWrapper();
@@ -38,7 +32,8 @@ SST::Event* SpikeEventWrapper::clone()
 
 size_t SpikeEventWrapper::size() const 
 {
-    return sizeof(SpikeEventWrapper) + (spike_data ? sizeof(SpikeEvent) : 0);
+    if (!spike_data) return sizeof(SpikeEventWrapper);
+    return sizeof(SpikeEventWrapper) + spike_data->wireBytes();
 }
 
 void SpikeEventWrapper::serialize_order(SST::Core::Serialization::serializer& ser) 
@@ -50,33 +45,11 @@ void SpikeEventWrapper::serialize_order(SST::Core::Serialization::serializer& se
     ser & has_spike;
     
     if (has_spike) {
-        if (ser.mode() == SST::Core::Serialization::serializer::PACK) {
-            // 打包模式：序列化SpikeEvent的数据
-            uint32_t neuron_id = spike_data->getNeuronId();
-            uint32_t dest_neuron = spike_data->getDestinationNeuron();
-            uint32_t dest_node = spike_data->getDestinationNode();
-            double weight = spike_data->getWeight();
-            SST::SimTime_t timestamp = spike_data->getTimestamp();
-            
-            ser & neuron_id;
-            ser & dest_neuron;
-            ser & dest_node;
-            ser & weight;
-            ser & timestamp;
-        } else {
-            // 解包模式：反序列化并创建SpikeEvent
-            uint32_t neuron_id, dest_neuron, dest_node;
-            double weight;
-            SST::SimTime_t timestamp;
-            
-            ser & neuron_id;
-            ser & dest_neuron;
-            ser & dest_node;
-            ser & weight;
-            ser & timestamp;
-            
-            spike_data = new SpikeEvent(neuron_id, dest_neuron, dest_node, weight, timestamp);
+        // 交由SpikeEvent自身序列化，沿用其线上格式（完整或紧凑）
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            spike_data = new SpikeEvent();
         }
+        spike_data->serialize_order(ser);
     } else if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
         spike_data = nullptr;
     }
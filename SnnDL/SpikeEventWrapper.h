@@ -32,6 +32,9 @@ public:
      */
     virtual ~SpikeEventWrapper();
     
+    /** 每个链路跳各分配一次，使用定长对象池 */
+    SNNDL_POOLED_EVENT(SpikeEventWrapper)
+    
     /**
      * @brief 获取包装的SpikeEvent
      * @return SpikeEvent指针
@@ -0,0 +1,179 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SpikeRecorder.cc: 发放栅格与链路流量的列式二进制记录器实现文件
+//
+
+#include "SpikeRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace SST::SnnDL;
+
+namespace {
+constexpr uint32_t RECORD_VERSION = 1;
+
+template <typename T>
+void put(std::vector<uint8_t>& out, T value) {
+    size_t pos = out.size();
+    out.resize(pos + sizeof(T));
+    std::memcpy(out.data() + pos, &value, sizeof(T));
+}
+
+/** 块头：标签 | 记录数 | 载荷字节数（载荷写完后回填） */
+size_t beginChunk(std::vector<uint8_t>& out, const char tag[4], uint32_t count) {
+    out.insert(out.end(), tag, tag + 4);
+    put<uint32_t>(out, count);
+    size_t size_pos = out.size();
+    put<uint64_t>(out, 0);
+    return size_pos;
+}
+
+void endChunk(std::vector<uint8_t>& out, size_t size_pos) {
+    uint64_t payload = out.size() - size_pos - sizeof(uint64_t);
+    std::memcpy(out.data() + size_pos, &payload, sizeof(payload));
+}
+}
+
+SpikeRecorder::SpikeRecorder(uint32_t node_id, size_t block_spikes, uint64_t traffic_interval)
+    : node_id_(node_id),
+      block_spikes_(std::max<size_t>(1, block_spikes)),
+      traffic_interval_(traffic_interval),
+      next_traffic_cycle_(traffic_interval) {
+    raster_.reserve(block_spikes_);
+}
+
+SpikeRecorder::~SpikeRecorder() {
+    std::string error;
+    if (file_) close(0, error);
+}
+
+bool SpikeRecorder::open(const std::string& path, std::string& error) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        error = "无法创建记录文件 " + path;
+        return false;
+    }
+    std::vector<uint8_t> header;
+    header.insert(header.end(), "SNNDLREC", "SNNDLREC" + 8);
+    put<uint32_t>(header, RECORD_VERSION);
+    put<uint32_t>(header, node_id_);
+    put<uint64_t>(header, traffic_interval_);
+    if (std::fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+        error = "写入记录文件头失败 " + path;
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    bytes_written_.store(header.size(), std::memory_order_relaxed);
+    writer_ = std::thread(&SpikeRecorder::writerLoop, this);
+    return true;
+}
+
+void SpikeRecorder::sealRaster() {
+    if (raster_.empty()) return;
+    // 多核心在同一周期交错发放，块内排序后周期差分非负
+    std::sort(raster_.begin(), raster_.end());
+    const uint32_t n = static_cast<uint32_t>(raster_.size());
+    const uint64_t base = raster_.front().first;
+    uint64_t max_delta = 0;
+    for (uint32_t i = 1; i < n; i++) {
+        max_delta = std::max(max_delta, raster_[i].first - raster_[i - 1].first);
+    }
+    uint8_t width = max_delta <= UINT8_MAX ? 1 : (max_delta <= UINT16_MAX ? 2 : (max_delta <= UINT32_MAX ? 4 : 8));
+
+    std::vector<uint8_t> chunk;
+    chunk.reserve(32 + static_cast<size_t>(n) * (width + sizeof(uint32_t)));
+    size_t size_pos = beginChunk(chunk, "RAST", n);
+    put<uint64_t>(chunk, base);
+    put<uint8_t>(chunk, width);
+    uint64_t prev = base;
+    for (const auto& e : raster_) {
+        uint64_t delta = e.first - prev;
+        prev = e.first;
+        size_t pos = chunk.size();
+        chunk.resize(pos + width);
+        std::memcpy(chunk.data() + pos, &delta, width);   // 小端取低位字节
+    }
+    for (const auto& e : raster_) put<uint32_t>(chunk, e.second);
+    endChunk(chunk, size_pos);
+
+    raster_.clear();
+    raster_blocks_++;
+    submit(std::move(chunk));
+}
+
+void SpikeRecorder::flushTraffic(uint64_t cycle) {
+    if (traffic_.empty()) return;
+    std::vector<std::pair<TrafficKey, TrafficCount>> rows(traffic_.begin(), traffic_.end());
+    traffic_.clear();
+    // 固定输出顺序，便于比较不同运行
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        const TrafficKey& x = a.first;
+        const TrafficKey& y = b.first;
+        if (x.kind != y.kind) return x.kind < y.kind;
+        if (x.src != y.src) return x.src < y.src;
+        if (x.dst != y.dst) return x.dst < y.dst;
+        if (x.link != y.link) return x.link < y.link;
+        return x.vn < y.vn;
+    });
+
+    std::vector<uint8_t> chunk;
+    size_t size_pos = beginChunk(chunk, "TRAF", static_cast<uint32_t>(rows.size()));
+    put<uint64_t>(chunk, cycle);
+    for (const auto& r : rows) put<uint8_t>(chunk, static_cast<uint8_t>(r.first.kind));
+    for (const auto& r : rows) put<uint8_t>(chunk, r.first.link);
+    for (const auto& r : rows) put<uint16_t>(chunk, r.first.vn);
+    for (const auto& r : rows) put<uint32_t>(chunk, r.first.src);
+    for (const auto& r : rows) put<uint32_t>(chunk, r.first.dst);
+    for (const auto& r : rows) put<uint64_t>(chunk, r.second.spikes);
+    for (const auto& r : rows) put<uint64_t>(chunk, r.second.bits);
+    endChunk(chunk, size_pos);
+
+    traffic_chunks_++;
+    submit(std::move(chunk));
+}
+
+void SpikeRecorder::submit(std::vector<uint8_t>&& chunk) {
+    if (!file_) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(chunk));
+    }
+    cv_.notify_one();
+}
+
+void SpikeRecorder::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) return;   // stop_ 且已排空
+        std::vector<uint8_t> chunk = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        if (std::fwrite(chunk.data(), 1, chunk.size(), file_) != chunk.size()) {
+            write_failed_.store(true, std::memory_order_relaxed);
+        }
+        bytes_written_.fetch_add(chunk.size(), std::memory_order_relaxed);
+        lock.lock();
+    }
+}
+
+bool SpikeRecorder::close(uint64_t cycle, std::string& error) {
+    if (!file_) return true;
+    sealRaster();
+    flushTraffic(cycle);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_one();
+    if (writer_.joinable()) writer_.join();
+    bool ok = !write_failed_.load(std::memory_order_relaxed);
+    if (std::fclose(file_) != 0) ok = false;
+    file_ = nullptr;
+    if (!ok) error = "写入记录文件失败";
+    return ok;
+}
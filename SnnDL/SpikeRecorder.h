@@ -0,0 +1,148 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SpikeRecorder.h: 发放栅格与链路流量的列式二进制记录器头文件
+//
+
+#ifndef _SPIKERECORDER_H
+#define _SPIKERECORDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 节点级发放栅格与流量记录器
+ *
+ * 核心发放时调用 recordFire，网络接口与核间互连收发时调用 recordTraffic。记录先在内存中攒成块，
+ * 满块后编码为列式字节串交给后台写线程，仿真线程不做文件I/O。
+ *
+ * 文件格式（小端）：
+ *   文件头 : "SNNDLREC"(8B) | u32 版本=1 | u32 节点ID | u64 流量快照间隔（周期，0=仅finish时）
+ *   数据块 : char[4] 标签 | u32 记录数n | u64 载荷字节数 | 载荷
+ *   "RAST" : u64 起始周期 | u8 差分字节宽w | 周期差分[n]（各w字节，首项为0） | u32 全局神经元ID[n]
+ *            块内按 (周期, 神经元) 排序，周期 = 起始周期 + 差分前缀和
+ *   "TRAF" : u64 快照周期 | u8 类型[n] | u8 链路[n] | u16 VC[n] | u32 源[n] | u32 目的[n]
+ *            | u64 脉冲数[n] | u64 比特数[n]，各值为上一快照以来的增量
+ * 每列连续存放、定宽，读取端可直接按数组解释，无需逐条解析。
+ */
+class SpikeRecorder {
+public:
+    /** 流量记录类型：src/dst 对 NET_* 为节点ID，对 INTER_CORE 为核心ID */
+    enum class TrafficKind : uint8_t {
+        NET_TX = 0,
+        NET_RX = 1,
+        INTER_CORE = 2
+    };
+    static constexpr uint8_t NETWORK_PORT = 0xFF;       ///< 不区分方向端口的网络接口
+    static constexpr uint32_t UNKNOWN_NODE = 0xFFFFFFFF;
+
+    SpikeRecorder(uint32_t node_id, size_t block_spikes, uint64_t traffic_interval);
+    ~SpikeRecorder();
+
+    SpikeRecorder(const SpikeRecorder&) = delete;
+    SpikeRecorder& operator=(const SpikeRecorder&) = delete;
+
+    /** 创建文件、写入文件头并启动写线程 */
+    bool open(const std::string& path, std::string& error);
+
+    void recordFire(uint64_t cycle, uint32_t neuron) {
+        raster_.emplace_back(cycle, neuron);
+        fires_++;
+        if (raster_.size() >= block_spikes_) sealRaster();
+    }
+
+    void recordTraffic(TrafficKind kind, uint8_t link, uint16_t vn, uint32_t src, uint32_t dst,
+                       uint64_t spikes, uint64_t bits) {
+        TrafficCount& c = traffic_[TrafficKey{kind, link, vn, src, dst}];
+        c.spikes += spikes;
+        c.bits += bits;
+    }
+
+    /** 由所属组件逐周期调用，按间隔输出流量快照 */
+    void tick(uint64_t cycle) {
+        if (traffic_interval_ > 0 && cycle >= next_traffic_cycle_) {
+            flushTraffic(cycle);
+            next_traffic_cycle_ = cycle + traffic_interval_;
+        }
+    }
+
+    /**
+     * @brief 写出未满的栅格块与最后一次流量快照，等待写线程落盘后关闭文件
+     * @return 全部数据成功写出时返回true
+     */
+    bool close(uint64_t cycle, std::string& error);
+
+    uint64_t fires() const { return fires_; }
+    uint64_t rasterBlocks() const { return raster_blocks_; }
+    uint64_t trafficChunks() const { return traffic_chunks_; }
+    uint64_t bytesWritten() const { return bytes_written_.load(std::memory_order_relaxed); }
+
+private:
+    struct TrafficKey {
+        TrafficKind kind;
+        uint8_t link;
+        uint16_t vn;
+        uint32_t src;
+        uint32_t dst;
+        bool operator==(const TrafficKey& o) const {
+            return kind == o.kind && link == o.link && vn == o.vn && src == o.src && dst == o.dst;
+        }
+    };
+    struct TrafficKeyHash {
+        size_t operator()(const TrafficKey& k) const {
+            uint64_t h = (static_cast<uint64_t>(k.src) << 32) ^ k.dst;
+            h ^= (static_cast<uint64_t>(k.kind) << 56) ^ (static_cast<uint64_t>(k.link) << 48) ^
+                 (static_cast<uint64_t>(k.vn) << 32);
+            return std::hash<uint64_t>()(h * 0x9E3779B97F4A7C15ull);
+        }
+    };
+    struct TrafficCount {
+        uint64_t spikes = 0;
+        uint64_t bits = 0;
+    };
+
+    void sealRaster();
+    void flushTraffic(uint64_t cycle);
+    void submit(std::vector<uint8_t>&& chunk);
+    void writerLoop();
+
+    uint32_t node_id_;
+    size_t block_spikes_;
+    uint64_t traffic_interval_;
+    uint64_t next_traffic_cycle_;
+
+    std::vector<std::pair<uint64_t, uint32_t>> raster_;   ///< 当前块的 (周期, 神经元)
+    std::unordered_map<TrafficKey, TrafficCount, TrafficKeyHash> traffic_;
+    uint64_t fires_ = 0;
+    uint64_t raster_blocks_ = 0;
+    uint64_t traffic_chunks_ = 0;
+
+    // 写线程
+    FILE* file_ = nullptr;
+    std::thread writer_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::vector<uint8_t>> queue_;
+    bool stop_ = false;
+    std::atomic<bool> write_failed_{false};
+    std::atomic<uint64_t> bytes_written_{0};
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _SPIKERECORDER_H */
@@ -7,6 +7,8 @@
 
 #include <sst/core/sst_config.h>
 #include "SpikeSource.h"
+#include "SpikeBundle.h"
+#include "SnnTrace.h"
 
 #include <fstream>
 #include <sstream>
@@ -27,6 +29,24 @@ SpikeSource::SpikeSource(ComponentId_t id, Params& params) : Component(id) {
     
     // 读取配置参数
     dataset_path = params.find<std::string>("dataset_path", "");
+    std::string sample_list = params.find<std::string>("sample_list", "");
+    if (!sample_list.empty()) {
+        std::ifstream list(sample_list);
+        if (!list.is_open()) {
+            output->fatal(CALL_INFO, -1, "错误: 无法打开样本列表 %s\n", sample_list.c_str());
+        }
+        std::string line;
+        while (std::getline(list, line)) {
+            size_t begin = line.find_first_not_of(" \t\r");
+            if (begin == std::string::npos || line[begin] == '#') continue;
+            size_t end = line.find_last_not_of(" \t\r");
+            sample_files.push_back(line.substr(begin, end - begin + 1));
+        }
+        if (sample_files.empty()) {
+            output->fatal(CALL_INFO, -1, "错误: 样本列表 %s 为空\n", sample_list.c_str());
+        }
+        dataset_path = sample_files[0];
+    }
     if (dataset_path.empty()) {
         output->fatal(CALL_INFO, -1, "错误: dataset_path参数是必需的\n");
     }
@@ -36,6 +56,20 @@ SpikeSource::SpikeSource(ComponentId_t id, Params& params) : Component(id) {
     neuron_offset = params.find<uint32_t>("neuron_offset", 0);
     max_events = params.find<uint32_t>("max_events", 0);
     neurons_per_core = params.find<uint32_t>("neurons_per_core", 4);  // 添加neurons_per_core参数
+    uint32_t cores_per_node = params.find<uint32_t>("cores_per_node", 4);
+    neurons_per_node = std::max<uint32_t>(1, neurons_per_core * cores_per_node);
+    uint32_t num_destinations = params.find<uint32_t>("num_destinations", 0);
+    destination_base = params.find<uint32_t>("destination_base", 0);
+    enable_clock_suspend = params.find<bool>("enable_clock_suspend", false);
+    
+    // 流式读取配置（二进制格式）
+    stream_options.chunk_events = params.find<uint32_t>("stream_chunk_events", 65536);
+    stream_options.prefetch_thread = params.find<int>("stream_prefetch_thread", 1) != 0;
+    stream_options.max_events = max_events;
+    stream_options.neuron_offset = neuron_offset;
+    stream_options.time_scale = time_scale;
+    stream_options.sensor_width = params.find<uint32_t>("sensor_width", 34);
+    stream_options.sensor_height = params.find<uint32_t>("sensor_height", 34);
     
     // output->verbose(CALL_INFO, 2, 0,
     //     "数据集参数: path=%s, format=%s, time_scale=%.3f, offset=%u, max_events=%u, neurons_per_core=%u\n",
@@ -43,16 +77,65 @@ SpikeSource::SpikeSource(ComponentId_t id, Params& params) : Component(id) {
     
     // 配置输出链接
     spike_output_link = configureLink("spike_output");
-    if (!spike_output_link) {
+    
+    // 按目标节点的专用端口：一个数据源解析一次数据集，按节点分发
+    uint32_t connected_destinations = 0;
+    destination_links.assign(num_destinations, nullptr);
+    destination_pending.resize(num_destinations);
+    for (uint32_t i = 0; i < num_destinations; i++) {
+        destination_links[i] = configureLink("spike_output_" + std::to_string(i));
+        if (destination_links[i]) connected_destinations++;
+    }
+    if (num_destinations > 0) {
+        output->verbose(CALL_INFO, 1, 0, "按目标节点分端口: 节点%u-%u, 已连接%u个端口\n",
+                       destination_base, destination_base + num_destinations - 1, connected_destinations);
+    }
+    
+    if (!spike_output_link && connected_destinations == 0) {
         output->verbose(CALL_INFO, 1, 0, "警告: 无法配置spike_output链接，将在运行时跳过事件发送\n");
     } else {
         // output->verbose(CALL_INFO, 2, 0, "配置了输出链接\n");
     }
     
-    // 注册时钟处理器（使用较高频率以确保精确的事件时序）
+    // 时间基准：数据时间戳以该时钟的周期为单位（默认1MHz，即微秒）
     std::string clock_freq = params.find<std::string>("clock", "1MHz");
-    registerClock(clock_freq, new Clock::Handler2<SpikeSource,&SpikeSource::clockTick>(this));
-    // output->verbose(CALL_INFO, 2, 0, "注册了时钟处理器，频率: %s\n", clock_freq.c_str());
+    skip_ahead = params.find<int>("skip_ahead", 1) != 0;
+    wakeup_link = nullptr;
+    time_base = nullptr;
+    if (skip_ahead) {
+        // 跳跃唤醒：不注册时钟，经自链接在下一个事件的时间点唤醒
+        time_base = getTimeConverter(clock_freq);
+        wakeup_link = configureSelfLink("wakeup", time_base,
+            new Event::Handler2<SpikeSource,&SpikeSource::handleWakeup>(this));
+    } else {
+        time_base = registerClock(clock_freq, new Clock::Handler2<SpikeSource,&SpikeSource::clockTick>(this));
+    }
+    
+    // 批量推理：样本周期与截断窗口换算为时间基准周期数
+    sample_index = 0;
+    sample_period_ticks = 0;
+    sample_window_ticks = 0;
+    sample_base_time = 0;
+    stream_events_done = 0;
+    stream_chunks_done = 0;
+    stream_out_of_order_done = 0;
+    stream_truncated_done = 0;
+    if (!sample_files.empty()) {
+        std::string sample_period = params.find<std::string>("sample_period", "");
+        if (sample_period.empty()) {
+            output->fatal(CALL_INFO, -1, "错误: 设置sample_list时必须给出sample_period\n");
+        }
+        std::string sample_gap = params.find<std::string>("sample_gap", "0us");
+        sample_period_ticks = getTimeConverter(sample_period)->getFactor() / time_base->getFactor();
+        uint64_t gap_ticks = getTimeConverter(sample_gap)->getFactor() / time_base->getFactor();
+        if (sample_period_ticks == 0 || gap_ticks >= sample_period_ticks) {
+            output->fatal(CALL_INFO, -1, "错误: sample_period=%s 须大于0且大于sample_gap=%s\n",
+                          sample_period.c_str(), sample_gap.c_str());
+        }
+        sample_window_ticks = sample_period_ticks - gap_ticks;
+        output->verbose(CALL_INFO, 1, 0, "批量推理: %zu个样本, 周期%" PRIu64 ", 输入窗口%" PRIu64 "\n",
+                       sample_files.size(), sample_period_ticks, sample_window_ticks);
+    }
     
     // 初始化状态变量
     current_sim_time = 0;
@@ -62,10 +145,21 @@ SpikeSource::SpikeSource(ComponentId_t id, Params& params) : Component(id) {
     // 初始化统计计数器
     events_loaded_count = 0;
     events_sent_count = 0;
+    batches_sent_count = 0;
+    events_dropped_count = 0;
+    wakeups_count = 0;
+    events_clipped_count = 0;
     
     // 注册统计对象
     stat_events_loaded = registerStatistic<uint64_t>("events_loaded");
     stat_events_sent = registerStatistic<uint64_t>("events_sent");
+    stat_batches_sent = registerStatistic<uint64_t>("batches_sent");
+    stat_events_dropped = registerStatistic<uint64_t>("events_dropped");
+    stat_wakeups = registerStatistic<uint64_t>("wakeups");
+    stat_stream_chunks = registerStatistic<uint64_t>("stream_chunks");
+    stat_events_out_of_order = registerStatistic<uint64_t>("events_out_of_order");
+    stat_samples_sent = registerStatistic<uint64_t>("samples_sent");
+    stat_events_clipped = registerStatistic<uint64_t>("events_clipped");
     
     // output->verbose(CALL_INFO, 1, 0, "SpikeSource组件构造完成\n");
 }
@@ -88,7 +182,8 @@ void SpikeSource::setup() {
     // 加载数据集
     if (loadDataset()) {
         data_loaded = true;
-        // output->verbose(CALL_INFO, 1, 0, "数据集加载成功，共%zu个事件\n", spike_queue.size());
+        if (skip_ahead) scheduleNextWakeup();
+        // output->verbose(CALL_INFO, 1, 0, "数据集加载成功，常驻%zu个事件\n", spike_stream.resident());
     } else {
         output->fatal(CALL_INFO, -1, "数据集加载失败\n");
     }
@@ -97,78 +192,186 @@ void SpikeSource::setup() {
 void SpikeSource::finish() {
     output->verbose(CALL_INFO, 1, 0, "进入finish阶段\n");
     
+    // 流式读取时加载数随发送增长，以流实际读入的事件数为准
+    events_loaded_count = stream_events_done + spike_stream.eventsRead();
+    uint64_t chunks_read = stream_chunks_done + spike_stream.chunksRead();
+    uint64_t out_of_order = stream_out_of_order_done + spike_stream.outOfOrder();
+    uint64_t truncated_bytes = stream_truncated_done + spike_stream.truncatedBytes();
+    
     // 输出最终统计信息
     output->output("=== SpikeSource最终统计 ===\n");
     output->output("加载事件数: %" PRIu64 "\n", events_loaded_count);
     output->output("发送事件数: %" PRIu64 "\n", events_sent_count);
+    if (!destination_links.empty()) {
+        output->output("批量事件数: %" PRIu64 "\n", batches_sent_count);
+    }
+    if (events_dropped_count > 0) {
+        output->output("丢弃事件数: %" PRIu64 "\n", events_dropped_count);
+    }
+    if (!sample_files.empty()) {
+        output->output("样本数: %zu/%zu, 截断事件数: %" PRIu64 "\n",
+                       sample_index + 1, sample_files.size(), events_clipped_count);
+    }
+    output->verbose(CALL_INFO, 1, 0, "%s次数: %" PRIu64 "\n", skip_ahead ? "跳跃唤醒" : "时钟处理", wakeups_count);
+    output->verbose(CALL_INFO, 1, 0, "流式读取: %" PRIu64 "块, 逆序事件%" PRIu64 ", 截断字节%" PRIu64 "\n",
+                   chunks_read, out_of_order, truncated_bytes);
     
     // 更新统计对象
     stat_events_loaded->addData(events_loaded_count);
     stat_events_sent->addData(events_sent_count);
+    stat_batches_sent->addData(batches_sent_count);
+    stat_events_dropped->addData(events_dropped_count);
+    stat_wakeups->addData(wakeups_count);
+    stat_stream_chunks->addData(chunks_read);
+    stat_events_out_of_order->addData(out_of_order);
+    if (!sample_files.empty()) {
+        stat_samples_sent->addData(sample_index + 1);
+        stat_events_clipped->addData(events_clipped_count);
+    }
 }
 
 // ===== 时钟处理器 =====
 bool SpikeSource::clockTick(Cycle_t current_cycle) {
     if (!data_loaded || finished_sending) {
-        return false;
+        // 没有后续事件需要注入，可直接注销时钟
+        return enable_clock_suspend && finished_sending;
     }
     
-    // 更新当前仿真时间（1MHz时钟，每个周期1微秒）
-    // 数据文件中的时间戳是微秒，所以我们需要将周期数转换为微秒
-    // 1MHz时钟意味着每个周期 = 1微秒
+    // 时钟周期即数据时间单位（默认1MHz时钟，每个周期1微秒）
     current_sim_time = current_cycle;
+    wakeups_count++;
+    dispatchDueEvents();
     
-    // 调试输出：检查时间匹配问题
-    if (current_cycle <= 20) {  // 只在前20个周期输出调试信息
-        printf("DEBUG: SpikeSource 周期: %lu, 当前时间: %lu, 队列大小: %zu", 
-               current_cycle, current_sim_time, spike_queue.size());
-        if (!spike_queue.empty()) {
-            printf(", 下一个事件时间: %lu", spike_queue.top().timestamp);
-        }
-        printf("\n");
-        fflush(stdout);
+    // 检查是否完成发送
+    if (finished_sending && enable_clock_suspend) {
+        return true;  // 数据源不会再被唤醒，注销时钟
     }
-    
+    return false;  // 继续仿真
+}
+
+void SpikeSource::handleWakeup(SST::Event* ev) {
+    delete ev;
+    current_sim_time = getCurrentSimTime(time_base);
+    wakeups_count++;
+    dispatchDueEvents();
+    scheduleNextWakeup();
+}
+
+void SpikeSource::scheduleNextWakeup() {
+    const SpikeData* next = nextEvent();
+    if (!next || !wakeup_link) return;
+    // 下一个事件之前没有任何工作，直接跳到其时间点
+    uint64_t due = sample_base_time + next->timestamp;
+    SimTime_t delay = due > current_sim_time ? due - current_sim_time : 0;
+    wakeup_link->send(delay, nullptr);
+}
+
+void SpikeSource::dispatchDueEvents() {
     // 发送所有到期的脉冲事件
-    while (!spike_queue.empty() && spike_queue.top().timestamp <= current_sim_time) {
-        const SpikeData& spike_data = spike_queue.top();
+    const SpikeData* next_event;
+    while ((next_event = nextEvent()) != nullptr && sample_base_time + next_event->timestamp <= current_sim_time) {
+        SpikeData spike_data = *next_event;
+        spike_stream.pop();
+        spike_data.timestamp += sample_base_time;
         
-        // 创建并发送脉冲事件 - 自动计算目标节点ID  
-        // ★ 修正：每个PE有16个神经元，需要除以16而不是4
-        uint32_t neurons_per_pe = neurons_per_core * 4;  // 4 cores per PE × 4 neurons per core = 16 neurons per PE
-        uint32_t dest_node_id = spike_data.neuron_id / neurons_per_pe;
-        SpikeEvent* spike_event = new SpikeEvent(spike_data.neuron_id, spike_data.neuron_id, dest_node_id, 1.0, spike_data.timestamp);
+        uint32_t dest_node_id = spike_data.neuron_id / neurons_per_node;
         
-        // 检查链接是否有效
+        // 有专用端口的目标节点：暂存到本周期批次，循环结束后统一发送
+        int slot = destinationSlot(dest_node_id);
+        if (slot >= 0) {
+            if (destination_pending[slot].empty()) destinations_touched.push_back(slot);
+            destination_pending[slot].push_back(spike_data);
+            continue;
+        }
+        
+        // 逐事件经spike_output发送
         if (spike_output_link) {
-            // printf("DEBUG: 尝试发送脉冲事件 - 神经元: %u, 时间戳: %lu, Link指针: %p\n", 
-            //        spike_data.neuron_id, spike_data.timestamp, (void*)spike_output_link);
-            // fflush(stdout);
-            
+            SpikeEvent* spike_event = new SpikeEvent(spike_data.neuron_id, spike_data.neuron_id, dest_node_id, 1.0, spike_data.timestamp);
             spike_output_link->send(spike_event);
             events_sent_count++;
             
-            output->verbose(CALL_INFO, 4, 0, "发送脉冲: 神经元%u, 时间%" PRIu64 "\n",
+            SNNDL_TRACE(output, 4, 0, "发送脉冲: 神经元%u, 时间%" PRIu64 "\n",
                            spike_data.neuron_id, spike_data.timestamp);
         } else {
-            output->verbose(CALL_INFO, 2, 0, "警告: 脉冲输出链接为空，丢弃事件: 神经元%u, 时间%" PRIu64 "\n",
-                           spike_data.neuron_id, spike_data.timestamp);
-            delete spike_event;  // 清理事件内存
+            output->verbose(CALL_INFO, 2, 0, "警告: 目标节点%u无可用链接，丢弃事件: 神经元%u, 时间%" PRIu64 "\n",
+                           dest_node_id, spike_data.neuron_id, spike_data.timestamp);
+            events_dropped_count++;
         }
-        
-        spike_queue.pop();
     }
+    flushDestinationBatches();
     
     // 检查是否完成发送
-    if (spike_queue.empty()) {
+    if (!finished_sending && !nextEvent()) {
         finished_sending = true;
         output->verbose(CALL_INFO, 1, 0, "所有脉冲事件已发送完毕\n");
     }
-    
-    return false;  // 继续仿真
+}
+
+const SpikeData* SpikeSource::nextEvent() {
+    while (true) {
+        const SpikeData* next = spike_stream.peek();
+        if (next && (sample_window_ticks == 0 || next->timestamp < sample_window_ticks)) return next;
+        // 超出输入窗口：丢弃本样本其余事件，留出sample_gap供网络排空
+        while (next) {
+            spike_stream.pop();
+            events_clipped_count++;
+            next = spike_stream.peek();
+        }
+        if (sample_index + 1 >= sample_files.size()) return nullptr;
+        sample_index++;
+        sample_base_time += sample_period_ticks;
+        if (!loadSample(sample_index)) {
+            output->fatal(CALL_INFO, -1, "样本%zu加载失败: %s\n", sample_index, sample_files[sample_index].c_str());
+        }
+        SNNDL_TRACE(output, 2, 0, "切换到样本%zu: %s, 起始时间%" PRIu64 "\n",
+                    sample_index, dataset_path.c_str(), sample_base_time);
+    }
+}
+
+bool SpikeSource::loadSample(size_t index) {
+    // 流在每次打开时重新计数，先累计上一个样本的读取统计
+    stream_events_done += spike_stream.eventsRead();
+    stream_chunks_done += spike_stream.chunksRead();
+    stream_out_of_order_done += spike_stream.outOfOrder();
+    stream_truncated_done += spike_stream.truncatedBytes();
+    dataset_path = sample_files[index];
+    return loadDataset();
 }
 
 // ===== 私有辅助方法 =====
+int SpikeSource::destinationSlot(uint32_t dest_node) const {
+    if (dest_node < destination_base) return -1;
+    uint32_t slot = dest_node - destination_base;
+    if (slot >= destination_links.size() || !destination_links[slot]) return -1;
+    return static_cast<int>(slot);
+}
+
+void SpikeSource::flushDestinationBatches() {
+    for (uint32_t slot : destinations_touched) {
+        std::vector<SpikeData>& pending = destination_pending[slot];
+        uint32_t dest_node = destination_base + slot;
+        
+        // 单个事件直接发送SpikeEvent，多个事件打包为一个SpikeBundle
+        SST::Event* ev;
+        if (pending.size() == 1) {
+            ev = new SpikeEvent(pending[0].neuron_id, pending[0].neuron_id, dest_node, 1.0, pending[0].timestamp);
+        } else {
+            SpikeBundle* bundle = new SpikeBundle(dest_node);
+            for (const SpikeData& d : pending) {
+                bundle->addSpike(SpikeEvent(d.neuron_id, d.neuron_id, dest_node, 1.0, d.timestamp));
+            }
+            ev = bundle;
+        }
+        destination_links[slot]->send(ev);
+        
+        SNNDL_TRACE(output, 4, 0, "批量发送: 目标节点%u, %zu个脉冲\n", dest_node, pending.size());
+        events_sent_count += pending.size();
+        batches_sent_count++;
+        pending.clear();
+    }
+    destinations_touched.clear();
+}
+
 bool SpikeSource::loadDataset() {
     // output->verbose(CALL_INFO, 1, 0, "开始加载数据集: %s (格式: %s)\n", 
     //                dataset_path.c_str(), dataset_format.c_str());
@@ -177,6 +380,8 @@ bool SpikeSource::loadDataset() {
         return loadTextFormat(dataset_path);
     } else if (dataset_format == "NMNIST_AER") {
         return loadNMNISTFormat(dataset_path);
+    } else if (dataset_format == "BINARY") {
+        return loadBinaryFormat(dataset_path);
     } else if (dataset_format == "SHD_HDF5") {
         return loadSHDFormat(dataset_path);
     } else {
@@ -195,6 +400,7 @@ bool SpikeSource::loadTextFormat(const std::string& file_path) {
     std::string line;
     uint32_t line_count = 0;
     uint32_t events_count = 0;
+    std::vector<SpikeData> events;
     
     while (std::getline(file, line) && (max_events == 0 || events_count < max_events)) {
         line_count++;
@@ -227,7 +433,7 @@ bool SpikeSource::loadTextFormat(const std::string& file_path) {
             // 时间戳已经是微秒，直接使用
             uint64_t adjusted_timestamp = timestamp;
 
-            spike_queue.push(SpikeData(neuron_id, adjusted_timestamp));  // 保持原始神经元ID
+            events.emplace_back(neuron_id, adjusted_timestamp);  // 保持原始神经元ID
             events_count++;
             events_loaded_count++;
             
@@ -238,52 +444,34 @@ bool SpikeSource::loadTextFormat(const std::string& file_path) {
     
     file.close();
     
+    // 文本输入不保证有序，排序一次后按序消费
+    spike_stream.assign(std::move(events));
+    
     // output->verbose(CALL_INFO, 1, 0, "TEXT格式加载完成: %u个事件\n", events_count);
     return true;
 }
 
-bool SpikeSource::loadNMNISTFormat(const std::string& file_path) {
-    // N-MNIST AER格式的实现
-    // 这里提供一个简化的实现框架，实际需要根据具体的二进制格式来解析
-    
-    output->verbose(CALL_INFO, 1, 0, "N-MNIST AER格式暂未完全实现\n");
-    output->verbose(CALL_INFO, 1, 0, "建议使用TEXT格式或实现完整的AER解析器\n");
-    
-    // 简化实现：假设文件已转换为文本格式 (x, y, timestamp, polarity)
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
+bool SpikeSource::openStream(const std::string& file_path, SpikeStream::Format format) {
+    std::string error;
+    if (!spike_stream.open(file_path, format, stream_options, error)) {
+        output->verbose(CALL_INFO, 1, 0, "无法打开数据集流: %s\n", error.c_str());
         return false;
     }
-    
-    std::string line;
-    uint32_t events_count = 0;
-    
-    while (std::getline(file, line) && (max_events == 0 || events_count < max_events)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        std::istringstream iss(line);
-        uint32_t x, y, polarity;
-        uint64_t timestamp;
-        
-        if (!(iss >> x >> y >> timestamp >> polarity)) {
-            continue;
-        }
-        
-        // 将(x,y)坐标转换为神经元ID (假设28x28图像)
-        uint32_t neuron_id = y * 28 + x + neuron_offset;
-        uint64_t adjusted_timestamp = convertToSimTime(timestamp);
-        
-        spike_queue.push(SpikeData(neuron_id, adjusted_timestamp));
-        events_count++;
-        events_loaded_count++;
-    }
-    
-    file.close();
-    
-    output->verbose(CALL_INFO, 1, 0, "N-MNIST格式加载完成: %u个事件\n", events_count);
+    output->verbose(CALL_INFO, 1, 0, "%s流已打开: 每块%u个事件, 预取线程=%s\n",
+                   dataset_format.c_str(), stream_options.chunk_events,
+                   stream_options.prefetch_thread ? "是" : "否");
     return true;
 }
 
+bool SpikeSource::loadNMNISTFormat(const std::string& file_path) {
+    // N-MNIST 原始AER二进制：每事件5字节，按时间顺序存放，分块流式读取
+    return openStream(file_path, SpikeStream::Format::NMNIST_AER);
+}
+
+bool SpikeSource::loadBinaryFormat(const std::string& file_path) {
+    return openStream(file_path, SpikeStream::Format::BINARY);
+}
+
 bool SpikeSource::loadSHDFormat(const std::string& /* file_path */) {
     // SHD HDF5格式的实现
     // 需要链接HDF5库，这里提供一个占位实现
@@ -17,37 +17,24 @@
 
 #include <vector>
 #include <string>
-#include <queue>
 #include <cstdint>
 
 #include "SpikeEvent.h"
+#include "SpikeStream.h"
 
 namespace SST {
 namespace SnnDL {
 
-/**
- * @brief 脉冲数据结构，用于存储从文件读取的脉冲事件
- */
-struct SpikeData {
-    uint32_t neuron_id;     ///< 神经元ID
-    uint64_t timestamp;     ///< 时间戳（微秒）
-    
-    SpikeData(uint32_t id, uint64_t ts) : neuron_id(id), timestamp(ts) {}
-    
-    // 用于优先队列的比较运算符（时间戳小的优先）
-    bool operator>(const SpikeData& other) const {
-        return timestamp > other.timestamp;
-    }
-};
-
 /**
  * @brief 脉冲数据源组件
  * 
  * 该组件负责从神经形态数据集文件中读取脉冲数据，并在仿真过程中
  * 按照正确的时序向网络注入脉冲事件。支持多种数据格式：
- * - N-MNIST (AER格式)
+ * - N-MNIST (原始AER二进制格式，分块流式读取)
+ * - 预排序二进制 (timestamp, neuron) 记录（分块流式读取）
  * - Spiking Heidelberg Digits (HDF5格式)
  * - 简单文本格式 (neuron_id, timestamp)
+ * 二进制格式只在内存中保留一个读取窗口（双缓冲），见 SpikeStream。
  */
 class SpikeSource : public SST::Component {
 public:
@@ -64,22 +51,44 @@ public:
     // 参数文档
     SST_ELI_DOCUMENT_PARAMS(
         {"dataset_path",   "数据集文件路径", ""},
-        {"dataset_format", "数据集格式 (TEXT|NMNIST_AER|SHD_HDF5)", "TEXT"},
+        {"dataset_format", "数据集格式 (TEXT|NMNIST_AER|BINARY|SHD_HDF5)。BINARY为按时间排序的 {u64 timestamp_us, u32 neuron_id} 小端记录", "TEXT"},
         {"time_scale",     "时间缩放因子 (仿真时间单位到数据时间单位)", "1.0"},
         {"neuron_offset",  "神经元ID偏移量", "0"},
+        {"neurons_per_core", "每个核心的神经元数，用于计算目标节点ID", "4"},
+        {"cores_per_node", "每个节点的核心数，目标节点 = neuron_id / (neurons_per_core*cores_per_node)", "4"},
+        {"num_destinations", "按目标节点分端口的数量（spike_output_0..N-1），0=仅使用spike_output", "0"},
+        {"destination_base", "spike_output_0 对应的目标节点ID", "0"},
         {"max_events",     "最大事件数量限制 (0=无限制)", "0"},
-        {"verbose",        "日志详细级别", "0"}
+        {"verbose",        "日志详细级别", "0"},
+        {"clock", "时间基准频率，数据时间戳以其周期为单位", "1MHz"},
+        {"skip_ahead", "不注册时钟，通过自链接直接在下一个事件的时间点唤醒 (1=是,0=每周期检查)", "1"},
+        {"enable_clock_suspend", "全部事件发送完毕后注销时钟（仅skip_ahead=0时有效）", "0"},
+        {"stream_chunk_events", "二进制格式每次读入的事件数（双缓冲各一块）", "65536"},
+        {"stream_prefetch_thread", "是否用后台线程预取下一块 (1=是,0=在当前块耗尽时同步读取)", "1"},
+        {"sensor_width", "NMNIST_AER 传感器宽度，神经元ID = (polarity*height + y)*width + x + neuron_offset", "34"},
+        {"sensor_height", "NMNIST_AER 传感器高度", "34"},
+        {"sample_list", "批量推理的样本列表文件（每行一个数据集路径，格式均为dataset_format，#开头为注释），设置后忽略dataset_path", ""},
+        {"sample_period", "每个样本占用的时间（如\"300us\"），第k个样本的时间戳整体平移 k*sample_period；须与MultiCorePE的sample_period一致", ""},
+        {"sample_gap", "每个样本周期末尾不注入输入的时间，供在途脉冲排空后再复位；样本内时间戳不小于 sample_period-sample_gap 的事件被截断", "0us"}
     )
 
     // 端口文档
     SST_ELI_DOCUMENT_PORTS(
-        {"spike_output", "发送脉冲事件的输出端口", {"SnnDL.SpikeEvent"}}
+        {"spike_output", "发送脉冲事件的输出端口（逐事件发送；也用于未连接专用端口的目标节点）", {"SnnDL.SpikeEvent"}},
+        {"spike_output_%(num_destinations)d", "按目标节点分配的输出端口，每周期每个目标节点最多一个批量事件", {"SnnDL.SpikeEvent", "SnnDL.SpikeBundle"}}
     )
 
     // 统计信息文档
     SST_ELI_DOCUMENT_STATISTICS(
         {"events_loaded", "从文件加载的事件总数", "events", 1},
-        {"events_sent", "发送的事件总数", "events", 1}
+        {"events_sent", "发送的事件总数", "events", 1},
+        {"stream_chunks", "流式读取的块数", "chunks", 1},
+        {"wakeups", "处理到期事件的唤醒次数（时钟周期或跳跃唤醒）", "wakeups", 1},
+        {"batches_sent", "经按目标节点端口发送的批量事件数", "events", 1},
+        {"events_dropped", "目标节点无可用链接而丢弃的事件数", "events", 1},
+        {"events_out_of_order", "二进制输入中时间戳逆序的事件数（到达即发送）", "events", 1},
+        {"samples_sent", "批量推理模式下已注入的样本数", "samples", 1},
+        {"events_clipped", "批量推理模式下超出样本输入窗口而被截断的事件数", "events", 1}
     )
 
     /**
@@ -108,9 +117,45 @@ private:
      * @return false表示继续仿真
      */
     virtual bool clockTick(SST::Cycle_t current_cycle);
+    
+    /**
+     * @brief 跳跃唤醒处理器：发送到期事件并预约下一个事件时间点
+     */
+    void handleWakeup(SST::Event* ev);
+
+    /**
+     * @brief 按流中下一个事件的时间戳预约自链接唤醒
+     */
+    void scheduleNextWakeup();
+
+    /**
+     * @brief 发送时间戳不晚于 current_sim_time 的全部事件
+     */
+    void dispatchDueEvents();
+
+    /**
+     * @brief 当前样本中下一个待发送的事件，当前样本耗尽或超出输入窗口时切换到下一个样本
+     * @return 没有更多事件时返回nullptr；时间戳为样本内时间，加 sample_base_time 得到发送时间
+     */
+    const SpikeData* nextEvent();
+
+    /**
+     * @brief 打开样本列表中的第 index 个样本
+     */
+    bool loadSample(size_t index);
 
     // ===== 私有辅助方法 =====
     
+    /**
+     * @brief 目标节点对应的专用端口槽位，无已连接的专用端口时返回-1
+     */
+    int destinationSlot(uint32_t dest_node) const;
+    
+    /**
+     * @brief 将本周期按目标节点暂存的事件各打包为一个事件发送
+     */
+    void flushDestinationBatches();
+    
     /**
      * @brief 加载数据集文件
      * @return 是否加载成功
@@ -131,6 +176,18 @@ private:
      */
     bool loadNMNISTFormat(const std::string& file_path);
     
+    /**
+     * @brief 打开预排序二进制格式数据集（流式读取）
+     * @param file_path 文件路径
+     * @return 是否打开成功
+     */
+    bool loadBinaryFormat(const std::string& file_path);
+    
+    /**
+     * @brief 以给定格式打开二进制流
+     */
+    bool openStream(const std::string& file_path, SpikeStream::Format format);
+    
     /**
      * @brief 加载SHD HDF5格式数据集
      * @param file_path 文件路径
@@ -150,6 +207,8 @@ private:
     // SST基础设施
     SST::Output* output;                    ///< 日志输出对象
     SST::Link* spike_output_link;           ///< 输出脉冲链接
+    SST::Link* wakeup_link;                 ///< 跳跃唤醒自链接
+    SST::TimeConverter* time_base;          ///< 跳跃唤醒的时间基准
     
     // 配置参数
     std::string dataset_path;               ///< 数据集文件路径
@@ -158,22 +217,54 @@ private:
     uint32_t neuron_offset;                 ///< 神经元ID偏移
     uint32_t max_events;                    ///< 最大事件数限制
     uint32_t neurons_per_core;              ///< 每个核心的神经元数，用于计算目标节点ID
+    uint32_t neurons_per_node;              ///< 每个节点的神经元数（neurons_per_core × cores_per_node）
     
-    // 脉冲数据存储
-    std::priority_queue<SpikeData, std::vector<SpikeData>, std::greater<SpikeData>> spike_queue;
+    // 按目标节点分端口发送
+    uint32_t destination_base;                      ///< spike_output_0 对应的目标节点
+    std::vector<SST::Link*> destination_links;      ///< 目标节点 -> 专用链接（未连接为nullptr）
+    std::vector<std::vector<SpikeData>> destination_pending;  ///< 本周期待发送的事件（按目标节点）
+    std::vector<uint32_t> destinations_touched;     ///< 本周期有事件的目标槽位
+    
+    // 脉冲数据存储（按时间排序的流，二进制格式仅常驻读取窗口）
+    SpikeStream spike_stream;
+    SpikeStream::Options stream_options;
     uint64_t current_sim_time;              ///< 当前仿真时间（微秒）
     
+    // 批量推理：样本依次注入，第k个样本从 k*sample_period 开始
+    std::vector<std::string> sample_files;  ///< 样本数据集路径（为空时为单数据集模式）
+    size_t sample_index;                    ///< 当前样本序号
+    uint64_t sample_period_ticks;           ///< 样本周期（时间基准周期数）
+    uint64_t sample_window_ticks;           ///< 样本输入窗口（sample_period - sample_gap），0为不截断
+    uint64_t sample_base_time;              ///< 当前样本第一个时间单位对应的仿真时间
+    uint64_t stream_events_done;            ///< 已结束样本的流读取统计（每次打开重新计数）
+    uint64_t stream_chunks_done;
+    uint64_t stream_out_of_order_done;
+    uint64_t stream_truncated_done;
+    
     // 统计计数器
     uint64_t events_loaded_count;           ///< 加载事件计数
     uint64_t events_sent_count;             ///< 发送事件计数
+    uint64_t batches_sent_count;            ///< 批量事件计数
+    uint64_t events_dropped_count;          ///< 丢弃事件计数
+    uint64_t wakeups_count;                 ///< 唤醒次数
+    uint64_t events_clipped_count;          ///< 截断事件计数
     
     // 统计对象
     Statistic<uint64_t>* stat_events_loaded;
     Statistic<uint64_t>* stat_events_sent;
+    Statistic<uint64_t>* stat_batches_sent;
+    Statistic<uint64_t>* stat_events_dropped;
+    Statistic<uint64_t>* stat_wakeups;
+    Statistic<uint64_t>* stat_stream_chunks;
+    Statistic<uint64_t>* stat_events_out_of_order;
+    Statistic<uint64_t>* stat_samples_sent;
+    Statistic<uint64_t>* stat_events_clipped;
     
     // 状态标志
     bool data_loaded;                       ///< 数据是否已加载
     bool finished_sending;                  ///< 是否完成发送
+    bool enable_clock_suspend;              ///< 发送完毕后是否注销时钟
+    bool skip_ahead;                        ///< 以自链接替代时钟
 };
 
 } // namespace SnnDL
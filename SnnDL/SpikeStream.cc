@@ -0,0 +1,201 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SpikeStream.cc: 按时间顺序分块读取脉冲数据集的双缓冲流实现文件
+//
+
+#include "SpikeStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace SST::SnnDL;
+
+SpikeStream::~SpikeStream() {
+    stop();
+}
+
+bool SpikeStream::parseFormat(const std::string& name, Format& format) {
+    if (name == "TEXT") {
+        format = Format::TEXT;
+    } else if (name == "NMNIST_AER") {
+        format = Format::NMNIST_AER;
+    } else if (name == "BINARY") {
+        format = Format::BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool SpikeStream::open(const std::string& path, Format format, const Options& options, std::string& error) {
+    stop();
+    format_ = format;
+    options_ = options;
+    options_.chunk_events = std::max<uint32_t>(1, options_.chunk_events);
+    if (format_ == Format::NMNIST_AER) {
+        record_bytes_ = 5;
+    } else if (format_ == Format::BINARY) {
+        record_bytes_ = sizeof(uint64_t) + sizeof(uint32_t);
+    } else {
+        error = "TEXT格式请整体加载后调用assign";
+        return false;
+    }
+
+    file_.clear();
+    file_.open(path, std::ios::binary);
+    if (!file_.is_open()) {
+        error = "无法打开文件: " + path;
+        return false;
+    }
+    raw_.resize(static_cast<size_t>(options_.chunk_events) * record_bytes_);
+
+    // 第一块同步读入，仿真开始时即有数据可发
+    front_.clear();
+    pos_ = 0;
+    back_.clear();
+    back_ready_ = false;
+    last_timestamp_ = 0;
+    // 计数按本次打开的文件重新开始（批量推理逐样本重新打开）
+    events_read_ = 0;
+    chunks_read_ = 0;
+    out_of_order_ = 0;
+    truncated_bytes_ = 0;
+    eof_ = !readChunk(front_);
+
+    if (options_.prefetch_thread && !eof_) {
+        stopping_ = false;
+        worker_ = std::thread(&SpikeStream::prefetchLoop, this);
+    }
+    return true;
+}
+
+void SpikeStream::assign(std::vector<SpikeData>&& events) {
+    stop();
+    std::stable_sort(events.begin(), events.end());
+    front_ = std::move(events);
+    pos_ = 0;
+    back_.clear();
+    back_ready_ = false;
+    eof_ = true;
+    events_read_ = front_.size();
+    chunks_read_ = 1;
+    out_of_order_ = 0;
+    truncated_bytes_ = 0;
+}
+
+size_t SpikeStream::resident() const {
+    size_t front_left = pos_ < front_.size() ? front_.size() - pos_ : 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return front_left + (back_ready_ ? back_.size() : 0);
+}
+
+bool SpikeStream::advance() {
+    if (!worker_.joinable()) {
+        // 同步模式：前台耗尽时就地读下一块
+        while (!eof_) {
+            front_.clear();
+            pos_ = 0;
+            eof_ = !readChunk(front_);
+            if (!front_.empty()) return true;
+        }
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return back_ready_ || eof_; });
+        if (!back_ready_) return false;
+        front_.swap(back_);
+        back_.clear();
+        back_ready_ = false;
+        pos_ = 0;
+        cv_.notify_all();
+        if (!front_.empty()) return true;
+    }
+}
+
+bool SpikeStream::readChunk(std::vector<SpikeData>& out) {
+    size_t want = options_.chunk_events;
+    if (options_.max_events > 0) {
+        uint64_t read = events_read_;
+        if (read >= options_.max_events) return false;
+        want = static_cast<size_t>(std::min<uint64_t>(want, options_.max_events - read));
+    }
+
+    file_.read(reinterpret_cast<char*>(raw_.data()), static_cast<std::streamsize>(want * record_bytes_));
+    size_t got = static_cast<size_t>(file_.gcount());
+    size_t records = got / record_bytes_;
+    decode(raw_.data(), records, out);
+    events_read_ += records;
+    chunks_read_++;
+
+    if (!file_) {
+        // 文件末尾不足一条记录的残余字节
+        truncated_bytes_ += got % record_bytes_;
+        return false;
+    }
+    return options_.max_events == 0 || events_read_ < options_.max_events;
+}
+
+void SpikeStream::decode(const uint8_t* data, size_t records, std::vector<SpikeData>& out) {
+    out.reserve(out.size() + records);
+    const uint32_t plane = options_.sensor_width * options_.sensor_height;
+    for (size_t i = 0; i < records; i++) {
+        const uint8_t* rec = data + i * record_bytes_;
+        uint32_t neuron;
+        uint64_t timestamp;
+        if (format_ == Format::NMNIST_AER) {
+            uint32_t x = rec[0];
+            uint32_t y = rec[1];
+            uint32_t polarity = rec[2] >> 7;
+            timestamp = (static_cast<uint64_t>(rec[2] & 0x7F) << 16) |
+                        (static_cast<uint64_t>(rec[3]) << 8) | rec[4];
+            neuron = polarity * plane + y * options_.sensor_width + x;
+        } else {
+            std::memcpy(&timestamp, rec, sizeof(timestamp));
+            std::memcpy(&neuron, rec + sizeof(timestamp), sizeof(neuron));
+        }
+        neuron += options_.neuron_offset;
+        timestamp = static_cast<uint64_t>(timestamp * options_.time_scale);
+
+        if (timestamp < last_timestamp_) {
+            out_of_order_++;
+        } else {
+            last_timestamp_ = timestamp;
+        }
+        out.emplace_back(neuron, timestamp);
+    }
+}
+
+void SpikeStream::prefetchLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return stopping_ || (!back_ready_ && !eof_); });
+        if (stopping_) return;
+        lock.unlock();
+
+        std::vector<SpikeData> chunk;
+        bool more = readChunk(chunk);
+
+        lock.lock();
+        back_ = std::move(chunk);
+        back_ready_ = true;
+        if (!more) eof_ = true;
+        cv_.notify_all();
+    }
+}
+
+void SpikeStream::stop() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        worker_.join();
+    }
+    stopping_ = false;
+    if (file_.is_open()) file_.close();
+}
@@ -0,0 +1,145 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SpikeStream.h: 按时间顺序分块读取脉冲数据集的双缓冲流头文件
+//
+
+#ifndef _SPIKESTREAM_H
+#define _SPIKESTREAM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 脉冲数据结构，用于存储从文件读取的脉冲事件
+ */
+struct SpikeData {
+    uint32_t neuron_id;     ///< 神经元ID
+    uint64_t timestamp;     ///< 时间戳（微秒）
+
+    SpikeData() : neuron_id(0), timestamp(0) {}
+    SpikeData(uint32_t id, uint64_t ts) : neuron_id(id), timestamp(ts) {}
+
+    bool operator<(const SpikeData& other) const {
+        return timestamp < other.timestamp;
+    }
+};
+
+/**
+ * @brief 双缓冲脉冲事件流
+ *
+ * 二进制格式按块读取：前台缓冲供仿真消费，后台缓冲由预取线程（或在前台耗尽时同步）
+ * 填充，常驻内存只有两个块。二进制输入要求按时间戳非降序存放，直接作为有序序列消费，
+ * 不再经过优先队列；逆序事件仍会送出（其时间戳已过期，立即发送）并计数。
+ * 文本格式无序，整体读入后排序为一个有序序列。
+ *
+ * 支持的格式：
+ * - TEXT：每行 "neuron_id timestamp_us"，# 开头为注释
+ * - NMNIST_AER：N-MNIST 原始二进制，每事件5字节
+ *   (x, y, polarity<<7 | ts[22:16], ts[15:8], ts[7:0])，时间戳单位微秒
+ * - BINARY：预排序二进制记录，每事件12字节 {u64 timestamp_us, u32 neuron_id}，小端
+ */
+class SpikeStream {
+public:
+    enum class Format { TEXT, NMNIST_AER, BINARY };
+
+    /**
+     * @brief 流配置
+     */
+    struct Options {
+        uint32_t chunk_events = 65536;   ///< 每块事件数
+        bool prefetch_thread = true;     ///< 是否使用后台线程预取下一块
+        uint64_t max_events = 0;         ///< 最大事件数（0=无限制）
+        uint32_t neuron_offset = 0;      ///< 二进制格式的神经元ID偏移
+        float time_scale = 1.0f;         ///< 二进制格式时间戳缩放
+        uint32_t sensor_width = 34;      ///< NMNIST_AER 传感器宽度
+        uint32_t sensor_height = 34;     ///< NMNIST_AER 传感器高度
+    };
+
+    SpikeStream() = default;
+    ~SpikeStream();
+    SpikeStream(const SpikeStream&) = delete;
+    SpikeStream& operator=(const SpikeStream&) = delete;
+
+    /**
+     * @brief 将格式名称解析为枚举（TEXT|NMNIST_AER|BINARY）
+     */
+    static bool parseFormat(const std::string& name, Format& format);
+
+    /**
+     * @brief 打开二进制数据集并读入第一块
+     * @return 是否成功，失败时 error 给出原因
+     */
+    bool open(const std::string& path, Format format, const Options& options, std::string& error);
+
+    /**
+     * @brief 直接以已排序的事件序列作为流内容（文本格式等整体加载的输入）
+     */
+    void assign(std::vector<SpikeData>&& events);
+
+    /**
+     * @brief 下一个事件，流结束时返回 nullptr
+     */
+    const SpikeData* peek() {
+        if (pos_ >= front_.size() && !advance()) return nullptr;
+        return &front_[pos_];
+    }
+
+    void pop() { pos_++; }
+
+    /**
+     * @brief 当前常驻的事件数（前台剩余 + 后台已预取）
+     */
+    size_t resident() const;
+
+    uint64_t eventsRead() const { return events_read_; }
+    uint64_t chunksRead() const { return chunks_read_; }
+    uint64_t outOfOrder() const { return out_of_order_; }
+    uint64_t truncatedBytes() const { return truncated_bytes_; }
+
+private:
+    bool advance();
+    bool readChunk(std::vector<SpikeData>& out);
+    void decode(const uint8_t* data, size_t records, std::vector<SpikeData>& out);
+    void prefetchLoop();
+    void stop();
+
+    Format format_ = Format::TEXT;
+    Options options_;
+    std::ifstream file_;
+    size_t record_bytes_ = 0;
+    std::vector<uint8_t> raw_;
+
+    std::vector<SpikeData> front_;
+    size_t pos_ = 0;
+    std::vector<SpikeData> back_;
+    bool back_ready_ = false;
+    bool eof_ = true;                   ///< 文件已读完（后台缓冲可能仍有数据）
+
+    std::thread worker_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    // 读取线程更新、仿真线程读取
+    std::atomic<uint64_t> events_read_{0};
+    std::atomic<uint64_t> chunks_read_{0};
+    std::atomic<uint64_t> out_of_order_{0};
+    std::atomic<uint64_t> truncated_bytes_{0};
+    uint64_t last_timestamp_ = 0;       ///< 仅由读取方访问
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _SPIKESTREAM_H */
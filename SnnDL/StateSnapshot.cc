@@ -0,0 +1,87 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// StateSnapshot.cc: 节点状态快照（warm start）读写实现文件
+//
+
+#include "StateSnapshot.h"
+
+#include <cstdio>
+
+using namespace SST::SnnDL;
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'S', 'N', 'N', 'D', 'L', 'C', 'K', 'P'};
+const uint32_t SNAPSHOT_VERSION = 1;
+
+template <typename T>
+bool readField(FILE* f, T& value) {
+    return std::fread(&value, sizeof(T), 1, f) == 1;
+}
+
+template <typename T>
+bool writeField(FILE* f, const T& value) {
+    return std::fwrite(&value, sizeof(T), 1, f) == 1;
+}
+
+} // namespace
+
+bool SST::SnnDL::writeStateSnapshot(const std::string& path, const StateSnapshotHeader& header,
+                                    const std::vector<std::vector<uint8_t>>& core_states, std::string& error) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        error = "无法创建快照文件 " + path;
+        return false;
+    }
+    bool ok = std::fwrite(SNAPSHOT_MAGIC, 1, sizeof(SNAPSHOT_MAGIC), f) == sizeof(SNAPSHOT_MAGIC) &&
+              writeField(f, SNAPSHOT_VERSION) && writeField(f, header.node_id) &&
+              writeField(f, header.num_cores) && writeField(f, header.neurons_per_core) &&
+              writeField(f, header.cycle);
+    for (size_t core = 0; ok && core < core_states.size(); core++) {
+        const std::vector<uint8_t>& state = core_states[core];
+        if (state.empty()) continue;
+        ok = writeField(f, static_cast<uint32_t>(core)) && writeField(f, static_cast<uint64_t>(state.size())) &&
+             std::fwrite(state.data(), 1, state.size(), f) == state.size();
+    }
+    if (std::fclose(f) != 0) ok = false;
+    if (!ok) error = "写入快照文件失败 " + path;
+    return ok;
+}
+
+bool SST::SnnDL::readCoreStateSnapshot(const std::string& path, uint32_t core_id, StateSnapshotHeader& header,
+                                       std::vector<uint8_t>& state, std::string& error) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        error = "无法打开快照文件 " + path;
+        return false;
+    }
+    char magic[8] = {};
+    uint32_t version = 0;
+    bool ok = std::fread(magic, 1, sizeof(magic), f) == sizeof(magic) && readField(f, version) &&
+              readField(f, header.node_id) && readField(f, header.num_cores) &&
+              readField(f, header.neurons_per_core) && readField(f, header.cycle);
+    if (!ok || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 || version != SNAPSHOT_VERSION) {
+        std::fclose(f);
+        error = "不是SnnDL快照文件或版本不符: " + path;
+        return false;
+    }
+    // 按段长跳过其他核心，只读入本核心的段
+    uint32_t core = 0;
+    uint64_t size = 0;
+    while (readField(f, core) && readField(f, size)) {
+        if (core != core_id) {
+            if (std::fseek(f, static_cast<long>(size), SEEK_CUR) != 0) break;
+            continue;
+        }
+        state.resize(static_cast<size_t>(size));
+        ok = size == 0 || std::fread(state.data(), 1, state.size(), f) == state.size();
+        std::fclose(f);
+        if (!ok) error = "快照文件中核心" + std::to_string(core_id) + "的段被截断: " + path;
+        return ok;
+    }
+    std::fclose(f);
+    error = "快照文件中没有核心" + std::to_string(core_id) + "的状态: " + path;
+    return false;
+}
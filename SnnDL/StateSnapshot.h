@@ -0,0 +1,136 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// StateSnapshot.h: 节点状态快照（warm start）读写头文件
+//
+
+#ifndef _STATESNAPSHOT_H
+#define _STATESNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 按小端原样追加定宽字段与数组的字节写入器
+ */
+class StateWriter {
+public:
+    explicit StateWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "只能写入定宽字段");
+        append(&value, sizeof(T));
+    }
+
+    /** u64 元素个数 | 元素[n] */
+    template <typename T>
+    void putArray(const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "只能写入定宽数组");
+        put<uint64_t>(count);
+        if (count > 0) append(data, count * sizeof(T));
+    }
+
+    template <typename V>
+    void putArray(const V& values) {
+        putArray(values.data(), values.size());
+    }
+
+private:
+    void append(const void* data, size_t bytes) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        out_.insert(out_.end(), p, p + bytes);
+    }
+
+    std::vector<uint8_t>& out_;
+};
+
+/**
+ * @brief 与 StateWriter 对应的读取器，越界后 ok() 为假且不再读取
+ */
+class StateReader {
+public:
+    StateReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "只能读取定宽字段");
+        return take(&value, sizeof(T));
+    }
+
+    /** 按 putArray 的格式读取，调整 values 大小（vector 或对齐vector） */
+    template <typename V>
+    bool getArray(V& values) {
+        using T = typename V::value_type;
+        uint64_t count = 0;
+        if (!get(count) || count > (size_ - pos_) / sizeof(T)) {
+            ok_ = false;
+            return false;
+        }
+        values.resize(static_cast<size_t>(count));
+        return count == 0 || take(values.data(), static_cast<size_t>(count) * sizeof(T));
+    }
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return pos_ == size_; }
+
+private:
+    bool take(void* dst, size_t bytes) {
+        if (!ok_ || bytes > size_ - pos_) {
+            ok_ = false;
+            return false;
+        }
+        std::memcpy(dst, data_ + pos_, bytes);
+        pos_ += bytes;
+        return true;
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+/**
+ * @brief 节点状态快照文件
+ *
+ * MultiCorePE 在 checkpoint_cycle（或 finish）时收集各核心 SnnCoreAPI::saveState 的输出写成一个文件，
+ * 之后的运行以 checkpoint_in 指向该文件，各核心在构造时读回自己的段，跳过连接表解析与暖机。
+ *
+ * 文件格式（小端）：
+ *   文件头 : "SNNDLCKP"(8B) | u32 版本=1 | u32 节点ID | u32 核心数 | u32 每核神经元数 | u64 保存周期
+ *   核心段 : u32 核心ID | u64 字节数 | 核心状态（格式由各核心实现自定）
+ */
+struct StateSnapshotHeader {
+    uint32_t node_id = 0;
+    uint32_t num_cores = 0;
+    uint32_t neurons_per_core = 0;
+    uint64_t cycle = 0;
+};
+
+/**
+ * @brief 写出快照文件
+ * @param core_states 下标为核心ID；空串表示该核心未提供状态，不写入核心段
+ */
+bool writeStateSnapshot(const std::string& path, const StateSnapshotHeader& header,
+                        const std::vector<std::vector<uint8_t>>& core_states, std::string& error);
+
+/**
+ * @brief 读取快照中某个核心的状态段
+ * @param header 输出：文件头，调用方据此校验节点与规模
+ * @return 找到该核心的段时返回true
+ */
+bool readCoreStateSnapshot(const std::string& path, uint32_t core_id, StateSnapshotHeader& header,
+                           std::vector<uint8_t>& state, std::string& error);
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _STATESNAPSHOT_H */
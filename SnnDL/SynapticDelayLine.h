@@ -0,0 +1,122 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// SynapticDelayLine.h: 每神经元环形突触延迟累加器头文件
+//
+
+#ifndef _SYNAPTICDELAYLINE_H
+#define _SYNAPTICDELAYLINE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 突触延迟线
+ *
+ * D = max_delay+1 个槽位的环，每个槽位为全部神经元的一组输入电流累加器。
+ * 延迟 d 的加权脉冲累加到槽位 (now+d) % D，周期 now 取出槽位 now % D 并清零。
+ * 同一神经元同一到期周期的输入在槽位里合并，不再为每个延迟单独保留事件。
+ * 每个槽位记录被写过的神经元，取出时只访问这些神经元（升序），空槽位为 O(1)。
+ */
+class SynapticDelayLine {
+public:
+    /**
+     * @param max_delay 最大延迟（周期），0 表示不启用
+     * @param num_neurons 神经元数
+     */
+    void configure(uint32_t max_delay, uint32_t num_neurons) {
+        slots_ = max_delay + 1;
+        num_neurons_ = num_neurons;
+        if (max_delay == 0) {
+            current_.clear();
+            mark_.clear();
+            touched_.clear();
+            pending_ = 0;
+            return;
+        }
+        current_.assign(static_cast<size_t>(slots_) * num_neurons_, 0.0f);
+        mark_.assign(static_cast<size_t>(slots_) * num_neurons_, 0);
+        touched_.assign(slots_, {});
+        pending_ = 0;
+    }
+
+    bool enabled() const { return slots_ > 1; }
+    uint32_t maxDelay() const { return slots_ - 1; }
+
+    /**
+     * @brief 累加一个延迟输入，在周期 now+delay 取出
+     * @param now 起算周期，不早于最近一次 consume 的周期（now+1 起的槽位尚未取出）
+     * @param delay 延迟周期，须在 [1, maxDelay()] 内（调用者负责截断）
+     */
+    void add(uint64_t now, uint32_t delay, uint32_t neuron, float weight) {
+        uint32_t slot = static_cast<uint32_t>((now + delay) % slots_);
+        size_t idx = static_cast<size_t>(slot) * num_neurons_ + neuron;
+        current_[idx] += weight;
+        if (!mark_[idx]) {
+            mark_[idx] = 1;
+            touched_[slot].push_back(neuron);
+            pending_++;
+        }
+    }
+
+    /**
+     * @brief 取出周期 now 到期的输入并清零对应槽位
+     * @param apply 对每个被写过的神经元调用 apply(neuron, current)，按神经元升序
+     * @return 取出的神经元数
+     */
+    template <typename F>
+    size_t consume(uint64_t now, F&& apply) {
+        if (pending_ == 0) return 0;
+        uint32_t slot = static_cast<uint32_t>(now % slots_);
+        std::vector<uint32_t>& list = touched_[slot];
+        if (list.empty()) return 0;
+        std::sort(list.begin(), list.end());
+        float* slot_current = &current_[static_cast<size_t>(slot) * num_neurons_];
+        uint8_t* slot_mark = &mark_[static_cast<size_t>(slot) * num_neurons_];
+        size_t count = list.size();
+        for (uint32_t neuron : list) {
+            float value = slot_current[neuron];
+            slot_current[neuron] = 0.0f;
+            slot_mark[neuron] = 0;
+            apply(neuron, value);
+        }
+        pending_ -= count;
+        list.clear();
+        return count;
+    }
+
+    /** 丢弃全部尚未到期的输入 */
+    void clear() {
+        for (uint32_t slot = 0; slot < touched_.size(); slot++) {
+            size_t base = static_cast<size_t>(slot) * num_neurons_;
+            for (uint32_t neuron : touched_[slot]) {
+                current_[base + neuron] = 0.0f;
+                mark_[base + neuron] = 0;
+            }
+            touched_[slot].clear();
+        }
+        pending_ = 0;
+    }
+
+    /** 尚未到期的 (槽位, 神经元) 累加器个数 */
+    size_t pending() const { return pending_; }
+    bool empty() const { return pending_ == 0; }
+
+private:
+    uint32_t slots_ = 1;
+    uint32_t num_neurons_ = 0;
+    std::vector<float> current_;                  ///< [slot*N + neuron] 输入电流累加
+    std::vector<uint8_t> mark_;                   ///< [slot*N + neuron] 是否已登记到 touched_
+    std::vector<std::vector<uint32_t>> touched_;  ///< 每个槽位被写过的神经元
+    size_t pending_ = 0;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _SYNAPTICDELAYLINE_H */
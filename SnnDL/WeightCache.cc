@@ -0,0 +1,171 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// WeightCache.cc: 固定容量组相联突触权重缓存实现文件
+//
+
+#include "WeightCache.h"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace SST::SnnDL;
+
+WeightCache::WeightCache(uint32_t capacity, uint32_t ways, Policy policy)
+    : ways_(1), num_sets_(1), set_shift_(0), policy_(policy), lru_tick_(0), occupied_(0),
+      hits_(0), misses_(0), evictions_(0) {
+    configure(capacity, ways, policy);
+}
+
+void WeightCache::configure(uint32_t capacity, uint32_t ways, Policy policy) {
+    ways_ = std::min<uint32_t>(std::max<uint32_t>(ways, 1), 64);
+    policy_ = policy;
+
+    // 组数取2的幂，便于用乘法散列的高位直接得到组号
+    uint32_t wanted_sets = std::max<uint32_t>(1, (std::max<uint32_t>(capacity, 1) + ways_ - 1) / ways_);
+    num_sets_ = 1;
+    uint32_t log2_sets = 0;
+    while (num_sets_ < wanted_sets) {
+        num_sets_ <<= 1;
+        log2_sets++;
+    }
+    set_shift_ = 64 - log2_sets;
+
+    entries_.assign(static_cast<size_t>(num_sets_) * ways_, Entry{EMPTY_KEY, 0.0f, 0});
+    clock_hands_.assign(num_sets_, 0);
+    lru_tick_ = 0;
+    occupied_ = 0;
+}
+
+uint32_t WeightCache::setIndex(uint64_t key) const {
+    if (num_sets_ == 1) return 0;
+    // Fibonacci 散列：同一行内连续的 post 分散到不同组
+    return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ULL) >> set_shift_);
+}
+
+void WeightCache::touch(Entry& entry) {
+    if (policy_ == Policy::LRU) {
+        if (++lru_tick_ == 0) {
+            // 访问戳回绕：全部归零后重新计数，仅短暂影响替换精度
+            for (auto& e : entries_) e.meta = 0;
+            lru_tick_ = 1;
+        }
+        entry.meta = lru_tick_;
+    } else {
+        entry.meta = 1;
+    }
+}
+
+bool WeightCache::lookup(uint64_t key, float& value) {
+    Entry* set = &entries_[static_cast<size_t>(setIndex(key)) * ways_];
+    for (uint32_t w = 0; w < ways_; w++) {
+        if (set[w].key == key) {
+            value = set[w].value;
+            touch(set[w]);
+            hits_++;
+            return true;
+        }
+    }
+    misses_++;
+    return false;
+}
+
+bool WeightCache::peek(uint64_t key, float& value) const {
+    const Entry* set = &entries_[static_cast<size_t>(setIndex(key)) * ways_];
+    for (uint32_t w = 0; w < ways_; w++) {
+        if (set[w].key == key) {
+            value = set[w].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t WeightCache::selectVictim(uint32_t set_idx) {
+    Entry* set = &entries_[static_cast<size_t>(set_idx) * ways_];
+    if (policy_ == Policy::LRU) {
+        uint32_t victim = 0;
+        for (uint32_t w = 1; w < ways_; w++) {
+            if (set[w].meta < set[victim].meta) victim = w;
+        }
+        return victim;
+    }
+
+    // CLOCK：清除引用位直到找到未被引用的条目，最多两圈
+    uint8_t& hand = clock_hands_[set_idx];
+    for (uint32_t step = 0; step < 2 * ways_; step++) {
+        Entry& e = set[hand];
+        uint32_t current = hand;
+        hand = static_cast<uint8_t>((hand + 1) % ways_);
+        if (e.meta == 0) return current;
+        e.meta = 0;
+    }
+    return hand;
+}
+
+void WeightCache::insert(uint64_t key, float value) {
+    uint32_t set_idx = setIndex(key);
+    Entry* set = &entries_[static_cast<size_t>(set_idx) * ways_];
+
+    int free_way = -1;
+    for (uint32_t w = 0; w < ways_; w++) {
+        if (set[w].key == key) {
+            set[w].value = value;
+            touch(set[w]);
+            return;
+        }
+        if (free_way < 0 && set[w].key == EMPTY_KEY) free_way = static_cast<int>(w);
+    }
+
+    uint32_t way;
+    if (free_way >= 0) {
+        way = static_cast<uint32_t>(free_way);
+        occupied_++;
+    } else {
+        way = selectVictim(set_idx);
+        evictions_++;
+    }
+    set[way].key = key;
+    set[way].value = value;
+    touch(set[way]);
+}
+
+void WeightCache::clear() {
+    for (auto& e : entries_) {
+        e.key = EMPTY_KEY;
+        e.meta = 0;
+    }
+    std::fill(clock_hands_.begin(), clock_hands_.end(), 0);
+    occupied_ = 0;
+}
+
+void WeightCache::exportEntries(std::vector<std::pair<uint64_t, float>>& out) const {
+    std::vector<const Entry*> valid;
+    valid.reserve(occupied_);
+    for (const auto& e : entries_) {
+        if (e.key != EMPTY_KEY) valid.push_back(&e);
+    }
+    if (policy_ == Policy::LRU) {
+        std::stable_sort(valid.begin(), valid.end(),
+                         [](const Entry* a, const Entry* b) { return a->meta < b->meta; });
+    }
+    out.clear();
+    out.reserve(valid.size());
+    for (const Entry* e : valid) out.emplace_back(e->key, e->value);
+}
+
+bool WeightCache::parsePolicy(const std::string& name, Policy& policy) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "lru") {
+        policy = Policy::LRU;
+        return true;
+    }
+    if (lower == "clock") {
+        policy = Policy::CLOCK;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,121 @@
+// -*- c++ -*-
+//
+// Copyright 2025 SST Contributors
+//
+// WeightCache.h: 固定容量组相联突触权重缓存头文件
+//
+
+#ifndef _WEIGHTCACHE_H
+#define _WEIGHTCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SST {
+namespace SnnDL {
+
+/**
+ * @brief 固定容量的组相联权重缓存
+ *
+ * 以 pre*N+post 为键，条目平铺存放在连续数组中（每条目16字节，
+ * 一个组占据相邻缓存行），查找不分配内存。容量满时按替换策略
+ * 逐条淘汰，而不是整体清空。
+ */
+class WeightCache {
+public:
+    /**
+     * @brief 替换策略
+     */
+    enum class Policy {
+        LRU,    ///< 组内最近最少使用
+        CLOCK   ///< 组内时钟（二次机会）算法
+    };
+
+    /**
+     * @brief 构造函数
+     * @param capacity 条目总数上限（按组数向上取整为2的幂）
+     * @param ways 组相联度
+     * @param policy 替换策略
+     */
+    WeightCache(uint32_t capacity = 4096, uint32_t ways = 8, Policy policy = Policy::LRU);
+
+    /**
+     * @brief 重新配置容量与策略，并清空缓存
+     */
+    void configure(uint32_t capacity, uint32_t ways, Policy policy);
+
+    /**
+     * @brief 查找权重并更新替换信息，计入命中/未命中统计
+     * @param key 缓存键 (pre*N+post)
+     * @param value 输出：命中时的权重
+     * @return 是否命中
+     */
+    bool lookup(uint64_t key, float& value);
+
+    /**
+     * @brief 查找权重但不更新替换信息与统计
+     */
+    bool peek(uint64_t key, float& value) const;
+
+    /**
+     * @brief 插入或更新权重，组满时淘汰一个条目
+     */
+    void insert(uint64_t key, float value);
+
+    /**
+     * @brief 清空全部条目（统计保留）
+     */
+    void clear();
+
+    /**
+     * @brief 导出全部有效条目，LRU 策略下按访问先后排列，依次 insert 即可重建替换顺序
+     */
+    void exportEntries(std::vector<std::pair<uint64_t, float>>& out) const;
+
+    uint32_t size() const { return occupied_; }
+    uint32_t capacity() const { return static_cast<uint32_t>(entries_.size()); }
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t evictions() const { return evictions_; }
+
+    /**
+     * @brief 将策略名称解析为枚举（lru|clock，大小写不敏感）
+     * @param name 策略名称
+     * @param policy 输出：解析结果
+     * @return 是否为已知策略
+     */
+    static bool parsePolicy(const std::string& name, Policy& policy);
+
+private:
+    static constexpr uint64_t EMPTY_KEY = ~static_cast<uint64_t>(0);
+
+    struct Entry {
+        uint64_t key;    ///< 缓存键，EMPTY_KEY 表示空闲
+        float value;     ///< 权重值
+        uint32_t meta;   ///< LRU: 最近访问戳；CLOCK: 引用位
+    };
+
+    uint32_t setIndex(uint64_t key) const;
+    void touch(Entry& entry);
+    uint32_t selectVictim(uint32_t set);
+
+    std::vector<Entry> entries_;        ///< num_sets_ * ways_ 个条目，按组连续存放
+    std::vector<uint8_t> clock_hands_;  ///< 每组的时钟指针
+    uint32_t ways_;
+    uint32_t num_sets_;
+    uint32_t set_shift_;                ///< 乘法散列取高位的位移量
+    Policy policy_;
+    uint32_t lru_tick_;
+    uint32_t occupied_;
+
+    uint64_t hits_;
+    uint64_t misses_;
+    uint64_t evictions_;
+};
+
+} // namespace SnnDL
+} // namespace SST
+
+#endif /* _WEIGHTCACHE_H */
@@ -2,11 +2,15 @@
 
 #include <sst/core/sst_config.h>
 #include "WeightLoader.h"
+#include "CsrWeightStore.h"
+#include "SparseWeightLayout.h"
 
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
 #include <cstring>
+#include <sys/stat.h>
 
 using namespace SST;
 using namespace SST::SnnDL;
@@ -30,6 +34,11 @@ WeightLoader::WeightLoader(ComponentId_t id, Params& params)
     file_core_offset_ = params.find<int>("file_core_offset", 0);
     timed_seed_enable_ = params.find<int>("timed_seed_enable", 1) != 0;
     timed_seed_count_ = params.find<uint32_t>("timed_seed_count", 1);
+    std::string layout = params.find<std::string>("weight_layout", "dense");
+    std::string precision = params.find<std::string>("weight_precision", "float32");
+    float weight_scale = params.find<float>("weight_scale", 1.0f / 64.0f);
+    image_file_ = params.find<std::string>("image_file", "");
+    runtime_reload_ = params.find<int>("runtime_reload", 1) != 0;
 
     output_ = new Output("WeightLoader[@p:@l]: ", verbose_, 0, Output::STDOUT);
     output_->verbose(CALL_INFO, 1, 0, "🔧 初始化WeightLoader\n");
@@ -42,6 +51,19 @@ WeightLoader::WeightLoader(ComponentId_t id, Params& params)
     if (!memory_) {
         output_->fatal(CALL_INFO, -1, "❌ WeightLoader未配置StandardMem子组件\n");
     }
+    if (layout == "csr") {
+        sparse_layout_ = true;
+    } else if (layout != "dense") {
+        output_->fatal(CALL_INFO, -1, "❌ 未知的weight_layout: %s\n", layout.c_str());
+    }
+    std::string precision_error;
+    if (!FixedPointFormat::parse(precision, weight_scale, weight_precision_, precision_error)) {
+        output_->fatal(CALL_INFO, -1, "❌ weight_precision配置错误: %s\n", precision_error.c_str());
+    }
+    if (weight_precision_.isFixed()) {
+        output_->verbose(CALL_INFO, 1, 0, "🔢 权重精度 %s, lsb=%g, 范围[%g, %g]\n", weight_precision_.name(),
+                         weight_precision_.lsb(), weight_precision_.minValue(), weight_precision_.maxValue());
+    }
 }
 
 WeightLoader::~WeightLoader() {
@@ -70,6 +92,10 @@ void WeightLoader::setup() {
 }
 
 void WeightLoader::finish() {
+    if (saturated_weights_ > 0) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ %s量化时共有%" PRIu64 "个权重被饱和截断\n",
+                         weight_precision_.name(), saturated_weights_);
+    }
     output_->verbose(CALL_INFO, 1, 0, "🏁 WeightLoader 完成\n");
 }
 
@@ -106,46 +132,276 @@ void WeightLoader::handleMemoryResponse(SST::Interfaces::StandardMem::Request* r
 
 
 void WeightLoader::loadFileOnce() {
-    // 优先从 single_file 或 file_template 载入；退化到 weight_file（旧参数）或填充值
-    bool ok = false;
+    // 有映像缓存时直接读回编码好的各核映像；否则解析权重文件，并按需写出缓存供后续运行复用
+    bool ok = !image_file_.empty() && readImageFile(image_file_);
+    if (!ok) {
+        ok = buildCoreImages();
+        if (ok && !image_file_.empty() && writeImageFile(image_file_)) {
+            output_->verbose(CALL_INFO, 1, 0, "💾 内存映像已缓存到 %s\n", image_file_.c_str());
+        }
+    }
+    images_from_source_ = ok;
+    if (ok) {
+        for (int core = 0; core < num_cores_; ++core) {
+            issueCoreImage(core, core_images_[core], true);
+        }
+    } else {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 未提供可用权重文件，回退为填充值 %.3f\n", fill_value_);
+        issueWritesFill(fill_value_);
+    }
+    loaded_ = true;
+}
+
+bool WeightLoader::buildCoreImages() {
+    // 优先从 single_file 或 file_template 载入；退化到 weight_file（旧参数）
+    core_images_.assign(std::max(num_cores_, 0), std::vector<uint8_t>());
     if (!single_file_.empty()) {
-        ok = loadSingleFileAllCores(single_file_, weight_format_);
+        return loadSingleFileAllCores(single_file_, weight_format_);
     } else if (per_core_files_ && !file_template_.empty()) {
-        ok = loadPerCoreFiles(file_template_, weight_format_);
+        return loadPerCoreFiles(file_template_, weight_format_);
     } else if (!weight_file_.empty()) {
         // 旧参数兼容：将其作为 single_file 使用
-        ok = loadSingleFileAllCores(weight_file_, weight_format_);
+        return loadSingleFileAllCores(weight_file_, weight_format_);
     }
-    if (!ok) {
-        output_->verbose(CALL_INFO, 1, 0, "⚠️ 未提供可用权重文件，回退为填充值 %.3f\n", fill_value_);
-        issueWritesFill(fill_value_);
+    return false;
+}
+
+std::string WeightLoader::imageSignature() const {
+    // 影响映像内容的全部配置与源文件；不一致时缓存作废
+    std::ostringstream sig;
+    sig << "single=" << single_file_ << ";template=" << (per_core_files_ ? file_template_ : "")
+        << ";weight_file=" << weight_file_ << ";format=" << weight_format_ << ";cores=" << num_cores_
+        << ";n=" << neurons_per_core_ << ";offset=" << file_core_offset_ << ";row_major=" << row_major_
+        << ";fill=" << fill_value_ << ";layout=" << (sparse_layout_ ? "csr" : "dense")
+        << ";precision=" << weight_precision_.name() << ";lsb=" << weight_precision_.lsb();
+    // 源权重文件的大小与修改时间：文件被改写后缓存同样作废
+    std::vector<std::string> sources;
+    if (!single_file_.empty()) {
+        sources.push_back(single_file_);
+    } else if (per_core_files_ && !file_template_.empty()) {
+        for (int core = 0; core < num_cores_; ++core) sources.push_back(perCorePath(file_template_, core));
+    } else if (!weight_file_.empty()) {
+        sources.push_back(weight_file_);
     }
-    loaded_ = true;
+    for (const auto& path : sources) {
+        struct stat st;
+        sig << ";src=" << path;
+        if (::stat(path.c_str(), &st) == 0) {
+            sig << ":" << static_cast<uint64_t>(st.st_size) << ":" << static_cast<int64_t>(st.st_mtime);
+        } else {
+            sig << ":missing";
+        }
+    }
+    return sig.str();
+}
+
+std::string WeightLoader::perCorePath(const std::string& tmpl, int core) {
+    // 支持多种模板格式：{core}、{core:02d}等
+    std::string path = tmpl;
+    
+    // 处理 {core:02d} 格式
+    size_t pos = path.find("{core:02d}");
+    if (pos != std::string::npos) {
+        char formatted[16];
+        std::snprintf(formatted, sizeof(formatted), "%02d", core);
+        path.replace(pos, 10, formatted);
+    } else {
+        // 处理简单的 {core} 格式
+        pos = path.find("{core}");
+        if (pos != std::string::npos) {
+            path.replace(pos, 6, std::to_string(core));
+        }
+    }
+    return path;
+}
+
+bool WeightLoader::readImageFile(const std::string& path) {
+    // 格式：char[8] "SNNDLIMG" | u32 签名长度 | 签名 | 每核心 { u64 字节数 | 映像 }
+    std::ifstream fin(path, std::ios::binary);
+    if (!fin.good()) return false;
+    char magic[8] = {};
+    uint32_t sig_len = 0;
+    fin.read(magic, sizeof(magic));
+    fin.read(reinterpret_cast<char*>(&sig_len), sizeof(sig_len));
+    if (!fin || std::memcmp(magic, "SNNDLIMG", sizeof(magic)) != 0 || sig_len > 65536) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ %s 不是内存映像缓存，重新解析权重文件\n", path.c_str());
+        return false;
+    }
+    std::string sig(sig_len, '\0');
+    fin.read(&sig[0], sig_len);
+    if (!fin || sig != imageSignature()) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 内存映像缓存 %s 与当前配置或权重文件不符，重新解析权重文件\n", path.c_str());
+        return false;
+    }
+    core_images_.assign(std::max(num_cores_, 0), std::vector<uint8_t>());
+    for (auto& image : core_images_) {
+        uint64_t size = 0;
+        fin.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!fin) return false;
+        image.resize(static_cast<size_t>(size));
+        fin.read(reinterpret_cast<char*>(image.data()), static_cast<std::streamsize>(size));
+        if (!fin) {
+            output_->verbose(CALL_INFO, 1, 0, "⚠️ 内存映像缓存 %s 被截断，重新解析权重文件\n", path.c_str());
+            return false;
+        }
+    }
+    output_->verbose(CALL_INFO, 1, 0, "✅ 从内存映像缓存加载 %d 个核心: %s\n", num_cores_, path.c_str());
+    return true;
+}
+
+bool WeightLoader::writeImageFile(const std::string& path) const {
+    std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+    if (!fout.good()) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 无法写出内存映像缓存 %s\n", path.c_str());
+        return false;
+    }
+    std::string sig = imageSignature();
+    uint32_t sig_len = static_cast<uint32_t>(sig.size());
+    fout.write("SNNDLIMG", 8);
+    fout.write(reinterpret_cast<const char*>(&sig_len), sizeof(sig_len));
+    fout.write(sig.data(), sig_len);
+    for (const auto& image : core_images_) {
+        uint64_t size = image.size();
+        fout.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        fout.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(size));
+    }
+    if (!fout.good()) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 写出内存映像缓存 %s 失败\n", path.c_str());
+        return false;
+    }
+    return true;
 }
 
 void WeightLoader::issueWritesFill(float value) {
     if (!memory_) return;
     const uint32_t N = neurons_per_core_;
-    std::vector<uint8_t> data(sizeof(float));
-    std::memcpy(data.data(), &value, sizeof(float));
+    const size_t count = static_cast<size_t>(N) * static_cast<size_t>(N);
+
+    // 各核心内容相同，只构造一次内存映像
+    std::vector<float> values(count, value);
+    std::vector<uint8_t> image;
+    uint64_t saturated = 0;
+    if (sparse_layout_) {
+        SparseWeightLayout::fromDense(values.data(), N, N, image, weight_precision_, &saturated);
+    } else {
+        saturated = weight_precision_.encodeArray(values.data(), count, image);
+    }
+    saturated_weights_ += saturated * static_cast<uint64_t>(num_cores_);
 
     uint64_t total_writes = 0;
     for (int core = 0; core < num_cores_; ++core) {
         uint64_t base = base_addr_start_ + static_cast<uint64_t>(core) * per_core_stride_;
-        for (uint32_t pre = 0; pre < N; ++pre) {
-            for (uint32_t post = 0; post < N; ++post) {
-                uint64_t offset = static_cast<uint64_t>(pre) * N + post;
-                uint64_t addr = base + offset * sizeof(float);
-                auto* w = new SST::Interfaces::StandardMem::Write(addr, data.size(), data, /*posted*/true);
-                memory_->sendUntimedData(w);
-                total_writes++;
-            }
-        }
+        total_writes += issueChunkedWrites(base, image, true);
         output_->verbose(CALL_INFO, 2, 0, "   核心%d: base=%" PRIu64 " 写入 %u x %u\n", core, base, N, N);
     }
     output_->verbose(CALL_INFO, 1, 0, "✅ WeightLoader发出写请求数=%" PRIu64 "\n", total_writes);
 }
 
+void WeightLoader::buildCoreImage(const std::vector<float>& wbuf, int core, std::vector<uint8_t>& image) {
+    const uint32_t N = neurons_per_core_;
+    const size_t expected = static_cast<size_t>(N) * static_cast<size_t>(N);
+    if (validate_length_ && wbuf.size() < expected) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 核心%d权重长度不足(%zu<%zu)，用fill_value补齐\n", core, wbuf.size(), expected);
+    }
+
+    // 内存中统一为行优先 [pre][post]；列优先文件在此一次性转置
+    std::vector<float> rows(expected, fill_value_);
+    if (row_major_) {
+        std::copy(wbuf.begin(), wbuf.begin() + std::min(wbuf.size(), expected), rows.begin());
+    } else {
+        // 文件元素 k 对应 (post = k / N, pre = k % N)；按块遍历以保持读写局部性
+        const uint32_t B = 32;
+        for (uint32_t post0 = 0; post0 < N; post0 += B) {
+            for (uint32_t pre0 = 0; pre0 < N; pre0 += B) {
+                uint32_t post_end = std::min(N, post0 + B);
+                uint32_t pre_end = std::min(N, pre0 + B);
+                for (uint32_t post = post0; post < post_end; ++post) {
+                    size_t col = static_cast<size_t>(post) * N;
+                    for (uint32_t pre = pre0; pre < pre_end; ++pre) {
+                        size_t k = col + pre;
+                        if (k < wbuf.size()) rows[static_cast<size_t>(pre) * N + post] = wbuf[k];
+                    }
+                }
+            }
+        }
+    }
+
+    if (sparse_layout_) {
+        uint64_t saturated = 0;
+        uint64_t nnz = SparseWeightLayout::fromDense(rows.data(), N, N, image, weight_precision_, &saturated);
+        saturated_weights_ += saturated;
+        output_->verbose(CALL_INFO, 2, 0, "   核心%d稀疏布局: 突触=%" PRIu64 ", 映像=%zu字节(稠密%zu)\n",
+                         core, nnz, image.size(), expected * weight_precision_.bytes());
+        return;
+    }
+    saturated_weights_ += weight_precision_.encodeArray(rows.data(), expected, image);
+}
+
+bool WeightLoader::buildCsrCoreSparseImage(const std::string& path, int file_core, std::vector<uint8_t>& image) {
+    std::string error;
+    std::shared_ptr<const CsrWeightStore> store = CsrWeightStore::open(path, error);
+    if (!store) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 无法映射CSR权重文件 %s: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+    // 直接由文件的行区间生成稀疏映像，不展开为 N×N；只保留核内突触
+    const uint32_t N = neurons_per_core_;
+    const uint64_t core_base = static_cast<uint64_t>(std::max(0, file_core)) * N;
+    CsrView rows = store->globalRows(core_base, N);
+    SparseWeightLayout::Builder builder(N, weight_precision_);
+    for (uint32_t pre = 0; pre < rows.rows; ++pre) {
+        for (uint64_t i = rows.rowBegin(pre); i < rows.rowEnd(pre); ++i) {
+            uint64_t post = rows.col[i];
+            if (post < core_base || post >= core_base + N || weight_precision_.snap(rows.weight[i]) == 0.0f) continue;
+            builder.add(static_cast<uint32_t>(post - core_base), rows.weight[i]);
+        }
+        builder.endRow();
+    }
+    builder.serialize(image);
+    saturated_weights_ += builder.saturated();
+    output_->verbose(CALL_INFO, 2, 0, "   核心%d稀疏布局(CSR): 突触=%" PRIu64 ", 映像=%zu字节\n",
+                     file_core, builder.nnz(), image.size());
+    return true;
+}
+
+void WeightLoader::issueCoreImage(int core, const std::vector<uint8_t>& image, bool untimed) {
+    if (!memory_) return;
+    const uint64_t base = base_addr_start_ + static_cast<uint64_t>(core) * per_core_stride_;
+    uint64_t writes = issueChunkedWrites(base, image, untimed);
+    output_->verbose(CALL_INFO, 2, 0, "   核心%d: base=%" PRIu64 " 写请求数=%" PRIu64 "\n", core, base, writes);
+}
+
+uint64_t WeightLoader::issueChunkedWrites(uint64_t base, const std::vector<uint8_t>& image, bool untimed) {
+    // chunk_size_bytes 为0时每行一次写入；否则按地址对齐切块，首块补齐到边界
+    const uint64_t chunk = chunk_size_bytes_ > 0
+        ? chunk_size_bytes_
+        : static_cast<uint64_t>(neurons_per_core_) * weight_precision_.bytes();
+    if (chunk == 0) return 0;
+
+    uint64_t writes = 0;
+    uint64_t pos = 0;
+    const uint64_t total = image.size();
+    while (pos < total) {
+        uint64_t addr = base + pos;
+        uint64_t len = chunk - (addr % chunk);
+        if (len > total - pos) len = total - pos;
+
+        std::vector<uint8_t> data(image.begin() + pos, image.begin() + pos + len);
+        if (untimed) {
+            auto* w = new SST::Interfaces::StandardMem::Write(addr, len, data, /*posted*/true);
+            memory_->sendUntimedData(w);
+        } else {
+            // 使用非posted写入，以便跟踪全部写入完成
+            auto* w = new SST::Interfaces::StandardMem::Write(addr, len, data, false);
+            memory_->send(w);
+            pending_writes_++;
+        }
+        writes++;
+        pos += len;
+    }
+    return writes;
+}
+
 bool WeightLoader::readFileAllFloats(const std::string& path, const std::string& fmt, std::vector<float>& out) {
     out.clear();
     if (fmt == "bin") {
@@ -174,33 +430,51 @@ bool WeightLoader::readFileAllFloats(const std::string& path, const std::string&
     }
 }
 
-void WeightLoader::issueWritesForCoreFloats(int core, const std::vector<float>& wbuf) {
-    if (!memory_) return;
-    const uint32_t N = neurons_per_core_;
-    const uint64_t base = base_addr_start_ + static_cast<uint64_t>(core) * per_core_stride_;
-    const size_t expected = static_cast<size_t>(N) * static_cast<size_t>(N);
-    if (validate_length_ && wbuf.size() < expected) {
-        output_->verbose(CALL_INFO, 1, 0, "⚠️ 核心%d权重长度不足(%zu<%zu)，用fill_value补齐\n", core, wbuf.size(), expected);
+bool WeightLoader::isCsrInput(const std::string& path, const std::string& fmt) const {
+    return fmt == "csr" || (fmt == "bin" && CsrWeightStore::isCsrFile(path));
+}
+
+bool WeightLoader::readCsrCoreFloats(const std::string& path, int file_core, std::vector<float>& out) {
+    out.clear();
+    std::string error;
+    std::shared_ptr<const CsrWeightStore> store = CsrWeightStore::open(path, error);
+    if (!store) {
+        output_->verbose(CALL_INFO, 1, 0, "⚠️ 无法映射CSR权重文件 %s: %s\n", path.c_str(), error.c_str());
+        return false;
     }
-    // 逐元素写（后续可做chunk聚合）
-    size_t idx = 0;
-    for (uint32_t pre = 0; pre < N; ++pre) {
-        for (uint32_t post = 0; post < N; ++post) {
-            float val;
-            if (idx < wbuf.size()) val = row_major_ ? wbuf[idx] : wbuf[pre + static_cast<size_t>(post) * N];
-            else val = fill_value_;
-            std::vector<uint8_t> data(sizeof(float));
-            std::memcpy(data.data(), &val, sizeof(float));
-            uint64_t offset = static_cast<uint64_t>(pre) * N + post;
-            uint64_t addr = base + offset * sizeof(float);
-            auto* w = new SST::Interfaces::StandardMem::Write(addr, data.size(), data, /*posted*/true);
-            memory_->sendUntimedData(w);
-            idx++;
+    // 内存中的每核矩阵只包含核内突触：行 = 本核心突触前，列 = 本核心突触后
+    const uint32_t N = neurons_per_core_;
+    const uint64_t core_base = static_cast<uint64_t>(std::max(0, file_core)) * N;
+    CsrView rows = store->globalRows(core_base, N);
+    out.assign(static_cast<size_t>(N) * N, 0.0f);
+    for (uint32_t pre = 0; pre < rows.rows; ++pre) {
+        for (uint64_t i = rows.rowBegin(pre); i < rows.rowEnd(pre); ++i) {
+            uint64_t post = rows.col[i];
+            if (post < core_base || post >= core_base + N) continue;
+            uint32_t post_local = static_cast<uint32_t>(post - core_base);
+            size_t k = row_major_ ? static_cast<size_t>(pre) * N + post_local
+                                  : static_cast<size_t>(post_local) * N + pre;
+            out[k] = rows.weight[i];
         }
     }
+    return true;
 }
 
 bool WeightLoader::loadSingleFileAllCores(const std::string& path, const std::string& fmt) {
+    if (isCsrInput(path, fmt)) {
+        // CSR文件共享映射，每个核心只展开自己的行区间
+        for (int core = 0; core < num_cores_; ++core) {
+            if (sparse_layout_) {
+                if (!buildCsrCoreSparseImage(path, file_core_offset_ + core, core_images_[core])) return false;
+                continue;
+            }
+            std::vector<float> slice;
+            if (!readCsrCoreFloats(path, file_core_offset_ + core, slice)) return false;
+            buildCoreImage(slice, core, core_images_[core]);
+        }
+        output_->verbose(CALL_INFO, 1, 0, "✅ CSR单文件加载完成: %s\n", path.c_str());
+        return true;
+    }
     std::vector<float> all;
     if (!readFileAllFloats(path, fmt, all)) return false;
     const uint32_t N = neurons_per_core_;
@@ -214,7 +488,7 @@ bool WeightLoader::loadSingleFileAllCores(const std::string& path, const std::st
         } else {
             slice.assign(all.begin() + offset, all.end());
         }
-        issueWritesForCoreFloats(core, slice);
+        buildCoreImage(slice, core, core_images_[core]);
         offset += per_core;
     }
     output_->verbose(CALL_INFO, 1, 0, "✅ 单文件加载完成: %s\n", path.c_str());
@@ -225,119 +499,45 @@ bool WeightLoader::loadPerCoreFiles(const std::string& tmpl, const std::string&
     const uint32_t N = neurons_per_core_;
     const size_t per_core = static_cast<size_t>(N) * static_cast<size_t>(N);
     for (int core = 0; core < num_cores_; ++core) {
-        // 支持多种模板格式：{core}、{core:02d}等
-        std::string path = tmpl;
-        
-        // 处理 {core:02d} 格式
-        size_t pos = path.find("{core:02d}");
-        if (pos != std::string::npos) {
-            char formatted[16];
-            std::snprintf(formatted, sizeof(formatted), "%02d", core);
-            path.replace(pos, 10, formatted);
-        } else {
-            // 处理简单的 {core} 格式
-            pos = path.find("{core}");
-            if (pos != std::string::npos) {
-                path.replace(pos, 6, std::to_string(core));
-            }
+        std::string path = perCorePath(tmpl, core);
+        if (sparse_layout_ && isCsrInput(path, fmt) &&
+            buildCsrCoreSparseImage(path, file_core_offset_ + core, core_images_[core])) {
+            continue;
         }
         std::vector<float> buf;
-        if (!readFileAllFloats(path, fmt, buf)) {
+        bool ok = isCsrInput(path, fmt) ? readCsrCoreFloats(path, file_core_offset_ + core, buf)
+                                        : readFileAllFloats(path, fmt, buf);
+        if (!ok) {
             output_->verbose(CALL_INFO, 1, 0, "⚠️ 未找到核心%d文件 %s ，使用fill_value填充\n", core, path.c_str());
             buf.clear();
         }
         if (validate_length_ && buf.size() < per_core) {
             output_->verbose(CALL_INFO, 2, 0, "   核心%d文件长度不足(%zu<%zu)，补齐\n", core, buf.size(), per_core);
         }
-        issueWritesForCoreFloats(core, buf);
+        buildCoreImage(buf, core, core_images_[core]);
     }
     output_->verbose(CALL_INFO, 1, 0, "✅ 按核心分文件加载完成: 模板 %s\n", tmpl.c_str());
     return true;
 }
 
 void WeightLoader::loadFileOnceRuntime() {
-    // 运行时版本的loadFileOnce，使用时钟驱动的内存写入
-    bool ok = false;
-    if (!single_file_.empty()) {
-        ok = loadSingleFileAllCores(single_file_, weight_format_);
-    } else if (per_core_files_ && !file_template_.empty()) {
-        ok = loadPerCoreFilesRuntime(file_template_, weight_format_);
-    } else if (!weight_file_.empty()) {
-        ok = loadSingleFileAllCores(weight_file_, weight_format_);
-    }
-    if (!ok) {
+    // 运行时重发init阶段已构造的映像，不再重新解析权重文件；
+    // 按核心分文件时使用带时序的写入（可跟踪完成），单文件沿用untimed写入
+    if (!runtime_reload_) {
+        output_->verbose(CALL_INFO, 2, 0, "   runtime_reload=0，沿用init阶段写入的内存映像\n");
+    } else if (!images_from_source_) {
         output_->verbose(CALL_INFO, 1, 0, "⚠️ 运行时未找到权重文件，跳过加载\n");
-    }
-    loaded_ = true;
-}
-
-bool WeightLoader::loadPerCoreFilesRuntime(const std::string& tmpl, const std::string& fmt) {
-    const uint32_t N = neurons_per_core_;
-    const size_t per_core = static_cast<size_t>(N) * static_cast<size_t>(N);
-    for (int core = 0; core < num_cores_; ++core) {
-        std::string path = tmpl;
-        
-        size_t pos = path.find("{core:02d}");
-        if (pos != std::string::npos) {
-            char formatted[16];
-            std::snprintf(formatted, sizeof(formatted), "%02d", core);
-            path.replace(pos, 10, formatted);
-        } else {
-            pos = path.find("{core}");
-            if (pos != std::string::npos) {
-                path.replace(pos, 6, std::to_string(core));
-            }
-        }
-        
-        std::vector<float> buf;
-        if (!readFileAllFloats(path, fmt, buf)) {
-            output_->verbose(CALL_INFO, 1, 0, "⚠️ 运行时未找到核心%d文件 %s\n", core, path.c_str());
-            buf.clear();
-        }
-        if (validate_length_ && buf.size() < per_core) {
-            output_->verbose(CALL_INFO, 2, 0, "   运行时核心%d文件长度不足(%zu<%zu)\n", core, buf.size(), per_core);
+    } else {
+        const bool timed = single_file_.empty() && per_core_files_ && !file_template_.empty();
+        for (int core = 0; core < num_cores_; ++core) {
+            issueCoreImage(core, core_images_[core], !timed);
         }
-        issueWritesForCoreFloatsRuntime(core, buf);
-    }
-    output_->verbose(CALL_INFO, 1, 0, "✅ 运行时按核心分文件加载完成: 模板 %s\n", tmpl.c_str());
-    return true;
-}
-
-void WeightLoader::issueWritesForCoreFloatsRuntime(int core, const std::vector<float>& wbuf) {
-    if (!memory_) return;
-    const uint32_t N = neurons_per_core_;
-    const uint64_t base = base_addr_start_ + static_cast<uint64_t>(core) * per_core_stride_;
-    const size_t expected = static_cast<size_t>(N) * static_cast<size_t>(N);
-    
-    if (validate_length_ && wbuf.size() < expected) {
-        output_->verbose(CALL_INFO, 1, 0, "⚠️ 运行时核心%d权重长度不足(%zu<%zu)，用fill_value补齐\n", core, wbuf.size(), expected);
-    }
-    
-    // 使用时钟驱动的写入而不是sendUntimedData
-    size_t idx = 0;
-    for (uint32_t pre = 0; pre < N; ++pre) {
-        for (uint32_t post = 0; post < N; ++post) {
-            float val;
-            if (idx < wbuf.size()) val = row_major_ ? wbuf[idx] : wbuf[pre + static_cast<size_t>(post) * N];
-            else val = fill_value_;
-            
-            std::vector<uint8_t> data(sizeof(float));
-            std::memcpy(data.data(), &val, sizeof(float));
-            uint64_t offset = static_cast<uint64_t>(pre) * N + post;
-            uint64_t addr = base + offset * sizeof(float);
-            
-            // 使用非posted写入确保立即完成
-            auto* w = new SST::Interfaces::StandardMem::Write(addr, data.size(), data, false); // posted=false
-            memory_->send(w);
-            pending_writes_++;  // 增加待处理写入计数
-            
-            /*
-            output_->verbose(CALL_INFO, 2, 0, "💾 运行时写入: core=%d pre=%u post=%u addr=0x%lx val=%.6f pending=%u\n", 
-                            core, pre, post, addr, val, pending_writes_);
-            */
-            idx++;
+        output_->verbose(CALL_INFO, 1, 0, "✅ 运行时重发%d个核心的内存映像%s\n", num_cores_,
+                         timed ? "（带时序写入）" : "");
+        if (timed) {
+            output_->verbose(CALL_INFO, 2, 0, "   待完成写请求=%u\n", pending_writes_);
         }
     }
-    // output_->verbose(CALL_INFO, 2, 0, "✅ 运行时核心%d权重写入完成: %u x %u\n", core, N, N);
+    std::vector<std::vector<uint8_t>>().swap(core_images_);
+    loaded_ = true;
 }
-
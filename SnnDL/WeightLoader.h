@@ -10,6 +10,8 @@
 #include <sst/core/output.h>
 #include <sst/core/interfaces/stdMem.h>
 
+#include "FixedPoint.h"
+
 namespace SST {
 namespace SnnDL {
 
@@ -32,13 +34,18 @@ public:
         {"num_cores", "核心数", "1"},
         {"neurons_per_core", "每核神经元数(形成 NxN 权重矩阵)", "64"},
         {"fill_value", "当无文件可用时使用的填充值(float)", "0.5"},
-        {"weight_format", "权重文件格式: bin/csv", "bin"},
+        {"weight_format", "权重文件格式: bin/csv/csr (bin文件以SNNDLCSR开头时按csr处理，进程内共享映射)", "bin"},
         {"per_core_files", "是否按核心分文件(1=是,0=否)", "0"},
         {"file_template", "按核心分文件时的模板, 例如 weights_core{core}.bin", ""},
         {"single_file", "单文件路径(覆盖weight_file)", ""},
         {"row_major", "文件是否按行优先(1=是,0=否=列优先)", "1"},
-        {"chunk_size_bytes", "每次写入的字节块大小(建议与cacheline一致)", "64"},
-        {"validate_length", "是否校验文件长度与期望匹配", "1"}
+        {"chunk_size_bytes", "每次写入的字节块大小(建议与cacheline一致，按地址对齐切分；0=每行一次写入)", "64"},
+        {"validate_length", "是否校验文件长度与期望匹配", "1"},
+        {"weight_layout", "内存中的权重布局: dense(float[N][N]) / csr(row_ptr + 紧凑{post,weight}条目，零权重不写入，见SparseWeightLayout.h)，须与核心的weight_layout一致", "dense"},
+        {"weight_precision", "内存中的权重精度: float32 / int16 / int8(就近舍入、饱和，见FixedPoint.h)，须与核心的weight_precision一致", "float32"},
+        {"weight_scale", "定点权重一个码字对应的数值(lsb)，建议取2的幂", "0.015625"},
+        {"image_file", "编码后内存映像的缓存文件：存在且与当前配置及权重文件（大小、修改时间）一致时直接读回，不再解析权重文件；否则解析后写出", ""},
+        {"runtime_reload", "首个时钟周期是否用带时序的写入重发一次内存映像(1=是,0=否)；映像已由init阶段的untimed写入就位时可关闭", "1"}
     )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -57,12 +64,20 @@ private:
     void loadFileOnce();
     void loadFileOnceRuntime();
     void issueWritesFill(float value);
-    void issueWritesForCoreFloats(int core, const std::vector<float>& wbuf);
-    void issueWritesForCoreFloatsRuntime(int core, const std::vector<float>& wbuf);
+    bool buildCoreImages();
+    std::string imageSignature() const;
+    static std::string perCorePath(const std::string& tmpl, int core);
+    bool readImageFile(const std::string& path);
+    bool writeImageFile(const std::string& path) const;
+    void buildCoreImage(const std::vector<float>& wbuf, int core, std::vector<uint8_t>& image);
+    bool buildCsrCoreSparseImage(const std::string& path, int file_core, std::vector<uint8_t>& image);
+    void issueCoreImage(int core, const std::vector<uint8_t>& image, bool untimed);
+    uint64_t issueChunkedWrites(uint64_t base, const std::vector<uint8_t>& image, bool untimed);
     bool readFileAllFloats(const std::string& path, const std::string& fmt, std::vector<float>& out);
+    bool isCsrInput(const std::string& path, const std::string& fmt) const;
+    bool readCsrCoreFloats(const std::string& path, int file_core, std::vector<float>& out);
     bool loadSingleFileAllCores(const std::string& path, const std::string& fmt);
     bool loadPerCoreFiles(const std::string& tmpl, const std::string& fmt);
-    bool loadPerCoreFilesRuntime(const std::string& tmpl, const std::string& fmt);
 
     SST::Output* output_;
     SST::Interfaces::StandardMem* memory_;
@@ -81,7 +96,14 @@ private:
     bool row_major_;
     uint32_t chunk_size_bytes_;
     bool validate_length_;
+    bool sparse_layout_ = false;
+    FixedPointFormat weight_precision_;   // 内存映像中的权重编码
+    uint64_t saturated_weights_ = 0;      // 量化时被饱和截断的权重个数
     int file_core_offset_ = 0; // 读取单文件时偏移的核心数
+    std::string image_file_;
+    bool runtime_reload_ = true;
+    std::vector<std::vector<uint8_t>> core_images_;  // 各核心编码后的内存映像，运行时重发后释放
+    bool images_from_source_ = false;                // 映像来自权重文件或缓存（而非fill_value回退）
 
     // Timed seed writes to ensure visibility in timed simulation
     bool timed_seed_enable_ = true;
@@ -41,6 +41,37 @@ AC_DEFUN([SST_SnnDL_CONFIG], [
   dnl Set conditional for HDF5 support in Makefiles
   AM_CONDITIONAL([HAVE_HDF5], [test "x$HDF5_LIBS" != "x"])
   
+  dnl Optional SIMD build of the neuron update kernels (NeuronStateArray.cc only)
+  AC_ARG_ENABLE([snndl-simd],
+    [AS_HELP_STRING([--enable-snndl-simd=@<:@no|avx2|avx512@:>@],
+      [Compile the SnnDL neuron update kernels with AVX2 or AVX-512F @<:@default=no@:>@])],
+    [enable_snndl_simd=$enableval],
+    [enable_snndl_simd=no])
+
+  SNNDL_SIMD_CXXFLAGS=""
+  AS_CASE([$enable_snndl_simd],
+    [no], [],
+    [yes|avx2], [SNNDL_SIMD_CXXFLAGS="-mavx2"],
+    [avx512], [SNNDL_SIMD_CXXFLAGS="-mavx512f"],
+    [AC_MSG_ERROR([unknown --enable-snndl-simd value: $enable_snndl_simd (expected no|avx2|avx512)])])
+
+  dnl Make sure the compiler accepts the flag before using it
+  AS_IF([test "x$SNNDL_SIMD_CXXFLAGS" != "x"], [
+    AC_LANG_PUSH([C++])
+    snndl_save_CXXFLAGS="$CXXFLAGS"
+    CXXFLAGS="$CXXFLAGS $SNNDL_SIMD_CXXFLAGS"
+    AC_MSG_CHECKING([whether $CXX accepts $SNNDL_SIMD_CXXFLAGS])
+    AC_COMPILE_IFELSE([AC_LANG_PROGRAM([[#include <immintrin.h>]], [[]])],
+      [AC_MSG_RESULT([yes])],
+      [AC_MSG_RESULT([no])
+       AC_MSG_ERROR([$CXX does not support $SNNDL_SIMD_CXXFLAGS])])
+    CXXFLAGS="$snndl_save_CXXFLAGS"
+    AC_LANG_POP([C++])
+    AC_MSG_NOTICE([SnnDL SIMD neuron kernels enabled: $SNNDL_SIMD_CXXFLAGS])
+  ])
+
+  AC_SUBST([SNNDL_SIMD_CXXFLAGS])
+
   dnl Execute success/failure actions
   AS_IF([test "$sst_check_SnnDL" = "yes"], [$1], [$2])
 ])
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""
+SnnDL 基准测试的 SST 配置脚本（由 run_benchmarks.py 调用，也可单独运行）。
+
+参数通过环境变量 SNNDL_BENCH_CONFIG 指向的JSON给出：
+  workload     : snndl_workload.py 生成的 workload.json
+  sim_time_us  : 仿真时长（默认为输入跨度 + 100us）
+  stats_file   : 统计输出CSV路径
+  weights      : event  - 权重随脉冲事件携带（核心按 connectivity_file 扇出，不建模权重内存）
+                 memory - 与 test_corrected_4x4.py 相同：WeightLoader写入全局内存，
+                          每个核心经L1/内存控制器按需读取权重
+  pe_params    : 额外传给每个 MultiCorePE 的参数（覆盖默认值）
+
+单独运行：
+  SNNDL_BENCH_CONFIG=bench.json sst bench_snndl.py
+"""
+
+import json
+import os
+
+import sst
+
+with open(os.environ["SNNDL_BENCH_CONFIG"]) as f:
+    bench = json.load(f)
+with open(bench["workload"]) as f:
+    workload = json.load(f)
+
+cfg = workload["config"]
+MESH_SIZE = cfg["mesh"]
+NUM_CORES_PER_PE = cfg["cores_per_node"]
+NEURONS_PER_CORE = cfg["neurons_per_core"]
+NEURONS_PER_PE = NUM_CORES_PER_PE * NEURONS_PER_CORE
+TOTAL_NODES = MESH_SIZE * MESH_SIZE
+TOTAL_NEURONS = workload["total_neurons"]
+SIM_TIME_US = bench.get("sim_time_us", cfg["duration_us"] + 100)
+WEIGHTS = bench.get("weights", "event")
+VERBOSE = bench.get("verbose", 0)
+
+NETWORK_BANDWIDTH = "40GiB/s"
+BUFFER_SIZE = "8KiB"
+MESH_LINK_LATENCY = bench.get("mesh_link_latency", "5ns")
+BASE_WEIGHT_ADDR = 0x10000000
+
+if WEIGHTS not in ("event", "memory"):
+    raise ValueError(f"未知的weights模式: {WEIGHTS} (可选 event|memory)")
+
+# === 全局内存与WeightLoader（memory模式）===
+if WEIGHTS == "memory":
+    global_memory_controller = sst.Component("global_memory_controller", "memHierarchy.MemController")
+    global_memory_controller.addParams({
+        "clock": "1GHz",
+        "backing": "malloc",
+        "backend": "memHierarchy.simpleMem",
+        "backend.access_time": "100ns",
+        "backend.mem_size": "4GiB",
+        "addr_range_start": "0",
+        "addr_range_end": str(4 * 1024 ** 3 - 1),
+    })
+    weight_loader = sst.Component("weight_loader", "SnnDL.WeightLoader")
+    weight_loader.addParams({
+        "verbose": VERBOSE,
+        "base_addr_start": BASE_WEIGHT_ADDR,
+        "per_core_stride": NEURONS_PER_CORE * NEURONS_PER_CORE * 4,
+        "num_cores": TOTAL_NODES * NUM_CORES_PER_PE,
+        "neurons_per_core": NEURONS_PER_CORE,
+        "weight_format": "csr",
+        "single_file": workload["connectivity_file"],
+        "fill_value": 0.0,
+    })
+    weight_loader_mem = weight_loader.setSubComponent("memory", "memHierarchy.standardInterface")
+    weight_loader_mem.addParams({"port": "lowlink"})
+    sst.Link("weight_loader_to_global_mem").connect(
+        (weight_loader_mem, "lowlink", "5ns"),
+        (global_memory_controller, "highlink", "5ns"))
+
+# === 路由器 ===
+routers = []
+for i in range(TOTAL_NODES):
+    router = sst.Component(f"router_{i}", "merlin.hr_router")
+    router.addParams({
+        "id": i,
+        "num_ports": 5,
+        "link_bw": NETWORK_BANDWIDTH,
+        "flit_size": "8B",
+        "xbar_bw": NETWORK_BANDWIDTH,
+        "input_latency": "10ns",
+        "output_latency": "10ns",
+        "input_buf_size": "4KiB",
+        "output_buf_size": "4KiB",
+        "num_vns": 1,
+        "xbar_arb": "merlin.xbar_arb_lru",
+    })
+    topo = router.setSubComponent("topology", "merlin.mesh")
+    topo.addParams({
+        "shape": f"{MESH_SIZE}x{MESH_SIZE}",
+        "width": "1x1",
+        "local_ports": "1",
+    })
+    routers.append(router)
+
+# === PE节点 ===
+nodes = []
+for i in range(TOTAL_NODES):
+    node = sst.Component(f"multicore_pe_{i}", "SnnDL.MultiCorePE")
+    node_params = {
+        "verbose": VERBOSE,
+        "num_cores": NUM_CORES_PER_PE,
+        "neurons_per_core": NEURONS_PER_CORE,
+        "total_neurons": TOTAL_NEURONS,
+        "node_id": i,
+        "global_neuron_base": i * NEURONS_PER_PE,
+        "connectivity_file": workload["connectivity_file"],
+        "use_event_weight_fallback": 1,
+        "v_thresh": 1.0,
+        "v_rest": 0.0,
+        "v_reset": 0.0,
+    }
+    if WEIGHTS == "memory":
+        node_params.update({
+            "write_weights_on_init": 1,
+            "enable_weight_fetch": 1,
+            "base_addr": BASE_WEIGHT_ADDR + i * NUM_CORES_PER_PE * NEURONS_PER_CORE * NEURONS_PER_CORE * 4,
+        })
+    node_params.update(bench.get("pe_params", {}))
+    node.addParams(node_params)
+
+    nic = node.setSubComponent("network_interface", "SnnDL.SnnNIC")
+    nic.addParams({
+        "node_id": str(i),
+        "link_bw": NETWORK_BANDWIDTH,
+        "input_buf_size": BUFFER_SIZE,
+        "output_buf_size": BUFFER_SIZE,
+        "use_direct_link": "false",
+        "port_name": "network",
+        "verbose": VERBOSE,
+        "total_nodes": TOTAL_NODES,
+    })
+    sst.Link(f"nic_{i}_to_router_{i}").connect(
+        (nic, "network", "5ns"),
+        (routers[i], "port4", "5ns"))
+
+    if WEIGHTS == "memory":
+        for core_idx in range(NUM_CORES_PER_PE):
+            mem_ctrl = sst.Component(f"pe_{i}_core{core_idx}_mem_ctrl", "memHierarchy.MemController")
+            mem_ctrl.addParams({
+                "clock": "2GHz",
+                "backing": "malloc",
+                "backend": "memHierarchy.simpleMem",
+                "backend.access_time": "30ns",
+                "backend.mem_size": "1GiB",
+                "addr_range_start": "0",
+                "addr_range_end": str(1024 ** 3 - 1),
+            })
+            l1_cache = sst.Component(f"pe_{i}_core{core_idx}_l1", "memHierarchy.Cache")
+            l1_cache.addParams({
+                "cache_frequency": "2GHz",
+                "cache_size": "4KiB",
+                "associativity": "4",
+                "cache_line_size": "64",
+                "access_latency_cycles": "2",
+                "L1": "1",
+                "coherence_protocol": "none",
+            })
+            sst.Link(f"pe_{i}_core{core_idx}_mem").connect(
+                (node, f"core{core_idx}_mem", "1ns"),
+                (l1_cache, "highlink", "1ns"))
+            sst.Link(f"pe_{i}_core{core_idx}_l1_to_mem").connect(
+                (l1_cache, "lowlink", "5ns"),
+                (mem_ctrl, "highlink", "5ns"))
+    nodes.append(node)
+
+# === 输入脉冲源 ===
+for i in range(TOTAL_NODES):
+    source = sst.Component(f"spike_source_{i}", "SnnDL.SpikeSource")
+    source.addParams({
+        "verbose": VERBOSE,
+        "dataset_path": workload["input_files"][i],
+        "dataset_format": "BINARY",
+        "neurons_per_core": NEURONS_PER_CORE,
+        "cores_per_node": NUM_CORES_PER_PE,
+    })
+    sst.Link(f"spike_source_{i}_to_pe_{i}").connect(
+        (source, "spike_output", "5ns"),
+        (nodes[i], "external_spike_input", "5ns"))
+
+# === mesh连接 ===
+for y in range(MESH_SIZE):
+    for x in range(MESH_SIZE - 1):
+        node_id = y * MESH_SIZE + x
+        sst.Link(f"router_east_{node_id}_to_{node_id + 1}").connect(
+            (routers[node_id], "port0", MESH_LINK_LATENCY),
+            (routers[node_id + 1], "port1", MESH_LINK_LATENCY))
+for x in range(MESH_SIZE):
+    for y in range(MESH_SIZE - 1):
+        node_id = y * MESH_SIZE + x
+        sst.Link(f"router_south_{node_id}_to_{node_id + MESH_SIZE}").connect(
+            (routers[node_id], "port2", MESH_LINK_LATENCY),
+            (routers[node_id + MESH_SIZE], "port3", MESH_LINK_LATENCY))
+
+# === 统计：run_benchmarks.py 由这些计数计算吞吐 ===
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputCSV", {
+    "filepath": bench.get("stats_file", "bench_stats.csv"),
+    "separator": ",",
+})
+sst.enableStatisticsForComponentType("SnnDL.MultiCorePE", [
+    "total_spikes_processed",
+    "total_neurons_fired",
+    "inter_core_messages",
+    "external_spikes_sent",
+    "external_spikes_received",
+])
+sst.enableStatisticsForComponentType("SnnDL.SpikeSource", ["events_sent"])
+
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stop-at", f"{SIM_TIME_US}us")
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+将 4x4_weights_node_*.bin 等已有权重文件转换为 SnnDL 版本化CSR格式（SNNDLCSR v1）。
+
+输入格式：
+  dense   : float32[本节点神经元][突触后全局ID] 行优先（test_corrected_4x4.py 生成），零权重视为无连接
+  records : uint32 总连接数 + uint32 本地连接数 + N × {uint32 pre, uint32 post, float w}
+
+输出文件可直接作为 SnnPESubComponent 的 connectivity_file、SnnPE 的 weights_file
+或 WeightLoader 的 single_file/file_template（weight_format=csr）。
+多个输入会按节点顺序合并为一个文件，行号 = 突触前全局ID - row_base。
+
+用法示例：
+  python3 convert_weights_csr.py --format dense --rows-per-file 16 \\
+      --output datasets/4x4_weights.csr datasets/4x4_weights_node_{0..15}.bin
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"SNNDLCSR"
+VERSION = 1
+HEADER_BYTES = 80
+
+
+def align8(v):
+    return (v + 7) & ~7
+
+
+def read_dense(path, row_base, rows_per_file):
+    with open(path, "rb") as f:
+        data = f.read()
+    count = len(data) // 4
+    if len(data) % 4 != 0 or count % rows_per_file != 0:
+        raise ValueError(f"{path}: 大小({len(data)}B)不是{rows_per_file}行float32的整数倍")
+    width = count // rows_per_file
+    values = struct.unpack(f"<{count}f", data)
+    synapses = []
+    for pre in range(rows_per_file):
+        row = values[pre * width:(pre + 1) * width]
+        for post, w in enumerate(row):
+            if w != 0.0:
+                synapses.append((row_base + pre, post, w))
+    return synapses, width
+
+
+def read_records(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    total, _local = struct.unpack_from("<II", data, 0)
+    if len(data) != 8 + total * 12:
+        raise ValueError(f"{path}: 长度与记录数{total}不符")
+    synapses = [struct.unpack_from("<IIf", data, 8 + i * 12) for i in range(total)]
+    width = max((s[1] for s in synapses), default=-1) + 1
+    return synapses, width
+
+
+def write_csr(path, synapses, row_base, num_rows, num_cols):
+    synapses.sort(key=lambda s: (s[0], s[1]))
+    row_ptr = [0] * (num_rows + 1)
+    cols = []
+    weights = []
+    for pre, post, w in synapses:
+        if pre < row_base or pre >= row_base + num_rows:
+            continue
+        row_ptr[pre - row_base + 1] += 1
+        cols.append(post)
+        weights.append(w)
+    for r in range(num_rows):
+        row_ptr[r + 1] += row_ptr[r]
+
+    nnz = len(cols)
+    row_ptr_off = HEADER_BYTES
+    col_off = align8(row_ptr_off + (num_rows + 1) * 8)
+    weight_off = align8(col_off + nnz * 4)
+    total = align8(weight_off + nnz * 4)
+
+    header = MAGIC + struct.pack("<II", VERSION, HEADER_BYTES)
+    header += struct.pack("<7Q", num_rows, num_cols, nnz, row_base, row_ptr_off, col_off, weight_off)
+    header = header.ljust(HEADER_BYTES, b"\0")
+
+    out = bytearray(total)
+    out[0:HEADER_BYTES] = header
+    struct.pack_into(f"<{num_rows + 1}Q", out, row_ptr_off, *row_ptr)
+    if nnz:
+        struct.pack_into(f"<{nnz}I", out, col_off, *cols)
+        struct.pack_into(f"<{nnz}f", out, weight_off, *weights)
+    with open(path, "wb") as f:
+        f.write(out)
+    return nnz
+
+
+def main():
+    parser = argparse.ArgumentParser(description="转换权重文件为SnnDL CSR格式")
+    parser.add_argument("inputs", nargs="+", help="输入文件（dense格式按节点顺序给出）")
+    parser.add_argument("--output", required=True, help="输出CSR文件")
+    parser.add_argument("--format", choices=["dense", "records"], default="dense")
+    parser.add_argument("--rows-per-file", type=int, default=16, help="dense格式每个文件的行数（每节点神经元数）")
+    parser.add_argument("--row-base", type=int, default=0, help="第一个输入文件第0行的突触前全局ID")
+    args = parser.parse_args()
+
+    synapses = []
+    num_cols = 0
+    for i, path in enumerate(args.inputs):
+        if args.format == "dense":
+            part, width = read_dense(path, args.row_base + i * args.rows_per_file, args.rows_per_file)
+        else:
+            part, width = read_records(path)
+        synapses.extend(part)
+        num_cols = max(num_cols, width)
+
+    if args.format == "dense":
+        row_base = args.row_base
+        num_rows = len(args.inputs) * args.rows_per_file
+    else:
+        pres = [s[0] for s in synapses]
+        row_base = min(pres, default=0)
+        num_rows = (max(pres) - row_base + 1) if pres else 0
+
+    nnz = write_csr(args.output, synapses, row_base, num_rows, num_cols)
+    print(f"写出 {args.output}: 行={num_rows} (起始全局ID {row_base}), 列={num_cols}, 突触={nnz}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""
+由权重文件导出 MultiCorePE 节点间的脉冲通信图，并划分到 MPI rank，
+供 SST 的 sst.self 划分器按 rank 放置组件（见 test_corrected_4x4.py 的 SNNDL_PARTITION_FILE）。
+
+通信量：突触 pre→post 记为从 pre 所在节点到 post 所在节点的一条脉冲路径，
+给出 --profile（MultiCorePE placement_profile_out 导出的发放计数）时按 pre 的发放次数加权。
+脉冲经 merlin mesh 维序路由（先X后Y）逐跳穿过路由器，因此按路由路径把通信量
+累加到每条路由器间链路上，划分目标是被切断链路的总通信量最小、各 rank 节点数均衡。
+
+节点的全部组件（路由器、MultiCorePE/SnnNIC、核心的L1与内存控制器、SpikeSource）放在同一 rank，
+跨 rank 的只有路由器间链路，SST 的同步前瞻即为这些链路的最小延迟。
+
+输入格式：
+  dense : 每节点一个文件，float32[本节点神经元][突触后全局ID]，零权重视为无连接
+  csr   : convert_weights_csr.py 生成的单个 SNNDLCSR 文件
+
+用法示例：
+  python3 partition_nodes.py --format dense --ranks 4 --output datasets/4x4_partition.json \\
+      datasets/4x4_weights_node_{0..15}.bin
+  SNNDL_PARTITION_FILE=datasets/4x4_partition.json \\
+      mpirun -np 4 sst --partitioner=sst.self test_corrected_4x4.py
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+from convert_weights_csr import HEADER_BYTES, MAGIC, read_dense
+
+
+def read_csr(path):
+    """返回 [(pre全局ID, post全局ID)]"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        raise ValueError(f"{path}: 不是SNNDLCSR文件")
+    num_rows, _cols, nnz, row_base, row_ptr_off, col_off, _w_off = struct.unpack_from("<7Q", data, 16)
+    if row_ptr_off < HEADER_BYTES:
+        raise ValueError(f"{path}: 头部字段无效")
+    row_ptr = struct.unpack_from(f"<{num_rows + 1}Q", data, row_ptr_off)
+    cols = struct.unpack_from(f"<{nnz}I", data, col_off)
+    synapses = []
+    for r in range(num_rows):
+        for i in range(row_ptr[r], row_ptr[r + 1]):
+            synapses.append((row_base + r, cols[i]))
+    return synapses
+
+
+def read_profile(path):
+    activity = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            neuron, count = line.split()[:2]
+            activity[int(neuron)] = activity.get(int(neuron), 0.0) + float(count)
+    return activity
+
+
+def node_traffic(synapses, neurons_per_pe, num_nodes, activity):
+    """节点间通信矩阵 traffic[src][dst]（不含节点内）"""
+    traffic = [[0.0] * num_nodes for _ in range(num_nodes)]
+    for pre, post in synapses:
+        src, dst = pre // neurons_per_pe, post // neurons_per_pe
+        if src == dst or src >= num_nodes or dst >= num_nodes:
+            continue
+        traffic[src][dst] += activity.get(pre, 0.0) if activity is not None else 1.0
+    return traffic
+
+
+def mesh_link_loads(traffic, mesh_x, mesh_y):
+    """按维序路由把节点间通信量累加到无向路由器链路 {(a, b): load}，a < b"""
+    loads = {}
+    n = mesh_x * mesh_y
+    for src in range(n):
+        for dst in range(n):
+            t = traffic[src][dst]
+            if t == 0.0:
+                continue
+            x, y = src % mesh_x, src // mesh_x
+            dx, dy = dst % mesh_x, dst // mesh_x
+            cur = src
+            while (x, y) != (dx, dy):
+                if x != dx:
+                    x += 1 if dx > x else -1
+                else:
+                    y += 1 if dy > y else -1
+                nxt = y * mesh_x + x
+                key = (min(cur, nxt), max(cur, nxt))
+                loads[key] = loads.get(key, 0.0) + t
+                cur = nxt
+    # 没有通信的链路也列出，便于统计跨 rank 链路数
+    for node in range(n):
+        x, y = node % mesh_x, node // mesh_x
+        if x + 1 < mesh_x:
+            loads.setdefault((node, node + 1), 0.0)
+        if y + 1 < mesh_y:
+            loads.setdefault((node, node + mesh_x), 0.0)
+    return loads
+
+
+def cut_load(rank_of, loads):
+    return sum(load for (a, b), load in loads.items() if rank_of[a] != rank_of[b])
+
+
+def partition(num_nodes, ranks, loads, mesh_x):
+    """按行优先连续分块初始化，再以成对交换（KL式）降低被切断的通信量。
+    交换不改变各 rank 的节点数，均衡由初始分块保证：每个 rank 分得 floor 或 ceil(num_nodes/ranks) 个节点"""
+    if ranks < 1 or ranks > num_nodes:
+        raise ValueError(f"ranks={ranks} 需在 1~{num_nodes} 之间")
+    rank_of = [i * ranks // num_nodes for i in range(num_nodes)]
+    if ranks > 1 and mesh_x >= ranks and num_nodes // mesh_x < ranks:
+        # 行数少于 rank 数时按列分块
+        rank_of = [(i % mesh_x) * ranks // mesh_x for i in range(num_nodes)]
+
+    adj = [[] for _ in range(num_nodes)]
+    for (a, b), load in loads.items():
+        adj[a].append((b, load))
+        adj[b].append((a, load))
+
+    def gain_of_swap(u, v):
+        ru, rv = rank_of[u], rank_of[v]
+        gain = 0.0
+        for w, load in adj[u]:
+            if w == v:
+                continue
+            gain += load * ((rank_of[w] != ru) - (rank_of[w] != rv))
+        for w, load in adj[v]:
+            if w == u:
+                continue
+            gain += load * ((rank_of[w] != rv) - (rank_of[w] != ru))
+        return gain
+
+    improved = True
+    while improved:
+        improved = False
+        best = (1e-9, None, None)
+        for u in range(num_nodes):
+            for v in range(u + 1, num_nodes):
+                if rank_of[u] == rank_of[v]:
+                    continue
+                g = gain_of_swap(u, v)
+                if g > best[0]:
+                    best = (g, u, v)
+        if best[1] is not None:
+            _, u, v = best
+            rank_of[u], rank_of[v] = rank_of[v], rank_of[u]
+            improved = True
+    return rank_of
+
+
+def main():
+    parser = argparse.ArgumentParser(description="导出SnnDL节点通信图并划分MPI rank")
+    parser.add_argument("inputs", nargs="+", help="权重文件（dense按节点顺序给出，csr给出一个文件）")
+    parser.add_argument("--output", required=True, help="输出划分JSON")
+    parser.add_argument("--format", choices=["dense", "csr"], default="dense")
+    parser.add_argument("--neurons-per-pe", type=int, default=16, help="每个MultiCorePE的神经元数")
+    parser.add_argument("--mesh", default="4x4", help="路由器网格形状 XxY")
+    parser.add_argument("--ranks", type=int, required=True, help="MPI rank数")
+    parser.add_argument("--profile", help="发放计数文件（每行 全局神经元ID 计数），按活动加权通信量")
+    args = parser.parse_args()
+
+    mesh_x, mesh_y = (int(v) for v in args.mesh.lower().split("x"))
+    num_nodes = mesh_x * mesh_y
+    if args.ranks < 1 or args.ranks > num_nodes:
+        parser.error(f"--ranks 需在 1~{num_nodes} 之间")
+
+    synapses = []
+    if args.format == "dense":
+        for node, path in enumerate(args.inputs):
+            part, _width = read_dense(path, node * args.neurons_per_pe, args.neurons_per_pe)
+            synapses.extend((pre, post) for pre, post, _w in part)
+    else:
+        for path in args.inputs:
+            synapses.extend(read_csr(path))
+
+    activity = read_profile(args.profile) if args.profile else None
+    traffic = node_traffic(synapses, args.neurons_per_pe, num_nodes, activity)
+    loads = mesh_link_loads(traffic, mesh_x, mesh_y)
+
+    blocked = partition(num_nodes, args.ranks, {}, mesh_x)
+    rank_of = partition(num_nodes, args.ranks, loads, mesh_x)
+    total = sum(loads.values())
+    cut = cut_load(rank_of, loads)
+    cross_links = sorted((a, b, load) for (a, b), load in loads.items() if rank_of[a] != rank_of[b])
+
+    result = {
+        "mesh": [mesh_x, mesh_y],
+        "ranks": args.ranks,
+        "node_rank": rank_of,
+        "total_link_load": total,
+        "cut_link_load": cut,
+        "blocked_cut_link_load": cut_load(blocked, loads),
+        "cross_rank_links": [[a, b, load] for a, b, load in cross_links],
+        "node_traffic": [[s, d, traffic[s][d]] for s in range(num_nodes)
+                         for d in range(num_nodes) if traffic[s][d] > 0.0],
+    }
+    with open(args.output, "w") as f:
+        json.dump(result, f, indent=1)
+
+    print(f"节点通信图: {len(result['node_traffic'])}条节点对, 链路总通信量={total:.0f}")
+    print(f"划分到{args.ranks}个rank: 切断通信量 {result['blocked_cut_link_load']:.0f}(按块) -> {cut:.0f}, "
+          f"跨rank链路={len(cross_links)}")
+    for r in range(args.ranks):
+        print(f"  rank{r}: 节点 {[n for n in range(num_nodes) if rank_of[n] == r]}")
+    print("跨rank的只有路由器间链路，同步前瞻 = 这些链路的最小延迟（test_corrected_4x4.py 的 MESH_LINK_LATENCY）")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""
+SnnDL 仿真吞吐基准测试。
+
+对每个用例：用 snndl_workload.py 生成（并缓存）合成负载，以 bench_snndl.py 为配置运行 sst，
+记录墙钟时间、峰值RSS与SST统计，输出一行JSON（JSON Lines）：
+
+  wall_s          : sst 进程的墙钟时间（含初始化与权重加载）
+  peak_rss_mib    : sst 进程的峰值常驻内存（wait4 的 ru_maxrss）
+  spikes          : 各 MultiCorePE 的 total_spikes_processed 之和
+  events          : 仿真中传递的脉冲事件数 = SpikeSource events_sent
+                    + MultiCorePE inter_core_messages + external_spikes_sent
+  spikes_per_sec / events_per_sec : 上述计数 / wall_s
+
+给出 --baseline 时按用例名与基线比较 events_per_sec，下降超过 --max-regression 时以非零状态退出。
+
+用法示例：
+  python3 run_benchmarks.py --suite smoke
+  python3 run_benchmarks.py --suite scaling --output results/scaling.jsonl
+  python3 run_benchmarks.py --mesh 8 --topology small_world --rate-hz 500 --baseline results/scaling.jsonl
+"""
+
+import argparse
+import csv
+import glob
+import hashlib
+import json
+import os
+import subprocess
+import sys
+import time
+
+import snndl_workload
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+BENCH_CONFIG = os.path.join(HERE, "bench_snndl.py")
+
+# 预置用例集：每项为 snndl_workload 参数的覆盖值
+SUITES = {
+    "smoke": [
+        {"mesh": 2, "topology": "random"},
+    ],
+    "scaling": [
+        {"mesh": mesh, "topology": topology}
+        for topology in ("random", "small_world")
+        for mesh in (2, 4, 8, 16)
+    ],
+    "rate": [
+        {"mesh": 4, "topology": "random", "rate_hz": rate}
+        for rate in (50.0, 200.0, 1000.0)
+    ],
+}
+
+EVENT_STATS = ("events_sent", "inter_core_messages", "external_spikes_sent")
+
+
+def case_name(cfg, weights):
+    return f"{cfg['topology']}_{cfg['mesh']}x{cfg['mesh']}_f{cfg['fanout']}_r{cfg['rate_hz']:g}_{weights}"
+
+
+def workload_dir(work_dir, cfg):
+    """相同参数的负载只生成一次"""
+    key = hashlib.sha1(json.dumps(cfg, sort_keys=True).encode()).hexdigest()[:12]
+    return os.path.join(work_dir, f"workload_{cfg['topology']}_{cfg['mesh']}x{cfg['mesh']}_{key}")
+
+
+def ensure_workload(work_dir, cfg):
+    out_dir = workload_dir(work_dir, cfg)
+    manifest_path = os.path.join(out_dir, "workload.json")
+    if not os.path.exists(manifest_path):
+        snndl_workload.generate(cfg, out_dir)
+    with open(manifest_path) as f:
+        return json.load(f), manifest_path
+
+
+def read_stats(pattern):
+    """汇总SST CSV统计：返回 {统计名: 各组件Sum之和}"""
+    totals = {}
+    for path in glob.glob(pattern):
+        with open(path, newline="") as f:
+            reader = csv.reader(f)
+            header = [h.strip() for h in next(reader, [])]
+            if "StatisticName" not in header:
+                continue
+            name_col = header.index("StatisticName")
+            sum_cols = [i for i, h in enumerate(header) if h.startswith("Sum.")]
+            if not sum_cols:
+                continue
+            for row in reader:
+                if len(row) <= max(name_col, sum_cols[0]):
+                    continue
+                try:
+                    value = float(row[sum_cols[0]])
+                except ValueError:
+                    continue
+                name = row[name_col].strip()
+                totals[name] = totals.get(name, 0.0) + value
+    return totals
+
+
+def run_sst(sst, env, log_path, timeout):
+    """运行sst并返回 (退出码, 墙钟秒, 峰值RSS MiB)"""
+    start = time.perf_counter()
+    with open(log_path, "w") as log:
+        proc = subprocess.Popen([sst, BENCH_CONFIG], env=env, stdout=log, stderr=subprocess.STDOUT, cwd=HERE)
+        deadline = start + timeout if timeout else None
+        while True:
+            pid, status, usage = os.wait4(proc.pid, os.WNOHANG)
+            if pid != 0:
+                break
+            if deadline and time.perf_counter() > deadline:
+                proc.kill()
+                pid, status, usage = os.wait4(proc.pid, 0)
+                break
+            time.sleep(0.01)
+    wall = time.perf_counter() - start
+    proc.returncode = os.waitstatus_to_exitcode(status)
+    # Linux 上 ru_maxrss 单位为KiB
+    return proc.returncode, wall, usage.ru_maxrss / 1024.0
+
+
+def run_case(args, overrides):
+    cfg = dict(snndl_workload.DEFAULTS)
+    for key in ("fanout", "rate_hz", "duration_us", "neurons_per_core", "cores_per_node", "seed"):
+        value = getattr(args, key)
+        if value is not None:
+            cfg[key] = value
+    cfg.update(overrides)
+    name = case_name(cfg, args.weights)
+
+    workload, manifest_path = ensure_workload(args.work_dir, cfg)
+    run_dir = os.path.join(args.work_dir, "runs", name)
+    os.makedirs(run_dir, exist_ok=True)
+    for old in glob.glob(os.path.join(run_dir, "stats*.csv")):
+        os.remove(old)
+    bench = {
+        "workload": manifest_path,
+        "stats_file": os.path.join(run_dir, "stats.csv"),
+        "weights": args.weights,
+        "pe_params": dict(args.pe_param),
+    }
+    bench_path = os.path.join(run_dir, "bench.json")
+    with open(bench_path, "w") as f:
+        json.dump(bench, f, indent=2)
+
+    env = dict(os.environ, SNNDL_BENCH_CONFIG=bench_path)
+    code, wall, rss = run_sst(args.sst, env, os.path.join(run_dir, "sst.log"), args.timeout)
+    stats = read_stats(os.path.join(run_dir, "stats*.csv"))
+    spikes = stats.get("total_spikes_processed", 0.0)
+    events = sum(stats.get(s, 0.0) for s in EVENT_STATS)
+    return {
+        "name": name,
+        "mesh": cfg["mesh"],
+        "topology": cfg["topology"],
+        "fanout": cfg["fanout"],
+        "rate_hz": cfg["rate_hz"],
+        "weights": args.weights,
+        "total_neurons": workload["total_neurons"],
+        "synapses": workload["synapses"],
+        "input_events": workload["input_events"],
+        "exit_code": code,
+        "wall_s": round(wall, 4),
+        "peak_rss_mib": round(rss, 1),
+        "spikes": int(spikes),
+        "neurons_fired": int(stats.get("total_neurons_fired", 0.0)),
+        "events": int(events),
+        "spikes_per_sec": round(spikes / wall, 1) if wall > 0 else 0.0,
+        "events_per_sec": round(events / wall, 1) if wall > 0 else 0.0,
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%S"),
+    }
+
+
+def compare(results, baseline_path, max_regression):
+    """返回 events_per_sec 相对基线下降超过阈值的用例"""
+    baseline = {}
+    with open(baseline_path) as f:
+        for line in f:
+            if line.strip():
+                record = json.loads(line)
+                baseline[record["name"]] = record
+    regressions = []
+    for record in results:
+        base = baseline.get(record["name"])
+        if not base or base.get("events_per_sec", 0) <= 0:
+            continue
+        ratio = record["events_per_sec"] / base["events_per_sec"]
+        print(f"  {record['name']}: events/s {base['events_per_sec']:.0f} -> {record['events_per_sec']:.0f}"
+              f" ({(ratio - 1) * 100:+.1f}%)", file=sys.stderr)
+        if ratio < 1.0 - max_regression:
+            regressions.append(record["name"])
+    return regressions
+
+
+def parse_pe_param(text):
+    key, sep, value = text.partition("=")
+    if not sep:
+        raise argparse.ArgumentTypeError(f"--pe-param 须为 key=value: {text}")
+    return key, value
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SnnDL仿真吞吐基准测试")
+    parser.add_argument("--suite", choices=sorted(SUITES), help="预置用例集")
+    parser.add_argument("--mesh", type=int, nargs="*", help="单独指定网格边长（与--topology组合）")
+    parser.add_argument("--topology", nargs="*", default=["random"], choices=["random", "small_world"])
+    parser.add_argument("--fanout", type=int)
+    parser.add_argument("--rate-hz", type=float)
+    parser.add_argument("--duration-us", type=int)
+    parser.add_argument("--neurons-per-core", type=int)
+    parser.add_argument("--cores-per-node", type=int)
+    parser.add_argument("--seed", type=int)
+    parser.add_argument("--weights", choices=["event", "memory"], default="event",
+                        help="event: 权重随事件携带; memory: WeightLoader + 每核心L1/内存控制器")
+    parser.add_argument("--pe-param", type=parse_pe_param, action="append", default=[],
+                        help="额外的MultiCorePE参数 key=value，可重复")
+    parser.add_argument("--sst", default="sst", help="sst可执行文件")
+    parser.add_argument("--timeout", type=float, default=0, help="单个用例的超时秒数（0=不限）")
+    parser.add_argument("--work-dir", default=os.path.join(HERE, "bench_work"), help="负载与运行目录")
+    parser.add_argument("--output", help="追加写入结果的JSON Lines文件")
+    parser.add_argument("--baseline", help="用于比较的历史结果（JSON Lines）")
+    parser.add_argument("--max-regression", type=float, default=0.10, help="允许的events_per_sec相对下降比例")
+    args = parser.parse_args()
+
+    cases = []
+    if args.suite:
+        cases.extend(SUITES[args.suite])
+    if args.mesh:
+        cases.extend({"mesh": m, "topology": t} for t in args.topology for m in args.mesh)
+    if not cases:
+        cases = SUITES["smoke"]
+
+    results = []
+    out = None
+    if args.output:
+        os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+        out = open(args.output, "a")
+    for overrides in cases:
+        record = run_case(args, overrides)
+        results.append(record)
+        line = json.dumps(record, sort_keys=True)
+        print(line)
+        if out:
+            out.write(line + "\n")
+            out.flush()
+        if record["exit_code"] != 0:
+            print(f"⚠️ {record['name']} sst退出码 {record['exit_code']}，日志见 "
+                  f"{os.path.join(args.work_dir, 'runs', record['name'], 'sst.log')}", file=sys.stderr)
+    if out:
+        out.close()
+
+    if args.baseline:
+        regressions = compare(results, args.baseline, args.max_regression)
+        if regressions:
+            print(f"❌ 吞吐回退超过{args.max_regression * 100:.0f}%: {', '.join(regressions)}", file=sys.stderr)
+            return 1
+    return 0 if all(r["exit_code"] == 0 for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
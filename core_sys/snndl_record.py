@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+读取 MultiCorePE 的列式二进制记录（record_file 参数，格式见 SnnDL/SpikeRecorder.h）。
+
+每个数据块的各列是定宽连续数组，这里用 array.frombytes 整列读取，不逐条解析；
+装有 numpy 时也可对同一缓冲直接 numpy.frombuffer。
+
+  load(path) -> Recording
+    .node_id, .traffic_interval
+    .cycles   : array('Q')  发放周期（全部块拼接，块内升序）
+    .neurons  : array('I')  对应的全局神经元ID
+    .traffic  : [TrafficRow(cycle, kind, link, vn, src, dst, spikes, bits)]，各值为快照间隔内的增量
+
+用法示例：
+  python3 snndl_record.py record_node*.bin                  # 汇总
+  python3 snndl_record.py record_node0.bin --raster-csv raster.csv
+"""
+
+import argparse
+import array
+import collections
+import struct
+import sys
+from itertools import accumulate
+
+MAGIC = b"SNNDLREC"
+FILE_HEADER = struct.Struct("<8sIIQ")
+CHUNK_HEADER = struct.Struct("<4sIQ")
+
+TRAFFIC_KINDS = {0: "net_tx", 1: "net_rx", 2: "inter_core"}
+NETWORK_PORT = 0xFF
+UNKNOWN_NODE = 0xFFFFFFFF
+_DELTA_TYPECODES = {1: "B", 2: "H", 4: "I", 8: "Q"}
+
+TrafficRow = collections.namedtuple("TrafficRow", "cycle kind link vn src dst spikes bits")
+
+
+class Recording:
+    def __init__(self, node_id, traffic_interval):
+        self.node_id = node_id
+        self.traffic_interval = traffic_interval
+        self.cycles = array.array("Q")
+        self.neurons = array.array("I")
+        self.traffic = []
+
+
+def _column(typecode, data, offset, count):
+    col = array.array(typecode)
+    end = offset + col.itemsize * count
+    col.frombytes(data[offset:end])
+    if sys.byteorder != "little":
+        col.byteswap()
+    return col, end
+
+
+def _read_raster(rec, payload, count):
+    base, width = struct.unpack_from("<QB", payload, 0)
+    deltas, offset = _column(_DELTA_TYPECODES[width], payload, 9, count)
+    neurons, _ = _column("I", payload, offset, count)
+    rec.cycles.extend(base + d for d in accumulate(deltas))
+    rec.neurons.extend(neurons)
+
+
+def _read_traffic(rec, payload, count):
+    (cycle,) = struct.unpack_from("<Q", payload, 0)
+    offset = 8
+    cols = []
+    for typecode in ("B", "B", "H", "I", "I", "Q", "Q"):
+        col, offset = _column(typecode, payload, offset, count)
+        cols.append(col)
+    rec.traffic.extend(TrafficRow(cycle, *row) for row in zip(*cols))
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < FILE_HEADER.size:
+        raise ValueError(f"{path}: 文件过短")
+    magic, version, node_id, interval = FILE_HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != 1:
+        raise ValueError(f"{path}: 不是SnnDL记录文件 (magic={magic!r}, version={version})")
+    rec = Recording(node_id, interval)
+    offset = FILE_HEADER.size
+    while offset + CHUNK_HEADER.size <= len(data):
+        tag, count, size = CHUNK_HEADER.unpack_from(data, offset)
+        offset += CHUNK_HEADER.size
+        payload = data[offset:offset + size]
+        if len(payload) < size:
+            raise ValueError(f"{path}: 数据块 {tag!r} 被截断")
+        if tag == b"RAST":
+            _read_raster(rec, payload, count)
+        elif tag == b"TRAF":
+            _read_traffic(rec, payload, count)
+        # 未知标签按载荷长度跳过，便于以后扩展
+        offset += size
+    return rec
+
+
+def traffic_totals(traffic):
+    """按 (类型, 源, 目的, 链路, VC) 汇总全部快照"""
+    totals = collections.defaultdict(lambda: [0, 0])
+    for row in traffic:
+        t = totals[(TRAFFIC_KINDS.get(row.kind, row.kind), row.src, row.dst, row.link, row.vn)]
+        t[0] += row.spikes
+        t[1] += row.bits
+    return totals
+
+
+def main():
+    parser = argparse.ArgumentParser(description="读取SnnDL发放栅格与流量记录")
+    parser.add_argument("records", nargs="+", help="记录文件（每节点一个）")
+    parser.add_argument("--raster-csv", help="把所有节点的发放栅格导出为 cycle,neuron CSV")
+    parser.add_argument("--top", type=int, default=10, help="打印流量最大的前N条链路")
+    args = parser.parse_args()
+
+    recordings = [load(path) for path in args.records]
+    traffic = []
+    for path, rec in zip(args.records, recordings):
+        span = f"{rec.cycles[0]}..{rec.cycles[-1]}" if rec.cycles else "-"
+        print(f"{path}: 节点{rec.node_id}, 发放{len(rec.cycles)}次 (周期 {span}), 流量记录{len(rec.traffic)}条")
+        traffic.extend(rec.traffic)
+
+    totals = traffic_totals(traffic)
+    if totals:
+        print(f"流量最大的{min(args.top, len(totals))}条链路 (类型 源->目的 链路 VC: 脉冲 比特):")
+        for key, (spikes, bits) in sorted(totals.items(), key=lambda kv: -kv[1][0])[:args.top]:
+            kind, src, dst, link, vn = key
+            src = "?" if src == UNKNOWN_NODE else src
+            link = "-" if link == NETWORK_PORT else link
+            print(f"  {kind:<10s} {src}->{dst} {link} vc{vn}: {spikes} {bits}")
+
+    if args.raster_csv:
+        with open(args.raster_csv, "w") as f:
+            f.write("cycle,neuron\n")
+            for rec in recordings:
+                for cycle, neuron in zip(rec.cycles, rec.neurons):
+                    f.write(f"{cycle},{neuron}\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
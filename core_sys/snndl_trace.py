@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""
+读取 MultiCorePE 在 finish() 时转储的二进制事件环（trace_ring_size > 0 时生成，见 SnnDL/SnnTrace.h）。
+
+文件格式：
+  "SNNTRACE"(8B) | u32 版本=1 | u32 记录字节数=24 | u64 记录数 | u64 被覆盖数 | 记录[记录数]（从旧到新）
+  记录  : u64 cycle | u16 type | u16 core | u32 a | u32 b | f32 value（core=0xFFFF 表示节点级事件）
+
+用法示例：
+  python3 snndl_trace.py snndl_trace_node0.bin            # 按事件类型汇总
+  python3 snndl_trace.py snndl_trace_node0.bin --dump 20  # 打印最后20条记录
+"""
+
+import argparse
+import collections
+import struct
+import sys
+
+MAGIC = b"SNNTRACE"
+HEADER = struct.Struct("<8sIIQQ")
+RECORD = struct.Struct("<QHHIIf")
+
+NODE_CORE = 0xFFFF
+EVENT_TYPES = {
+    1: "SPIKE_IN",
+    2: "NEURON_FIRE",
+    3: "MEM_REQUEST",
+    4: "MEM_RESPONSE",
+    5: "EXT_IN",
+    6: "EXT_OUT",
+    7: "INTER_CORE",
+}
+
+TraceEvent = collections.namedtuple("TraceEvent", "cycle type core a b value")
+
+
+def load(path):
+    """返回 (记录列表, 被覆盖的记录数)"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < HEADER.size:
+        raise ValueError(f"{path}: 文件过短")
+    magic, version, record_bytes, count, overwritten = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != 1 or record_bytes != RECORD.size:
+        raise ValueError(f"{path}: 不是SnnDL事件环文件 (magic={magic!r}, version={version}, record={record_bytes})")
+    if len(data) < HEADER.size + count * RECORD.size:
+        raise ValueError(f"{path}: 记录数{count}与文件大小不符")
+    events = [TraceEvent(*RECORD.unpack_from(data, HEADER.size + i * RECORD.size)) for i in range(count)]
+    return events, overwritten
+
+
+def main():
+    parser = argparse.ArgumentParser(description="读取SnnDL二进制事件环")
+    parser.add_argument("trace", help="事件环转储文件")
+    parser.add_argument("--dump", type=int, default=0, help="打印最后N条记录")
+    args = parser.parse_args()
+
+    events, overwritten = load(args.trace)
+    if not events:
+        print(f"{args.trace}: 无记录")
+        return 0
+    print(f"{args.trace}: {len(events)}条记录 (覆盖{overwritten}), 周期 {events[0].cycle}..{events[-1].cycle}")
+    by_type = collections.Counter(EVENT_TYPES.get(e.type, str(e.type)) for e in events)
+    for name, n in by_type.most_common():
+        print(f"  {name:<13s} {n}")
+    for e in events[-args.dump:] if args.dump > 0 else []:
+        core = "node" if e.core == NODE_CORE else f"core{e.core}"
+        print(f"{e.cycle:>12d} {EVENT_TYPES.get(e.type, e.type):<13s} {core:<7s} a={e.a} b={e.b} value={e.value:g}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+SnnDL 合成负载生成器：随机/小世界连接 + 泊松输入脉冲。
+
+生成内容（均写入 --out-dir）：
+  network.csr       : 整个网络的 SNNDLCSR v1 连接表（convert_weights_csr.write_csr），
+                      行 = 突触前全局ID，可直接作为 MultiCorePE 的 connectivity_file
+                      或 WeightLoader 的 single_file（weight_format=csr）
+  input_node_<i>.bin: 节点i的 SpikeSource 输入，BINARY格式（按时间排序的 {u64 timestamp_us, u32 neuron_id}）
+  workload.json     : 生成参数与规模摘要（bench_snndl.py 读取）
+
+神经元全局ID = 节点ID × (cores_per_node × neurons_per_core) + 节点内ID，节点按行优先排列在 mesh×mesh 网格上。
+
+连接拓扑：
+  random      : 每个突触前神经元均匀随机选取 fanout 个突触后神经元（无自连接）
+  small_world : Watts-Strogatz，全局ID环上连接后继的 fanout 个近邻，每条边以 rewire_prob 重连到随机目标
+
+用法示例：
+  python3 snndl_workload.py --mesh 4 --topology small_world --fanout 16 --rate-hz 200 \\
+      --out-dir datasets/bench_4x4
+"""
+
+import argparse
+import json
+import os
+import random
+import struct
+import sys
+
+from convert_weights_csr import write_csr
+
+DEFAULTS = {
+    "mesh": 4,
+    "cores_per_node": 4,
+    "neurons_per_core": 64,
+    "topology": "random",
+    "fanout": 16,
+    "rewire_prob": 0.1,
+    "weight": 0.25,
+    "rate_hz": 100.0,
+    "input_fraction": 0.25,
+    "duration_us": 1000,
+    "seed": 1,
+}
+
+
+def neurons_per_node(cfg):
+    return cfg["cores_per_node"] * cfg["neurons_per_core"]
+
+
+def total_neurons(cfg):
+    return cfg["mesh"] * cfg["mesh"] * neurons_per_node(cfg)
+
+
+def random_synapses(n, fanout, weight, rng):
+    """每个突触前神经元 fanout 个互不相同的随机目标"""
+    fanout = min(fanout, n - 1)
+    synapses = []
+    for pre in range(n):
+        targets = set()
+        while len(targets) < fanout:
+            post = rng.randrange(n)
+            if post != pre:
+                targets.add(post)
+        synapses.extend((pre, post, weight) for post in targets)
+    return synapses
+
+
+def small_world_synapses(n, fanout, rewire_prob, weight, rng):
+    """Watts-Strogatz：环上后继近邻 + 随机重连，重连目标避开自环与重复边"""
+    fanout = min(fanout, n - 1)
+    synapses = []
+    for pre in range(n):
+        targets = set()
+        for k in range(1, fanout + 1):
+            post = (pre + k) % n
+            if rng.random() < rewire_prob:
+                post = rng.randrange(n)
+            while post == pre or post in targets:
+                post = rng.randrange(n)
+            targets.add(post)
+        synapses.extend((pre, post, weight) for post in targets)
+    return synapses
+
+
+def poisson_spikes(neurons, rate_hz, duration_us, rng):
+    """各神经元独立的泊松脉冲序列，返回按 (时间, 神经元) 排序的 [(timestamp_us, neuron)]"""
+    events = []
+    if rate_hz <= 0:
+        return events
+    mean_interval_us = 1e6 / rate_hz
+    for neuron in neurons:
+        t = rng.expovariate(1.0 / mean_interval_us)
+        while t < duration_us:
+            events.append((int(t), neuron))
+            t += rng.expovariate(1.0 / mean_interval_us)
+    events.sort()
+    return events
+
+
+def write_spike_binary(path, events):
+    with open(path, "wb") as f:
+        for timestamp, neuron in events:
+            f.write(struct.pack("<QI", timestamp, neuron))
+
+
+def generate(cfg, out_dir):
+    """按 cfg 生成连接表与输入文件，返回 workload.json 的内容"""
+    cfg = dict(DEFAULTS, **cfg)
+    os.makedirs(out_dir, exist_ok=True)
+    rng = random.Random(cfg["seed"])
+    n = total_neurons(cfg)
+    per_node = neurons_per_node(cfg)
+
+    if cfg["topology"] == "random":
+        synapses = random_synapses(n, cfg["fanout"], cfg["weight"], rng)
+    elif cfg["topology"] == "small_world":
+        synapses = small_world_synapses(n, cfg["fanout"], cfg["rewire_prob"], cfg["weight"], rng)
+    else:
+        raise ValueError(f"未知的拓扑: {cfg['topology']} (可选 random|small_world)")
+    csr_path = os.path.join(out_dir, "network.csr")
+    nnz = write_csr(csr_path, synapses, 0, n, n)
+    cross_node = sum(1 for pre, post, _ in synapses if pre // per_node != post // per_node)
+
+    input_files = []
+    input_events = 0
+    nodes = cfg["mesh"] * cfg["mesh"]
+    inputs_per_node = max(1, int(per_node * cfg["input_fraction"]))
+    for node in range(nodes):
+        base = node * per_node
+        driven = sorted(rng.sample(range(base, base + per_node), inputs_per_node))
+        events = poisson_spikes(driven, cfg["rate_hz"], cfg["duration_us"], rng)
+        path = os.path.join(out_dir, f"input_node_{node}.bin")
+        write_spike_binary(path, events)
+        input_files.append(path)
+        input_events += len(events)
+
+    manifest = {
+        "config": cfg,
+        "total_neurons": n,
+        "synapses": nnz,
+        "cross_node_synapses": cross_node,
+        "input_events": input_events,
+        "connectivity_file": csr_path,
+        "input_files": input_files,
+    }
+    with open(os.path.join(out_dir, "workload.json"), "w") as f:
+        json.dump(manifest, f, indent=2)
+    return manifest
+
+
+def main():
+    parser = argparse.ArgumentParser(description="生成SnnDL合成负载（连接表 + 泊松输入）")
+    parser.add_argument("--out-dir", required=True, help="输出目录")
+    parser.add_argument("--mesh", type=int, default=DEFAULTS["mesh"], help="网格边长（2..16）")
+    parser.add_argument("--cores-per-node", type=int, default=DEFAULTS["cores_per_node"])
+    parser.add_argument("--neurons-per-core", type=int, default=DEFAULTS["neurons_per_core"])
+    parser.add_argument("--topology", choices=["random", "small_world"], default=DEFAULTS["topology"])
+    parser.add_argument("--fanout", type=int, default=DEFAULTS["fanout"], help="每个神经元的突触数")
+    parser.add_argument("--rewire-prob", type=float, default=DEFAULTS["rewire_prob"], help="small_world重连概率")
+    parser.add_argument("--weight", type=float, default=DEFAULTS["weight"], help="突触权重")
+    parser.add_argument("--rate-hz", type=float, default=DEFAULTS["rate_hz"], help="输入神经元的泊松发放率")
+    parser.add_argument("--input-fraction", type=float, default=DEFAULTS["input_fraction"],
+                        help="每个节点接收外部输入的神经元比例")
+    parser.add_argument("--duration-us", type=int, default=DEFAULTS["duration_us"], help="输入脉冲的时间跨度(us)")
+    parser.add_argument("--seed", type=int, default=DEFAULTS["seed"])
+    args = parser.parse_args()
+
+    cfg = {key: getattr(args, key) for key in DEFAULTS}
+    manifest = generate(cfg, args.out_dir)
+    print(f"{args.out_dir}: {manifest['total_neurons']}个神经元, {manifest['synapses']}个突触"
+          f"(跨节点{manifest['cross_node_synapses']}), {manifest['input_events']}个输入脉冲")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -2,6 +2,7 @@
 
 import sst
 import os
+import json
 import struct
 
 # === 扩展到4x4网格的正确配置 ===
@@ -21,6 +22,23 @@ PER_NODE_STRIDE = 32768  # 内存步长以容纳1024个权重（8KB）
 # 网络参数
 NETWORK_BANDWIDTH = "40GiB/s"
 BUFFER_SIZE = "8KiB"
+# 路由器间链路延迟：多rank运行时只有这些链路跨rank，其最小值即SST同步前瞻
+MESH_LINK_LATENCY = os.environ.get("SNNDL_MESH_LINK_LATENCY", "5ns")
+
+# 多rank划分（partition_nodes.py 生成），配合 sst --partitioner=sst.self 使用
+PARTITION_FILE = os.environ.get("SNNDL_PARTITION_FILE", "")
+node_rank = None
+if PARTITION_FILE:
+    with open(PARTITION_FILE) as f:
+        node_rank = json.load(f)["node_rank"]
+    if len(node_rank) != MESH_SIZE * MESH_SIZE:
+        raise ValueError(f"{PARTITION_FILE}: 节点数{len(node_rank)}与网格不符")
+    print(f"按划分文件放置: {PARTITION_FILE}, {max(node_rank) + 1}个rank")
+
+def place(component, node_id):
+    """节点的全部组件放到同一rank，未给划分文件时交由SST划分器决定"""
+    if node_rank is not None:
+        component.setRank(node_rank[node_id])
 
 print(f"大规模配置: {MESH_SIZE}x{MESH_SIZE} = {TOTAL_NODES}个节点（{MESH_SIZE}x{MESH_SIZE}网格）")
 
@@ -129,6 +147,7 @@ global_memory_controller.addParams({
     "addr_range_start": "0",
     "addr_range_end": "1073741823"
 })
+place(global_memory_controller, 0)
 
 # WeightLoader配置
 weight_loader = sst.Component("weight_loader", "SnnDL.WeightLoader")
@@ -146,6 +165,7 @@ weight_loader.addParams({
     "validate_length": 1,
     "row_major": 1
 })
+place(weight_loader, 0)
 
 weight_loader_mem = weight_loader.setSubComponent("memory", "memHierarchy.standardInterface")
 weight_loader_mem.addParams({"port": "lowlink"})
@@ -185,6 +205,7 @@ for i in range(TOTAL_NODES):
         "local_ports": "1",      # 1个本地端口用于连接PE
     })
 
+    place(router, i)
     routers.append(router)
 
 print(f"✅ 创建{len(routers)}个路由器完成")
@@ -204,7 +225,6 @@ for i in range(TOTAL_NODES):
         "node_id": i,
         "global_neuron_base": i * NEURONS_PER_PE,
         "enable_test_traffic": 1,
-        "enable_memory_weights": 1,
         "write_weights_on_init": 1,
         "weights_file": os.path.join(test_dir, f"4x4_weights_node_{i}.bin"),
         # StandardMem接口通过子组件配置
@@ -227,6 +247,7 @@ for i in range(TOTAL_NODES):
     node_params["base_addr"] = weight_addr
 
     node.addParams(node_params)
+    place(node, i)
 
     # 创建SnnNIC网络接口
     nic = node.setSubComponent("network_interface", "SnnDL.SnnNIC")
@@ -254,6 +275,7 @@ for i in range(TOTAL_NODES):
             "addr_range_start": "0",
             "addr_range_end": "8388607"
         })
+        place(mem_ctrl, i)
 
         # ★ 关键修正：创建L1缓存，使用正确的memHierarchy配置
         l1_cache = sst.Component(f"pe_{i}_core{core_idx}_l1", "memHierarchy.Cache")
@@ -268,6 +290,7 @@ for i in range(TOTAL_NODES):
             "debug": "0",
             "verbose": "0"
         })
+        place(l1_cache, i)
 
         # ★ 关键修正：直接连接到MultiCorePE的核心内存端口 ★
         # MultiCorePE中使用的端口名格式：core0_mem, core1_mem, core2_mem, core3_mem
@@ -304,6 +327,7 @@ for source_id in range(TOTAL_NODES):
         "loop_dataset": 1,
         "source_id": source_id
     })
+    place(spike_source, source_id)
     spike_sources.append(spike_source)
 
 print(f"✅ 创建{len(spike_sources)}个SpikeSource完成（{MESH_SIZE}x{MESH_SIZE}网格）")
@@ -333,8 +357,8 @@ for y in range(mesh_size):
 
         router_east_link = sst.Link(f"router_east_{node_id}_to_{east_node_id}")
         router_east_link.connect(
-            (routers[node_id], "port0", "5ns"),      # East port
-            (routers[east_node_id], "port1", "5ns")  # West port
+            (routers[node_id], "port0", MESH_LINK_LATENCY),      # East port
+            (routers[east_node_id], "port1", MESH_LINK_LATENCY)  # West port
         )
         connection_count += 1
 
@@ -346,8 +370,8 @@ for x in range(mesh_size):
 
         router_south_link = sst.Link(f"router_south_{node_id}_to_{south_node_id}")
         router_south_link.connect(
-            (routers[node_id], "port2", "5ns"),       # South port
-            (routers[south_node_id], "port3", "5ns")  # North port
+            (routers[node_id], "port2", MESH_LINK_LATENCY),       # South port
+            (routers[south_node_id], "port3", MESH_LINK_LATENCY)  # North port
         )
         connection_count += 1
 
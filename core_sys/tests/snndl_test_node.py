@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+test_snndl.py 使用的单节点 SST 配置：一个 MultiCorePE（无网络接口）+ 一个 SpikeSource。
+
+参数通过环境变量 SNNDL_TEST_CONFIG 指向的JSON给出：
+  stop_at       : 仿真结束时间（如 "200us"）
+  pe_params     : 传给 MultiCorePE 的参数
+  source_params : 传给 SpikeSource 的参数
+  memory        : 可选，内存权重。给出时建立 WeightLoader + 总线 + 内存控制器：
+                    loader_params : 传给 WeightLoader 的参数
+                    cores         : 可选，逐核心的 SnnPESubComponent 参数列表（用户槽位，各核心经
+                                    自己的 memory 子组件接入总线）；省略时使用匿名核心，经 core{i}_mem 端口接入
+
+单独运行：
+  SNNDL_TEST_CONFIG=case.json sst snndl_test_node.py
+"""
+
+import json
+import os
+
+import sst
+
+with open(os.environ["SNNDL_TEST_CONFIG"]) as f:
+    case = json.load(f)
+
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stop-at", case["stop_at"])
+
+pe = sst.Component("multicore_pe_0", "SnnDL.MultiCorePE")
+pe.addParams(case["pe_params"])
+
+source = sst.Component("spike_source_0", "SnnDL.SpikeSource")
+source.addParams(case["source_params"])
+
+sst.Link("spike_source_0_to_pe_0").connect(
+    (source, "spike_output", "1ns"),
+    (pe, "external_spike_input", "1ns"))
+
+memory = case.get("memory")
+if memory:
+    num_cores = int(case["pe_params"]["num_cores"])
+    mem_ctrl = sst.Component("weight_mem", "memHierarchy.MemController")
+    mem_ctrl.addParams({
+        "clock": "1GHz",
+        "backing": "malloc",
+        "backend": "memHierarchy.simpleMem",
+        "backend.access_time": "20ns",
+        "backend.mem_size": "64MiB",
+        "addr_range_start": "0",
+        "addr_range_end": str(64 * 1024 ** 2 - 1),
+    })
+    bus = sst.Component("weight_bus", "memHierarchy.Bus")
+    bus.addParams({"bus_frequency": "1GHz"})
+    sst.Link("weight_bus_to_mem").connect((bus, "lowlink0", "1ns"), (mem_ctrl, "highlink", "1ns"))
+
+    loader = sst.Component("weight_loader", "SnnDL.WeightLoader")
+    loader.addParams(memory["loader_params"])
+    loader_mem = loader.setSubComponent("memory", "memHierarchy.standardInterface")
+    loader_mem.addParams({"port": "lowlink"})
+    sst.Link("weight_loader_to_bus").connect((loader_mem, "lowlink", "1ns"), (bus, "highlink0", "1ns"))
+
+    for i in range(num_cores):
+        if "cores" in memory:
+            core = pe.setSubComponent(f"core{i}", "SnnDL.SnnPESubComponent")
+            core.addParams(memory["cores"][i])
+            core_mem = core.setSubComponent("memory", "memHierarchy.standardInterface")
+            core_mem.addParams({"port": "lowlink"})
+            endpoint = (core_mem, "lowlink", "1ns")
+        else:
+            endpoint = (pe, f"core{i}_mem", "1ns")
+        sst.Link(f"core{i}_to_bus").connect(endpoint, (bus, f"highlink{i + 1}", "1ns"))
@@ -0,0 +1,332 @@
+#!/usr/bin/env python3
+"""
+SnnDL 端到端回归测试：每个用例写出小型输入，经 snndl_test_node.py 运行一次 sst，
+再读取事件环（snndl_trace.py）或样本计数CSV检查结果。
+
+需要 sst 在 PATH 中且已注册 SnnDL 元件，否则跳过。
+
+运行：
+  python3 -m unittest discover -s core_sys/tests
+"""
+
+import json
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import unittest
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.dirname(HERE))
+
+import snndl_trace  # noqa: E402
+from partition_nodes import partition  # noqa: E402
+
+
+def snndl_available():
+    if shutil.which("sst") is None or shutil.which("sst-info") is None:
+        return False
+    result = subprocess.run(["sst-info", "SnnDL"], capture_output=True, text=True)
+    return result.returncode == 0 and "MultiCorePE" in result.stdout
+
+
+def write_records(path, synapses):
+    """写出records格式连接表：synapses 为 [(pre, post, w)]"""
+    with open(path, "wb") as f:
+        f.write(struct.pack("<II", len(synapses), len(synapses)))
+        for pre, post, w in synapses:
+            f.write(struct.pack("<IIf", pre, post, w))
+
+
+def write_spikes(path, spikes):
+    """写出TEXT格式输入：spikes 为 [(neuron, timestamp)]"""
+    with open(path, "w") as f:
+        for neuron, ts in spikes:
+            f.write(f"{neuron} {ts}\n")
+
+
+@unittest.skipUnless(snndl_available(), "需要sst与已注册的SnnDL元件")
+class SnnDLTestCase(unittest.TestCase):
+    NUM_CORES = 2
+    NEURONS_PER_CORE = 4
+
+    def setUp(self):
+        self.tmp = tempfile.mkdtemp(prefix="snndl_test_")
+        self.addCleanup(shutil.rmtree, self.tmp, ignore_errors=True)
+
+    def path(self, name):
+        return os.path.join(self.tmp, name)
+
+    def pe_params(self, **extra):
+        params = {
+            "num_cores": self.NUM_CORES,
+            "neurons_per_core": self.NEURONS_PER_CORE,
+            "node_id": 0,
+            "global_neuron_base": 0,
+            "use_event_weight_fallback": 1,
+            "enable_memory_weights": 0,
+            "internal_interconnect": "mailbox",
+            "mailbox_latency": 1,
+            "v_thresh": 0.5,
+            "v_rest": 0.0,
+            "v_reset": 0.0,
+            "trace_ring_size": 4096,
+            "trace_file": self.path("trace_node{node}.bin"),
+        }
+        params.update(extra)
+        return params
+
+    def run_sst(self, stop_at, pe_params, source_params, memory=None):
+        config = self.path("case.json")
+        case = {"stop_at": stop_at, "pe_params": pe_params, "source_params": source_params}
+        if memory is not None:
+            case["memory"] = memory
+        with open(config, "w") as f:
+            json.dump(case, f)
+        env = dict(os.environ, SNNDL_TEST_CONFIG=config)
+        result = subprocess.run(["sst", os.path.join(HERE, "snndl_test_node.py")],
+                                cwd=self.tmp, env=env, capture_output=True, text=True)
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        return result.stdout
+
+    def suspended_cycles(self, stdout):
+        """从 finish 日志（verbose>=1）读取各核心挂起跳过的周期数"""
+        return {int(core): int(n) for core, n in re.findall(r"核心(\d+)时钟挂起跳过周期=(\d+)", stdout)}
+
+    def trace(self):
+        events, overwritten = snndl_trace.load(self.path("trace_node0.bin"))
+        self.assertEqual(overwritten, 0)
+        return events
+
+
+class SynapticDelayTest(SnnDLTestCase):
+    def check_delays(self, synaptic_delay):
+        """逐突触延迟d叠加在统一延迟之上：脉冲在核心接收后第 synaptic_delay+d 个周期积分（阈值低于权重，积分当周期即发放）"""
+        delays = [1, 3, 7]
+        posts = [4, 5, 6]
+        write_records(self.path("conn.bin"), [(0, post, 1.0) for post in posts])
+        with open(self.path("delays.bin"), "wb") as f:
+            f.write(bytes(delays))
+        write_spikes(self.path("input.txt"), [(0, 1)])
+
+        self.run_sst("50us",
+                     self.pe_params(connectivity_file=self.path("conn.bin"),
+                                    connectivity_format="records",
+                                    delay_file=self.path("delays.bin"),
+                                    max_synaptic_delay=8,
+                                    synaptic_delay=synaptic_delay),
+                     {"dataset_path": self.path("input.txt"),
+                      "dataset_format": "TEXT",
+                      "neurons_per_core": self.NEURONS_PER_CORE,
+                      "cores_per_node": self.NUM_CORES})
+
+        events = self.trace()
+        arrivals = {e.b: e.cycle for e in events
+                    if snndl_trace.EVENT_TYPES.get(e.type) == "SPIKE_IN" and e.core == 1}
+        fires = {e.b: e.cycle for e in events
+                 if snndl_trace.EVENT_TYPES.get(e.type) == "NEURON_FIRE" and e.core == 1}
+        for post, delay in zip(posts, delays):
+            self.assertIn(post, arrivals)
+            self.assertIn(post, fires)
+            self.assertEqual(fires[post] - arrivals[post], synaptic_delay + delay,
+                             f"神经元{post}延迟{delay}，统一延迟{synaptic_delay}")
+
+    def test_delay_integrated_d_cycles_after_arrival(self):
+        self.check_delays(0)
+
+    def test_delay_added_to_synaptic_delay(self):
+        self.check_delays(3)
+
+
+class ClockSuspendTest(SnnDLTestCase):
+    def test_idle_izhikevich_core_suspends(self):
+        """Izhikevich神经元从稳定静息点出发，少量输入衰减后核心应挂起时钟"""
+        write_spikes(self.path("input.txt"), [(0, 1)])
+        stdout = self.run_sst("100us",
+                              self.pe_params(verbose=1, neuron_model="izhikevich", enable_clock_suspend=1),
+                              {"dataset_path": self.path("input.txt"),
+                               "dataset_format": "TEXT",
+                               "neurons_per_core": self.NEURONS_PER_CORE,
+                               "cores_per_node": self.NUM_CORES})
+        suspended = self.suspended_cycles(stdout)
+        for core in range(self.NUM_CORES):
+            self.assertGreater(suspended.get(core, 0), 50000, f"核心{core}未挂起")
+
+    def test_lazy_leak_core_suspends_with_subthreshold_membrane(self):
+        """惰性泄漏模式下，输入后膜电位停在阈下的神经元不应阻止核心挂起"""
+        write_spikes(self.path("input.txt"), [(0, 1)])
+        stdout = self.run_sst("100us",
+                              self.pe_params(verbose=1, v_thresh=2.0, lazy_leak=1, enable_clock_suspend=1),
+                              {"dataset_path": self.path("input.txt"),
+                               "dataset_format": "TEXT",
+                               "neurons_per_core": self.NEURONS_PER_CORE,
+                               "cores_per_node": self.NUM_CORES})
+        self.assertGreater(self.suspended_cycles(stdout).get(0, 0), 50000)
+
+
+class SampleBoundaryTest(SnnDLTestCase):
+    """样本0末尾神经元0发放、其输出在边界时仍在途；样本1只输入神经元1。
+    边界处在途脉冲须丢弃，样本1中不应出现神经元4的发放。"""
+
+    PERIOD_NS = 10000
+
+    def run_samples(self, **pe_extra):
+        write_spikes(self.path("sample0.txt"), [(0, self.PERIOD_NS - 10)])
+        write_spikes(self.path("sample1.txt"), [(1, 100)])
+        with open(self.path("samples.txt"), "w") as f:
+            f.write(self.path("sample0.txt") + "\n" + self.path("sample1.txt") + "\n")
+        self.run_sst("25us",
+                     self.pe_params(connectivity_file=self.path("conn.bin"),
+                                    connectivity_format="records",
+                                    sample_period="10us",
+                                    sample_counts_file=self.path("counts_node{node}.csv"),
+                                    **pe_extra),
+                     {"sample_list": self.path("samples.txt"),
+                      "sample_period": "10us",
+                      "clock": "1GHz",
+                      "dataset_format": "TEXT",
+                      "neurons_per_core": self.NEURONS_PER_CORE,
+                      "cores_per_node": self.NUM_CORES})
+        counts = {}
+        with open(self.path("counts_node0.csv")) as f:
+            next(f)
+            for line in f:
+                sample, neuron, n = (int(x) for x in line.split(","))
+                counts[(sample, neuron)] = n
+        return counts
+
+    def check_boundary(self, counts):
+        self.assertIn((0, 0), counts)
+        self.assertIn((1, 1), counts)
+        self.assertNotIn((0, 4), counts)
+        self.assertNotIn((1, 4), counts)
+
+    def test_delay_line_flushed_at_boundary(self):
+        write_records(self.path("conn.bin"), [(0, 4, 1.0)])
+        with open(self.path("delays.bin"), "wb") as f:
+            f.write(bytes([50]))
+        self.check_boundary(self.run_samples(delay_file=self.path("delays.bin"), max_synaptic_delay=64))
+
+    def test_delay_line_flushed_at_boundary_while_suspended(self):
+        """节点时钟挂起时边界须按时处理，而不是推迟到样本1的首个输入"""
+        write_records(self.path("conn.bin"), [(0, 4, 1.0)])
+        with open(self.path("delays.bin"), "wb") as f:
+            f.write(bytes([50]))
+        self.check_boundary(self.run_samples(delay_file=self.path("delays.bin"), max_synaptic_delay=64,
+                                             enable_clock_suspend=1))
+
+    def test_mailbox_flushed_at_boundary(self):
+        write_records(self.path("conn.bin"), [(0, 4, 1.0)])
+        self.check_boundary(self.run_samples(mailbox_latency=200))
+
+
+class SparseWeightFetchTest(SnnDLTestCase):
+    """多核心CSR权重取数：各核心的块行数/基址须与 WeightLoader 的 neurons_per_core/per_core_stride 一致"""
+
+    NEURONS_PER_CORE = 16
+    BASE_ADDR = 0x10000
+    STRIDE = 0x1000
+
+    def write_block(self, core, weights):
+        """写出核心的块内稠密 float32 矩阵：weights 为 {(块内pre, 块内post): w}"""
+        n = self.NEURONS_PER_CORE
+        with open(self.path(f"w_core{core}.bin"), "wb") as f:
+            for pre in range(n):
+                f.write(struct.pack(f"<{n}f", *(weights.get((pre, post), 0.0) for post in range(n))))
+
+    def core_params(self, core):
+        n = self.NEURONS_PER_CORE
+        return {
+            "core_id": core,
+            "total_cores": self.NUM_CORES,
+            "num_neurons": self.NUM_CORES * n,
+            "global_neuron_base": 0,
+            "node_id": 0,
+            "v_thresh": 0.5,
+            "v_rest": 0.0,
+            "v_reset": 0.0,
+            "base_addr": self.BASE_ADDR + core * self.STRIDE,
+            "weight_rows": n,
+            "weight_block_offset": core * n,
+            "weight_layout": "csr",
+            "enable_weight_fetch": 1,
+            "row_fanout_delivery": 1,
+            "write_weights_on_init": 0,
+            "memory_warmup_cycles": 100,
+        }
+
+    def run_fetch(self, pe_extra, cores=None):
+        """核心0输入块内行3（列5=0.7越阈），核心1输入神经元16即块内行0（列1=0.6越阈），返回各核心发放的神经元"""
+        self.write_block(0, {(3, 5): 0.7, (3, 6): 0.2})
+        self.write_block(1, {(0, 1): 0.6, (0, 2): 0.2})
+        write_spikes(self.path("input.txt"), [(3, 5), (16, 5)])
+        n = self.NEURONS_PER_CORE
+        memory = {
+            "loader_params": {
+                "num_cores": self.NUM_CORES,
+                "neurons_per_core": n,
+                "base_addr_start": self.BASE_ADDR,
+                "per_core_stride": self.STRIDE,
+                "per_core_files": 1,
+                "file_template": self.path("w_core{core}.bin"),
+                "weight_format": "bin",
+                "weight_layout": "csr",
+                "runtime_reload": 0,
+                "timed_seed_enable": 0,
+            },
+        }
+        if cores is not None:
+            memory["cores"] = cores
+        self.run_sst("30us",
+                     self.pe_params(neurons_per_core=n, use_event_weight_fallback=0, **pe_extra),
+                     {"dataset_path": self.path("input.txt"),
+                      "dataset_format": "TEXT",
+                      "neurons_per_core": n,
+                      "cores_per_node": self.NUM_CORES},
+                     memory=memory)
+
+        fires = {}
+        for e in self.trace():
+            if snndl_trace.EVENT_TYPES.get(e.type) == "NEURON_FIRE":
+                fires.setdefault(e.core, set()).add(e.b)
+        return fires
+
+    def test_rows_fetched_from_own_block(self):
+        """用户槽位核心：各核心读自己块的行，只有权重越阈的神经元发放"""
+        fires = self.run_fetch({}, cores=[self.core_params(core) for core in range(self.NUM_CORES)])
+        self.assertEqual(fires.get(0), {5})
+        self.assertEqual(fires.get(1), {17})
+
+    def test_anonymous_cores_fetch_rows(self):
+        """匿名核心：MultiCorePE 转发 enable_weight_fetch 与块地址，核心经 core{i}_mem 端口取数"""
+        fires = self.run_fetch({"enable_weight_fetch": 1,
+                                "write_weights_on_init": 0,
+                                "weight_layout": "csr",
+                                "row_fanout_delivery": 1,
+                                "base_addr": self.BASE_ADDR,
+                                "core_weight_stride": self.STRIDE})
+        self.assertEqual(fires.get(0), {5})
+        self.assertEqual(fires.get(1), {17})
+
+
+class PartitionTest(unittest.TestCase):
+    """partition_nodes.partition 的初始分块（不需要sst）"""
+
+    def test_ranks_balanced_without_empty_rank(self):
+        for num_nodes, ranks, mesh_x in [(16, 5, 4), (16, 3, 4), (8, 3, 8), (16, 4, 4)]:
+            counts = [0] * ranks
+            for rank in partition(num_nodes, ranks, {}, mesh_x):
+                counts[rank] += 1
+            self.assertLessEqual(max(counts) - min(counts), 1, f"{num_nodes}节点{ranks}rank: {counts}")
+            self.assertGreater(min(counts), 0)
+
+    def test_more_ranks_than_nodes_rejected(self):
+        with self.assertRaises(ValueError):
+            partition(4, 5, {}, 4)
+
+
+if __name__ == "__main__":
+    unittest.main()